@@ -0,0 +1,78 @@
+#include "benchmark_runner.hpp"
+#include "duckdb_benchmark_macro.hpp"
+
+#include <thread>
+
+using namespace duckdb;
+using namespace std;
+
+//////////////////
+// GROUP COMMIT //
+//////////////////
+// Every thread performs a series of small auto-committed inserts on its own connection
+// The number of commits per second is GROUP_COMMIT_COUNT divided by the benchmark time
+#define GROUP_COMMIT_COUNT 2000
+
+static void group_commit_insert(DuckDB *db, idx_t thread_count, idx_t threadnr) {
+	Connection con(*db);
+	for (idx_t i = threadnr; i < GROUP_COMMIT_COUNT; i += thread_count) {
+		con.Query("INSERT INTO integers VALUES (" + to_string(i) + ")");
+	}
+}
+
+#define GROUP_COMMIT_BENCHMARK(THREADS, COMMIT_DELAY)                                                                  \
+	void Load(DuckDBBenchmarkState *state) override {                                                                  \
+		state->conn.Query("PRAGMA commit_delay=" + to_string(COMMIT_DELAY));                                           \
+		state->conn.Query("CREATE TABLE integers(i INTEGER)");                                                         \
+	}                                                                                                                  \
+	void RunBenchmark(DuckDBBenchmarkState *state) override {                                                          \
+		vector<thread> threads;                                                                                        \
+		for (idx_t i = 0; i < THREADS; i++) {                                                                          \
+			threads.push_back(thread(group_commit_insert, &state->db, THREADS, i));                                    \
+		}                                                                                                              \
+		for (auto &thread : threads) {                                                                                 \
+			thread.join();                                                                                             \
+		}                                                                                                              \
+	}                                                                                                                  \
+	void Cleanup(DuckDBBenchmarkState *state) override {                                                               \
+		state->conn.Query("DROP TABLE integers");                                                                      \
+		state->conn.Query("CREATE TABLE integers(i INTEGER)");                                                         \
+	}                                                                                                                  \
+	string VerifyResult(QueryResult *result) override {                                                                \
+		return string();                                                                                               \
+	}                                                                                                                  \
+	bool InMemory() override {                                                                                         \
+		return false;                                                                                                  \
+	}                                                                                                                  \
+	string BenchmarkInfo() override {                                                                                  \
+		return StringUtil::Format("Commit 2K single-row inserts from %d threads (commit delay: %dus)", THREADS,        \
+		                          COMMIT_DELAY);                                                                       \
+	}
+
+DUCKDB_BENCHMARK(GroupCommit1Thread, "[group_commit]")
+GROUP_COMMIT_BENCHMARK(1, 0)
+FINISH_BENCHMARK(GroupCommit1Thread)
+
+DUCKDB_BENCHMARK(GroupCommit2Threads, "[group_commit]")
+GROUP_COMMIT_BENCHMARK(2, 0)
+FINISH_BENCHMARK(GroupCommit2Threads)
+
+DUCKDB_BENCHMARK(GroupCommit4Threads, "[group_commit]")
+GROUP_COMMIT_BENCHMARK(4, 0)
+FINISH_BENCHMARK(GroupCommit4Threads)
+
+DUCKDB_BENCHMARK(GroupCommit8Threads, "[group_commit]")
+GROUP_COMMIT_BENCHMARK(8, 0)
+FINISH_BENCHMARK(GroupCommit8Threads)
+
+DUCKDB_BENCHMARK(GroupCommit16Threads, "[group_commit]")
+GROUP_COMMIT_BENCHMARK(16, 0)
+FINISH_BENCHMARK(GroupCommit16Threads)
+
+DUCKDB_BENCHMARK(GroupCommit8ThreadsDelay, "[group_commit]")
+GROUP_COMMIT_BENCHMARK(8, 100)
+FINISH_BENCHMARK(GroupCommit8ThreadsDelay)
+
+DUCKDB_BENCHMARK(GroupCommit16ThreadsDelay, "[group_commit]")
+GROUP_COMMIT_BENCHMARK(16, 100)
+FINISH_BENCHMARK(GroupCommit16ThreadsDelay)
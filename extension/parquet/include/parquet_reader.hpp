@@ -12,6 +12,7 @@
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/common/types/data_chunk.hpp"
+#include "duckdb/function/table_function.hpp"
 #include "resizable_buffer.hpp"
 
 #include "parquet_types.h"
@@ -60,6 +61,8 @@ struct ParquetReaderScanState {
 	idx_t group_offset;
 	vector<unique_ptr<ParquetReaderColumnData>> column_data;
 	bool finished;
+	//! The filters that are pushed into the scan (if any), keyed by the index into column_ids
+	unordered_map<idx_t, vector<TableFilter>> *filters;
 };
 
 class ParquetReader {
@@ -74,14 +77,22 @@ public:
 	vector<string> names;
 
 public:
-	void Initialize(ParquetReaderScanState &state, vector<column_t> column_ids, vector<idx_t> groups_to_read);
+	void Initialize(ParquetReaderScanState &state, vector<column_t> column_ids, vector<idx_t> groups_to_read,
+	                unordered_map<idx_t, vector<TableFilter>> *filters = nullptr);
 	void ReadChunk(ParquetReaderScanState &state, DataChunk &output);
 
+	//! Checks the column chunk statistics of a row group against a set of filters. Returns false if no row in the
+	//! row group can satisfy the filters, in which case the row group does not need to be read at all.
+	bool RowGroupMatchesFilters(idx_t group_idx, vector<column_t> &column_ids,
+	                            unordered_map<idx_t, vector<TableFilter>> &filters);
+
 	idx_t NumRows();
 	idx_t NumRowGroups();
 
 private:
 	parquet::format::RowGroup &GetGroup(ParquetReaderScanState &state);
+	void ScanChunk(ParquetReaderScanState &state, DataChunk &output);
+	void FilterChunk(ParquetReaderScanState &state, DataChunk &output);
 	void PrepareChunkBuffer(ParquetReaderScanState &state, idx_t col_idx);
 	bool PreparePageBuffers(ParquetReaderScanState &state, idx_t col_idx);
 
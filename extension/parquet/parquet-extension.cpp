@@ -36,6 +36,7 @@ struct ParquetReadOperatorData : public FunctionOperatorData {
 	bool is_parallel;
 	idx_t file_index;
 	vector<column_t> column_ids;
+	unordered_map<idx_t, vector<TableFilter>> *table_filters;
 };
 
 struct ParquetReadParallelState : public ParallelState {
@@ -53,6 +54,18 @@ public:
 	                    /* pushdown_complex_filter */ nullptr, /* to_string */ nullptr, parquet_max_threads,
 	                    parquet_init_parallel_state, parquet_scan_parallel_init, parquet_parallel_state_next) {
 		projection_pushdown = true;
+		filter_pushdown = true;
+	}
+
+	//! Returns the row groups of the reader that can contain rows matching the pushed down filters
+	static vector<idx_t> parquet_filter_row_groups(ParquetReader &reader, ParquetReadOperatorData &data) {
+		vector<idx_t> group_ids;
+		for (idx_t i = 0; i < reader.NumRowGroups(); i++) {
+			if (!data.table_filters || reader.RowGroupMatchesFilters(i, data.column_ids, *data.table_filters)) {
+				group_ids.push_back(i);
+			}
+		}
+		return group_ids;
 	}
 
 	static unique_ptr<FunctionData> parquet_read_bind(ClientContext &context, CopyInfo &info,
@@ -96,16 +109,14 @@ public:
 
 		auto result = make_unique<ParquetReadOperatorData>();
 		result->column_ids = column_ids;
+		result->table_filters = &table_filters;
 
 		result->is_parallel = false;
 		result->file_index = 0;
-		// single-threaded: one thread has to read all groups
-		vector<idx_t> group_ids;
-		for (idx_t i = 0; i < bind_data.initial_reader->NumRowGroups(); i++) {
-			group_ids.push_back(i);
-		}
+		// single-threaded: one thread has to read all groups that are not pruned by the filters
 		result->reader = bind_data.initial_reader;
-		result->reader->Initialize(result->scan_state, column_ids, move(group_ids));
+		auto group_ids = parquet_filter_row_groups(*result->reader, *result);
+		result->reader->Initialize(result->scan_state, column_ids, move(group_ids), &table_filters);
 		return move(result);
 	}
 
@@ -114,6 +125,7 @@ public:
 	                           vector<column_t> &column_ids, unordered_map<idx_t, vector<TableFilter>> &table_filters) {
 		auto result = make_unique<ParquetReadOperatorData>();
 		result->column_ids = column_ids;
+		result->table_filters = &table_filters;
 		result->is_parallel = true;
 		if (!parquet_parallel_state_next(context, bind_data_, result.get(), parallel_state_)) {
 			return nullptr;
@@ -134,11 +146,8 @@ public:
 					string file = bind_data.files[data.file_index];
 					// move to the next file
 					data.reader = make_shared<ParquetReader>(context, file, data.reader->return_types);
-					vector<idx_t> group_ids;
-					for (idx_t i = 0; i < data.reader->NumRowGroups(); i++) {
-						group_ids.push_back(i);
-					}
-					data.reader->Initialize(data.scan_state, data.column_ids, move(group_ids));
+					auto group_ids = parquet_filter_row_groups(*data.reader, data);
+					data.reader->Initialize(data.scan_state, data.column_ids, move(group_ids), data.table_filters);
 				} else {
 					// exhausted all the files: done
 					break;
@@ -176,33 +185,33 @@ public:
 		auto &scan_data = (ParquetReadOperatorData &)*state_;
 
 		lock_guard<mutex> parallel_lock(parallel_state.lock);
-		if (parallel_state.row_group_index < parallel_state.current_reader->NumRowGroups()) {
-			// groups remain in the current parquet file: read the next group
-			scan_data.reader = parallel_state.current_reader;
-			vector<idx_t> group_indexes{parallel_state.row_group_index};
-			scan_data.reader->Initialize(scan_data.scan_state, scan_data.column_ids, group_indexes);
-			parallel_state.row_group_index++;
-			return true;
-		} else {
-			// no groups remain in the current parquet file: check if there are more files to read
-			while (parallel_state.file_index + 1 < bind_data.files.size()) {
-				// read the next file
-				string file = bind_data.files[++parallel_state.file_index];
-				parallel_state.current_reader =
-				    make_shared<ParquetReader>(context, file, parallel_state.current_reader->return_types);
-				if (parallel_state.current_reader->NumRowGroups() == 0) {
-					// empty parquet file, move to next file
-					continue;
-				}
-				// set up the scan state to read the first group
+		while (true) {
+			auto &reader = *parallel_state.current_reader;
+			// skip over the row groups of the current file that are pruned by the filters
+			while (parallel_state.row_group_index < reader.NumRowGroups() && scan_data.table_filters &&
+			       !reader.RowGroupMatchesFilters(parallel_state.row_group_index, scan_data.column_ids,
+			                                      *scan_data.table_filters)) {
+				parallel_state.row_group_index++;
+			}
+			if (parallel_state.row_group_index < reader.NumRowGroups()) {
+				// groups remain in the current parquet file: read the next group
 				scan_data.reader = parallel_state.current_reader;
-				vector<idx_t> group_indexes{0};
-				scan_data.reader->Initialize(scan_data.scan_state, scan_data.column_ids, group_indexes);
-				parallel_state.row_group_index = 1;
+				vector<idx_t> group_indexes{parallel_state.row_group_index};
+				scan_data.reader->Initialize(scan_data.scan_state, scan_data.column_ids, group_indexes,
+				                             scan_data.table_filters);
+				parallel_state.row_group_index++;
 				return true;
 			}
+			// no groups remain in the current parquet file: check if there are more files to read
+			if (parallel_state.file_index + 1 >= bind_data.files.size()) {
+				return false;
+			}
+			// read the next file
+			string file = bind_data.files[++parallel_state.file_index];
+			parallel_state.current_reader =
+			    make_shared<ParquetReader>(context, file, parallel_state.current_reader->return_types);
+			parallel_state.row_group_index = 0;
 		}
-		return false;
 	}
 };
 
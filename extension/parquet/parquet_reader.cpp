@@ -13,6 +13,7 @@
 #include "duckdb/common/types/timestamp.hpp"
 #include "duckdb/common/serializer/buffered_file_writer.hpp"
 #include "duckdb/common/serializer/buffered_serializer.hpp"
+#include "duckdb/storage/uncompressed_segment.hpp"
 
 #include "thrift/protocol/TCompactProtocol.h"
 #include "thrift/transport/TBufferTransports.h"
@@ -23,6 +24,7 @@
 
 #include "utf8proc_wrapper.hpp"
 
+#include <cmath>
 #include <sstream>
 
 namespace duckdb {
@@ -40,6 +42,7 @@ using parquet::format::FileMetaData;
 using parquet::format::PageHeader;
 using parquet::format::PageType;
 using parquet::format::RowGroup;
+using parquet::format::SchemaElement;
 using parquet::format::Type;
 using parquet::format::ConvertedType;
 
@@ -702,10 +705,142 @@ idx_t ParquetReader::NumRowGroups() {
 	return file_meta_data.row_groups.size();
 }
 
+template <class T>
+static bool CheckStatisticsTemplated(TableFilter &filter, T min, T max, T constant) {
+	switch (filter.comparison_type) {
+	case ExpressionType::COMPARE_EQUAL:
+		return constant >= min && constant <= max;
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		return constant <= max;
+	case ExpressionType::COMPARE_GREATERTHAN:
+		return constant < max;
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		return constant >= min;
+	case ExpressionType::COMPARE_LESSTHAN:
+		return constant > min;
+	default:
+		// unknown comparison: we cannot prune anything
+		return true;
+	}
+}
+
+template <class T> static bool LoadStatistic(const string &stat, T &result) {
+	// statistics are stored using the PLAIN encoding of the physical type
+	if (stat.size() != sizeof(T)) {
+		return false;
+	}
+	result = Load<T>((data_ptr_t)stat.c_str());
+	return true;
+}
+
+template <class T>
+static bool CheckNumericStatistics(TableFilter &filter, const string &min_stat, const string &max_stat, T constant) {
+	T min, max;
+	if (!LoadStatistic<T>(min_stat, min) || !LoadStatistic<T>(max_stat, max)) {
+		return true;
+	}
+	return CheckStatisticsTemplated<T>(filter, min, max, constant);
+}
+
+template <timestamp_t (*FUNC)(const int64_t &input)>
+static bool CheckTimestampStatistics(TableFilter &filter, const string &min_stat, const string &max_stat,
+                                     timestamp_t constant) {
+	int64_t min, max;
+	if (!LoadStatistic<int64_t>(min_stat, min) || !LoadStatistic<int64_t>(max_stat, max)) {
+		return true;
+	}
+	return CheckStatisticsTemplated<timestamp_t>(filter, FUNC(min), FUNC(max), constant);
+}
+
+template <class T>
+static bool CheckFloatingPointStatistics(TableFilter &filter, const string &min_stat, const string &max_stat,
+                                         T constant) {
+	T min, max;
+	if (!LoadStatistic<T>(min_stat, min) || !LoadStatistic<T>(max_stat, max)) {
+		return true;
+	}
+	if (std::isnan(min) || std::isnan(max)) {
+		return true;
+	}
+	return CheckStatisticsTemplated<T>(filter, min, max, constant);
+}
+
+static bool CheckStatistics(SchemaElement &s_ele, const LogicalType &type, TableFilter &filter,
+                            const string &min_stat, const string &max_stat) {
+	auto &constant = filter.constant;
+	switch (s_ele.type) {
+	case Type::INT32:
+		return CheckNumericStatistics<int32_t>(filter, min_stat, max_stat, constant.value_.integer);
+	case Type::INT64:
+		if (type.id() == LogicalTypeId::TIMESTAMP) {
+			switch (s_ele.converted_type) {
+			case ConvertedType::TIMESTAMP_MICROS:
+				return CheckTimestampStatistics<arrow_timestamp_micros_to_timestamp>(filter, min_stat, max_stat,
+				                                                                     constant.value_.bigint);
+			case ConvertedType::TIMESTAMP_MILLIS:
+				return CheckTimestampStatistics<arrow_timestamp_ms_to_timestamp>(filter, min_stat, max_stat,
+				                                                                 constant.value_.bigint);
+			default:
+				return true;
+			}
+		}
+		return CheckNumericStatistics<int64_t>(filter, min_stat, max_stat, constant.value_.bigint);
+	case Type::FLOAT:
+		return CheckFloatingPointStatistics<float>(filter, min_stat, max_stat, constant.value_.float_);
+	case Type::DOUBLE:
+		return CheckFloatingPointStatistics<double>(filter, min_stat, max_stat, constant.value_.double_);
+	case Type::BYTE_ARRAY:
+		// std::string compares bytewise as unsigned characters, which matches both the parquet and our ordering
+		return CheckStatisticsTemplated<string>(filter, min_stat, max_stat, constant.str_value);
+	default:
+		// INT96 timestamps have no well-defined sort order in parquet, booleans are never pushed down
+		return true;
+	}
+}
+
+bool ParquetReader::RowGroupMatchesFilters(idx_t group_idx, vector<column_t> &column_ids,
+                                           unordered_map<idx_t, vector<TableFilter>> &filters) {
+	auto &group = file_meta_data.row_groups[group_idx];
+	for (auto &entry : filters) {
+		auto file_col_idx = column_ids[entry.first];
+		if (file_col_idx == COLUMN_IDENTIFIER_ROW_ID) {
+			continue;
+		}
+		auto &chunk = group.columns[file_col_idx];
+		if (!chunk.__isset.meta_data || !chunk.meta_data.__isset.statistics) {
+			continue;
+		}
+		auto &stats = chunk.meta_data.statistics;
+		if (stats.__isset.null_count && stats.null_count == group.num_rows && group.num_rows > 0) {
+			// the column chunk only contains NULL values: the comparison can never be true
+			return false;
+		}
+		auto &s_ele = file_meta_data.schema[file_col_idx + 1];
+		const string *min_stat, *max_stat;
+		if (stats.__isset.min_value && stats.__isset.max_value) {
+			min_stat = &stats.min_value;
+			max_stat = &stats.max_value;
+		} else if (stats.__isset.min && stats.__isset.max && s_ele.type != Type::BYTE_ARRAY) {
+			// the deprecated min/max fields used signed comparisons for strings, only use them for numerics
+			min_stat = &stats.min;
+			max_stat = &stats.max;
+		} else {
+			continue;
+		}
+		for (auto &filter : entry.second) {
+			if (!CheckStatistics(s_ele, return_types[file_col_idx], filter, *min_stat, *max_stat)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
 void ParquetReader::Initialize(ParquetReaderScanState &state, vector<column_t> column_ids,
-                               vector<idx_t> groups_to_read) {
+                               vector<idx_t> groups_to_read, unordered_map<idx_t, vector<TableFilter>> *filters) {
 	state.current_group = -1;
 	state.finished = false;
+	state.filters = filters && !filters->empty() ? filters : nullptr;
 	state.column_ids = move(column_ids);
 	state.group_offset = 0;
 	state.group_idx_list = move(groups_to_read);
@@ -715,6 +850,39 @@ void ParquetReader::Initialize(ParquetReaderScanState &state, vector<column_t> c
 }
 
 void ParquetReader::ReadChunk(ParquetReaderScanState &state, DataChunk &output) {
+	while (true) {
+		ScanChunk(state, output);
+		if (state.finished) {
+			return;
+		}
+		if (state.filters) {
+			FilterChunk(state, output);
+		}
+		if (output.size() > 0) {
+			return;
+		}
+		// nothing in this chunk qualified (or the row group was empty): move on to the next chunk
+		output.Reset();
+	}
+}
+
+void ParquetReader::FilterChunk(ParquetReaderScanState &state, DataChunk &output) {
+	SelectionVector sel;
+	sel.Initialize(FlatVector::IncrementalSelectionVector);
+	idx_t approved_tuple_count = output.size();
+	for (auto &entry : *state.filters) {
+		auto &vector = output.data[entry.first];
+		for (auto &filter : entry.second) {
+			UncompressedSegment::filterSelection(sel, vector, filter, approved_tuple_count,
+			                                     FlatVector::Nullmask(vector));
+		}
+	}
+	if (approved_tuple_count != output.size()) {
+		output.Slice(sel, approved_tuple_count);
+	}
+}
+
+void ParquetReader::ScanChunk(ParquetReaderScanState &state, DataChunk &output) {
 	if (state.finished) {
 		return;
 	}
@@ -13,6 +13,7 @@
 #include "duckdb/common/types/timestamp.hpp"
 #include "duckdb/common/serializer/buffered_file_writer.hpp"
 #include "duckdb/common/serializer/buffered_serializer.hpp"
+#include "duckdb/common/operator/comparison_operators.hpp"
 
 #include "snappy.h"
 
@@ -30,6 +31,7 @@ using parquet::format::FileMetaData;
 using parquet::format::PageHeader;
 using parquet::format::PageType;
 using parquet::format::RowGroup;
+using parquet::format::Statistics;
 using parquet::format::Type;
 
 class MyTransport : public TTransport {
@@ -115,6 +117,107 @@ static void _write_plain(Vector &col, idx_t length, nullmask_t &nullmask, Serial
 	}
 }
 
+template <class SRC, class TGT>
+static void _write_min_max(ChunkCollection &buffer, idx_t col_idx, Statistics &stats) {
+	bool has_values = false;
+	TGT min = TGT(), max = TGT();
+	for (auto &chunk : buffer.chunks) {
+		auto &input_column = chunk->data[col_idx];
+		auto *ptr = FlatVector::GetData<SRC>(input_column);
+		auto &nullmask = FlatVector::Nullmask(input_column);
+		for (idx_t r = 0; r < chunk->size(); r++) {
+			if (nullmask[r]) {
+				continue;
+			}
+			auto value = (TGT)ptr[r];
+			if (!has_values) {
+				min = max = value;
+				has_values = true;
+			} else if (value < min) {
+				min = value;
+			} else if (value > max) {
+				max = value;
+			}
+		}
+	}
+	if (has_values) {
+		// the min/max are stored using the PLAIN encoding of the physical type
+		stats.min_value = string((const char *)&min, sizeof(TGT));
+		stats.max_value = string((const char *)&max, sizeof(TGT));
+		stats.__isset.min_value = true;
+		stats.__isset.max_value = true;
+	}
+}
+
+static void _write_string_min_max(ChunkCollection &buffer, idx_t col_idx, Statistics &stats) {
+	bool has_values = false;
+	string_t min, max;
+	for (auto &chunk : buffer.chunks) {
+		auto &input_column = chunk->data[col_idx];
+		auto *ptr = FlatVector::GetData<string_t>(input_column);
+		auto &nullmask = FlatVector::Nullmask(input_column);
+		for (idx_t r = 0; r < chunk->size(); r++) {
+			if (nullmask[r]) {
+				continue;
+			}
+			if (!has_values) {
+				min = max = ptr[r];
+				has_values = true;
+			} else if (LessThan::Operation<string_t>(ptr[r], min)) {
+				min = ptr[r];
+			} else if (GreaterThan::Operation<string_t>(ptr[r], max)) {
+				max = ptr[r];
+			}
+		}
+	}
+	if (has_values) {
+		stats.min_value = min.GetString();
+		stats.max_value = max.GetString();
+		stats.__isset.min_value = true;
+		stats.__isset.max_value = true;
+	}
+}
+
+//! Write the statistics of a column chunk, these allow readers to skip row groups that cannot match a filter
+static void _write_statistics(ChunkCollection &buffer, idx_t col_idx, LogicalType &type, Statistics &stats) {
+	int64_t null_count = 0;
+	for (auto &chunk : buffer.chunks) {
+		auto &nullmask = FlatVector::Nullmask(chunk->data[col_idx]);
+		for (idx_t r = 0; r < chunk->size(); r++) {
+			null_count += nullmask[r];
+		}
+	}
+	stats.null_count = null_count;
+	stats.__isset.null_count = true;
+
+	switch (type.id()) {
+	case LogicalTypeId::TINYINT:
+		_write_min_max<int8_t, int32_t>(buffer, col_idx, stats);
+		break;
+	case LogicalTypeId::SMALLINT:
+		_write_min_max<int16_t, int32_t>(buffer, col_idx, stats);
+		break;
+	case LogicalTypeId::INTEGER:
+		_write_min_max<int32_t, int32_t>(buffer, col_idx, stats);
+		break;
+	case LogicalTypeId::BIGINT:
+		_write_min_max<int64_t, int64_t>(buffer, col_idx, stats);
+		break;
+	case LogicalTypeId::FLOAT:
+		_write_min_max<float, float>(buffer, col_idx, stats);
+		break;
+	case LogicalTypeId::DOUBLE:
+		_write_min_max<double, double>(buffer, col_idx, stats);
+		break;
+	case LogicalTypeId::VARCHAR:
+		_write_string_min_max(buffer, col_idx, stats);
+		break;
+	default:
+		// no min/max for the remaining types: INT96 has no defined sort order
+		break;
+	}
+}
+
 ParquetWriter::ParquetWriter(FileSystem &fs, string file_name_, vector<LogicalType> types_, vector<string> names_)
     : file_name(file_name_), sql_types(move(types_)), column_names(move(names_)) {
 	// initialize the file writer
@@ -316,6 +419,8 @@ void ParquetWriter::Flush(ChunkCollection &buffer) {
 		column_chunk.meta_data.path_in_schema.push_back(file_meta_data.schema[i + 1].name);
 		column_chunk.meta_data.num_values = buffer.count;
 		column_chunk.meta_data.type = file_meta_data.schema[i + 1].type;
+		_write_statistics(buffer, i, sql_types[i], column_chunk.meta_data.statistics);
+		column_chunk.meta_data.__isset.statistics = true;
 	}
 	row_group.num_rows += buffer.count;
 
@@ -66,8 +66,10 @@ TableCatalogEntry::TableCatalogEntry(Catalog *catalog, SchemaCatalogEntry *schem
 	if (!storage) {
 		// create the physical storage
 		storage = make_shared<DataTable>(catalog->storage, schema->name, name, GetTypes(), move(info->data));
+		storage->info->cardinality = info->row_count;
 
 		// create the unique indexes for the UNIQUE and PRIMARY KEY constraints
+		idx_t unique_index = 0;
 		for (idx_t i = 0; i < bound_constraints.size(); i++) {
 			auto &constraint = bound_constraints[i];
 			if (constraint->type == ConstraintType::UNIQUE) {
@@ -89,7 +91,15 @@ TableCatalogEntry::TableCatalogEntry(Catalog *catalog, SchemaCatalogEntry *schem
 				}
 				// create an adaptive radix tree around the expressions
 				auto art = make_unique<ART>(column_ids, move(unbound_expressions), true);
-				storage->AddIndex(move(art), bound_expressions);
+				if (info->indexes.empty()) {
+					storage->AddIndex(move(art), bound_expressions);
+				} else {
+					// the index was written to disk: read it from there
+					D_ASSERT(unique_index < info->indexes.size());
+					art->Deserialize(*catalog->storage.buffer_manager, info->indexes[unique_index]);
+					storage->info->indexes.push_back(move(art));
+				}
+				unique_index++;
 			}
 		}
 	}
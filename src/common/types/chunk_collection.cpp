@@ -1,5 +1,6 @@
 #include "duckdb/common/types/chunk_collection.hpp"
 
+#include "duckdb/common/types/sort_key.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/printer.hpp"
 #include "duckdb/common/value_operations/value_operations.hpp"
@@ -8,7 +9,6 @@
 
 #include <algorithm>
 #include <cstring>
-#include <queue>
 
 using namespace std;
 
@@ -159,29 +159,19 @@ static int32_t compare_value(Vector &left_vec, Vector &right_vec, idx_t vector_i
 	return false;
 }
 
-static int compare_tuple(ChunkCollection *sort_by, vector<OrderType> &desc, vector<OrderByNullType> &null_order,
-                         idx_t left, idx_t right) {
-	D_ASSERT(sort_by);
-
-	idx_t chunk_idx_left = left / STANDARD_VECTOR_SIZE;
-	idx_t chunk_idx_right = right / STANDARD_VECTOR_SIZE;
-	idx_t vector_idx_left = left % STANDARD_VECTOR_SIZE;
-	idx_t vector_idx_right = right % STANDARD_VECTOR_SIZE;
-
-	auto &left_chunk = sort_by->chunks[chunk_idx_left];
-	auto &right_chunk = sort_by->chunks[chunk_idx_right];
-
+int ChunkCollection::CompareTuple(DataChunk &left, idx_t left_idx, DataChunk &right, idx_t right_idx,
+                                  vector<OrderType> &desc, vector<OrderByNullType> &null_order) {
 	for (idx_t col_idx = 0; col_idx < desc.size(); col_idx++) {
 		auto order_type = desc[col_idx];
 
-		Vector &left_vec = left_chunk->data[col_idx];
-		Vector &right_vec = right_chunk->data[col_idx];
+		Vector &left_vec = left.data[col_idx];
+		Vector &right_vec = right.data[col_idx];
 
 		D_ASSERT(left_vec.vector_type == VectorType::FLAT_VECTOR);
 		D_ASSERT(right_vec.vector_type == VectorType::FLAT_VECTOR);
 		D_ASSERT(left_vec.type == right_vec.type);
 
-		auto comp_res = compare_value(left_vec, right_vec, vector_idx_left, vector_idx_right, null_order[col_idx]);
+		auto comp_res = compare_value(left_vec, right_vec, left_idx, right_idx, null_order[col_idx]);
 
 		if (comp_res == 0) {
 			continue;
@@ -192,98 +182,36 @@ static int compare_tuple(ChunkCollection *sort_by, vector<OrderType> &desc, vect
 	return 0;
 }
 
-static int64_t _quicksort_initial(ChunkCollection *sort_by, vector<OrderType> &desc,
-                                  vector<OrderByNullType> &null_order, idx_t *result) {
-	// select pivot
-	int64_t pivot = 0;
-	int64_t low = 0, high = sort_by->count - 1;
-	// now insert elements
-	for (idx_t i = 1; i < sort_by->count; i++) {
-		if (compare_tuple(sort_by, desc, null_order, i, pivot) <= 0) {
-			result[low++] = i;
-		} else {
-			result[high--] = i;
-		}
-	}
-	D_ASSERT(low == high);
-	result[low] = pivot;
-	return low;
-}
-
-struct QuicksortInfo {
-	QuicksortInfo(int64_t left_, int64_t right_) : left(left_), right(right_) {
-	}
-
-	int64_t left;
-	int64_t right;
-};
-
-struct QuicksortStack {
-	queue<QuicksortInfo> info_queue;
-
-	QuicksortInfo Pop() {
-		auto element = info_queue.front();
-		info_queue.pop();
-		return element;
-	}
+static int compare_tuple(ChunkCollection *sort_by, vector<OrderType> &desc, vector<OrderByNullType> &null_order,
+                         idx_t left, idx_t right) {
+	D_ASSERT(sort_by);
 
-	bool IsEmpty() {
-		return info_queue.empty();
-	}
+	idx_t chunk_idx_left = left / STANDARD_VECTOR_SIZE;
+	idx_t chunk_idx_right = right / STANDARD_VECTOR_SIZE;
+	idx_t vector_idx_left = left % STANDARD_VECTOR_SIZE;
+	idx_t vector_idx_right = right % STANDARD_VECTOR_SIZE;
 
-	void Enqueue(int64_t left, int64_t right) {
-		if (left >= right) {
-			return;
-		}
-		info_queue.emplace(left, right);
-	}
-};
-
-static void _quicksort_inplace(ChunkCollection *sort_by, vector<OrderType> &desc, vector<OrderByNullType> &null_order,
-                               idx_t *result, QuicksortInfo info, QuicksortStack &stack) {
-	auto left = info.left;
-	auto right = info.right;
-
-	D_ASSERT(left < right);
-
-	int64_t middle = left + (right - left) / 2;
-	int64_t pivot = result[middle];
-	// move the mid point value to the front.
-	int64_t i = left + 1;
-	int64_t j = right;
-
-	std::swap(result[middle], result[left]);
-	bool all_equal = true;
-	while (i <= j) {
-		if (result)
-			while (i <= j) {
-				int cmp = compare_tuple(sort_by, desc, null_order, result[i], pivot);
-				if (cmp < 0) {
-					all_equal = false;
-				} else if (cmp > 0) {
-					all_equal = false;
-					break;
-				}
-				i++;
-			}
+	auto &left_chunk = sort_by->chunks[chunk_idx_left];
+	auto &right_chunk = sort_by->chunks[chunk_idx_right];
 
-		while (i <= j && compare_tuple(sort_by, desc, null_order, result[j], pivot) > 0) {
-			j--;
-		}
+	return ChunkCollection::CompareTuple(*left_chunk, vector_idx_left, *right_chunk, vector_idx_right, desc,
+	                                     null_order);
+}
 
-		if (i < j) {
-			std::swap(result[i], result[j]);
+//! Encodes the normalized sort keys of the collection; every entry consists of the key followed by the row index
+static unique_ptr<data_t[]> encode_sort_entries(ChunkCollection *sort_by, SortKeyLayout &layout, idx_t entry_width) {
+	auto entries = unique_ptr<data_t[]>(new data_t[sort_by->count * entry_width]);
+	idx_t row_idx = 0;
+	for (auto &chunk : sort_by->chunks) {
+		auto chunk_entries = entries.get() + row_idx * entry_width;
+		layout.Encode(*chunk, chunk_entries, entry_width);
+		for (idx_t i = 0; i < chunk->size(); i++) {
+			Store<idx_t>(row_idx + i, chunk_entries + i * entry_width + layout.key_width);
 		}
+		row_idx += chunk->size();
 	}
-	std::swap(result[i - 1], result[left]);
-	int64_t part = i - 1;
-
-	if (all_equal) {
-		return;
-	}
-
-	stack.Enqueue(left, part - 1);
-	stack.Enqueue(part + 1, right);
+	D_ASSERT(row_idx == sort_by->count);
+	return entries;
 }
 
 void ChunkCollection::Sort(vector<OrderType> &desc, vector<OrderByNullType> &null_order, idx_t result[]) {
@@ -291,16 +219,31 @@ void ChunkCollection::Sort(vector<OrderType> &desc, vector<OrderByNullType> &nul
 	if (count == 0) {
 		return;
 	}
-	// start off with an initial quicksort
-	int64_t part = _quicksort_initial(this, desc, null_order, result);
-
-	// now continuously perform
-	QuicksortStack stack;
-	stack.Enqueue(0, part);
-	stack.Enqueue(part + 1, count - 1);
-	while (!stack.IsEmpty()) {
-		auto element = stack.Pop();
-		_quicksort_inplace(this, desc, null_order, result, element, stack);
+	// normalize the sort columns into memcmp-comparable keys and radix sort them
+	SortKeyLayout layout(types, desc, null_order);
+	idx_t entry_width = layout.key_width + sizeof(idx_t);
+	auto entries = encode_sort_entries(this, layout, entry_width);
+	RadixSort::Sort(entries.get(), count, entry_width, layout.key_width);
+	for (idx_t i = 0; i < count; i++) {
+		result[i] = Load<idx_t>(entries.get() + i * entry_width + layout.key_width);
+	}
+	if (layout.complete) {
+		return;
+	}
+	// the key does not fully determine the order: sort the runs of equal keys by comparing the actual values
+	auto compare = [&](const idx_t &left, const idx_t &right) {
+		return compare_tuple(this, desc, null_order, left, right) < 0;
+	};
+	idx_t run_start = 0;
+	for (idx_t i = 1; i <= count; i++) {
+		if (i < count && memcmp(entries.get() + run_start * entry_width, entries.get() + i * entry_width,
+		                        layout.key_width) == 0) {
+			continue;
+		}
+		if (i - run_start > 1) {
+			std::sort(result + run_start, result + i, compare);
+		}
+		run_start = i;
 	}
 }
 
@@ -465,66 +408,32 @@ bool ChunkCollection::Equals(ChunkCollection &other) {
 	}
 	return true;
 }
-static void _heapify(ChunkCollection *input, vector<OrderType> &desc, vector<OrderByNullType> &null_order, idx_t *heap,
-                     idx_t heap_size, idx_t current_index) {
-	if (current_index >= heap_size) {
-		return;
-	}
-	idx_t left_child_index = current_index * 2 + 1;
-	idx_t right_child_index = current_index * 2 + 2;
-	idx_t swap_index = current_index;
-
-	if (left_child_index < heap_size) {
-		swap_index = compare_tuple(input, desc, null_order, heap[swap_index], heap[left_child_index]) <= 0
-		                 ? left_child_index
-		                 : swap_index;
-	}
-
-	if (right_child_index < heap_size) {
-		swap_index = compare_tuple(input, desc, null_order, heap[swap_index], heap[right_child_index]) <= 0
-		                 ? right_child_index
-		                 : swap_index;
-	}
-
-	if (swap_index != current_index) {
-		std::swap(heap[current_index], heap[swap_index]);
-		_heapify(input, desc, null_order, heap, heap_size, swap_index);
-	}
-}
-
-static void _heap_create(ChunkCollection *input, vector<OrderType> &desc, vector<OrderByNullType> &null_order,
-                         idx_t *heap, idx_t heap_size) {
-	for (idx_t i = 0; i < heap_size; i++) {
-		heap[i] = i;
-	}
-
-	// build heap
-	for (int64_t i = heap_size / 2 - 1; i >= 0; i--) {
-		_heapify(input, desc, null_order, heap, heap_size, i);
-	}
-
-	// Run through all the rows.
-	for (idx_t i = heap_size; i < input->count; i++) {
-		if (compare_tuple(input, desc, null_order, i, heap[0]) <= 0) {
-			heap[0] = i;
-			_heapify(input, desc, null_order, heap, heap_size, 0);
-		}
-	}
-}
-
 void ChunkCollection::Heap(vector<OrderType> &desc, vector<OrderByNullType> &null_order, idx_t heap[],
                            idx_t heap_size) {
 	D_ASSERT(heap);
-	if (count == 0)
+	if (count == 0) {
 		return;
+	}
+	D_ASSERT(heap_size <= count);
+	// normalize the sort columns into memcmp-comparable keys
+	SortKeyLayout layout(types, desc, null_order);
+	idx_t entry_width = layout.key_width + sizeof(idx_t);
+	auto entries = encode_sort_entries(this, layout, entry_width);
 
-	_heap_create(this, desc, null_order, heap, heap_size);
-
-	// Heap is ready. Now do a heapsort
-	for (int64_t i = heap_size - 1; i >= 0; i--) {
-		std::swap(heap[i], heap[0]);
-		_heapify(this, desc, null_order, heap, i, 0);
+	// select the smallest heap_size rows in order, falling back to comparing the values only for equal keys
+	auto rows = unique_ptr<idx_t[]>(new idx_t[count]);
+	for (idx_t i = 0; i < count; i++) {
+		rows[i] = i;
 	}
+	auto compare = [&](const idx_t &left, const idx_t &right) {
+		auto cmp = memcmp(entries.get() + left * entry_width, entries.get() + right * entry_width, layout.key_width);
+		if (cmp != 0 || layout.complete) {
+			return cmp < 0;
+		}
+		return compare_tuple(this, desc, null_order, left, right) < 0;
+	};
+	std::partial_sort(rows.get(), rows.get() + heap_size, rows.get() + count, compare);
+	memcpy(heap, rows.get(), heap_size * sizeof(idx_t));
 }
 
 idx_t ChunkCollection::MaterializeHeapChunk(DataChunk &target, idx_t order[], idx_t start_offset, idx_t heap_size) {
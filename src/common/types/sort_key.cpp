@@ -0,0 +1,215 @@
+#include "duckdb/common/types/sort_key.hpp"
+
+#include "duckdb/common/types/hugeint.hpp"
+#include "duckdb/execution/index/art/art_key.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace duckdb {
+using namespace std;
+
+SortKeyLayout::SortKeyLayout(vector<LogicalType> &types, vector<OrderType> &order_types_p,
+                             vector<OrderByNullType> &null_order_p)
+    : key_width(0), complete(true) {
+	D_ASSERT(order_types_p.size() == null_order_p.size());
+	D_ASSERT(order_types_p.size() <= types.size());
+	for (idx_t col_idx = 0; col_idx < order_types_p.size(); col_idx++) {
+		auto physical_type = types[col_idx].InternalType();
+		idx_t width;
+		switch (physical_type) {
+		case PhysicalType::BOOL:
+		case PhysicalType::INT8:
+		case PhysicalType::INT16:
+		case PhysicalType::INT32:
+		case PhysicalType::INT64:
+		case PhysicalType::INT128:
+		case PhysicalType::FLOAT:
+		case PhysicalType::DOUBLE:
+			width = GetTypeIdSize(physical_type);
+			break;
+		case PhysicalType::VARCHAR:
+			width = STRING_PREFIX_LENGTH;
+			break;
+		default:
+			// intervals and nested types have no order-preserving encoding: the key ends here
+			complete = false;
+			return;
+		}
+		column_types.push_back(physical_type);
+		order_types.push_back(order_types_p[col_idx]);
+		null_order.push_back(null_order_p[col_idx]);
+		column_widths.push_back(1 + width);
+		key_width += 1 + width;
+		if (physical_type == PhysicalType::VARCHAR) {
+			// strings are only encoded by their prefix: columns after a string cannot be part of the key
+			complete = false;
+			return;
+		}
+	}
+}
+
+//! Writes the lowest width bytes of the value in big-endian order
+static inline void EncodeBigEndian(uint64_t value, idx_t width, data_ptr_t target) {
+	for (idx_t i = 0; i < width; i++) {
+		target[i] = (value >> (8 * (width - i - 1))) & 0xFF;
+	}
+}
+
+template <class T, class U> static inline void EncodeSigned(T value, data_ptr_t target) {
+	// flipping the sign bit makes the two's complement representation order-preserving as an unsigned integer
+	auto unsigned_value = (U)value ^ ((U)1 << (sizeof(U) * 8 - 1));
+	EncodeBigEndian(unsigned_value, sizeof(U), target);
+}
+
+static void EncodeValue(PhysicalType type, data_ptr_t source, idx_t idx, data_ptr_t target) {
+	switch (type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+		EncodeSigned<int8_t, uint8_t>(((int8_t *)source)[idx], target);
+		break;
+	case PhysicalType::INT16:
+		EncodeSigned<int16_t, uint16_t>(((int16_t *)source)[idx], target);
+		break;
+	case PhysicalType::INT32:
+		EncodeSigned<int32_t, uint32_t>(((int32_t *)source)[idx], target);
+		break;
+	case PhysicalType::INT64:
+		EncodeSigned<int64_t, uint64_t>(((int64_t *)source)[idx], target);
+		break;
+	case PhysicalType::INT128: {
+		auto value = ((hugeint_t *)source)[idx];
+		EncodeSigned<int64_t, uint64_t>(value.upper, target);
+		EncodeBigEndian(value.lower, sizeof(uint64_t), target + sizeof(uint64_t));
+		break;
+	}
+	case PhysicalType::FLOAT:
+		EncodeBigEndian(Key::EncodeFloat(((float *)source)[idx]), sizeof(uint32_t), target);
+		break;
+	case PhysicalType::DOUBLE:
+		EncodeBigEndian(Key::EncodeDouble(((double *)source)[idx]), sizeof(uint64_t), target);
+		break;
+	case PhysicalType::VARCHAR: {
+		// strings are compared with strcmp: copy the prefix up to the first NULL byte and pad it with zeroes
+		auto value = ((string_t *)source)[idx];
+		auto data = value.GetData();
+		auto size = MinValue<idx_t>(value.GetSize(), SortKeyLayout::STRING_PREFIX_LENGTH);
+		idx_t i;
+		for (i = 0; i < size && data[i] != '\0'; i++) {
+			target[i] = data[i];
+		}
+		memset(target + i, 0, SortKeyLayout::STRING_PREFIX_LENGTH - i);
+		break;
+	}
+	default:
+		throw InternalException("Unsupported type for sort key encoding");
+	}
+}
+
+void SortKeyLayout::Encode(DataChunk &chunk, data_ptr_t keys, idx_t key_stride) {
+	idx_t offset = 0;
+	for (idx_t col_idx = 0; col_idx < column_types.size(); col_idx++) {
+		auto width = column_widths[col_idx];
+		// NULL values are ordered before (NULLS FIRST) or after (NULLS LAST) all valid values
+		data_t null_byte = null_order[col_idx] == OrderByNullType::NULLS_FIRST ? 0 : 1;
+		data_t valid_byte = 1 - null_byte;
+		bool invert = order_types[col_idx] == OrderType::DESCENDING;
+
+		VectorData vdata;
+		chunk.data[col_idx].Orrify(chunk.size(), vdata);
+		for (idx_t i = 0; i < chunk.size(); i++) {
+			auto idx = vdata.sel->get_index(i);
+			auto target = keys + i * key_stride + offset;
+			if ((*vdata.nullmask)[idx]) {
+				target[0] = null_byte;
+				memset(target + 1, 0, width - 1);
+			} else {
+				target[0] = valid_byte;
+				EncodeValue(column_types[col_idx], vdata.data, idx, target + 1);
+			}
+			if (invert) {
+				// descending order: invert the entire column, this also flips the position of the NULL values
+				for (idx_t byte_idx = 0; byte_idx < width; byte_idx++) {
+					target[byte_idx] = ~target[byte_idx];
+				}
+			}
+		}
+		offset += width;
+	}
+	D_ASSERT(offset == key_width);
+}
+
+//! Below this amount of entries a bucket is sorted with insertion sort instead of being partitioned further
+static constexpr idx_t INSERTION_SORT_THRESHOLD = 24;
+
+static void InsertionSort(data_ptr_t entries, idx_t count, idx_t entry_width, idx_t key_offset, idx_t key_width) {
+	auto compare_width = key_width - key_offset;
+	auto temp = unique_ptr<data_t[]>(new data_t[entry_width]);
+	for (idx_t i = 1; i < count; i++) {
+		memcpy(temp.get(), entries + i * entry_width, entry_width);
+		idx_t j = i;
+		while (j > 0 &&
+		       memcmp(entries + (j - 1) * entry_width + key_offset, temp.get() + key_offset, compare_width) > 0) {
+			j--;
+		}
+		if (j != i) {
+			memmove(entries + (j + 1) * entry_width, entries + j * entry_width, (i - j) * entry_width);
+			memcpy(entries + j * entry_width, temp.get(), entry_width);
+		}
+	}
+}
+
+static void RadixSortMSD(data_ptr_t entries, data_ptr_t temp, idx_t count, idx_t entry_width, idx_t key_offset,
+                         idx_t key_width) {
+	if (count <= INSERTION_SORT_THRESHOLD) {
+		InsertionSort(entries, count, entry_width, key_offset, key_width);
+		return;
+	}
+	idx_t counts[256];
+	for (; key_offset < key_width; key_offset++) {
+		// build the histogram of the current byte
+		memset(counts, 0, sizeof(counts));
+		for (idx_t i = 0; i < count; i++) {
+			counts[entries[i * entry_width + key_offset]]++;
+		}
+		if (counts[entries[key_offset]] != count) {
+			break;
+		}
+		// all entries share this byte: move on to the next byte without moving any data
+	}
+	if (key_offset == key_width) {
+		// all keys are equal
+		return;
+	}
+	// scatter the entries to their buckets
+	idx_t offsets[256];
+	idx_t total = 0;
+	for (idx_t radix = 0; radix < 256; radix++) {
+		offsets[radix] = total;
+		total += counts[radix];
+	}
+	for (idx_t i = 0; i < count; i++) {
+		auto entry = entries + i * entry_width;
+		memcpy(temp + offsets[entry[key_offset]]++ * entry_width, entry, entry_width);
+	}
+	memcpy(entries, temp, count * entry_width);
+	// recursively sort the buckets on the next byte
+	idx_t start = 0;
+	for (idx_t radix = 0; radix < 256; radix++) {
+		if (counts[radix] > 1 && key_offset + 1 < key_width) {
+			RadixSortMSD(entries + start * entry_width, temp, counts[radix], entry_width, key_offset + 1, key_width);
+		}
+		start += counts[radix];
+	}
+}
+
+void RadixSort::Sort(data_ptr_t entries, idx_t count, idx_t entry_width, idx_t key_width) {
+	D_ASSERT(key_width <= entry_width);
+	if (count <= 1 || key_width == 0) {
+		return;
+	}
+	auto temp = unique_ptr<data_t[]>(new data_t[count * entry_width]);
+	RadixSortMSD(entries, temp.get(), count, entry_width, 0, key_width);
+}
+
+} // namespace duckdb
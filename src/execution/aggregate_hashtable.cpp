@@ -759,7 +759,8 @@ idx_t GroupedAggregateHashTable::FindOrCreateGroups(DataChunk &groups, Vector &a
 	return FindOrCreateGroups(groups, hashes, addresses_out, new_groups_out);
 }
 
-void GroupedAggregateHashTable::FlushMove(Vector &source_addresses, Vector &source_hashes, idx_t count) {
+void GroupedAggregateHashTable::FlushMove(Vector &source_addresses, Vector &source_hashes, idx_t count,
+                                          bool skip_distinct) {
 	D_ASSERT(source_addresses.type == LogicalType::POINTER);
 	D_ASSERT(source_hashes.type == LogicalType::HASH);
 
@@ -780,9 +781,16 @@ void GroupedAggregateHashTable::FlushMove(Vector &source_addresses, Vector &sour
 	VectorOperations::AddInPlace(source_addresses, group_padding, count);
 
 	for (auto &aggr : aggregates) {
-		// for any entries for which a group was found, update the aggregate
-		D_ASSERT(aggr.function.combine);
-		aggr.function.combine(source_addresses, group_addresses, count);
+		if (skip_distinct && aggr.distinct) {
+			// the state is rebuilt from the distinct HT, but the source state is still owned by the source HT
+			if (aggr.function.destructor) {
+				aggr.function.destructor(source_addresses, count);
+			}
+		} else {
+			// for any entries for which a group was found, update the aggregate
+			D_ASSERT(aggr.function.combine);
+			aggr.function.combine(source_addresses, group_addresses, count);
+		}
 		VectorOperations::AddInPlace(source_addresses, aggr.payload_size, count);
 		VectorOperations::AddInPlace(group_addresses, aggr.payload_size, count);
 	}
@@ -816,16 +824,68 @@ void GroupedAggregateHashTable::Combine(GroupedAggregateHashTable &other) {
 		addresses_ptr[group_idx] = ptr + HASH_WIDTH;
 		group_idx++;
 		if (group_idx == STANDARD_VECTOR_SIZE) {
-			FlushMove(addresses, hashes, group_idx);
+			FlushMove(addresses, hashes, group_idx, true);
 			group_idx = 0;
 		}
 	});
-	FlushMove(addresses, hashes, group_idx);
+	FlushMove(addresses, hashes, group_idx, true);
 	string_heap.MergeHeap(other.string_heap);
+	CombineDistinct(other);
 	other.entries = 0; // disable finalizers
 	Verify();
 }
 
+void GroupedAggregateHashTable::CombineDistinct(GroupedAggregateHashTable &other) {
+	idx_t payload_offset = 0;
+	for (idx_t aggr_idx = 0; aggr_idx < aggregates.size(); aggr_idx++) {
+		auto &aggr = aggregates[aggr_idx];
+		if (aggr.distinct) {
+			auto &distinct_ht = *distinct_hashes[aggr_idx];
+			auto &other_distinct_ht = *other.distinct_hashes[aggr_idx];
+			D_ASSERT(distinct_ht.group_types.size() == group_types.size() + aggr.child_count);
+
+			vector<LogicalType> argument_types;
+			for (idx_t i = 0; i < aggr.child_count; i++) {
+				argument_types.push_back(distinct_ht.group_types[group_types.size() + i]);
+			}
+			DataChunk distinct_chunk, groups, arguments;
+			distinct_chunk.Initialize(distinct_ht.group_types);
+			groups.InitializeEmpty(group_types);
+			arguments.InitializeEmpty(argument_types);
+
+			SelectionVector new_pairs(STANDARD_VECTOR_SIZE);
+			Vector distinct_addresses(LogicalType::POINTER);
+			Vector group_addresses(LogicalType::POINTER);
+			idx_t scan_position = 0;
+			while (true) {
+				distinct_chunk.Reset();
+				if (other_distinct_ht.Scan(scan_position, distinct_chunk) == 0) {
+					break;
+				}
+				// only the (group, argument) pairs that this HT has not seen yet are added to the aggregate
+				auto new_count = distinct_ht.FindOrCreateGroups(distinct_chunk, distinct_addresses, new_pairs);
+				if (new_count == 0) {
+					continue;
+				}
+				for (idx_t i = 0; i < group_types.size(); i++) {
+					groups.data[i].Slice(distinct_chunk.data[i], new_pairs, new_count);
+				}
+				groups.SetCardinality(new_count);
+				for (idx_t i = 0; i < aggr.child_count; i++) {
+					arguments.data[i].Slice(distinct_chunk.data[group_types.size() + i], new_pairs, new_count);
+				}
+				arguments.SetCardinality(new_count);
+
+				// the groups were all created by the preceding FlushMove
+				FindOrCreateGroups(groups, group_addresses);
+				VectorOperations::AddInPlace(group_addresses, payload_offset, new_count);
+				aggr.function.update(&arguments.data[0], aggr.child_count, group_addresses, new_count);
+			}
+		}
+		payload_offset += aggr.payload_size;
+	}
+}
+
 struct PartitionInfo {
 	PartitionInfo() : addresses(LogicalType::POINTER), hashes(LogicalType::HASH), group_count(0) {
 		addresses_ptr = FlatVector::GetData<data_ptr_t>(addresses);
@@ -872,12 +932,84 @@ void GroupedAggregateHashTable::Partition(vector<GroupedAggregateHashTable *> &p
 		total_count += partition_entry->Size();
 	}
 	D_ASSERT(total_count == entries);
+	PartitionDistinct(partition_hts, mask, shift);
 	// mark the ht as empty so finalizers are not run
 	entries = 0;
 }
 
+void GroupedAggregateHashTable::PartitionDistinct(vector<GroupedAggregateHashTable *> &partition_hts, hash_t mask,
+                                                  idx_t shift) {
+	for (idx_t aggr_idx = 0; aggr_idx < aggregates.size(); aggr_idx++) {
+		if (!aggregates[aggr_idx].distinct) {
+			continue;
+		}
+		// the distinct HTs are hashed on (group, argument), but they have to end up in the partition of their group
+		auto &distinct_ht = *distinct_hashes[aggr_idx];
+		vector<PartitionInfo> partition_info(partition_hts.size());
+		DataChunk groups;
+		groups.Initialize(group_types);
+		Vector group_hashes(LogicalType::HASH);
+
+		idx_t batch_count = 0;
+		data_ptr_t batch_addresses[STANDARD_VECTOR_SIZE];
+		hash_t batch_hashes[STANDARD_VECTOR_SIZE];
+		// gathering advances the pointers, so the group columns are gathered from a copy of the addresses
+		data_ptr_t gather_addresses[STANDARD_VECTOR_SIZE];
+		Vector gather_address_vector(LogicalType::POINTER, (data_ptr_t)gather_addresses);
+
+		auto flush_batch = [&]() {
+			if (batch_count == 0) {
+				return;
+			}
+			memcpy(gather_addresses, batch_addresses, batch_count * sizeof(data_ptr_t));
+			groups.Reset();
+			groups.SetCardinality(batch_count);
+			for (idx_t i = 0; i < group_types.size(); i++) {
+				VectorOperations::Gather::Set(gather_address_vector, groups.data[i], batch_count);
+			}
+			groups.Hash(group_hashes);
+			group_hashes.Normalify(batch_count);
+			auto group_hashes_ptr = FlatVector::GetData<hash_t>(group_hashes);
+			for (idx_t i = 0; i < batch_count; i++) {
+				idx_t partition = (group_hashes_ptr[i] & mask) >> shift;
+				D_ASSERT(partition < partition_hts.size());
+				auto &info = partition_info[partition];
+				info.hashes_ptr[info.group_count] = batch_hashes[i];
+				info.addresses_ptr[info.group_count] = batch_addresses[i];
+				info.group_count++;
+				if (info.group_count == STANDARD_VECTOR_SIZE) {
+					partition_hts[partition]->distinct_hashes[aggr_idx]->FlushMove(info.addresses, info.hashes,
+					                                                               info.group_count);
+					info.group_count = 0;
+				}
+			}
+			batch_count = 0;
+		};
+
+		distinct_ht.PayloadApply([&](idx_t page_nr, idx_t page_offset, data_ptr_t ptr) {
+			batch_hashes[batch_count] = Load<hash_t>(ptr);
+			batch_addresses[batch_count] = ptr + HASH_WIDTH;
+			batch_count++;
+			if (batch_count == STANDARD_VECTOR_SIZE) {
+				flush_batch();
+			}
+		});
+		flush_batch();
+
+		for (idx_t r = 0; r < partition_hts.size(); r++) {
+			auto &partition_distinct_ht = *partition_hts[r]->distinct_hashes[aggr_idx];
+			partition_distinct_ht.FlushMove(partition_info[r].addresses, partition_info[r].hashes,
+			                                partition_info[r].group_count);
+			partition_distinct_ht.string_heap.MergeHeap(distinct_ht.string_heap);
+		}
+		distinct_ht.entries = 0;
+	}
+}
+
 idx_t GroupedAggregateHashTable::Scan(idx_t &scan_position, DataChunk &result) {
-	auto data_pointers = FlatVector::GetData<data_ptr_t>(addresses);
+	// use a local vector for the addresses so multiple threads can scan the HT concurrently
+	Vector scan_addresses(LogicalType::POINTER);
+	auto data_pointers = FlatVector::GetData<data_ptr_t>(scan_addresses);
 
 	auto remaining = entries - scan_position;
 	if (remaining == 0) {
@@ -903,16 +1035,16 @@ idx_t GroupedAggregateHashTable::Scan(idx_t &scan_position, DataChunk &result) {
 	// fetch the group columns
 	for (idx_t i = 0; i < group_types.size(); i++) {
 		auto &column = result.data[i];
-		VectorOperations::Gather::Set(addresses, column, result.size());
+		VectorOperations::Gather::Set(scan_addresses, column, result.size());
 	}
 
-	VectorOperations::AddInPlace(addresses, group_padding, result.size());
+	VectorOperations::AddInPlace(scan_addresses, group_padding, result.size());
 
 	for (idx_t i = 0; i < aggregates.size(); i++) {
 		auto &target = result.data[group_types.size() + i];
 		auto &aggr = aggregates[i];
-		aggr.function.finalize(addresses, target, result.size());
-		VectorOperations::AddInPlace(addresses, aggr.payload_size, result.size());
+		aggr.function.finalize(scan_addresses, target, result.size());
+		VectorOperations::AddInPlace(scan_addresses, aggr.payload_size, result.size());
 	}
 	scan_position += this_n;
 	return this_n;
@@ -0,0 +1,101 @@
+#include "duckdb/execution/buffered_chunk_collection.hpp"
+
+#include "duckdb/common/serializer/buffered_deserializer.hpp"
+#include "duckdb/common/serializer/buffered_serializer.hpp"
+
+namespace duckdb {
+using namespace std;
+
+BufferedChunkCollection::BufferedChunkCollection(BufferManager &buffer_manager, vector<LogicalType> types_p)
+    : types(move(types_p)), buffer_manager(buffer_manager), count(0) {
+	external = CanOffload(buffer_manager, types);
+}
+
+BufferedChunkCollection::~BufferedChunkCollection() {
+	for (auto &buffer : buffers) {
+		buffer_manager.DestroyBuffer(buffer.block_id);
+	}
+}
+
+bool BufferedChunkCollection::CanOffload(BufferManager &buffer_manager, vector<LogicalType> &types) {
+	if (!buffer_manager.HasTemporaryDirectory()) {
+		// buffers cannot be evicted: there is no point in serializing the chunks
+		return false;
+	}
+	for (auto &type : types) {
+		auto internal_type = type.InternalType();
+		if (TypeIsConstantSize(internal_type)) {
+			continue;
+		}
+		if (internal_type == PhysicalType::VARCHAR && type.id() != LogicalTypeId::BLOB) {
+			continue;
+		}
+		// nested types and blobs cannot be (de)serialized through the Vector API
+		return false;
+	}
+	return true;
+}
+
+void BufferedChunkCollection::Append(DataChunk &chunk) {
+	if (chunk.size() == 0) {
+		return;
+	}
+	D_ASSERT(chunk.GetTypes() == types);
+	count += chunk.size();
+	if (!external) {
+		// copy the chunk so the collection does not reference the string heaps of the input
+		auto copy = make_unique<DataChunk>();
+		copy->Initialize(types);
+		copy->Append(chunk);
+		chunks.push_back(move(copy));
+		return;
+	}
+	BufferedSerializer serializer;
+	chunk.Serialize(serializer);
+	auto blob = serializer.GetData();
+	idx_t entry_size = sizeof(idx_t) + blob.size;
+	if (buffers.size() == 0 || buffers.back().size + entry_size > buffers.back().capacity) {
+		// the chunk does not fit in the current buffer: allocate a new buffer
+		auto handle = buffer_manager.Allocate(MaxValue<idx_t>(Storage::BLOCK_ALLOC_SIZE,
+		                                                       entry_size + Storage::BLOCK_HEADER_SIZE));
+		ChunkBuffer buffer;
+		buffer.block_id = handle->block_id;
+		buffer.capacity = handle->node->size;
+		buffer.size = 0;
+		buffers.push_back(buffer);
+	}
+	auto &buffer = buffers.back();
+	D_ASSERT(buffer.size + entry_size <= buffer.capacity);
+	// write the size of the serialized chunk followed by the serialized chunk itself
+	auto handle = buffer_manager.Pin(buffer.block_id);
+	auto dataptr = handle->node->buffer + buffer.size;
+	Store<idx_t>(blob.size, dataptr);
+	memcpy(dataptr + sizeof(idx_t), blob.data.get(), blob.size);
+
+	ChunkLocation location;
+	location.buffer_idx = buffers.size() - 1;
+	location.offset = buffer.size;
+	chunk_locations.push_back(location);
+	buffer.size += entry_size;
+}
+
+void BufferedChunkCollection::GetChunk(idx_t chunk_idx, DataChunk &result) {
+	D_ASSERT(chunk_idx < ChunkCount());
+	if (!external) {
+		if (result.column_count() == 0) {
+			result.InitializeEmpty(types);
+		}
+		result.Reference(*chunks[chunk_idx]);
+		return;
+	}
+	auto &location = chunk_locations[chunk_idx];
+	// pin the buffer; if it was offloaded this reads it back from the temporary directory
+	auto handle = buffer_manager.Pin(buffers[location.buffer_idx].block_id);
+	auto dataptr = handle->node->buffer + location.offset;
+	auto blob_size = Load<idx_t>(dataptr);
+	BufferedDeserializer source(dataptr + sizeof(idx_t), blob_size);
+	result.Destroy();
+	result.Deserialize(source);
+}
+
+} // namespace duckdb
@@ -1,6 +1,7 @@
 #include "duckdb/execution/index/art/art.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 #include <algorithm>
 #include <ctgmath>
 
@@ -227,6 +228,277 @@ bool ART::Append(IndexLock &lock, DataChunk &appended_data, Vector &row_identifi
 	return Insert(lock, expression_result, row_identifiers);
 }
 
+//! The minimum amount of bulk load entries that is handled by a single task
+static constexpr idx_t ART_BULK_LOAD_TASK_SIZE = 100 * STANDARD_VECTOR_SIZE;
+
+static bool CompareBulkLoadEntries(const ARTBulkLoadEntry &a, const ARTBulkLoadEntry &b) {
+	if (*a.key < *b.key) {
+		return true;
+	}
+	if (*b.key < *a.key) {
+		return false;
+	}
+	return a.row_id < b.row_id;
+}
+
+class ARTSortTask : public Task {
+public:
+	//! Sorts the entries [start, end) if middle == end, or merges the sorted runs [start, middle) and [middle, end)
+	ARTSortTask(vector<ARTBulkLoadEntry> &entries, idx_t start, idx_t middle, idx_t end)
+	    : entries(entries), start(start), middle(middle), end(end) {
+	}
+
+	void Execute() override {
+		auto begin = entries.begin();
+		if (middle == end) {
+			sort(begin + start, begin + end, CompareBulkLoadEntries);
+		} else {
+			inplace_merge(begin + start, begin + middle, begin + end, CompareBulkLoadEntries);
+		}
+	}
+
+private:
+	vector<ARTBulkLoadEntry> &entries;
+	idx_t start;
+	idx_t middle;
+	idx_t end;
+};
+
+static void SortBulkLoadEntries(vector<ARTBulkLoadEntry> &entries, TaskScheduler &scheduler) {
+	idx_t run_count = MinValue<idx_t>(scheduler.NumberOfThreads(), entries.size() / ART_BULK_LOAD_TASK_SIZE);
+	if (run_count <= 1) {
+		sort(entries.begin(), entries.end(), CompareBulkLoadEntries);
+		return;
+	}
+	// sort a run of the entries per thread, and merge the sorted runs pairwise until a single run remains
+	vector<idx_t> bounds;
+	for (idx_t i = 0; i <= run_count; i++) {
+		bounds.push_back(entries.size() * i / run_count);
+	}
+	auto producer = scheduler.CreateProducer();
+	vector<unique_ptr<Task>> tasks;
+	for (idx_t i = 0; i + 1 < bounds.size(); i++) {
+		tasks.push_back(make_unique<ARTSortTask>(entries, bounds[i], bounds[i + 1], bounds[i + 1]));
+	}
+	scheduler.ExecuteTasks(*producer, move(tasks));
+	while (bounds.size() > 2) {
+		vector<idx_t> merged_bounds;
+		tasks.clear();
+		idx_t i;
+		for (i = 0; i + 2 < bounds.size(); i += 2) {
+			tasks.push_back(make_unique<ARTSortTask>(entries, bounds[i], bounds[i + 1], bounds[i + 2]));
+			merged_bounds.push_back(bounds[i]);
+		}
+		if (i + 1 < bounds.size()) {
+			// odd amount of runs: the last run is merged in the next round
+			merged_bounds.push_back(bounds[i]);
+		}
+		merged_bounds.push_back(entries.size());
+		scheduler.ExecuteTasks(*producer, move(tasks));
+		bounds = move(merged_bounds);
+	}
+}
+
+//! A child of an inner node that is built by a bulk load
+struct ARTBulkLoadChild {
+	uint8_t key_byte;
+	idx_t start;
+	idx_t end;
+	unique_ptr<Node> node;
+};
+
+//! Creates the node holding the sorted entries [start, end) at the given depth. If the entries all have the same key,
+//! this is a leaf. Otherwise, it is an inner node sized to fit its children, and the key ranges of the children that
+//! still have to be built are written to "children".
+static unique_ptr<Node> CreateBulkLoadNode(ART &art, vector<ARTBulkLoadEntry> &entries, idx_t start, idx_t end,
+                                           idx_t depth, vector<ARTBulkLoadChild> &children, idx_t &child_depth) {
+	auto &first = *entries[start].key;
+	auto &last = *entries[end - 1].key;
+	if (first == last) {
+		auto leaf = make_unique<Leaf>(art, move(entries[start].key), entries[start].row_id);
+		for (idx_t i = start + 1; i < end; i++) {
+			leaf->Insert(entries[i].row_id);
+		}
+		return move(leaf);
+	}
+	// the entries are sorted, so the common prefix of the range is the common prefix of the first and the last key
+	idx_t min_length = MinValue<idx_t>(first.len, last.len);
+	idx_t prefix_length = 0;
+	while (depth + prefix_length < min_length && first[depth + prefix_length] == last[depth + prefix_length]) {
+		prefix_length++;
+	}
+	D_ASSERT(depth + prefix_length < min_length);
+	child_depth = depth + prefix_length + 1;
+	idx_t key_position = depth + prefix_length;
+	for (idx_t i = start; i < end; i++) {
+		auto key_byte = (*entries[i].key)[key_position];
+		if (children.empty() || children.back().key_byte != key_byte) {
+			if (!children.empty()) {
+				children.back().end = i;
+			}
+			ARTBulkLoadChild child;
+			child.key_byte = key_byte;
+			child.start = i;
+			children.push_back(move(child));
+		}
+	}
+	children.back().end = end;
+
+	unique_ptr<Node> node;
+	if (children.size() <= 4) {
+		node = make_unique<Node4>(art, prefix_length);
+	} else if (children.size() <= 16) {
+		node = make_unique<Node16>(art, prefix_length);
+	} else if (children.size() <= 48) {
+		node = make_unique<Node48>(art, prefix_length);
+	} else {
+		node = make_unique<Node256>(art, prefix_length);
+	}
+	node->prefix_length = prefix_length;
+	memcpy(node->prefix.get(), first.data.get() + depth, prefix_length);
+	return node;
+}
+
+//! Adds the built children (in ascending order of their key byte) to an inner node
+static void AddBulkLoadChildren(Node &node, vector<ARTBulkLoadChild> &children) {
+	for (auto &child : children) {
+		switch (node.type) {
+		case NodeType::N4: {
+			auto &n = (Node4 &)node;
+			n.key[n.count] = child.key_byte;
+			n.child[n.count] = move(child.node);
+			break;
+		}
+		case NodeType::N16: {
+			auto &n = (Node16 &)node;
+			n.key[n.count] = child.key_byte;
+			n.child[n.count] = move(child.node);
+			break;
+		}
+		case NodeType::N48: {
+			auto &n = (Node48 &)node;
+			n.childIndex[child.key_byte] = n.count;
+			n.child[n.count] = move(child.node);
+			break;
+		}
+		case NodeType::N256: {
+			auto &n = (Node256 &)node;
+			n.child[child.key_byte] = move(child.node);
+			break;
+		}
+		default:
+			throw InternalException("Unrecognized inner node type for ART bulk load");
+		}
+		node.count++;
+	}
+}
+
+static unique_ptr<Node> BulkLoadTree(ART &art, vector<ARTBulkLoadEntry> &entries, idx_t start, idx_t end, idx_t depth) {
+	vector<ARTBulkLoadChild> children;
+	idx_t child_depth;
+	auto node = CreateBulkLoadNode(art, entries, start, end, depth, children, child_depth);
+	for (auto &child : children) {
+		child.node = BulkLoadTree(art, entries, child.start, child.end, child_depth);
+	}
+	AddBulkLoadChildren(*node, children);
+	return node;
+}
+
+class ARTBulkLoadTask : public Task {
+public:
+	ARTBulkLoadTask(ART &art, vector<ARTBulkLoadEntry> &entries, ARTBulkLoadChild &child, idx_t depth)
+	    : art(art), entries(entries), child(child), depth(depth) {
+	}
+
+	void Execute() override {
+		child.node = BulkLoadTree(art, entries, child.start, child.end, depth);
+	}
+
+private:
+	ART &art;
+	vector<ARTBulkLoadEntry> &entries;
+	ARTBulkLoadChild &child;
+	idx_t depth;
+};
+
+unique_ptr<IndexBulkLoadState> ART::InitializeBulkLoad() {
+	return make_unique<ARTBulkLoadState>();
+}
+
+void ART::BulkLoadAppend(IndexBulkLoadState &state, DataChunk &input, Vector &row_ids) {
+	D_ASSERT(row_ids.type.InternalType() == ROW_TYPE);
+	D_ASSERT(logical_types[0] == input.data[0].type);
+	auto &bulk_load = (ARTBulkLoadState &)state;
+
+	vector<unique_ptr<Key>> keys;
+	GenerateKeys(input, keys);
+
+	row_ids.Normalify(input.size());
+	auto row_identifiers = FlatVector::GetData<row_t>(row_ids);
+	for (idx_t i = 0; i < input.size(); i++) {
+		if (!keys[i]) {
+			continue;
+		}
+		ARTBulkLoadEntry entry;
+		entry.key = move(keys[i]);
+		entry.row_id = row_identifiers[i];
+		bulk_load.entries.push_back(move(entry));
+	}
+}
+
+bool ART::BulkLoadFinalize(IndexLock &lock, IndexBulkLoadState &state, TaskScheduler &scheduler) {
+	auto &entries = ((ARTBulkLoadState &)state).entries;
+	if (entries.empty()) {
+		return true;
+	}
+	SortBulkLoadEntries(entries, scheduler);
+	if (is_unique) {
+		// verify the constraint up front, so nothing has to be undone when it is violated
+		for (idx_t i = 1; i < entries.size(); i++) {
+			if (*entries[i - 1].key == *entries[i].key) {
+				return false;
+			}
+		}
+		if (tree) {
+			for (auto &entry : entries) {
+				if (Lookup(tree, *entry.key, 0) != nullptr) {
+					return false;
+				}
+			}
+		}
+	}
+	if (tree) {
+		// the tree already holds entries: insert the keys one at a time, in sorted order
+		for (auto &entry : entries) {
+			bool success = Insert(tree, move(entry.key), 0, entry.row_id);
+			D_ASSERT(success);
+			(void)success;
+		}
+		entries.clear();
+		return true;
+	}
+	// build the tree bottom-up from the sorted keys
+	vector<ARTBulkLoadChild> children;
+	idx_t child_depth;
+	tree = CreateBulkLoadNode(*this, entries, 0, entries.size(), 0, children, child_depth);
+	if (entries.size() >= 2 * ART_BULK_LOAD_TASK_SIZE && scheduler.NumberOfThreads() > 1) {
+		// build the subtrees of the children of the root in parallel
+		auto producer = scheduler.CreateProducer();
+		vector<unique_ptr<Task>> tasks;
+		for (auto &child : children) {
+			tasks.push_back(make_unique<ARTBulkLoadTask>(*this, entries, child, child_depth));
+		}
+		scheduler.ExecuteTasks(*producer, move(tasks));
+	} else {
+		for (auto &child : children) {
+			child.node = BulkLoadTree(*this, entries, child.start, child.end, child_depth);
+		}
+	}
+	AddBulkLoadChildren(*tree, children);
+	entries.clear();
+	return true;
+}
+
 void ART::VerifyAppend(DataChunk &chunk) {
 	if (!is_unique) {
 		return;
@@ -260,6 +532,7 @@ bool ART::InsertToLeaf(Leaf &leaf, row_t row_id) {
 }
 
 bool ART::Insert(unique_ptr<Node> &node, unique_ptr<Key> value, unsigned depth, row_t row_id) {
+	Node::Load(node);
 	Key &key = *value;
 	if (!node) {
 		// node is currently empty, create a leaf here with the key
@@ -327,6 +600,20 @@ bool ART::Insert(unique_ptr<Node> &node, unique_ptr<Key> value, unsigned depth,
 	return true;
 }
 
+//===--------------------------------------------------------------------===//
+// Serialization
+//===--------------------------------------------------------------------===//
+BlockPointer ART::Serialize(MetaBlockWriter &writer) {
+	return Node::Serialize(*this, tree, writer);
+}
+
+void ART::Deserialize(BufferManager &buffer_manager, BlockPointer root) {
+	D_ASSERT(!tree);
+	if (root.block_id != INVALID_BLOCK) {
+		tree = make_unique<UnloadedNode>(*this, buffer_manager, root);
+	}
+}
+
 //===--------------------------------------------------------------------===//
 // Delete
 //===--------------------------------------------------------------------===//
@@ -354,6 +641,7 @@ void ART::Erase(unique_ptr<Node> &node, Key &key, unsigned depth, row_t row_id)
 	if (!node) {
 		return;
 	}
+	Node::Load(node);
 	// Delete a leaf from a tree
 	if (node->type == NodeType::NLeaf) {
 		// Make sure we have the right leaf
@@ -449,8 +737,73 @@ void ART::SearchEqualJoinNoFetch(Value &equal_value, idx_t &result_size) {
 	result_size = leaf->num_elements;
 }
 
+//! The amount of lookups whose traversals of the tree are interleaved
+static constexpr idx_t ART_LOOKUP_GROUP_SIZE = 16;
+
+static inline void PrefetchNode(Node *node) {
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_prefetch(node);
+#endif
+}
+
+void ART::SearchEqualBatch(DataChunk &input, Leaf *result[]) {
+	vector<unique_ptr<Key>> keys;
+	GenerateKeys(input, keys);
+	Node::Load(tree);
+
+	Node *nodes[ART_LOOKUP_GROUP_SIZE];
+	idx_t depths[ART_LOOKUP_GROUP_SIZE];
+	idx_t active[ART_LOOKUP_GROUP_SIZE];
+	for (idx_t group_start = 0; group_start < input.size(); group_start += ART_LOOKUP_GROUP_SIZE) {
+		idx_t group_end = MinValue<idx_t>(group_start + ART_LOOKUP_GROUP_SIZE, input.size());
+		idx_t active_count = 0;
+		for (idx_t i = group_start; i < group_end; i++) {
+			result[i] = nullptr;
+			if (keys[i] && tree) {
+				nodes[i - group_start] = tree.get();
+				depths[i - group_start] = 0;
+				active[active_count++] = i;
+			}
+		}
+		// advance the traversals of the group one level at a time: the child that a traversal moves to is prefetched,
+		// and is only accessed after the other traversals of the group have advanced as well
+		while (active_count > 0) {
+			idx_t remaining = 0;
+			for (idx_t a = 0; a < active_count; a++) {
+				auto i = active[a];
+				auto &key = *keys[i];
+				auto node = nodes[i - group_start];
+				auto &depth = depths[i - group_start];
+				if (node->type == NodeType::NLeaf) {
+					auto leaf = static_cast<Leaf *>(node);
+					if (LeafMatches(leaf, key, depth)) {
+						result[i] = leaf;
+					}
+					continue;
+				}
+				if (node->prefix_length) {
+					if (Node::PrefixMismatch(*this, node, key, depth) != node->prefix_length) {
+						continue;
+					}
+					depth += node->prefix_length;
+				}
+				idx_t pos = node->GetChildPos(key[depth]);
+				if (pos == INVALID_INDEX) {
+					continue;
+				}
+				auto child = node->GetChild(pos)->get();
+				PrefetchNode(child);
+				nodes[i - group_start] = child;
+				depth++;
+				active[remaining++] = i;
+			}
+			active_count = remaining;
+		}
+	}
+}
+
 Node *ART::Lookup(unique_ptr<Node> &node, Key &key, unsigned depth) {
-	auto node_val = node.get();
+	auto node_val = Node::Load(node)->get();
 
 	while (node_val) {
 		if (node_val->type == NodeType::NLeaf) {
@@ -566,7 +919,7 @@ bool ART::Bound(unique_ptr<Node> &n, Key &key, Iterator &it, bool inclusive) {
 	if (!n) {
 		return false;
 	}
-	Node *node = n.get();
+	Node *node = Node::Load(n)->get();
 
 	idx_t depth = 0;
 	while (true) {
@@ -672,17 +1025,17 @@ static Leaf &FindMinimum(Iterator &it, Node &node) {
 		it.node = (Leaf *)&node;
 		return (Leaf &)node;
 	case NodeType::N4:
-		next = ((Node4 &)node).child[0].get();
+		next = Node::Load(((Node4 &)node).child[0])->get();
 		break;
 	case NodeType::N16:
-		next = ((Node16 &)node).child[0].get();
+		next = Node::Load(((Node16 &)node).child[0])->get();
 		break;
 	case NodeType::N48: {
 		auto &n48 = (Node48 &)node;
 		while (n48.childIndex[pos] == Node::EMPTY_MARKER) {
 			pos++;
 		}
-		next = n48.child[n48.childIndex[pos]].get();
+		next = Node::Load(n48.child[n48.childIndex[pos]])->get();
 		break;
 	}
 	case NodeType::N256: {
@@ -690,9 +1043,12 @@ static Leaf &FindMinimum(Iterator &it, Node &node) {
 		while (!n256.child[pos]) {
 			pos++;
 		}
-		next = n256.child[pos].get();
+		next = Node::Load(n256.child[pos])->get();
 		break;
 	}
+	case NodeType::NUnloaded:
+		// the children are loaded before they are visited
+		throw InternalException("FindMinimum called on an ART node that has not been loaded");
 	}
 	it.SetEntry(it.depth, IteratorEntry(&node, pos));
 	it.depth++;
@@ -709,7 +1065,7 @@ bool ART::SearchLess(ARTIndexScanState *state, bool inclusive, idx_t max_count,
 
 	if (!it->start) {
 		// first find the minimum value in the ART: we start scanning from this value
-		auto &minimum = FindMinimum(state->iterator, *tree);
+		auto &minimum = FindMinimum(state->iterator, **Node::Load(tree));
 		// early out min value higher than upper bound query
 		if (*minimum.value > *upper_bound) {
 			return true;
@@ -806,4 +1162,187 @@ bool ART::Scan(Transaction &transaction, DataTable &table, IndexScanState &table
 	return true;
 }
 
+//===--------------------------------------------------------------------===//
+// Split Scan
+//===--------------------------------------------------------------------===//
+struct ARTScanBounds {
+	unique_ptr<Key> lower;
+	bool lower_inclusive = false;
+	unique_ptr<Key> upper;
+	bool upper_inclusive = false;
+
+	//! Whether or not the key falls in the range of the scan
+	bool Contains(Key &key) {
+		if (lower && (key < *lower || (!lower_inclusive && key == *lower))) {
+			return false;
+		}
+		if (upper && (key > *upper || (!upper_inclusive && key == *upper))) {
+			return false;
+		}
+		return true;
+	}
+	//! Whether or not any of the keys that start with the prefix can fall in the range of the scan
+	bool Overlaps(vector<data_t> &prefix) {
+		if (lower && memcmp(prefix.data(), lower->data.get(), MinValue<idx_t>(prefix.size(), lower->len)) < 0) {
+			return false;
+		}
+		if (upper && memcmp(prefix.data(), upper->data.get(), MinValue<idx_t>(prefix.size(), upper->len)) > 0) {
+			return false;
+		}
+		return true;
+	}
+};
+
+static ARTScanBounds GetScanBounds(ART &art, ARTIndexScanState &state) {
+	ARTScanBounds bounds;
+	if (!state.values[1].is_null) {
+		bounds.lower = CreateKey(art, art.types[0], state.values[0]);
+		bounds.lower_inclusive = state.expressions[0] == ExpressionType::COMPARE_GREATERTHANOREQUALTO;
+		bounds.upper = CreateKey(art, art.types[0], state.values[1]);
+		bounds.upper_inclusive = state.expressions[1] == ExpressionType::COMPARE_LESSTHANOREQUALTO;
+		return bounds;
+	}
+	switch (state.expressions[0]) {
+	case ExpressionType::COMPARE_EQUAL:
+		bounds.lower = CreateKey(art, art.types[0], state.values[0]);
+		bounds.lower_inclusive = true;
+		bounds.upper = CreateKey(art, art.types[0], state.values[0]);
+		bounds.upper_inclusive = true;
+		break;
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+	case ExpressionType::COMPARE_GREATERTHAN:
+		bounds.lower = CreateKey(art, art.types[0], state.values[0]);
+		bounds.lower_inclusive = state.expressions[0] == ExpressionType::COMPARE_GREATERTHANOREQUALTO;
+		break;
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+	case ExpressionType::COMPARE_LESSTHAN:
+		bounds.upper = CreateKey(art, art.types[0], state.values[0]);
+		bounds.upper_inclusive = state.expressions[0] == ExpressionType::COMPARE_LESSTHANOREQUALTO;
+		break;
+	default:
+		throw NotImplementedException("Operation not implemented");
+	}
+	return bounds;
+}
+
+struct ARTScanRangeEntry {
+	ARTScanRangeEntry(Node *node, vector<data_t> prefix) : node(node), prefix(move(prefix)) {
+		// the bytes of the compressed path of the node are shared by all keys in its subtree as well
+		if (node->type == NodeType::NLeaf) {
+			auto &key = *((Leaf *)node)->value;
+			this->prefix.assign(key.data.get(), key.data.get() + key.len);
+		} else {
+			this->prefix.insert(this->prefix.end(), node->prefix.get(), node->prefix.get() + node->prefix_length);
+		}
+	}
+
+	Node *node;
+	//! The bytes that all keys in the subtree of the node start with
+	vector<data_t> prefix;
+};
+
+idx_t ART::SplitScan(IndexScanState &table_state, idx_t max_ranges, double &estimated_fraction) {
+	auto &state = (ARTIndexScanState &)table_state;
+	D_ASSERT(state.values[0].type().InternalType() == types[0]);
+	D_ASSERT(max_ranges > 0);
+
+	lock_guard<mutex> l(lock);
+	state.ranges.clear();
+	estimated_fraction = 0;
+	auto root = Node::Load(tree)->get();
+	if (!root) {
+		return 0;
+	}
+	auto bounds = GetScanBounds(*this, state);
+
+	// descend the upper levels of the tree breadth-first, until there are max_ranges subtrees or only leaves are left
+	// the subtrees that have not been expanded yet are at [head, end) of the frontier
+	vector<ARTScanRangeEntry> frontier;
+	idx_t head = 0;
+	idx_t leaf_count = root->type == NodeType::NLeaf ? 1 : 0;
+	frontier.emplace_back(root, vector<data_t>());
+	while (frontier.size() - head < max_ranges && leaf_count < frontier.size() - head) {
+		auto node = frontier[head].node;
+		auto prefix = move(frontier[head].prefix);
+		head++;
+		if (node->type == NodeType::NLeaf) {
+			frontier.emplace_back(node, move(prefix));
+			continue;
+		}
+		for (idx_t pos = node->GetNextPos(INVALID_INDEX); pos != INVALID_INDEX; pos = node->GetNextPos(pos)) {
+			auto child = node->GetChild(pos)->get();
+			auto child_prefix = prefix;
+			child_prefix.push_back(Node::GetKeyByte(*node, pos));
+			frontier.emplace_back(child, move(child_prefix));
+			if (child->type == NodeType::NLeaf) {
+				leaf_count++;
+			}
+		}
+	}
+	// the sub-ranges are the subtrees that overlap with the range of the scan
+	for (idx_t i = head; i < frontier.size(); i++) {
+		if (bounds.Overlaps(frontier[i].prefix)) {
+			state.ranges.push_back(move(frontier[i].prefix));
+		}
+	}
+	// hand out the sub-ranges in the order of their keys
+	sort(state.ranges.begin(), state.ranges.end());
+	// the estimate assumes that all subtrees of the frontier hold roughly the same amount of rows
+	estimated_fraction = (double)state.ranges.size() / (double)(frontier.size() - head);
+	return state.ranges.size();
+}
+
+static void ScanSubtree(Node *node, ARTScanBounds &bounds, vector<row_t> &result_ids) {
+	if (node->type == NodeType::NLeaf) {
+		auto leaf = (Leaf *)node;
+		if (bounds.Contains(*leaf->value)) {
+			for (idx_t i = 0; i < leaf->num_elements; i++) {
+				result_ids.push_back(leaf->GetRowId(i));
+			}
+		}
+		return;
+	}
+	for (idx_t pos = node->GetNextPos(INVALID_INDEX); pos != INVALID_INDEX; pos = node->GetNextPos(pos)) {
+		ScanSubtree(node->GetChild(pos)->get(), bounds, result_ids);
+	}
+}
+
+void ART::ScanRange(IndexLock &lock, IndexScanState &table_state, idx_t range_idx, vector<row_t> &result_ids) {
+	auto &state = (ARTIndexScanState &)table_state;
+	D_ASSERT(range_idx < state.ranges.size());
+	auto &prefix = state.ranges[range_idx];
+	auto bounds = GetScanBounds(*this, state);
+
+	// the tree might have changed since the scan was split: search the subtree of the sub-range by its prefix
+	auto node = Node::Load(tree)->get();
+	idx_t depth = 0;
+	while (node && node->type != NodeType::NLeaf && depth < prefix.size()) {
+		for (idx_t i = 0; i < node->prefix_length && depth < prefix.size(); i++, depth++) {
+			if (node->prefix[i] != prefix[depth]) {
+				return;
+			}
+		}
+		if (depth == prefix.size()) {
+			break;
+		}
+		auto pos = node->GetChildPos(prefix[depth]);
+		if (pos == INVALID_INDEX) {
+			return;
+		}
+		node = node->GetChild(pos)->get();
+		depth++;
+	}
+	if (!node) {
+		return;
+	}
+	if (node->type == NodeType::NLeaf) {
+		// a leaf can be reached before the whole prefix is matched: check that its key belongs to the sub-range
+		auto &key = *((Leaf *)node)->value;
+		if (key.len < prefix.size() || memcmp(key.data.get(), prefix.data(), prefix.size()) != 0) {
+			return;
+		}
+	}
+	ScanSubtree(node, bounds, result_ids);
+}
+
 } // namespace duckdb
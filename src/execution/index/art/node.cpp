@@ -1,6 +1,8 @@
 #include "duckdb/execution/index/art/node.hpp"
 #include "duckdb/execution/index/art/art.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/storage/meta_block_reader.hpp"
+#include "duckdb/storage/meta_block_writer.hpp"
 
 namespace duckdb {
 
@@ -75,4 +77,120 @@ void Node::Erase(ART &art, unique_ptr<Node> &node, idx_t pos) {
 	}
 }
 
+//===--------------------------------------------------------------------===//
+// Serialization
+//===--------------------------------------------------------------------===//
+UnloadedNode::UnloadedNode(ART &art, BufferManager &buffer_manager, BlockPointer pointer)
+    : Node(art, NodeType::NUnloaded, 0), art(art), buffer_manager(buffer_manager), pointer(pointer) {
+}
+
+unique_ptr<Node> *Node::Load(unique_ptr<Node> &node) {
+	if (node && node->type == NodeType::NUnloaded) {
+		auto &unloaded = (UnloadedNode &)*node;
+		node = Deserialize(unloaded.art, unloaded.buffer_manager, unloaded.pointer);
+	}
+	return &node;
+}
+
+uint8_t Node::GetKeyByte(Node &node, idx_t pos) {
+	switch (node.type) {
+	case NodeType::N4:
+		return ((Node4 &)node).key[pos];
+	case NodeType::N16:
+		return ((Node16 &)node).key[pos];
+	default:
+		// the positions of the children of a Node48 and a Node256 are the key bytes
+		return pos;
+	}
+}
+
+BlockPointer Node::Serialize(ART &art, unique_ptr<Node> &node, MetaBlockWriter &writer) {
+	if (!node) {
+		return BlockPointer(INVALID_BLOCK, 0);
+	}
+	Load(node);
+	if (node->type == NodeType::NLeaf) {
+		auto &leaf = (Leaf &)*node;
+		D_ASSERT(leaf.num_elements > 0);
+		BlockPointer pointer(writer.block->id, writer.offset);
+		writer.Write<uint8_t>((uint8_t)NodeType::NLeaf);
+		writer.Write<uint32_t>(leaf.value->len);
+		writer.WriteData(leaf.value->data.get(), leaf.value->len);
+		writer.Write<uint64_t>(leaf.num_elements);
+		for (idx_t i = 0; i < leaf.num_elements; i++) {
+			writer.Write<row_t>(leaf.GetRowId(i));
+		}
+		return pointer;
+	}
+	// first write the children, so their locations are known when the node itself is written
+	vector<uint8_t> key_bytes;
+	vector<BlockPointer> children;
+	for (idx_t pos = node->GetNextPos(INVALID_INDEX); pos != INVALID_INDEX; pos = node->GetNextPos(pos)) {
+		key_bytes.push_back(GetKeyByte(*node, pos));
+		children.push_back(Serialize(art, *node->GetChild(pos), writer));
+	}
+	BlockPointer pointer(writer.block->id, writer.offset);
+	writer.Write<uint8_t>((uint8_t)node->type);
+	writer.Write<uint32_t>(node->prefix_length);
+	writer.WriteData(node->prefix.get(), node->prefix_length);
+	writer.Write<uint16_t>(children.size());
+	for (idx_t i = 0; i < children.size(); i++) {
+		writer.Write<uint8_t>(key_bytes[i]);
+		writer.Write<block_id_t>(children[i].block_id);
+		writer.Write<uint64_t>(children[i].offset);
+	}
+	return pointer;
+}
+
+unique_ptr<Node> Node::Deserialize(ART &art, BufferManager &buffer_manager, BlockPointer pointer) {
+	if (pointer.block_id == INVALID_BLOCK) {
+		return nullptr;
+	}
+	MetaBlockReader reader(buffer_manager, pointer.block_id);
+	reader.offset = pointer.offset;
+	auto type = (NodeType)reader.Read<uint8_t>();
+	if (type == NodeType::NLeaf) {
+		auto len = reader.Read<uint32_t>();
+		auto data = unique_ptr<data_t[]>(new data_t[len]);
+		reader.ReadData(data.get(), len);
+		auto num_elements = reader.Read<uint64_t>();
+		D_ASSERT(num_elements > 0);
+		auto leaf = make_unique<Leaf>(art, make_unique<Key>(move(data), len), reader.Read<row_t>());
+		for (idx_t i = 1; i < num_elements; i++) {
+			leaf->Insert(reader.Read<row_t>());
+		}
+		return move(leaf);
+	}
+	auto prefix_length = reader.Read<uint32_t>();
+	unique_ptr<Node> node;
+	switch (type) {
+	case NodeType::N4:
+		node = make_unique<Node4>(art, prefix_length);
+		break;
+	case NodeType::N16:
+		node = make_unique<Node16>(art, prefix_length);
+		break;
+	case NodeType::N48:
+		node = make_unique<Node48>(art, prefix_length);
+		break;
+	case NodeType::N256:
+		node = make_unique<Node256>(art, prefix_length);
+		break;
+	default:
+		throw Exception("Unrecognized ART node type in the database file");
+	}
+	node->prefix_length = prefix_length;
+	reader.ReadData(node->prefix.get(), prefix_length);
+	auto count = reader.Read<uint16_t>();
+	for (idx_t i = 0; i < count; i++) {
+		auto key_byte = reader.Read<uint8_t>();
+		auto block_id = reader.Read<block_id_t>();
+		auto offset = reader.Read<uint64_t>();
+		// the children are read when they are first accessed
+		unique_ptr<Node> child = make_unique<UnloadedNode>(art, buffer_manager, BlockPointer(block_id, offset));
+		InsertLeaf(art, node, key_byte, child);
+	}
+	return node;
+}
+
 } // namespace duckdb
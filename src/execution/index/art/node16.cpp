@@ -45,7 +45,7 @@ idx_t Node16::GetNextPos(idx_t pos) {
 
 unique_ptr<Node> *Node16::GetChild(idx_t pos) {
 	D_ASSERT(pos < count);
-	return &child[pos];
+	return Node::Load(child[pos]);
 }
 
 idx_t Node16::GetMin() {
@@ -48,7 +48,7 @@ idx_t Node256::GetNextPos(idx_t pos) {
 
 unique_ptr<Node> *Node256::GetChild(idx_t pos) {
 	D_ASSERT(child[pos]);
-	return &child[pos];
+	return Node::Load(child[pos]);
 }
 
 void Node256::insert(ART &art, unique_ptr<Node> &node, uint8_t keyByte, unique_ptr<Node> &child) {
@@ -45,7 +45,7 @@ idx_t Node4::GetNextPos(idx_t pos) {
 
 unique_ptr<Node> *Node4::GetChild(idx_t pos) {
 	D_ASSERT(pos < count);
-	return &child[pos];
+	return Node::Load(child[pos]);
 }
 
 void Node4::insert(ART &art, unique_ptr<Node> &node, uint8_t keyByte, unique_ptr<Node> &child) {
@@ -95,7 +95,7 @@ void Node4::erase(ART &art, unique_ptr<Node> &node, int pos) {
 
 	// This is a one way node
 	if (n->count == 1) {
-		auto childref = n->child[0].get();
+		auto childref = Node::Load(n->child[0])->get();
 		//! concatenate prefixes
 		auto new_length = node->prefix_length + childref->prefix_length + 1;
 		//! have to allocate space in our prefix array
@@ -43,7 +43,7 @@ idx_t Node48::GetNextPos(idx_t pos) {
 
 unique_ptr<Node> *Node48::GetChild(idx_t pos) {
 	D_ASSERT(childIndex[pos] != Node::EMPTY_MARKER);
-	return &child[childIndex[pos]];
+	return Node::Load(child[childIndex[pos]]);
 }
 
 idx_t Node48::GetMin() {
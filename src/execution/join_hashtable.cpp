@@ -8,6 +8,8 @@
 #include "duckdb/common/vector_operations/unary_executor.hpp"
 #include "duckdb/common/operator/comparison_operators.hpp"
 
+#include <atomic>
+
 using namespace std;
 
 namespace duckdb {
@@ -45,6 +47,16 @@ JoinHashTable::JoinHashTable(BufferManager &buffer_manager, vector<JoinCondition
 		build_size += GetTypeIdSize(build_types[i].InternalType());
 	}
 	tuple_size = condition_size + build_size;
+	// the strings of the VARCHAR columns are copied along with the entries when the HT is partitioned
+	idx_t column_offset = 0;
+	for (auto types : {&condition_types, &build_types}) {
+		for (auto &type : *types) {
+			if (type.InternalType() == PhysicalType::VARCHAR) {
+				string_offsets.push_back(column_offset);
+			}
+			column_offset += GetTypeIdSize(type.InternalType());
+		}
+	}
 	pointer_offset = tuple_size;
 	// entry size is the tuple size and the size of the hash/next pointer
 	entry_size = tuple_size + MaxValue(sizeof(hash_t), sizeof(uintptr_t));
@@ -66,6 +78,12 @@ JoinHashTable::~JoinHashTable() {
 	}
 	pinned_handles.clear();
 	for (auto &block : blocks) {
+		if (block.block_id != INVALID_BLOCK) {
+			buffer_manager.DestroyBuffer(block.block_id);
+		}
+	}
+	string_handles.clear();
+	for (auto &block : string_blocks) {
 		buffer_manager.DestroyBuffer(block.block_id);
 	}
 }
@@ -256,52 +274,14 @@ idx_t JoinHashTable::PrepareKeys(DataChunk &keys, unique_ptr<VectorData[]> &key_
 	return added_count;
 }
 
-void JoinHashTable::Build(DataChunk &keys, DataChunk &payload) {
-	D_ASSERT(!finalized);
-	D_ASSERT(keys.size() == payload.size());
-	if (keys.size() == 0) {
-		return;
-	}
-	// special case: correlated mark join
-	if (join_type == JoinType::MARK && correlated_mark_join_info.correlated_types.size() > 0) {
-		auto &info = correlated_mark_join_info;
-		lock_guard<mutex> mj_lock(info.mj_lock);
-		// Correlated MARK join
-		// for the correlated mark join we need to keep track of COUNT(*) and COUNT(COLUMN) for each of the correlated
-		// columns push into the aggregate hash table
-		D_ASSERT(info.correlated_counts);
-		info.group_chunk.SetCardinality(keys);
-		for (idx_t i = 0; i < info.correlated_types.size(); i++) {
-			info.group_chunk.data[i].Reference(keys.data[i]);
-		}
-		info.payload_chunk.SetCardinality(keys);
-		for (idx_t i = 0; i < 2; i++) {
-			info.payload_chunk.data[i].Reference(keys.data[info.correlated_types.size()]);
-		}
-		info.correlated_counts->AddChunk(info.group_chunk, info.payload_chunk);
-	}
-
-	// prepare the keys for processing
-	unique_ptr<VectorData[]> key_data;
-	const SelectionVector *current_sel;
-	SelectionVector sel(STANDARD_VECTOR_SIZE);
-	idx_t added_count = PrepareKeys(keys, key_data, current_sel, sel);
-	if (added_count < keys.size()) {
-		has_null = true;
-	}
-	if (added_count == 0) {
-		return;
-	}
-	count += added_count;
-
-	vector<unique_ptr<BufferHandle>> handles;
+void JoinHashTable::AllocateEntries(idx_t entry_count, vector<unique_ptr<BufferHandle>> &handles,
+                                    data_ptr_t key_locations[]) {
 	vector<BlockAppendEntry> append_entries;
-	data_ptr_t key_locations[STANDARD_VECTOR_SIZE];
-	// first allocate space of where to serialize the keys and payload columns
-	idx_t remaining = added_count;
+	idx_t remaining = entry_count;
 	{
 		// first append to the last block (if any)
 		lock_guard<mutex> append_lock(ht_lock);
+		count += entry_count;
 		if (blocks.size() != 0) {
 			auto &last_block = blocks.back();
 			if (last_block.count < last_block.capacity) {
@@ -337,6 +317,48 @@ void JoinHashTable::Build(DataChunk &keys, DataChunk &payload) {
 			append_entry.baseptr += entry_size;
 		}
 	}
+}
+
+void JoinHashTable::Build(DataChunk &keys, DataChunk &payload) {
+	D_ASSERT(!finalized);
+	D_ASSERT(keys.size() == payload.size());
+	if (keys.size() == 0) {
+		return;
+	}
+	// special case: correlated mark join
+	if (join_type == JoinType::MARK && correlated_mark_join_info.correlated_types.size() > 0) {
+		auto &info = correlated_mark_join_info;
+		lock_guard<mutex> mj_lock(info.mj_lock);
+		// Correlated MARK join
+		// for the correlated mark join we need to keep track of COUNT(*) and COUNT(COLUMN) for each of the correlated
+		// columns push into the aggregate hash table
+		D_ASSERT(info.correlated_counts);
+		info.group_chunk.SetCardinality(keys);
+		for (idx_t i = 0; i < info.correlated_types.size(); i++) {
+			info.group_chunk.data[i].Reference(keys.data[i]);
+		}
+		info.payload_chunk.SetCardinality(keys);
+		for (idx_t i = 0; i < 2; i++) {
+			info.payload_chunk.data[i].Reference(keys.data[info.correlated_types.size()]);
+		}
+		info.correlated_counts->AddChunk(info.group_chunk, info.payload_chunk);
+	}
+
+	// prepare the keys for processing
+	unique_ptr<VectorData[]> key_data;
+	const SelectionVector *current_sel;
+	SelectionVector sel(STANDARD_VECTOR_SIZE);
+	idx_t added_count = PrepareKeys(keys, key_data, current_sel, sel);
+	if (added_count < keys.size()) {
+		has_null = true;
+	}
+	if (added_count == 0) {
+		return;
+	}
+	// first allocate space of where to serialize the keys and payload columns
+	vector<unique_ptr<BufferHandle>> handles;
+	data_ptr_t key_locations[STANDARD_VECTOR_SIZE];
+	AllocateEntries(added_count, handles, key_locations);
 
 	// hash the keys and obtain an entry in the list
 	// note that we only hash the keys used in the equality comparison
@@ -360,7 +382,7 @@ void JoinHashTable::Build(DataChunk &keys, DataChunk &payload) {
 	SerializeVector(hash_values, payload.size(), *current_sel, added_count, key_locations);
 }
 
-void JoinHashTable::InsertHashes(Vector &hashes, idx_t count, data_ptr_t key_locations[]) {
+void JoinHashTable::InsertHashes(Vector &hashes, idx_t count, data_ptr_t key_locations[], bool parallel) {
 	D_ASSERT(hashes.type.id() == LogicalTypeId::HASH);
 
 	// use bitmask to get position in array
@@ -369,8 +391,22 @@ void JoinHashTable::InsertHashes(Vector &hashes, idx_t count, data_ptr_t key_loc
 	hashes.Normalify(count);
 
 	D_ASSERT(hashes.vector_type == VectorType::FLAT_VECTOR);
-	auto pointers = (data_ptr_t *)hash_map->node->buffer;
 	auto indices = FlatVector::GetData<hash_t>(hashes);
+	if (parallel) {
+		// other threads insert into the same pointer table: swap in the new head of the chain with a CAS
+		auto pointers = (std::atomic<data_ptr_t> *)hash_map->node->buffer;
+		for (idx_t i = 0; i < count; i++) {
+			auto &head = pointers[indices[i]];
+			auto prev_pointer = (data_ptr_t *)(key_locations[i] + pointer_offset);
+			auto current_head = head.load(std::memory_order_relaxed);
+			do {
+				Store<data_ptr_t>(current_head, (data_ptr_t)prev_pointer);
+			} while (!head.compare_exchange_weak(current_head, key_locations[i], std::memory_order_release,
+			                                     std::memory_order_relaxed));
+		}
+		return;
+	}
+	auto pointers = (data_ptr_t *)hash_map->node->buffer;
 	for (idx_t i = 0; i < count; i++) {
 		auto index = indices[i];
 		// set prev in current key to the value (NOTE: this will be nullptr if
@@ -383,10 +419,36 @@ void JoinHashTable::InsertHashes(Vector &hashes, idx_t count, data_ptr_t key_loc
 	}
 }
 
-void JoinHashTable::Finalize() {
-	// the build has finished, now iterate over all the nodes and construct the final hash table
+void JoinHashTable::Merge(JoinHashTable &other) {
+	D_ASSERT(!finalized && !other.finalized);
+	lock_guard<mutex> append_lock(ht_lock);
+	// take over the blocks and strings of the other HT without copying them
+	blocks.insert(blocks.end(), other.blocks.begin(), other.blocks.end());
+	other.blocks.clear();
+	string_heap.MergeHeap(other.string_heap);
+	count += other.count;
+	other.count = 0;
+	if (other.has_null) {
+		has_null = true;
+	}
+}
+
+idx_t JoinHashTable::PointerTableCapacity(idx_t count) {
 	// select a HT that has at least 50% empty space
-	idx_t capacity = NextPowerOfTwo(MaxValue<idx_t>(count * 2, (Storage::BLOCK_ALLOC_SIZE / sizeof(data_ptr_t)) + 1));
+	return NextPowerOfTwo(MaxValue<idx_t>(count * 2, (Storage::BLOCK_ALLOC_SIZE / sizeof(data_ptr_t)) + 1));
+}
+
+idx_t JoinHashTable::SizeInBytes() {
+	idx_t size = blocks.size() * block_capacity * entry_size + PointerTableCapacity(count) * sizeof(data_ptr_t);
+	for (auto &block : string_blocks) {
+		size += block.capacity;
+	}
+	return size;
+}
+
+void JoinHashTable::InitializePointerTable() {
+	D_ASSERT(!finalized);
+	idx_t capacity = PointerTableCapacity(count);
 	// size needs to be a power of 2
 	D_ASSERT((capacity & (capacity - 1)) == 0);
 	bitmask = capacity - 1;
@@ -394,15 +456,25 @@ void JoinHashTable::Finalize() {
 	// allocate the HT and initialize it with all-zero entries
 	hash_map = buffer_manager.Allocate(capacity * sizeof(data_ptr_t));
 	memset(hash_map->node->buffer, 0, capacity * sizeof(data_ptr_t));
+	pinned_handles.resize(blocks.size());
+	// the strings are pointed to by the entries from now on: keep the string blocks pinned until the HT is destroyed
+	for (auto &block : string_blocks) {
+		string_handles.push_back(buffer_manager.Pin(block.block_id));
+	}
+	finalized = true;
+}
 
+void JoinHashTable::Finalize(idx_t block_start, idx_t block_end, bool parallel) {
+	D_ASSERT(finalized);
+	D_ASSERT(block_end <= blocks.size());
 	Vector hashes(LogicalType::HASH);
 	auto hash_data = FlatVector::GetData<hash_t>(hashes);
 	data_ptr_t key_locations[STANDARD_VECTOR_SIZE];
 	// now construct the actual hash table; scan the nodes
 	// as we can the nodes we pin all the blocks of the HT and keep them pinned until the HT is destroyed
 	// this is so that we can keep pointers around to the blocks
-	// FIXME: if we cannot keep everything pinned in memory, we could switch to an out-of-memory merge join or so
-	for (auto &block : blocks) {
+	for (idx_t block_idx = block_start; block_idx < block_end; block_idx++) {
+		auto &block = blocks[block_idx];
 		auto handle = buffer_manager.Pin(block.block_id);
 		data_ptr_t dataptr = handle->node->buffer;
 		idx_t entry = 0;
@@ -414,15 +486,135 @@ void JoinHashTable::Finalize() {
 				key_locations[i] = dataptr;
 				dataptr += entry_size;
 			}
+			if (!string_blocks.empty()) {
+				SwizzleStrings(key_locations, next);
+			}
 			// now insert into the hash table
-			InsertHashes(hashes, next, key_locations);
+			InsertHashes(hashes, next, key_locations, parallel);
 
 			entry += next;
 		}
-		pinned_handles.push_back(move(handle));
+		pinned_handles[block_idx] = move(handle);
 	}
+}
 
-	finalized = true;
+void JoinHashTable::Finalize() {
+	// the build has finished, now iterate over all the nodes and construct the final hash table
+	InitializePointerTable();
+	Finalize(0, blocks.size(), false);
+}
+
+void JoinHashTable::AppendEntries(data_ptr_t entries[], idx_t entry_count) {
+	if (entry_count == 0) {
+		return;
+	}
+	vector<unique_ptr<BufferHandle>> handles;
+	data_ptr_t key_locations[STANDARD_VECTOR_SIZE];
+	AllocateEntries(entry_count, handles, key_locations);
+	for (idx_t i = 0; i < entry_count; i++) {
+		memcpy(key_locations[i], entries[i], entry_size);
+	}
+	if (!string_offsets.empty()) {
+		AppendStrings(key_locations, entry_count);
+	}
+}
+
+//! The offset of the string pointer within a string_t
+static constexpr idx_t STRING_POINTER_OFFSET = sizeof(uint32_t) + string_t::PREFIX_LENGTH;
+
+void JoinHashTable::AppendStrings(data_ptr_t key_locations[], idx_t count) {
+	lock_guard<mutex> append_lock(ht_lock);
+	// the handle of the last string block, which is the block that is appended to
+	unique_ptr<BufferHandle> handle;
+	for (idx_t i = 0; i < count; i++) {
+		for (auto &string_offset : string_offsets) {
+			auto location = key_locations[i] + string_offset;
+			auto str = Load<string_t>(location);
+			if (str.IsInlined()) {
+				continue;
+			}
+			idx_t required_size = str.GetSize() + 1;
+			if (string_blocks.empty() || string_blocks.back().size + required_size > string_blocks.back().capacity) {
+				// the last string block is full: allocate a new one
+				// only the part of the buffer after the block header is written to disk when the block is evicted
+				HTStringBlock new_block;
+				new_block.size = 0;
+				handle = buffer_manager.Allocate(
+				    MaxValue<idx_t>(Storage::BLOCK_ALLOC_SIZE, required_size + Storage::BLOCK_HEADER_SIZE));
+				new_block.capacity = handle->node->size;
+				new_block.block_id = handle->block_id;
+				string_blocks.push_back(new_block);
+			} else if (!handle) {
+				handle = buffer_manager.Pin(string_blocks.back().block_id);
+			}
+			auto &block = string_blocks.back();
+			auto target = handle->node->buffer + block.size;
+			memcpy(target, str.GetData(), str.GetSize());
+			target[str.GetSize()] = '\0';
+			// the block can be evicted: store the location of the string instead of a pointer to it
+			uint64_t string_location = (uint64_t(string_blocks.size() - 1) << 32) | block.size;
+			Store<uint64_t>(string_location, location + STRING_POINTER_OFFSET);
+			block.size += required_size;
+		}
+	}
+}
+
+void JoinHashTable::SwizzleStrings(data_ptr_t key_locations[], idx_t count) {
+	D_ASSERT(string_handles.size() == string_blocks.size());
+	for (idx_t i = 0; i < count; i++) {
+		for (auto &string_offset : string_offsets) {
+			auto location = key_locations[i] + string_offset;
+			if (Load<uint32_t>(location) < string_t::INLINE_LENGTH) {
+				continue;
+			}
+			auto string_location = Load<uint64_t>(location + STRING_POINTER_OFFSET);
+			auto &handle = string_handles[string_location >> 32];
+			Store<data_ptr_t>(handle->node->buffer + (string_location & 0xFFFFFFFF), location + STRING_POINTER_OFFSET);
+		}
+	}
+}
+
+struct JoinPartitionInfo {
+	JoinPartitionInfo() : entry_count(0) {
+	}
+	data_ptr_t entries[STANDARD_VECTOR_SIZE];
+	idx_t entry_count;
+};
+
+void JoinHashTable::Partition(vector<JoinHashTable *> &partition_hts, hash_t mask, idx_t shift, idx_t block_start,
+                              idx_t block_end) {
+	D_ASSERT(!finalized);
+	D_ASSERT(partition_hts.size() > 1);
+	D_ASSERT(block_end <= blocks.size());
+	vector<JoinPartitionInfo> partition_info(partition_hts.size());
+	for (idx_t block_idx = block_start; block_idx < block_end; block_idx++) {
+		auto &block = blocks[block_idx];
+		auto handle = buffer_manager.Pin(block.block_id);
+		auto dataptr = handle->node->buffer;
+		for (idx_t entry = 0; entry < block.count; entry++) {
+			// the hash is stored in the place of the next pointer until the HT is finalized
+			auto hash = Load<hash_t>(dataptr + pointer_offset);
+			idx_t partition = (hash & mask) >> shift;
+			D_ASSERT(partition < partition_hts.size());
+
+			auto &info = partition_info[partition];
+			info.entries[info.entry_count++] = dataptr;
+			if (info.entry_count == STANDARD_VECTOR_SIZE) {
+				partition_hts[partition]->AppendEntries(info.entries, info.entry_count);
+				info.entry_count = 0;
+			}
+			dataptr += entry_size;
+		}
+		for (idx_t partition = 0; partition < partition_hts.size(); partition++) {
+			auto &info = partition_info[partition];
+			partition_hts[partition]->AppendEntries(info.entries, info.entry_count);
+			info.entry_count = 0;
+		}
+		// the entries have been moved to the partitions: the block is no longer required
+		handle.reset();
+		buffer_manager.DestroyBuffer(block.block_id);
+		block.block_id = INVALID_BLOCK;
+	}
 }
 
 unique_ptr<ScanStructure> JoinHashTable::Probe(DataChunk &keys) {
@@ -1031,7 +1223,7 @@ void JoinHashTable::ScanFullOuter(DataChunk &result, JoinHTScanState &state) {
 	// scan the HT starting from the current position and check which rows from the build side did not find a match
 	data_ptr_t key_locations[STANDARD_VECTOR_SIZE];
 	idx_t found_entries = 0;
-	for (; state.block_position < blocks.size(); state.block_position++) {
+	for (; state.block_position < blocks.size(); state.block_position++, state.position = 0) {
 		auto &block = blocks[state.block_position];
 		auto &handle = pinned_handles[state.block_position];
 		auto baseptr = handle->node->buffer;
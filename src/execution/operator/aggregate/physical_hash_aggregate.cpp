@@ -173,8 +173,7 @@ void PhysicalHashAggregate::Sink(ExecutionContext &context, GlobalOperatorState
 	payload_chunk.Verify();
 	D_ASSERT(payload_chunk.column_count() == 0 || group_chunk.size() == payload_chunk.size());
 
-	// if we have non-combinable aggregates (e.g. string_agg) or any distinct aggregates we cannot keep parallel hash
-	// tables
+	// if we have non-combinable aggregates (e.g. string_agg) we cannot keep parallel hash tables
 	if (ForceSingleHT(state)) {
 		lock_guard<mutex> glock(gstate.lock);
 		gstate.is_empty = gstate.is_empty && group_chunk.size() == 0;
@@ -189,7 +188,6 @@ void PhysicalHashAggregate::Sink(ExecutionContext &context, GlobalOperatorState
 	}
 
 	D_ASSERT(all_combinable);
-	D_ASSERT(!any_distinct);
 
 	if (group_chunk.size() > 0) {
 		llstate.is_empty = false;
@@ -208,7 +206,8 @@ class PhysicalHashAggregateState : public PhysicalOperatorState {
 public:
 	PhysicalHashAggregateState(PhysicalOperator &op, vector<LogicalType> &group_types,
 	                           vector<LogicalType> &aggregate_types, PhysicalOperator *child)
-	    : PhysicalOperatorState(op, child), ht_index(0), ht_scan_position(0) {
+	    : PhysicalOperatorState(op, child), initialized(false), parallel_state(nullptr), ht_index(0),
+	      ht_scan_position(0), ht_scan_end(0) {
 		auto scan_chunk_types = group_types;
 		for (auto &aggr_type : aggregate_types) {
 			scan_chunk_types.push_back(aggr_type);
@@ -219,9 +218,25 @@ public:
 	//! Materialized GROUP BY expressions & aggregates
 	DataChunk scan_chunk;
 
+	bool initialized;
+	//! The parallel state (if the HTs are scanned by multiple threads)
+	ParallelState *parallel_state;
 	//! The current position to scan the HT for output tuples
 	idx_t ht_index;
 	idx_t ht_scan_position;
+	//! The end of the range of the HT that is assigned to this thread (parallel scan only)
+	idx_t ht_scan_end;
+};
+
+class HashAggregateParallelState : public ParallelState {
+public:
+	HashAggregateParallelState() : ht_index(0), ht_scan_position(0) {
+	}
+
+	mutex lock;
+	//! The HT and the position within the HT that are handed out next
+	idx_t ht_index;
+	idx_t ht_scan_position;
 };
 
 void PhysicalHashAggregate::Combine(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate) {
@@ -247,7 +262,6 @@ void PhysicalHashAggregate::Combine(ExecutionContext &context, GlobalOperatorSta
 
 	lock_guard<mutex> glock(gstate.lock);
 	D_ASSERT(all_combinable);
-	D_ASSERT(!any_distinct);
 
 	if (!llstate.is_empty) {
 		gstate.is_empty = false;
@@ -403,21 +417,54 @@ void PhysicalHashAggregate::GetChunkInternal(ExecutionContext &context, DataChun
 		state.finished = true;
 		return;
 	}
+	if (!state.initialized) {
+		state.parallel_state = FindParallelState(context);
+		state.initialized = true;
+	}
 	idx_t elements_found = 0;
-
-	while (true) {
-		if (state.ht_index == gstate.finalized_hts.size()) {
-			state.finished = true;
-			return;
+	if (state.parallel_state) {
+		// parallel scan: the threads scan disjoint ranges of the finalized HTs
+		auto &pstate = (HashAggregateParallelState &)*state.parallel_state;
+		while (true) {
+			if (state.ht_scan_position < state.ht_scan_end) {
+				elements_found = gstate.finalized_hts[state.ht_index]->Scan(state.ht_scan_position, state.scan_chunk);
+				D_ASSERT(elements_found > 0 && state.ht_scan_position <= state.ht_scan_end);
+				break;
+			}
+			// the assigned range is exhausted: fetch the next range
+			lock_guard<mutex> plock(pstate.lock);
+			while (pstate.ht_index < gstate.finalized_hts.size() &&
+			       pstate.ht_scan_position >= gstate.finalized_hts[pstate.ht_index]->Size()) {
+				pstate.ht_index++;
+				pstate.ht_scan_position = 0;
+			}
+			if (pstate.ht_index == gstate.finalized_hts.size()) {
+				state.finished = true;
+				return;
+			}
+			// the ranges are a multiple of the vector size, so a Scan never crosses the end of a range
+			idx_t range_size = ParallelScanVectorCount(context.client) * STANDARD_VECTOR_SIZE;
+			state.ht_index = pstate.ht_index;
+			state.ht_scan_position = pstate.ht_scan_position;
+			state.ht_scan_end =
+			    MinValue<idx_t>(pstate.ht_scan_position + range_size, gstate.finalized_hts[pstate.ht_index]->Size());
+			pstate.ht_scan_position = state.ht_scan_end;
 		}
-		elements_found = gstate.finalized_hts[state.ht_index]->Scan(state.ht_scan_position, state.scan_chunk);
+	} else {
+		while (true) {
+			if (state.ht_index == gstate.finalized_hts.size()) {
+				state.finished = true;
+				return;
+			}
+			elements_found = gstate.finalized_hts[state.ht_index]->Scan(state.ht_scan_position, state.scan_chunk);
 
-		if (elements_found > 0) {
-			break;
+			if (elements_found > 0) {
+				break;
+			}
+			gstate.finalized_hts[state.ht_index].reset();
+			state.ht_index++;
+			state.ht_scan_position = 0;
 		}
-		gstate.finalized_hts[state.ht_index].reset();
-		state.ht_index++;
-		state.ht_scan_position = 0;
 	}
 
 	// compute the final projection list
@@ -441,10 +488,29 @@ unique_ptr<PhysicalOperatorState> PhysicalHashAggregate::GetOperatorState() {
 	                                               children.size() == 0 ? nullptr : children[0].get());
 }
 
+idx_t PhysicalHashAggregate::MaxThreads(ClientContext &context) {
+	auto &gstate = (HashAggregateGlobalState &)*sink_state;
+	if (gstate.is_empty) {
+		// the (possibly empty) result is produced by a single thread
+		return 1;
+	}
+	idx_t total_groups = 0;
+	for (auto &ht : gstate.finalized_hts) {
+		total_groups += ht->Size();
+	}
+	return total_groups / (ParallelScanVectorCount(context) * STANDARD_VECTOR_SIZE) + 1;
+}
+
+unique_ptr<ParallelState> PhysicalHashAggregate::GetParallelState() {
+	return make_unique<HashAggregateParallelState>();
+}
+
 bool PhysicalHashAggregate::ForceSingleHT(GlobalOperatorState &state) {
 	auto &gstate = (HashAggregateGlobalState &)state;
 
-	return !all_combinable || any_distinct || gstate.partition_info.n_partitions < 2;
+	// distinct aggregates are combinable: the per-thread distinct HTs are radix-partitioned along with the groups and
+	// merged per partition
+	return !all_combinable || gstate.partition_info.n_partitions < 2;
 }
 
 string PhysicalHashAggregate::ParamsToString() const {
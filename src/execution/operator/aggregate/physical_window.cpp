@@ -1,13 +1,17 @@
 #include "duckdb/execution/operator/aggregate/physical_window.hpp"
 
+#include "duckdb/common/operator/comparison_operators.hpp"
 #include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/execution/window_segment_tree.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/pipeline.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/planner/expression/bound_reference_expression.hpp"
 #include "duckdb/planner/expression/bound_window_expression.hpp"
 
-#include <cmath>
+#include <algorithm>
 
 using namespace std;
 
@@ -17,50 +21,25 @@ namespace duckdb {
 class PhysicalWindowOperatorState : public PhysicalOperatorState {
 public:
 	PhysicalWindowOperatorState(PhysicalOperator &op, PhysicalOperator *child)
-	    : PhysicalOperatorState(op, child), position(0) {
+	    : PhysicalOperatorState(op, child), initialized(false), parallel_state(nullptr), partition_idx(0), chunk_idx(0),
+	      chunk_end(0) {
 	}
 
-	idx_t position;
-	ChunkCollection tuples;
-	ChunkCollection window_results;
+	bool initialized;
+	//! The parallel state (if the result is scanned by multiple threads)
+	ParallelState *parallel_state;
+	//! The hash partition that is currently being scanned
+	idx_t partition_idx;
+	//! The chunk within the hash partition that is scanned next
+	idx_t chunk_idx;
+	//! The end of the range of chunks within the hash partition that is assigned to this thread (parallel scan only)
+	idx_t chunk_end;
 };
 
 // this implements a sorted window functions variant
 PhysicalWindow::PhysicalWindow(vector<LogicalType> types, vector<unique_ptr<Expression>> select_list,
                                PhysicalOperatorType type)
-    : PhysicalOperator(type, move(types)), select_list(move(select_list)) {
-}
-
-static bool EqualsSubset(vector<Value> &a, vector<Value> &b, idx_t start, idx_t end) {
-	D_ASSERT(start <= end);
-	for (idx_t i = start; i < end; i++) {
-		if (a[i] != b[i]) {
-			return false;
-		}
-	}
-	return true;
-}
-
-static idx_t BinarySearchRightmost(ChunkCollection &input, vector<Value> row, idx_t l, idx_t r, idx_t comp_cols) {
-	if (comp_cols == 0) {
-		return r - 1;
-	}
-	while (l < r) {
-		idx_t m = floor((l + r) / 2);
-		bool less_than_equals = true;
-		for (idx_t i = 0; i < comp_cols; i++) {
-			if (input.GetRow(m)[i] > row[i]) {
-				less_than_equals = false;
-				break;
-			}
-		}
-		if (less_than_equals) {
-			l = m + 1;
-		} else {
-			r = m;
-		}
-	}
-	return l - 1;
+    : PhysicalSink(type, move(types)), select_list(move(select_list)) {
 }
 
 static void MaterializeExpressions(Expression **exprs, idx_t expr_count, ChunkCollection &input,
@@ -152,44 +131,128 @@ struct WindowBoundariesState {
 	int64_t window_end = -1;
 	bool is_same_partition = false;
 	bool is_peer = false;
-	vector<Value> row_prev;
 };
 
+template <class T>
+static void TemplatedMarkBoundaries(VectorData &vdata, idx_t count, bool boundaries[]) {
+	auto data = (T *)vdata.data;
+	auto &nullmask = *vdata.nullmask;
+	for (idx_t i = 1; i < count; i++) {
+		auto prev_idx = vdata.sel->get_index(i - 1);
+		auto idx = vdata.sel->get_index(i);
+		if (nullmask[prev_idx] || nullmask[idx]) {
+			boundaries[i] = boundaries[i] || nullmask[prev_idx] != nullmask[idx];
+		} else {
+			boundaries[i] = boundaries[i] || !Equals::Operation<T>(data[prev_idx], data[idx]);
+		}
+	}
+}
+
+static void MarkBoundariesGeneric(Vector &input, idx_t count, bool boundaries[]) {
+	for (idx_t i = 1; i < count; i++) {
+		boundaries[i] = boundaries[i] || input.GetValue(i - 1) != input.GetValue(i);
+	}
+}
+
+//! Marks the rows of the (sorted) collection at which the values of the columns [start_col, end_col) differ from
+//! those of the previous row. The first row is always marked.
+static void MarkBoundaries(ChunkCollection &input, idx_t start_col, idx_t end_col, bool boundaries[]) {
+	if (input.count == 0) {
+		return;
+	}
+	boundaries[0] = true;
+	for (idx_t col_idx = start_col; col_idx < end_col; col_idx++) {
+		idx_t offset = 0;
+		for (idx_t chunk_idx = 0; chunk_idx < input.chunks.size(); chunk_idx++) {
+			auto &chunk = *input.chunks[chunk_idx];
+			auto &vector = chunk.data[col_idx];
+			auto count = chunk.size();
+			if (chunk_idx > 0) {
+				// compare the first row with the last row of the previous chunk
+				auto &prev_chunk = *input.chunks[chunk_idx - 1];
+				boundaries[offset] = boundaries[offset] ||
+				                     prev_chunk.GetValue(col_idx, prev_chunk.size() - 1) != chunk.GetValue(col_idx, 0);
+			}
+			VectorData vdata;
+			vector.Orrify(count, vdata);
+			switch (vector.type.InternalType()) {
+			case PhysicalType::BOOL:
+			case PhysicalType::INT8:
+				TemplatedMarkBoundaries<int8_t>(vdata, count, boundaries + offset);
+				break;
+			case PhysicalType::INT16:
+				TemplatedMarkBoundaries<int16_t>(vdata, count, boundaries + offset);
+				break;
+			case PhysicalType::INT32:
+				TemplatedMarkBoundaries<int32_t>(vdata, count, boundaries + offset);
+				break;
+			case PhysicalType::INT64:
+				TemplatedMarkBoundaries<int64_t>(vdata, count, boundaries + offset);
+				break;
+			case PhysicalType::INT128:
+				TemplatedMarkBoundaries<hugeint_t>(vdata, count, boundaries + offset);
+				break;
+			case PhysicalType::FLOAT:
+				TemplatedMarkBoundaries<float>(vdata, count, boundaries + offset);
+				break;
+			case PhysicalType::DOUBLE:
+				TemplatedMarkBoundaries<double>(vdata, count, boundaries + offset);
+				break;
+			case PhysicalType::INTERVAL:
+				TemplatedMarkBoundaries<interval_t>(vdata, count, boundaries + offset);
+				break;
+			case PhysicalType::VARCHAR:
+				TemplatedMarkBoundaries<string_t>(vdata, count, boundaries + offset);
+				break;
+			default:
+				MarkBoundariesGeneric(vector, count, boundaries + offset);
+				break;
+			}
+			offset += count;
+		}
+	}
+}
+
+//! Returns the first row after row_idx that is marked as a boundary, or end if there is none
+static idx_t FindNextBoundary(bool boundaries[], idx_t row_idx, idx_t end) {
+	for (idx_t i = row_idx + 1; i < end; i++) {
+		if (boundaries[i]) {
+			return i;
+		}
+	}
+	return end;
+}
+
 static bool WindowNeedsRank(BoundWindowExpression *wexpr) {
 	return wexpr->type == ExpressionType::WINDOW_PERCENT_RANK || wexpr->type == ExpressionType::WINDOW_RANK ||
 	       wexpr->type == ExpressionType::WINDOW_RANK_DENSE || wexpr->type == ExpressionType::WINDOW_CUME_DIST;
 }
 
-static void UpdateWindowBoundaries(BoundWindowExpression *wexpr, ChunkCollection &input, idx_t input_size,
-                                   idx_t row_idx, ChunkCollection &boundary_start_collection,
+static void UpdateWindowBoundaries(BoundWindowExpression *wexpr, bool needs_sorting, bool partition_boundaries[],
+                                   bool peer_boundaries[], idx_t input_size, idx_t row_idx,
+                                   ChunkCollection &boundary_start_collection,
                                    ChunkCollection &boundary_end_collection, WindowBoundariesState &bounds) {
 
-	if (input.column_count() > 0) {
-		vector<Value> row_cur = input.GetRow(row_idx);
-		idx_t sort_col_count = wexpr->partitions.size() + wexpr->orders.size();
-
+	if (needs_sorting) {
 		// determine partition and peer group boundaries to ultimately figure out window size
-		bounds.is_same_partition = EqualsSubset(bounds.row_prev, row_cur, 0, wexpr->partitions.size());
-		bounds.is_peer = bounds.is_same_partition &&
-		                 EqualsSubset(bounds.row_prev, row_cur, wexpr->partitions.size(), sort_col_count);
-		bounds.row_prev = row_cur;
+		bounds.is_same_partition = !partition_boundaries[row_idx];
+		bounds.is_peer = !peer_boundaries[row_idx];
 
 		// when the partition changes, recompute the boundaries
-		if (!bounds.is_same_partition || row_idx == 0) { // special case for first row, need to init
+		if (!bounds.is_same_partition) {
 			bounds.partition_start = row_idx;
 			bounds.peer_start = row_idx;
 
 			// find end of partition
-			bounds.partition_end =
-			    BinarySearchRightmost(input, row_cur, bounds.partition_start, input.count, wexpr->partitions.size()) +
-			    1;
-
+			bounds.partition_end = FindNextBoundary(partition_boundaries, row_idx, input_size);
 		} else if (!bounds.is_peer) {
 			bounds.peer_start = row_idx;
 		}
 
-		if (wexpr->end == WindowBoundary::CURRENT_ROW_RANGE || wexpr->type == ExpressionType::WINDOW_CUME_DIST) {
-			bounds.peer_end = BinarySearchRightmost(input, row_cur, row_idx, bounds.partition_end, sort_col_count) + 1;
+		if ((wexpr->end == WindowBoundary::CURRENT_ROW_RANGE || wexpr->type == ExpressionType::WINDOW_CUME_DIST) &&
+		    !bounds.is_peer) {
+			// find end of peer group
+			bounds.peer_end = FindNextBoundary(peer_boundaries, row_idx, bounds.partition_end);
 		}
 	} else {
 		bounds.is_same_partition = 0;
@@ -328,18 +391,24 @@ static void ComputeWindowExpression(BoundWindowExpression *wexpr, ChunkCollectio
 		segment_tree = make_unique<WindowSegmentTree>(*(wexpr->aggregate), wexpr->return_type, &payload_collection);
 	}
 
-	WindowBoundariesState bounds;
-	uint64_t dense_rank = 1, rank_equal = 0, rank = 1;
-
+	// mark the rows at which a new partition and a new peer group start
+	unique_ptr<bool[]> partition_boundaries;
+	unique_ptr<bool[]> peer_boundaries;
 	if (needs_sorting) {
-		bounds.row_prev = sort_collection.GetRow(0);
+		partition_boundaries = unique_ptr<bool[]>(new bool[input.count]());
+		peer_boundaries = unique_ptr<bool[]>(new bool[input.count]());
+		MarkBoundaries(sort_collection, 0, wexpr->partitions.size(), partition_boundaries.get());
+		MarkBoundaries(sort_collection, 0, sort_collection.column_count(), peer_boundaries.get());
 	}
 
+	WindowBoundariesState bounds;
+	uint64_t dense_rank = 1, rank_equal = 0, rank = 1;
+
 	// this is the main loop, go through all sorted rows and compute window function result
 	for (idx_t row_idx = 0; row_idx < input.count; row_idx++) {
 		// special case, OVER (), aggregate over everything
-		UpdateWindowBoundaries(wexpr, sort_collection, input.count, row_idx, boundary_start_collection,
-		                       boundary_end_collection, bounds);
+		UpdateWindowBoundaries(wexpr, needs_sorting, partition_boundaries.get(), peer_boundaries.get(), input.count,
+		                       row_idx, boundary_start_collection, boundary_end_collection, bounds);
 		if (WindowNeedsRank(wexpr)) {
 			if (!bounds.is_same_partition || row_idx == 0) { // special case for first row, need to init
 				dense_rank = 1;
@@ -468,58 +537,322 @@ static void ComputeWindowExpression(BoundWindowExpression *wexpr, ChunkCollectio
 	}
 }
 
-void PhysicalWindow::GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
-	auto state = reinterpret_cast<PhysicalWindowOperatorState *>(state_);
-	ChunkCollection &big_data = state->tuples;
-	ChunkCollection &window_results = state->window_results;
+//===--------------------------------------------------------------------===//
+// Sink
+//===--------------------------------------------------------------------===//
+//! The amount of hash partitions the input is split into per thread
+static constexpr idx_t WINDOW_PARTITIONS_PER_THREAD = 4;
+
+//! Returns true if all window expressions partition by the same (non-empty) list of expressions; the input can then be
+//! hash partitioned on them, as every window partition ends up in a single hash partition
+static bool HasCommonPartitions(vector<unique_ptr<Expression>> &select_list) {
+	auto first = reinterpret_cast<BoundWindowExpression *>(select_list[0].get());
+	if (first->partitions.empty()) {
+		return false;
+	}
+	for (auto &expr : select_list) {
+		auto wexpr = reinterpret_cast<BoundWindowExpression *>(expr.get());
+		if (wexpr->partitions.size() != first->partitions.size()) {
+			return false;
+		}
+		for (idx_t prt_idx = 0; prt_idx < wexpr->partitions.size(); prt_idx++) {
+			if (!Expression::Equals(wexpr->partitions[prt_idx].get(), first->partitions[prt_idx].get())) {
+				return false;
+			}
+			auto type = wexpr->partitions[prt_idx]->return_type.InternalType();
+			if (type == PhysicalType::LIST || type == PhysicalType::STRUCT) {
+				// nested types cannot be hashed
+				return false;
+			}
+		}
+	}
+	return true;
+}
 
-	// this is a blocking operator, so compute complete result on first invocation
-	if (state->position == 0) {
-		do {
-			children[0]->GetChunk(context, state->child_chunk, state->child_state.get());
-			big_data.Append(state->child_chunk);
-		} while (state->child_chunk.size() != 0);
+//! Returns the amount of hash partitions the input of the window is split into
+static idx_t WindowPartitionCount(PhysicalWindow &op, ClientContext &context) {
+	if (!HasCommonPartitions(op.select_list)) {
+		return 1;
+	}
+	idx_t threads = TaskScheduler::GetScheduler(context).NumberOfThreads();
+	if (threads <= 1 && !context.force_parallelism) {
+		// a single thread does not benefit from partitioning the input
+		return 1;
+	}
+	return threads * WINDOW_PARTITIONS_PER_THREAD;
+}
 
-		if (big_data.count == 0) {
-			return;
+class WindowGlobalState : public GlobalOperatorState {
+public:
+	WindowGlobalState(PhysicalWindow &op, ClientContext &context)
+	    : partition_count(WindowPartitionCount(op, context)) {
+		for (idx_t partition = 0; partition < partition_count; partition++) {
+			partitions.push_back(make_unique<ChunkCollection>());
+			window_results.push_back(make_unique<ChunkCollection>());
 		}
+		local_partitions.resize(partition_count);
+	}
 
-		vector<LogicalType> window_types;
-		for (idx_t expr_idx = 0; expr_idx < select_list.size(); expr_idx++) {
-			window_types.push_back(select_list[expr_idx]->return_type);
-		}
+	//! The lock for updating the global window state
+	mutex lock;
+	//! The amount of hash partitions of the input
+	idx_t partition_count;
+	//! The thread-local input rows of every hash partition, they are concatenated when the partition is computed
+	vector<vector<unique_ptr<ChunkCollection>>> local_partitions;
+	//! The input rows of every hash partition
+	vector<unique_ptr<ChunkCollection>> partitions;
+	//! The results of the window expressions for the rows of every hash partition
+	vector<unique_ptr<ChunkCollection>> window_results;
+};
 
-		for (idx_t i = 0; i < big_data.chunks.size(); i++) {
-			DataChunk window_chunk;
-			window_chunk.Initialize(window_types);
-			window_chunk.SetCardinality(big_data.chunks[i]->size());
-			for (idx_t col_idx = 0; col_idx < window_chunk.column_count(); col_idx++) {
-				window_chunk.data[col_idx].vector_type = VectorType::CONSTANT_VECTOR;
-				ConstantVector::SetNull(window_chunk.data[col_idx], true);
+class WindowLocalSinkState : public LocalSinkState {
+public:
+	WindowLocalSinkState(PhysicalWindow &op, idx_t partition_count) : hashes(LogicalType::HASH) {
+		if (partition_count > 1) {
+			auto wexpr = reinterpret_cast<BoundWindowExpression *>(op.select_list[0].get());
+			vector<LogicalType> key_types;
+			for (auto &pexpr : wexpr->partitions) {
+				key_types.push_back(pexpr->return_type);
+				executor.AddExpression(*pexpr);
+			}
+			keys.Initialize(key_types);
+			slice.InitializeEmpty(op.children[0]->types);
+			for (idx_t partition = 0; partition < partition_count; partition++) {
+				partition_sel.emplace_back(STANDARD_VECTOR_SIZE);
 			}
+			partition_counts.resize(partition_count);
+		}
+		for (idx_t partition = 0; partition < partition_count; partition++) {
+			partitions.push_back(make_unique<ChunkCollection>());
+		}
+	}
+
+	//! Executes the PARTITION BY expressions
+	ExpressionExecutor executor;
+	//! The partition keys of the current input chunk
+	DataChunk keys;
+	//! The hashes of the partition keys
+	Vector hashes;
+	//! The rows of the current input chunk that belong to every hash partition
+	vector<SelectionVector> partition_sel;
+	vector<idx_t> partition_counts;
+	//! The rows of the current input chunk of a single hash partition
+	DataChunk slice;
+	//! The thread-local input rows of every hash partition
+	vector<unique_ptr<ChunkCollection>> partitions;
+};
+
+unique_ptr<GlobalOperatorState> PhysicalWindow::GetGlobalState(ClientContext &context) {
+	return make_unique<WindowGlobalState>(*this, context);
+}
+
+unique_ptr<LocalSinkState> PhysicalWindow::GetLocalSinkState(ExecutionContext &context) {
+	return make_unique<WindowLocalSinkState>(*this, WindowPartitionCount(*this, context.client));
+}
+
+void PhysicalWindow::Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate_,
+                          DataChunk &input) {
+	auto &lstate = (WindowLocalSinkState &)lstate_;
+	idx_t partition_count = lstate.partitions.size();
+	if (partition_count == 1) {
+		lstate.partitions[0]->Append(input);
+		return;
+	}
+	// hash the partition keys and scatter the rows over the hash partitions
+	lstate.keys.Reset();
+	lstate.executor.Execute(input, lstate.keys);
+	VectorOperations::Hash(lstate.keys.data[0], lstate.hashes, input.size());
+	for (idx_t i = 1; i < lstate.keys.column_count(); i++) {
+		VectorOperations::CombineHash(lstate.hashes, lstate.keys.data[i], input.size());
+	}
+	VectorData hdata;
+	lstate.hashes.Orrify(input.size(), hdata);
+	auto hash_data = (hash_t *)hdata.data;
+	fill(lstate.partition_counts.begin(), lstate.partition_counts.end(), 0);
+	for (idx_t i = 0; i < input.size(); i++) {
+		auto partition = hash_data[hdata.sel->get_index(i)] % partition_count;
+		lstate.partition_sel[partition].set_index(lstate.partition_counts[partition]++, i);
+	}
+	for (idx_t partition = 0; partition < partition_count; partition++) {
+		if (lstate.partition_counts[partition] == 0) {
+			continue;
+		}
+		lstate.slice.Slice(input, lstate.partition_sel[partition], lstate.partition_counts[partition]);
+		lstate.partitions[partition]->Append(lstate.slice);
+	}
+}
+
+void PhysicalWindow::Combine(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate_) {
+	auto &gstate = (WindowGlobalState &)state;
+	auto &lstate = (WindowLocalSinkState &)lstate_;
+	lock_guard<mutex> glock(gstate.lock);
+	for (idx_t partition = 0; partition < gstate.partition_count; partition++) {
+		if (lstate.partitions[partition]->count > 0) {
+			gstate.local_partitions[partition].push_back(move(lstate.partitions[partition]));
+		}
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Finalize
+//===--------------------------------------------------------------------===//
+//! Sorts the rows of a hash partition and computes all window expressions over them
+static void ComputeWindowPartition(PhysicalWindow &op, WindowGlobalState &gstate, idx_t partition) {
+	auto &local_partitions = gstate.local_partitions[partition];
+	D_ASSERT(!local_partitions.empty());
+	gstate.partitions[partition] = move(local_partitions[0]);
+	for (idx_t i = 1; i < local_partitions.size(); i++) {
+		gstate.partitions[partition]->Append(*local_partitions[i]);
+	}
+	local_partitions.clear();
+
+	auto &big_data = *gstate.partitions[partition];
+	auto &window_results = *gstate.window_results[partition];
 
-			window_chunk.Verify();
-			window_results.Append(window_chunk);
+	vector<LogicalType> window_types;
+	for (idx_t expr_idx = 0; expr_idx < op.select_list.size(); expr_idx++) {
+		window_types.push_back(op.select_list[expr_idx]->return_type);
+	}
+
+	for (idx_t i = 0; i < big_data.chunks.size(); i++) {
+		DataChunk window_chunk;
+		window_chunk.Initialize(window_types);
+		window_chunk.SetCardinality(big_data.chunks[i]->size());
+		for (idx_t col_idx = 0; col_idx < window_chunk.column_count(); col_idx++) {
+			window_chunk.data[col_idx].vector_type = VectorType::CONSTANT_VECTOR;
+			ConstantVector::SetNull(window_chunk.data[col_idx], true);
 		}
 
-		D_ASSERT(window_results.column_count() == select_list.size());
-		idx_t window_output_idx = 0;
-		// we can have multiple window functions
-		for (idx_t expr_idx = 0; expr_idx < select_list.size(); expr_idx++) {
-			D_ASSERT(select_list[expr_idx]->GetExpressionClass() == ExpressionClass::BOUND_WINDOW);
-			// sort by partition and order clause in window def
-			auto wexpr = reinterpret_cast<BoundWindowExpression *>(select_list[expr_idx].get());
-			ComputeWindowExpression(wexpr, big_data, window_results, window_output_idx++);
+		window_chunk.Verify();
+		window_results.Append(window_chunk);
+	}
+
+	D_ASSERT(window_results.column_count() == op.select_list.size());
+	idx_t window_output_idx = 0;
+	// we can have multiple window functions
+	for (idx_t expr_idx = 0; expr_idx < op.select_list.size(); expr_idx++) {
+		D_ASSERT(op.select_list[expr_idx]->GetExpressionClass() == ExpressionClass::BOUND_WINDOW);
+		// sort by partition and order clause in window def
+		auto wexpr = reinterpret_cast<BoundWindowExpression *>(op.select_list[expr_idx].get());
+		ComputeWindowExpression(wexpr, big_data, window_results, window_output_idx++);
+	}
+}
+
+class PhysicalWindowPartitionTask : public Task {
+public:
+	PhysicalWindowPartitionTask(Pipeline &parent_, PhysicalWindow &op_, WindowGlobalState &state_, idx_t partition_)
+	    : parent(parent_), op(op_), state(state_), partition(partition_) {
+	}
+
+	void Execute() override {
+		try {
+			ComputeWindowPartition(op, state, partition);
+		} catch (std::exception &ex) {
+			parent.executor.PushError(ex.what());
+		} catch (...) {
+			parent.executor.PushError("Unknown exception in window computation!");
+		}
+		lock_guard<mutex> glock(state.lock);
+		parent.finished_tasks++;
+		if (parent.total_tasks == parent.finished_tasks) {
+			parent.Finish();
 		}
 	}
 
-	if (state->position >= big_data.count) {
+private:
+	Pipeline &parent;
+	PhysicalWindow &op;
+	WindowGlobalState &state;
+	idx_t partition;
+};
+
+void PhysicalWindow::Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> state) {
+	this->sink_state = move(state);
+	auto &gstate = (WindowGlobalState &)*this->sink_state;
+	vector<idx_t> partitions;
+	for (idx_t partition = 0; partition < gstate.partition_count; partition++) {
+		if (!gstate.local_partitions[partition].empty()) {
+			partitions.push_back(partition);
+		}
+	}
+	if (partitions.size() <= 1) {
+		for (auto partition : partitions) {
+			ComputeWindowPartition(*this, gstate, partition);
+		}
 		return;
 	}
+	// sort and compute every hash partition in a separate task
+	pipeline.total_tasks += partitions.size();
+	for (auto partition : partitions) {
+		auto new_task = make_unique<PhysicalWindowPartitionTask>(pipeline, *this, gstate, partition);
+		TaskScheduler::GetScheduler(context).ScheduleTask(pipeline.token, move(new_task));
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// GetChunkInternal
+//===--------------------------------------------------------------------===//
+class PhysicalWindowParallelState : public ParallelState {
+public:
+	PhysicalWindowParallelState() : partition_idx(0), chunk_idx(0) {
+	}
+
+	mutex lock;
+	//! The hash partition and the chunk within the hash partition that are handed out next
+	idx_t partition_idx;
+	idx_t chunk_idx;
+};
+
+//! Assigns the next range of chunks of the result to a thread, returns false if all chunks have been assigned
+static bool AssignNextChunks(WindowGlobalState &gstate, PhysicalWindowParallelState &pstate,
+                             PhysicalWindowOperatorState &state, idx_t chunk_count) {
+	lock_guard<mutex> plock(pstate.lock);
+	while (pstate.partition_idx < gstate.partition_count) {
+		auto partition_chunks = gstate.partitions[pstate.partition_idx]->chunks.size();
+		if (pstate.chunk_idx < partition_chunks) {
+			state.partition_idx = pstate.partition_idx;
+			state.chunk_idx = pstate.chunk_idx;
+			state.chunk_end = MinValue<idx_t>(pstate.chunk_idx + chunk_count, partition_chunks);
+			pstate.chunk_idx = state.chunk_end;
+			return true;
+		}
+		pstate.partition_idx++;
+		pstate.chunk_idx = 0;
+	}
+	return false;
+}
+
+void PhysicalWindow::GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
+	auto state = reinterpret_cast<PhysicalWindowOperatorState *>(state_);
+	auto &gstate = (WindowGlobalState &)*this->sink_state;
+	if (!state->initialized) {
+		state->parallel_state = FindParallelState(context);
+		state->initialized = true;
+	}
+	// the results are returned hash partition by hash partition
+	if (state->parallel_state) {
+		if (state->chunk_idx >= state->chunk_end &&
+		    !AssignNextChunks(gstate, (PhysicalWindowParallelState &)*state->parallel_state, *state,
+		                      ParallelScanVectorCount(context.client))) {
+			state->finished = true;
+			return;
+		}
+	} else {
+		while (state->partition_idx < gstate.partition_count &&
+		       state->chunk_idx >= gstate.partitions[state->partition_idx]->chunks.size()) {
+			state->partition_idx++;
+			state->chunk_idx = 0;
+		}
+		if (state->partition_idx >= gstate.partition_count) {
+			state->finished = true;
+			return;
+		}
+	}
 
-	// just return what was computed before, appending the result cols of the window expressions at the end
-	auto &proj_ch = big_data.GetChunk(state->position);
-	auto &wind_ch = window_results.GetChunk(state->position);
+	// return what was computed before, appending the result cols of the window expressions at the end
+	auto &proj_ch = *gstate.partitions[state->partition_idx]->chunks[state->chunk_idx];
+	auto &wind_ch = *gstate.window_results[state->partition_idx]->chunks[state->chunk_idx];
+	state->chunk_idx++;
 
 	idx_t out_idx = 0;
 	D_ASSERT(proj_ch.size() == wind_ch.size());
@@ -530,11 +863,23 @@ void PhysicalWindow::GetChunkInternal(ExecutionContext &context, DataChunk &chun
 	for (idx_t col_idx = 0; col_idx < wind_ch.column_count(); col_idx++) {
 		chunk.data[out_idx++].Reference(wind_ch.data[col_idx]);
 	}
-	state->position += STANDARD_VECTOR_SIZE;
 }
 
 unique_ptr<PhysicalOperatorState> PhysicalWindow::GetOperatorState() {
 	return make_unique<PhysicalWindowOperatorState>(*this, children[0].get());
 }
 
+idx_t PhysicalWindow::MaxThreads(ClientContext &context) {
+	auto &gstate = (WindowGlobalState &)*this->sink_state;
+	idx_t chunk_count = 0;
+	for (auto &partition : gstate.partitions) {
+		chunk_count += partition->chunks.size();
+	}
+	return chunk_count / ParallelScanVectorCount(context) + 1;
+}
+
+unique_ptr<ParallelState> PhysicalWindow::GetParallelState() {
+	return make_unique<PhysicalWindowParallelState>();
+}
+
 } // namespace duckdb
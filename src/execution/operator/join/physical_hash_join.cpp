@@ -2,9 +2,14 @@
 
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/execution/buffered_chunk_collection.hpp"
+#include "duckdb/execution/executor.hpp"
 #include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/execution/partitionable_hashtable.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
 #include "duckdb/function/aggregate/distributive_functions.hpp"
+#include "duckdb/parallel/pipeline.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 
 using namespace std;
 
@@ -42,6 +47,8 @@ public:
 	DataChunk build_chunk;
 	DataChunk join_keys;
 	ExpressionExecutor build_executor;
+	//! The thread-local HT, which is merged into the global HT in Combine
+	unique_ptr<JoinHashTable> hash_table;
 };
 
 class HashJoinGlobalState : public GlobalOperatorState {
@@ -53,6 +60,20 @@ public:
 	unique_ptr<JoinHashTable> hash_table;
 	//! Only used for FULL OUTER JOIN: scan state of the final scan to find unmatched tuples in the build-side
 	JoinHTScanState ht_scan_state;
+	//! Whether the HT is probed by multiple threads: the unmatched tuples of a FULL OUTER join are then scanned, and the
+	//! partitions other than the first one are joined, by separate tasks after all threads have finished probing
+	bool parallel_probe = false;
+
+	//! Only used for joins whose build side does not fit in memory: the radix partitioning of the build side
+	unique_ptr<RadixPartitionInfo> partition_info;
+	//! The partitions of the build side. The probe side is partitioned in the same way, after which every partition of
+	//! the probe side is joined with its matching partition of the build side
+	vector<unique_ptr<JoinHashTable>> partitions;
+	//! Only used for partitioned joins that are probed by multiple threads: the probe-side input of every partition,
+	//! one collection for every thread that read the probe side
+	vector<vector<unique_ptr<BufferedChunkCollection>>> probe_partitions;
+	//! Lock for the tasks that partition the build side
+	mutex lock;
 };
 
 unique_ptr<GlobalOperatorState> PhysicalHashJoin::GetGlobalState(ClientContext &context) {
@@ -104,13 +125,23 @@ unique_ptr<LocalSinkState> PhysicalHashJoin::GetLocalSinkState(ExecutionContext
 		state->build_executor.AddExpression(*cond.right);
 	}
 	state->join_keys.Initialize(condition_types);
+	if (!IsCorrelatedMarkJoin()) {
+		// the correlated MARK join keeps track of the group counts in the global HT: it is built directly
+		state->hash_table = make_unique<JoinHashTable>(BufferManager::GetBufferManager(context.client), conditions,
+		                                               build_types, join_type);
+	}
 	return move(state);
 }
 
+bool PhysicalHashJoin::IsCorrelatedMarkJoin() {
+	return join_type == JoinType::MARK && delim_types.size() > 0 && delim_types.size() + 1 == conditions.size();
+}
+
 void PhysicalHashJoin::Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate_,
                             DataChunk &input) {
 	auto &sink = (HashJoinGlobalState &)state;
 	auto &lstate = (HashJoinLocalState &)lstate_;
+	auto &hash_table = lstate.hash_table ? *lstate.hash_table : *sink.hash_table;
 	// resolve the join keys for the right chunk
 	lstate.build_executor.Execute(input, lstate.join_keys);
 	// build the HT
@@ -121,21 +152,176 @@ void PhysicalHashJoin::Sink(ExecutionContext &context, GlobalOperatorState &stat
 		for (idx_t i = 0; i < right_projection_map.size(); i++) {
 			lstate.build_chunk.data[i].Reference(input.data[right_projection_map[i]]);
 		}
-		sink.hash_table->Build(lstate.join_keys, lstate.build_chunk);
+		hash_table.Build(lstate.join_keys, lstate.build_chunk);
 	} else {
 		// there is not a projected map: place the entire right chunk in the HT
-		sink.hash_table->Build(lstate.join_keys, input);
+		hash_table.Build(lstate.join_keys, input);
+	}
+}
+
+void PhysicalHashJoin::Combine(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate_) {
+	auto &sink = (HashJoinGlobalState &)state;
+	auto &lstate = (HashJoinLocalState &)lstate_;
+	if (lstate.hash_table) {
+		sink.hash_table->Merge(*lstate.hash_table);
 	}
 }
 
 //===--------------------------------------------------------------------===//
 // Finalize
 //===--------------------------------------------------------------------===//
+static void PartitionBuildSide(HashJoinGlobalState &sink, idx_t block_start, idx_t block_end) {
+	vector<JoinHashTable *> partition_hts;
+	for (auto &partition : sink.partitions) {
+		partition_hts.push_back(partition.get());
+	}
+	sink.hash_table->Partition(partition_hts, sink.partition_info->radix_mask, sink.partition_info->RADIX_SHIFT,
+	                           block_start, block_end);
+}
+
+//! Either radix-partitions the blocks [block_start, block_end) of the build side, or inserts them into the pointer
+//! table of the HT
+static void FinalizeBlocks(HashJoinGlobalState &sink, idx_t block_start, idx_t block_end, bool parallel) {
+	if (sink.partition_info) {
+		PartitionBuildSide(sink, block_start, block_end);
+	} else {
+		sink.hash_table->Finalize(block_start, block_end, parallel);
+	}
+}
+
+//! Called after all blocks of the build side have been finalized
+static void FinishFinalize(HashJoinGlobalState &sink) {
+	if (sink.partition_info) {
+		// the partitions hold copies of the strings of the build side
+		sink.hash_table->string_heap.Destroy();
+	}
+}
+
+class HashJoinFinalizeTask : public Task {
+public:
+	HashJoinFinalizeTask(Pipeline &parent_, HashJoinGlobalState &sink_, idx_t block_start_, idx_t block_end_)
+	    : parent(parent_), sink(sink_), block_start(block_start_), block_end(block_end_) {
+	}
+
+	void Execute() override {
+		try {
+			FinalizeBlocks(sink, block_start, block_end, true);
+		} catch (std::exception &ex) {
+			parent.executor.PushError(ex.what());
+		} catch (...) {
+			parent.executor.PushError("Unknown exception in hash join finalize!");
+		}
+		lock_guard<mutex> glock(sink.lock);
+		parent.finished_tasks++;
+		if (parent.total_tasks == parent.finished_tasks) {
+			FinishFinalize(sink);
+			parent.Finish();
+		}
+	}
+
+private:
+	Pipeline &parent;
+	HashJoinGlobalState &sink;
+	idx_t block_start;
+	idx_t block_end;
+};
+
 void PhysicalHashJoin::Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> state) {
 	auto &sink = (HashJoinGlobalState &)*state;
-	sink.hash_table->Finalize();
-
+	auto &ht = *sink.hash_table;
+	auto &buffer_manager = BufferManager::GetBufferManager(context);
+	// the finalized HT has to stay pinned while it is probed: it can use at most half of the available memory
+	idx_t memory_budget = buffer_manager.GetMaxMemory() / 2;
+	if (ht.SizeInBytes() <= memory_budget || !buffer_manager.HasTemporaryDirectory() || IsCorrelatedMarkJoin()) {
+		// the HT fits in memory: fill the pointer table
+		ht.InitializePointerTable();
+	} else {
+		// the HT does not fit in memory: radix-partition the build side. The partitions are joined in parallel, so
+		// every thread can have a partition pinned: the partitions of all threads have to fit in half the budget
+		idx_t n_threads = TaskScheduler::GetScheduler(context).NumberOfThreads();
+		idx_t partition_budget = MaxValue<idx_t>(memory_budget / (2 * n_threads), 1);
+		idx_t required_partitions = (ht.SizeInBytes() + partition_budget - 1) / partition_budget;
+		sink.partition_info = make_unique<RadixPartitionInfo>(NextPowerOfTwo(required_partitions));
+		for (idx_t i = 0; i < sink.partition_info->n_partitions; i++) {
+			auto partition = make_unique<JoinHashTable>(buffer_manager, conditions, build_types, join_type);
+			partition->has_null = ht.has_null;
+			sink.partitions.push_back(move(partition));
+		}
+	}
 	PhysicalSink::Finalize(pipeline, context, move(state));
+
+	// process ranges of blocks in parallel
+	idx_t block_count = ht.BlockCount();
+	idx_t n_tasks = TaskScheduler::GetScheduler(context).NumberOfThreads();
+	n_tasks = MinValue<idx_t>(n_tasks, block_count / MINIMUM_BLOCKS_PER_TASK);
+	if (n_tasks <= 1) {
+		FinalizeBlocks(sink, 0, block_count, false);
+		FinishFinalize(sink);
+		return;
+	}
+	pipeline.total_tasks += n_tasks;
+	for (idx_t task_idx = 0; task_idx < n_tasks; task_idx++) {
+		idx_t block_start = task_idx * block_count / n_tasks;
+		idx_t block_end = (task_idx + 1) * block_count / n_tasks;
+		auto new_task = make_unique<HashJoinFinalizeTask>(pipeline, sink, block_start, block_end);
+		TaskScheduler::GetScheduler(context).ScheduleTask(pipeline.token, move(new_task));
+	}
+}
+
+bool PhysicalHashJoin::IsPartitioned() {
+	return sink_state && ((HashJoinGlobalState &)*sink_state).partition_info;
+}
+
+bool PhysicalHashJoin::HasDeferredProbe() {
+	return join_type == JoinType::OUTER || IsPartitioned();
+}
+
+//! The state of a task that finishes the probe of the join after all threads have read the probe side
+class HashJoinDeferredTaskState : public ParallelState {
+public:
+	//! Only used for partitioned joins: the partition that is joined by the task
+	idx_t partition = 0;
+	//! The collection and chunk of the probe-side input of the partition that is read next
+	idx_t collection_idx = 0;
+	idx_t chunk_idx = 0;
+	//! The scan state of the unmatched build-side tuples
+	JoinHTScanState scan_state;
+};
+
+void PhysicalHashJoin::InitializeParallelProbe(ClientContext &context) {
+	auto &sink = (HashJoinGlobalState &)*sink_state;
+	sink.parallel_probe = true;
+	if (sink.partition_info) {
+		// the first partition is probed by all threads while they read and partition the probe side
+		sink.partitions[0]->Finalize();
+		sink.probe_partitions.resize(sink.partitions.size());
+	}
+}
+
+vector<unique_ptr<ParallelState>> PhysicalHashJoin::GetDeferredProbeTasks(ClientContext &context) {
+	auto &sink = (HashJoinGlobalState &)*sink_state;
+	vector<unique_ptr<ParallelState>> task_states;
+	if (!sink.partition_info) {
+		if (join_type == JoinType::OUTER && sink.hash_table->size() > 0) {
+			// all probes have marked their matches: scan the unmatched tuples of the build side
+			task_states.push_back(make_unique<HashJoinDeferredTaskState>());
+		}
+		return task_states;
+	}
+	// every partition is joined by its own task; the first partition has already been probed, so its task only scans
+	// the unmatched tuples of a FULL OUTER join
+	for (idx_t partition = 0; partition < sink.partitions.size(); partition++) {
+		bool has_build = join_type == JoinType::OUTER && sink.partitions[partition]->size() > 0;
+		if (!has_build && sink.probe_partitions[partition].empty()) {
+			// nothing to join
+			sink.partitions[partition].reset();
+			continue;
+		}
+		auto task_state = make_unique<HashJoinDeferredTaskState>();
+		task_state->partition = partition;
+		task_states.push_back(move(task_state));
+	}
+	return task_states;
 }
 
 //===--------------------------------------------------------------------===//
@@ -152,6 +338,23 @@ public:
 	DataChunk join_keys;
 	ExpressionExecutor probe_executor;
 	unique_ptr<JoinHashTable::ScanStructure> scan_structure;
+
+	//! Only used for partitioned joins: the partition that is currently being joined
+	idx_t probe_partition = 0;
+	//! The probe-side input of the partitions that are joined after the probe side has been read entirely
+	vector<unique_ptr<BufferedChunkCollection>> probe_partitions;
+	//! Collects the probe-side rows of every partition until a full chunk can be appended to its probe partition
+	vector<unique_ptr<DataChunk>> partition_buffers;
+	//! The selection vectors used to split the probe-side input into partitions
+	vector<SelectionVector> sel_vectors;
+	vector<idx_t> sel_vector_sizes;
+	//! The index of the next chunk to read from the probe partition
+	idx_t partition_chunk_idx = 0;
+	//! The probe-side chunk and join keys that are currently being probed
+	DataChunk partition_chunk;
+	DataChunk partition_keys;
+	//! Only used for FULL OUTER JOIN: scan state to find the unmatched tuples in the build-side of the partition
+	JoinHTScanState partition_scan_state;
 };
 
 unique_ptr<PhysicalOperatorState> PhysicalHashJoin::GetOperatorState() {
@@ -161,12 +364,25 @@ unique_ptr<PhysicalOperatorState> PhysicalHashJoin::GetOperatorState() {
 	for (auto &cond : conditions) {
 		state->probe_executor.AddExpression(*cond.left);
 	}
+	auto probe_types = children[0]->GetTypes();
+	state->partition_chunk.InitializeEmpty(probe_types);
+	state->partition_keys.Initialize(condition_types);
 	return move(state);
 }
 
 void PhysicalHashJoin::GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
 	auto state = reinterpret_cast<PhysicalHashJoinState *>(state_);
 	auto &sink = (HashJoinGlobalState &)*sink_state;
+	auto task_state = (HashJoinDeferredTaskState *)FindParallelState(context);
+	if (task_state) {
+		// a deferred task of the pipeline: the probe side has been read entirely by the other tasks
+		if (sink.partition_info) {
+			ProbeDeferredPartition(context, chunk, state, *task_state);
+		} else {
+			sink.hash_table->ScanFullOuter(chunk, task_state->scan_state);
+		}
+		return;
+	}
 	if (sink.hash_table->size() == 0 &&
 	    (sink.hash_table->join_type == JoinType::INNER || sink.hash_table->join_type == JoinType::SEMI)) {
 		// empty hash table with INNER or SEMI join means empty result set
@@ -182,7 +398,7 @@ void PhysicalHashJoin::GetChunkInternal(ExecutionContext &context, DataChunk &ch
 				state->cached_chunk.Reset();
 			} else
 #endif
-			    if (join_type == JoinType::OUTER) {
+			    if (join_type == JoinType::OUTER && !sink.partition_info && !sink.parallel_probe) {
 				// check if we need to scan any unmatched tuples from the RHS for the full outer join
 				sink.hash_table->ScanFullOuter(chunk, sink.ht_scan_state);
 			}
@@ -214,6 +430,10 @@ void PhysicalHashJoin::GetChunkInternal(ExecutionContext &context, DataChunk &ch
 void PhysicalHashJoin::ProbeHashTable(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
 	auto state = reinterpret_cast<PhysicalHashJoinState *>(state_);
 	auto &sink = (HashJoinGlobalState &)*sink_state;
+	if (sink.partition_info) {
+		ProbePartitions(context, chunk, state);
+		return;
+	}
 
 	if (state->child_chunk.size() > 0 && state->scan_structure) {
 		// still have elements remaining from the previous probe (i.e. we got
@@ -245,4 +465,233 @@ void PhysicalHashJoin::ProbeHashTable(ExecutionContext &context, DataChunk &chun
 	} while (chunk.size() == 0);
 }
 
+static void FlushPartitionBuffer(PhysicalHashJoinState &state, idx_t partition) {
+	auto &buffer = state.partition_buffers[partition];
+	if (buffer && buffer->size() > 0) {
+		state.probe_partitions[partition]->Append(*buffer);
+		buffer->Reset();
+	}
+}
+
+bool PhysicalHashJoin::NextPartitionChunk(ExecutionContext &context, PhysicalOperatorState *state_) {
+	auto state = reinterpret_cast<PhysicalHashJoinState *>(state_);
+	auto &sink = (HashJoinGlobalState &)*sink_state;
+	auto &partition_info = *sink.partition_info;
+	if (state->probe_partition > 0) {
+		// the input of the other partitions is read back from the probe partitions
+		auto &probe_partition = state->probe_partitions[state->probe_partition];
+		if (!probe_partition || state->partition_chunk_idx >= probe_partition->ChunkCount()) {
+			probe_partition.reset();
+			state->partition_chunk_idx = 0;
+			return false;
+		}
+		probe_partition->GetChunk(state->partition_chunk_idx++, state->partition_chunk);
+		state->partition_keys.Reset();
+		state->probe_executor.Execute(state->partition_chunk, state->partition_keys);
+		return true;
+	}
+	// the first partition is probed directly while the probe side is read and partitioned
+	if (state->probe_partitions.empty()) {
+		state->probe_partitions.resize(partition_info.n_partitions);
+		state->partition_buffers.resize(partition_info.n_partitions);
+		state->sel_vectors.resize(partition_info.n_partitions);
+		state->sel_vector_sizes.resize(partition_info.n_partitions);
+		for (auto &sel_vector : state->sel_vectors) {
+			sel_vector.Initialize();
+		}
+	}
+	auto &sel_vectors = state->sel_vectors;
+	auto &sel_vector_sizes = state->sel_vector_sizes;
+	Vector hashes(LogicalType::HASH);
+	auto probe_types = state->child_chunk.GetTypes();
+	DataChunk slice;
+	slice.InitializeEmpty(probe_types);
+	while (true) {
+		children[0]->GetChunk(context, state->child_chunk, state->child_state.get());
+		if (state->child_chunk.size() == 0) {
+			// the probe side has been read entirely: write the remaining buffered input to the probe partitions
+			for (idx_t partition = 1; partition < partition_info.n_partitions; partition++) {
+				FlushPartitionBuffer(*state, partition);
+			}
+			if (sink.parallel_probe) {
+				// hand the probe partitions over to the tasks that join the other partitions
+				lock_guard<mutex> glock(sink.lock);
+				for (idx_t partition = 1; partition < partition_info.n_partitions; partition++) {
+					if (state->probe_partitions[partition]) {
+						sink.probe_partitions[partition].push_back(move(state->probe_partitions[partition]));
+					}
+				}
+			}
+			return false;
+		}
+		state->probe_executor.Execute(state->child_chunk, state->join_keys);
+		// rows with NULL keys are hashed as well: they will not find a match in any of the partitions
+		sink.hash_table->Hash(state->join_keys, FlatVector::IncrementalSelectionVector, state->join_keys.size(),
+		                      hashes);
+		hashes.Normalify(state->join_keys.size());
+		auto hash_data = FlatVector::GetData<hash_t>(hashes);
+		for (idx_t partition = 0; partition < partition_info.n_partitions; partition++) {
+			sel_vector_sizes[partition] = 0;
+		}
+		for (idx_t i = 0; i < state->child_chunk.size(); i++) {
+			idx_t partition = (hash_data[i] & partition_info.radix_mask) >> partition_info.RADIX_SHIFT;
+			sel_vectors[partition].set_index(sel_vector_sizes[partition]++, i);
+		}
+		for (idx_t partition = 1; partition < partition_info.n_partitions; partition++) {
+			auto count = sel_vector_sizes[partition];
+			if (count == 0) {
+				continue;
+			}
+			auto &buffer = state->partition_buffers[partition];
+			if (!buffer) {
+				buffer = make_unique<DataChunk>();
+				buffer->Initialize(probe_types);
+				state->probe_partitions[partition] =
+				    make_unique<BufferedChunkCollection>(BufferManager::GetBufferManager(context.client), probe_types);
+			}
+			if (buffer->size() + count > STANDARD_VECTOR_SIZE) {
+				FlushPartitionBuffer(*state, partition);
+			}
+			slice.Slice(state->child_chunk, sel_vectors[partition], count);
+			buffer->Append(slice);
+		}
+		if (sel_vector_sizes[0] > 0) {
+			state->partition_chunk.Slice(state->child_chunk, sel_vectors[0], sel_vector_sizes[0]);
+			state->partition_keys.Slice(state->join_keys, sel_vectors[0], sel_vector_sizes[0]);
+			return true;
+		}
+	}
+}
+
+//! Constructs the result of probing an empty partition. Unlike an empty HT, the build side as a whole is not empty:
+//! the MARK of a probe-side row with a NULL key is NULL instead of false
+static void ConstructEmptyPartitionResult(JoinType join_type, bool has_null, DataChunk &keys, DataChunk &input,
+                                          DataChunk &result) {
+	PhysicalComparisonJoin::ConstructEmptyJoinResult(join_type, has_null, input, result);
+	if (join_type != JoinType::MARK || has_null) {
+		return;
+	}
+	auto &nullmask = FlatVector::Nullmask(result.data.back());
+	for (idx_t col_idx = 0; col_idx < keys.column_count(); col_idx++) {
+		VectorData kdata;
+		keys.data[col_idx].Orrify(keys.size(), kdata);
+		if (!kdata.nullmask->any()) {
+			continue;
+		}
+		for (idx_t i = 0; i < keys.size(); i++) {
+			if ((*kdata.nullmask)[kdata.sel->get_index(i)]) {
+				nullmask[i] = true;
+			}
+		}
+	}
+}
+
+void PhysicalHashJoin::ProbePartitions(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
+	auto state = reinterpret_cast<PhysicalHashJoinState *>(state_);
+	auto &sink = (HashJoinGlobalState &)*sink_state;
+	while (true) {
+		if (state->scan_structure) {
+			// still have elements remaining from the previous probe
+			state->scan_structure->Next(state->partition_keys, state->partition_chunk, chunk);
+			if (chunk.size() > 0) {
+				return;
+			}
+			state->scan_structure = nullptr;
+		}
+		if (state->probe_partition >= sink.partitions.size()) {
+			// all partitions have been joined
+			return;
+		}
+		auto &ht = *sink.partitions[state->probe_partition];
+		if (!ht.finalized) {
+			// pin the build side of the partition and construct its pointer table
+			ht.Finalize();
+		}
+		if (!NextPartitionChunk(context, state)) {
+			// the probe side of the partition is exhausted
+			if (sink.parallel_probe) {
+				// other threads can still be probing the first partition: the deferred tasks of the pipeline finish the
+				// first partition and join the other partitions
+				return;
+			}
+			if (join_type == JoinType::OUTER) {
+				// scan the unmatched tuples of the build side of the partition
+				ht.ScanFullOuter(chunk, state->partition_scan_state);
+				if (chunk.size() > 0) {
+					return;
+				}
+			}
+			// the partition has been joined: free it and move on to the next partition
+			sink.partitions[state->probe_partition].reset();
+			state->probe_partition++;
+			state->partition_scan_state = JoinHTScanState();
+			continue;
+		}
+		if (ht.size() == 0) {
+			ConstructEmptyPartitionResult(join_type, ht.has_null, state->partition_keys, state->partition_chunk, chunk);
+			if (chunk.size() > 0) {
+				return;
+			}
+			continue;
+		}
+		state->scan_structure = ht.Probe(state->partition_keys);
+	}
+}
+
+void PhysicalHashJoin::ProbeDeferredPartition(ExecutionContext &context, DataChunk &chunk,
+                                              PhysicalOperatorState *state_, HashJoinDeferredTaskState &task_state) {
+	auto state = reinterpret_cast<PhysicalHashJoinState *>(state_);
+	auto &sink = (HashJoinGlobalState &)*sink_state;
+	auto partition = task_state.partition;
+	while (sink.partitions[partition]) {
+		auto &ht = *sink.partitions[partition];
+		if (state->scan_structure) {
+			// still have elements remaining from the previous probe
+			state->scan_structure->Next(state->partition_keys, state->partition_chunk, chunk);
+			if (chunk.size() > 0) {
+				return;
+			}
+			state->scan_structure = nullptr;
+		}
+		if (!ht.finalized) {
+			// pin the build side of the partition and construct its pointer table
+			ht.Finalize();
+		}
+		auto &probe_partition = sink.probe_partitions[partition];
+		if (task_state.collection_idx < probe_partition.size()) {
+			// fetch the next probe-side chunk of the partition
+			auto &collection = probe_partition[task_state.collection_idx];
+			if (task_state.chunk_idx >= collection->ChunkCount()) {
+				collection.reset();
+				task_state.collection_idx++;
+				task_state.chunk_idx = 0;
+				continue;
+			}
+			collection->GetChunk(task_state.chunk_idx++, state->partition_chunk);
+			state->partition_keys.Reset();
+			state->probe_executor.Execute(state->partition_chunk, state->partition_keys);
+			if (ht.size() == 0) {
+				ConstructEmptyPartitionResult(join_type, ht.has_null, state->partition_keys, state->partition_chunk,
+				                              chunk);
+				if (chunk.size() > 0) {
+					return;
+				}
+				continue;
+			}
+			state->scan_structure = ht.Probe(state->partition_keys);
+			continue;
+		}
+		// the probe side of the partition is exhausted
+		if (join_type == JoinType::OUTER) {
+			// scan the unmatched tuples of the build side of the partition
+			ht.ScanFullOuter(chunk, task_state.scan_state);
+			if (chunk.size() > 0) {
+				return;
+			}
+		}
+		// the partition has been joined: free it
+		sink.partitions[partition].reset();
+	}
+}
+
 } // namespace duckdb
@@ -9,7 +9,7 @@
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/transaction/transaction.hpp"
 
-#include <iostream>
+#include <algorithm>
 #include <utility>
 
 using namespace std;
@@ -22,7 +22,6 @@ public:
 	    : PhysicalOperatorState(op, left) {
 		D_ASSERT(left && right);
 		for (idx_t i = 0; i < STANDARD_VECTOR_SIZE; i++) {
-			rhs_rows.emplace_back();
 			result_sizes.emplace_back();
 		}
 	}
@@ -32,8 +31,13 @@ public:
 	idx_t result_size = 0;
 	vector<idx_t> result_sizes;
 	DataChunk join_keys;
-	//! Vector of rows that mush be fetched for every LHS key
-	vector<vector<row_t>> rhs_rows;
+	//! The leaves of the index that match the LHS keys
+	Leaf *leaves[STANDARD_VECTOR_SIZE];
+	//! The (RHS row id, LHS row) pairs of the matches of the LHS chunk, sorted by row id so the rows are fetched
+	//! segment by segment
+	vector<pair<row_t, idx_t>> matches;
+	//! The next match to output
+	idx_t match_idx = 0;
 	ExpressionExecutor probe_executor;
 	IndexLock lock;
 };
@@ -76,18 +80,29 @@ void PhysicalIndexJoin::Output(ExecutionContext &context, DataChunk &chunk, Phys
 	size_t output_sel_idx{};
 	vector<row_t> fetch_rows;
 	auto state = reinterpret_cast<PhysicalIndexJoinOperatorState *>(state_);
-	while (output_sel_idx < STANDARD_VECTOR_SIZE && state->lhs_idx < state->child_chunk.size()) {
-		if (state->rhs_idx < state->result_sizes[state->lhs_idx]) {
-			sel.set_index(output_sel_idx++, state->lhs_idx);
-			if (!fetch_types.empty()) {
-				//! We need to collect the rows we want to fetch
-				fetch_rows.push_back(state->rhs_rows[state->lhs_idx][state->rhs_idx]);
+	if (fetch_types.empty()) {
+		while (output_sel_idx < STANDARD_VECTOR_SIZE && state->lhs_idx < state->child_chunk.size()) {
+			if (state->rhs_idx < state->result_sizes[state->lhs_idx]) {
+				sel.set_index(output_sel_idx++, state->lhs_idx);
+				state->rhs_idx++;
+			} else {
+				//! We are done with the matches from this LHS Key
+				state->rhs_idx = 0;
+				state->lhs_idx++;
 			}
-			state->rhs_idx++;
-		} else {
-			//! We are done with the matches from this LHS Key
-			state->rhs_idx = 0;
-			state->lhs_idx++;
+		}
+	} else {
+		//! Collect the rows we want to fetch, in the order of their row ids
+		while (output_sel_idx < STANDARD_VECTOR_SIZE && state->match_idx < state->matches.size()) {
+			auto &match = state->matches[state->match_idx++];
+			sel.set_index(output_sel_idx++, match.second);
+			fetch_rows.push_back(match.first);
+		}
+		//! Track the output matches in rhs_idx as well, so the matches are not looked up again for this LHS chunk
+		state->rhs_idx = state->match_idx;
+		if (state->match_idx >= state->matches.size()) {
+			//! We are done with the matches of this LHS chunk
+			state->lhs_idx = state->child_chunk.size();
 		}
 	}
 	//! Now we fetch the RHS data
@@ -127,28 +142,25 @@ void PhysicalIndexJoin::Output(ExecutionContext &context, DataChunk &chunk, Phys
 void PhysicalIndexJoin::GetRHSMatches(ExecutionContext &context, PhysicalOperatorState *state_) const {
 	auto state = reinterpret_cast<PhysicalIndexJoinOperatorState *>(state_);
 	auto &art = (ART &)*index;
-	auto &transaction = Transaction::GetTransaction(context.client);
+	//! Look up all keys of the LHS chunk at once
+	art.SearchEqualBatch(state->join_keys, state->leaves);
+	state->matches.clear();
+	state->match_idx = 0;
 	for (idx_t i = 0; i < state->child_chunk.size(); i++) {
-		auto equal_value = state->join_keys.GetValue(0, i);
-		auto index_state = art.InitializeScanSinglePredicate(transaction, equal_value, ExpressionType::COMPARE_EQUAL);
-		state->rhs_rows[i].clear();
-		if (!equal_value.is_null) {
-			if (fetch_types.empty()) {
-				//! Nothing to materialize
-				art.SearchEqualJoinNoFetch(equal_value, state->result_sizes[i]);
-			} else {
-				art.SearchEqual((ARTIndexScanState *)index_state.get(), (size_t)-1, state->rhs_rows[i]);
-				state->result_sizes[i] = state->rhs_rows[i].size();
+		auto leaf = state->leaves[i];
+		state->result_sizes[i] = leaf ? leaf->num_elements : 0;
+		if (leaf && !fetch_types.empty()) {
+			for (idx_t k = 0; k < leaf->num_elements; k++) {
+				state->matches.push_back(make_pair(leaf->GetRowId(k), i));
 			}
-		} else {
-			//! This is null so no matches
-			state->result_sizes[i] = 0;
 		}
 	}
 	for (idx_t i = state->child_chunk.size(); i < STANDARD_VECTOR_SIZE; i++) {
 		//! No LHS chunk value so result size is empty
 		state->result_sizes[i] = 0;
 	}
+	//! Sort the matches by row id, so the RHS rows are fetched in the order in which they are stored
+	sort(state->matches.begin(), state->matches.end());
 }
 
 void PhysicalIndexJoin::GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
@@ -4,7 +4,13 @@
 #include "duckdb/common/value_operations/value_operations.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
-#include "duckdb/storage/data_table.hpp"
+#include "duckdb/execution/sorted_run.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/pipeline.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+#include <algorithm>
 
 using namespace std;
 
@@ -13,10 +19,21 @@ namespace duckdb {
 class PhysicalOrderOperatorState : public PhysicalOperatorState {
 public:
 	PhysicalOrderOperatorState(PhysicalOperator &op, PhysicalOperator *child)
-	    : PhysicalOperatorState(op, child), position(0) {
+	    : PhysicalOperatorState(op, child), initialized(false), parallel_state(nullptr), partition_idx(0), chunk_idx(0),
+	      chunk_end(0) {
 	}
 
-	idx_t position;
+	bool initialized;
+	//! The parallel state (if the sorted result is scanned by multiple threads)
+	ParallelState *parallel_state;
+	//! The partition of the sorted result that is currently being scanned
+	idx_t partition_idx;
+	//! The chunk within the partition that is scanned next
+	idx_t chunk_idx;
+	//! The end of the range of chunks within the partition that is assigned to this thread (parallel scan only)
+	idx_t chunk_end;
+	//! The chunk holding the sort keys and payload of the current position
+	DataChunk scan_chunk;
 };
 
 //===--------------------------------------------------------------------===//
@@ -24,84 +41,461 @@ public:
 //===--------------------------------------------------------------------===//
 class OrderByGlobalOperatorState : public GlobalOperatorState {
 public:
-	//! The lock for updating the global aggregate state
+	OrderByGlobalOperatorState(PhysicalOrder &op, BufferManager &buffer_manager) : buffer_manager(buffer_manager) {
+		for (auto &order : op.orders) {
+			sort_types.push_back(order.expression->return_type);
+			order_types.push_back(order.type);
+			null_order_types.push_back(order.null_order);
+		}
+		// every sorted run stores the sort keys followed by the payload
+		run_types = sort_types;
+		for (auto &type : op.children[0]->types) {
+			run_types.push_back(type);
+		}
+	}
+
+	BufferManager &buffer_manager;
+	//! The lock for updating the global sort state
 	mutex lock;
-	//! The sorted data
-	ChunkCollection sorted_data;
-	//! The sorted vector
-	unique_ptr<idx_t[]> sorted_vector;
+	//! The types of the sort keys
+	vector<LogicalType> sort_types;
+	vector<OrderType> order_types;
+	vector<OrderByNullType> null_order_types;
+	//! The types of the sorted runs (sort keys followed by the payload)
+	vector<LogicalType> run_types;
+	//! The sorted runs produced by the individual threads
+	vector<unique_ptr<SortedRun>> runs;
+	//! The keys that split the sorted output into partitions that can be merged independently; partition i contains
+	//! all rows in the range [splitters[i - 1], splitters[i])
+	DataChunk splitters;
+	//! The fully sorted partitions of the result, in order
+	vector<unique_ptr<SortedRun>> partitions;
+};
+
+class OrderByLocalSinkState : public LocalSinkState {
+public:
+	explicit OrderByLocalSinkState(PhysicalOrder &op) {
+		vector<LogicalType> sort_types;
+		for (auto &order : op.orders) {
+			sort_types.push_back(order.expression->return_type);
+			executor.AddExpression(*order.expression);
+		}
+		auto run_types = sort_types;
+		for (auto &type : op.children[0]->types) {
+			run_types.push_back(type);
+		}
+		keys.Initialize(sort_types);
+		sort_chunk.InitializeEmpty(run_types);
+	}
+
+	//! Executes the ORDER BY expressions
+	ExpressionExecutor executor;
+	//! The sort keys of the current input chunk
+	DataChunk keys;
+	//! The sort keys and payload of the current input chunk
+	DataChunk sort_chunk;
+	//! The thread-local data that has not been sorted yet
+	ChunkCollection local_data;
 };
 
 unique_ptr<GlobalOperatorState> PhysicalOrder::GetGlobalState(ClientContext &context) {
-	return make_unique<OrderByGlobalOperatorState>();
+	return make_unique<OrderByGlobalOperatorState>(*this, BufferManager::GetBufferManager(context));
+}
+
+unique_ptr<LocalSinkState> PhysicalOrder::GetLocalSinkState(ExecutionContext &context) {
+	return make_unique<OrderByLocalSinkState>(*this);
 }
 
-void PhysicalOrder::Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate,
+//! Sorts the thread-local data and adds it as a new sorted run to the global state
+static void FlushSortedRun(OrderByGlobalOperatorState &gstate, OrderByLocalSinkState &lstate) {
+	auto &local_data = lstate.local_data;
+	if (local_data.count == 0) {
+		return;
+	}
+	auto sorted_vector = unique_ptr<idx_t[]>(new idx_t[local_data.count]);
+	local_data.Sort(gstate.order_types, gstate.null_order_types, sorted_vector.get());
+
+	auto run = make_unique<SortedRun>(gstate.buffer_manager, gstate.run_types, gstate.sort_types.size());
+	DataChunk sorted_chunk;
+	sorted_chunk.Initialize(gstate.run_types);
+	for (idx_t position = 0; position < local_data.count; position += STANDARD_VECTOR_SIZE) {
+		sorted_chunk.Reset();
+		local_data.MaterializeSortedChunk(sorted_chunk, sorted_vector.get(), position);
+		run->Append(sorted_chunk);
+	}
+	lstate.local_data = ChunkCollection();
+
+	lock_guard<mutex> glock(gstate.lock);
+	gstate.runs.push_back(move(run));
+}
+
+void PhysicalOrder::Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate_,
                          DataChunk &input) {
-	// concatenate all the data of the child chunks
 	auto &gstate = (OrderByGlobalOperatorState &)state;
-	lock_guard<mutex> glock(gstate.lock);
-	gstate.sorted_data.Append(input);
+	auto &lstate = (OrderByLocalSinkState &)lstate_;
+
+	// compute the sort keys and concatenate them with the payload
+	lstate.keys.Reset();
+	lstate.executor.Execute(input, lstate.keys);
+	idx_t key_count = lstate.keys.column_count();
+	for (idx_t i = 0; i < key_count; i++) {
+		lstate.sort_chunk.data[i].Reference(lstate.keys.data[i]);
+	}
+	for (idx_t i = 0; i < input.column_count(); i++) {
+		lstate.sort_chunk.data[key_count + i].Reference(input.data[i]);
+	}
+	lstate.sort_chunk.SetCardinality(input);
+	lstate.local_data.Append(lstate.sort_chunk);
+
+	// once enough data has been gathered we sort it into a run, which can be offloaded if memory runs out
+	idx_t SORTED_RUN_VECTOR_COUNT = 1000;
+	if (context.client.force_parallelism) {
+		SORTED_RUN_VECTOR_COUNT = 1;
+	}
+	if (lstate.local_data.count >= SORTED_RUN_VECTOR_COUNT * STANDARD_VECTOR_SIZE) {
+		FlushSortedRun(gstate, lstate);
+	}
+}
+
+void PhysicalOrder::Combine(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate) {
+	FlushSortedRun((OrderByGlobalOperatorState &)state, (OrderByLocalSinkState &)lstate);
+}
+
+//===--------------------------------------------------------------------===//
+// Merge
+//===--------------------------------------------------------------------===//
+//! Appends the rows [start, end) of the source to the end of the target
+static void AppendRows(DataChunk &source, idx_t start, idx_t end, DataChunk &target) {
+	idx_t target_offset = target.size();
+	for (idx_t col_idx = 0; col_idx < source.column_count(); col_idx++) {
+		auto &source_vector = source.data[col_idx];
+		auto &target_vector = target.data[col_idx];
+		switch (source_vector.type.InternalType()) {
+		case PhysicalType::LIST:
+		case PhysicalType::STRUCT:
+			// copying nested vectors copies their entire child collection: copy them row-by-row instead
+			for (idx_t i = start; i < end; i++) {
+				target_vector.SetValue(target_offset + i - start, source_vector.GetValue(i));
+			}
+			break;
+		default:
+			VectorOperations::Copy(source_vector, target_vector, end, start, target_offset);
+			break;
+		}
+	}
+	target.SetCardinality(target_offset + end - start);
+}
+
+//! A cursor over the part of a sorted run that falls within a single merge partition
+struct MergeCursor {
+	MergeCursor(OrderByGlobalOperatorState &gstate, SortedRun &run, idx_t lower, idx_t upper)
+	    : gstate(gstate), run(run), chunk_idx(0), position(0), upper(upper), exhausted(false) {
+		if (lower != INVALID_INDEX) {
+			// find the last chunk that starts with a key smaller than the lower bound: no earlier chunk can contain
+			// rows of this partition
+			idx_t left = 0, right = run.ChunkCount();
+			while (left < right) {
+				idx_t middle = left + (right - left) / 2;
+				auto &boundary = run.boundaries.GetChunk(middle);
+				if (CompareToSplitter(boundary, middle % STANDARD_VECTOR_SIZE, lower) < 0) {
+					left = middle + 1;
+				} else {
+					right = middle;
+				}
+			}
+			chunk_idx = left > 0 ? left - 1 : 0;
+		}
+		Load();
+		if (lower != INVALID_INDEX) {
+			// skip the rows that belong to the previous partition
+			while (!exhausted && CompareToSplitter(chunk, position, lower) < 0) {
+				Next();
+			}
+		}
+		CheckUpperBound();
+	}
+
+	OrderByGlobalOperatorState &gstate;
+	SortedRun &run;
+	DataChunk chunk;
+	idx_t chunk_idx;
+	idx_t position;
+	//! The splitter that marks the (exclusive) end of the partition, or INVALID_INDEX for the last partition
+	idx_t upper;
+	bool exhausted;
+
+	int CompareToSplitter(DataChunk &keys, idx_t row, idx_t splitter) {
+		return ChunkCollection::CompareTuple(keys, row, gstate.splitters, splitter, gstate.order_types,
+		                                     gstate.null_order_types);
+	}
+
+	bool BeforeUpperBound(idx_t row) {
+		return upper == INVALID_INDEX || CompareToSplitter(chunk, row, upper) < 0;
+	}
+
+	void Load() {
+		if (chunk_idx >= run.ChunkCount()) {
+			exhausted = true;
+			return;
+		}
+		run.GetChunk(chunk_idx, chunk);
+		position = 0;
+	}
+
+	void Next() {
+		position++;
+		if (position >= chunk.size()) {
+			chunk_idx++;
+			Load();
+		}
+	}
+
+	void CheckUpperBound() {
+		if (!exhausted && !BeforeUpperBound(position)) {
+			exhausted = true;
+		}
+	}
+};
+
+//! Performs a k-way merge of all sorted runs, restricted to the rows that fall within the specified partition
+static void MergePartition(OrderByGlobalOperatorState &gstate, idx_t partition) {
+	idx_t lower = partition == 0 ? INVALID_INDEX : partition - 1;
+	idx_t upper = partition == gstate.splitters.size() ? INVALID_INDEX : partition;
+
+	vector<unique_ptr<MergeCursor>> cursors;
+	for (auto &run : gstate.runs) {
+		cursors.push_back(make_unique<MergeCursor>(gstate, *run, lower, upper));
+	}
+	auto compare_cursors = [&](idx_t left, idx_t right) {
+		auto &l = *cursors[left];
+		auto &r = *cursors[right];
+		auto cmp = ChunkCollection::CompareTuple(l.chunk, l.position, r.chunk, r.position, gstate.order_types,
+		                                         gstate.null_order_types);
+		// std heaps are max-heaps: invert the comparison so the smallest row is on top
+		return cmp == 0 ? left > right : cmp > 0;
+	};
+	vector<idx_t> heap;
+	for (idx_t i = 0; i < cursors.size(); i++) {
+		if (!cursors[i]->exhausted) {
+			heap.push_back(i);
+		}
+	}
+	make_heap(heap.begin(), heap.end(), compare_cursors);
+
+	auto result = make_unique<SortedRun>(gstate.buffer_manager, gstate.run_types, gstate.sort_types.size());
+	DataChunk output;
+	output.Initialize(gstate.run_types);
+	while (!heap.empty()) {
+		pop_heap(heap.begin(), heap.end(), compare_cursors);
+		idx_t cursor_idx = heap.back();
+		auto &cursor = *cursors[cursor_idx];
+		heap.pop_back();
+
+		// emit rows from this cursor for as long as they are not bigger than the smallest row of the other cursors
+		idx_t start = cursor.position;
+		idx_t end = start + 1;
+		while (end < cursor.chunk.size() && output.size() + (end - start) < STANDARD_VECTOR_SIZE &&
+		       cursor.BeforeUpperBound(end)) {
+			if (!heap.empty()) {
+				auto &next = *cursors[heap.front()];
+				if (ChunkCollection::CompareTuple(cursor.chunk, end, next.chunk, next.position, gstate.order_types,
+				                                  gstate.null_order_types) > 0) {
+					break;
+				}
+			}
+			end++;
+		}
+		AppendRows(cursor.chunk, start, end, output);
+		if (output.size() == STANDARD_VECTOR_SIZE) {
+			result->Append(output);
+			output.Reset();
+		}
+
+		cursor.position = end - 1;
+		cursor.Next();
+		cursor.CheckUpperBound();
+		if (!cursor.exhausted) {
+			heap.push_back(cursor_idx);
+			push_heap(heap.begin(), heap.end(), compare_cursors);
+		}
+	}
+	result->Append(output);
+	gstate.partitions[partition] = move(result);
 }
 
 //===--------------------------------------------------------------------===//
 // Finalize
 //===--------------------------------------------------------------------===//
-void PhysicalOrder::Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> state) {
-	// finalize: perform the actual sorting
-	auto &sink = (OrderByGlobalOperatorState &)*state;
-	ChunkCollection &big_data = sink.sorted_data;
+class PhysicalOrderMergeTask : public Task {
+public:
+	PhysicalOrderMergeTask(Pipeline &parent_, OrderByGlobalOperatorState &state_, idx_t partition_)
+	    : parent(parent_), state(state_), partition(partition_) {
+	}
 
-	// compute the sorting columns from the input data
-	ExpressionExecutor executor;
-	vector<LogicalType> sort_types;
-	vector<OrderType> order_types;
-	vector<OrderByNullType> null_order_types;
-	for (idx_t i = 0; i < orders.size(); i++) {
-		auto &expr = orders[i].expression;
-		sort_types.push_back(expr->return_type);
-		order_types.push_back(orders[i].type);
-		null_order_types.push_back(orders[i].null_order);
-		executor.AddExpression(*expr);
+	void Execute() override {
+		try {
+			MergePartition(state, partition);
+		} catch (std::exception &ex) {
+			parent.executor.PushError(ex.what());
+		} catch (...) {
+			parent.executor.PushError("Unknown exception in ORDER BY merge!");
+		}
+		lock_guard<mutex> glock(state.lock);
+		parent.finished_tasks++;
+		if (parent.total_tasks == parent.finished_tasks) {
+			// all partitions have been merged: the input runs are no longer required
+			state.runs.clear();
+			parent.Finish();
+		}
 	}
 
-	ChunkCollection sort_collection;
-	for (idx_t i = 0; i < big_data.chunks.size(); i++) {
-		DataChunk sort_chunk;
-		sort_chunk.Initialize(sort_types);
+private:
+	Pipeline &parent;
+	OrderByGlobalOperatorState &state;
+	idx_t partition;
+};
 
-		executor.Execute(*big_data.chunks[i], sort_chunk);
-		sort_collection.Append(sort_chunk);
+//! Picks the keys that split the merged output into (at most) n_partitions partitions of roughly equal size
+static void ComputeSplitters(OrderByGlobalOperatorState &gstate, idx_t n_partitions) {
+	ChunkCollection samples;
+	for (auto &run : gstate.runs) {
+		samples.Append(run->boundaries);
 	}
+	auto sorted_samples = unique_ptr<idx_t[]>(new idx_t[samples.count]);
+	samples.Sort(gstate.order_types, gstate.null_order_types, sorted_samples.get());
 
-	D_ASSERT(sort_collection.count == big_data.count);
+	gstate.splitters.Initialize(gstate.sort_types);
+	gstate.splitters.SetCardinality(n_partitions - 1);
+	for (idx_t i = 1; i < n_partitions; i++) {
+		auto sample_idx = sorted_samples[i * samples.count / n_partitions];
+		for (idx_t col_idx = 0; col_idx < gstate.sort_types.size(); col_idx++) {
+			gstate.splitters.SetValue(col_idx, i - 1, samples.GetValue(col_idx, sample_idx));
+		}
+	}
+}
 
-	// now perform the actual sort
-	sink.sorted_vector = unique_ptr<idx_t[]>(new idx_t[sort_collection.count]);
-	sort_collection.Sort(order_types, null_order_types, sink.sorted_vector.get());
+void PhysicalOrder::Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> state) {
+	this->sink_state = move(state);
+	auto &gstate = (OrderByGlobalOperatorState &)*this->sink_state;
+	if (gstate.runs.size() <= 1) {
+		// zero or one run: the data is already sorted
+		gstate.partitions = move(gstate.runs);
+		return;
+	}
+	// split the key space into partitions that are merged in parallel
+	idx_t sample_count = 0;
+	for (auto &run : gstate.runs) {
+		sample_count += run->ChunkCount();
+	}
+	idx_t n_partitions = TaskScheduler::GetScheduler(context).NumberOfThreads();
+	n_partitions = MinValue<idx_t>(n_partitions, sample_count);
+	n_partitions = MinValue<idx_t>(n_partitions, STANDARD_VECTOR_SIZE);
+	n_partitions = MaxValue<idx_t>(n_partitions, 1);
+	ComputeSplitters(gstate, n_partitions);
 
-	PhysicalSink::Finalize(pipeline, context, move(state));
+	gstate.partitions.resize(n_partitions);
+	if (n_partitions == 1) {
+		MergePartition(gstate, 0);
+		gstate.runs.clear();
+		return;
+	}
+	// schedule one merge task per partition
+	pipeline.total_tasks += n_partitions;
+	for (idx_t partition = 0; partition < n_partitions; partition++) {
+		auto new_task = make_unique<PhysicalOrderMergeTask>(pipeline, gstate, partition);
+		TaskScheduler::GetScheduler(context).ScheduleTask(pipeline.token, move(new_task));
+	}
 }
 
 //===--------------------------------------------------------------------===//
 // GetChunkInternal
 //===--------------------------------------------------------------------===//
+class PhysicalOrderParallelState : public ParallelState {
+public:
+	PhysicalOrderParallelState() : partition_idx(0), chunk_idx(0) {
+	}
+
+	mutex lock;
+	//! The partition and the chunk within the partition that are handed out next
+	idx_t partition_idx;
+	idx_t chunk_idx;
+};
+
+//! Assigns the next range of chunks of the sorted result to a thread, returns false if all chunks have been assigned
+static bool AssignNextChunks(OrderByGlobalOperatorState &gstate, PhysicalOrderParallelState &pstate,
+                             PhysicalOrderOperatorState &state, idx_t chunk_count) {
+	lock_guard<mutex> plock(pstate.lock);
+	while (pstate.partition_idx < gstate.partitions.size()) {
+		auto partition_chunks = gstate.partitions[pstate.partition_idx]->ChunkCount();
+		if (pstate.chunk_idx < partition_chunks) {
+			state.partition_idx = pstate.partition_idx;
+			state.chunk_idx = pstate.chunk_idx;
+			state.chunk_end = MinValue<idx_t>(pstate.chunk_idx + chunk_count, partition_chunks);
+			pstate.chunk_idx = state.chunk_end;
+			return true;
+		}
+		pstate.partition_idx++;
+		pstate.chunk_idx = 0;
+	}
+	return false;
+}
+
 void PhysicalOrder::GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
 	auto state = reinterpret_cast<PhysicalOrderOperatorState *>(state_);
-	auto &sink = (OrderByGlobalOperatorState &)*this->sink_state;
-	ChunkCollection &big_data = sink.sorted_data;
-	if (state->position >= big_data.count) {
-		return;
+	auto &gstate = (OrderByGlobalOperatorState &)*this->sink_state;
+	if (!state->initialized) {
+		state->parallel_state = FindParallelState(context);
+		state->initialized = true;
+	}
+	if (state->parallel_state) {
+		// parallel scan: the threads scan disjoint ranges of chunks of the sorted result
+		if (state->chunk_idx >= state->chunk_end &&
+		    !AssignNextChunks(gstate, (PhysicalOrderParallelState &)*state->parallel_state, *state,
+		                      ParallelScanVectorCount(context.client))) {
+			state->finished = true;
+			return;
+		}
+		gstate.partitions[state->partition_idx]->GetChunk(state->chunk_idx++, state->scan_chunk);
+	} else {
+		while (true) {
+			if (state->partition_idx >= gstate.partitions.size()) {
+				state->finished = true;
+				return;
+			}
+			auto &partition = *gstate.partitions[state->partition_idx];
+			if (state->chunk_idx < partition.ChunkCount()) {
+				partition.GetChunk(state->chunk_idx++, state->scan_chunk);
+				break;
+			}
+			state->partition_idx++;
+			state->chunk_idx = 0;
+		}
+	}
+	// strip the sort keys from the result
+	idx_t key_count = gstate.sort_types.size();
+	chunk.SetCardinality(state->scan_chunk);
+	for (idx_t col_idx = 0; col_idx < chunk.column_count(); col_idx++) {
+		chunk.data[col_idx].Reference(state->scan_chunk.data[key_count + col_idx]);
 	}
-
-	big_data.MaterializeSortedChunk(chunk, sink.sorted_vector.get(), state->position);
-	state->position += STANDARD_VECTOR_SIZE;
 }
 
 unique_ptr<PhysicalOperatorState> PhysicalOrder::GetOperatorState() {
 	return make_unique<PhysicalOrderOperatorState>(*this, children[0].get());
 }
 
+idx_t PhysicalOrder::MaxThreads(ClientContext &context) {
+	auto &gstate = (OrderByGlobalOperatorState &)*this->sink_state;
+	idx_t chunk_count = 0;
+	for (auto &partition : gstate.partitions) {
+		chunk_count += partition->ChunkCount();
+	}
+	return chunk_count / ParallelScanVectorCount(context) + 1;
+}
+
+unique_ptr<ParallelState> PhysicalOrder::GetParallelState() {
+	return make_unique<PhysicalOrderParallelState>();
+}
+
 string PhysicalOrder::ParamsToString() const {
 	string result;
 	for (idx_t i = 0; i < orders.size(); i++) {
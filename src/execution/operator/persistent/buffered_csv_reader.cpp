@@ -34,7 +34,14 @@ static string GenerateColumnName(const idx_t total_cols, const idx_t col_number,
 	return string(prefix + leading_zeros + value);
 }
 
-static string GetLineNumberStr(idx_t linenr, bool linenr_estimated) {
+//! The lines of a byte range are counted from the start of the range: their numbers within the file are not known
+static const char *PARALLEL_LINENR_NOTE =
+    " (approximate: the file is read in parallel, set parallel=false for exact line numbers)";
+
+static string GetLineNumberStr(idx_t linenr, bool linenr_estimated, bool has_range) {
+	if (has_range) {
+		return std::to_string(linenr + 1) + PARALLEL_LINENR_NOTE;
+	}
 	string estimated = (linenr_estimated ? string(" (estimated)") : string(""));
 	return std::to_string(linenr + 1) + estimated;
 }
@@ -920,7 +927,7 @@ in_quotes:
 	} while (ReadBuffer(start));
 	// still in quoted state at the end of the file, error:
 	throw InvalidInputException("Error in file \"%s\" on line %s: unterminated quotes. (%s)", options.file_path,
-	                            GetLineNumberStr(linenr, linenr_estimated).c_str(), options.toString());
+	                            GetLineNumberStr(linenr, linenr_estimated, has_range).c_str(), options.toString());
 unquote:
 	/* state: unquote */
 	// this state handles the state directly after we unquote
@@ -949,7 +956,8 @@ unquote:
 				throw InvalidInputException(
 				    "Error in file \"%s\" on line %s: quote should be followed by end of value, end "
 				    "of row or another quote. (%s)",
-				    options.file_path, GetLineNumberStr(linenr, linenr_estimated).c_str(), options.toString());
+				    options.file_path, GetLineNumberStr(linenr, linenr_estimated, has_range).c_str(),
+				    options.toString());
 			}
 			if (delimiter_pos == options.delimiter.size()) {
 				// quote followed by delimiter, add value
@@ -965,7 +973,7 @@ unquote:
 	} while (ReadBuffer(start));
 	throw InvalidInputException(
 	    "Error in file \"%s\" on line %s: quote should be followed by end of value, end of row or another quote. (%s)",
-	    options.file_path, GetLineNumberStr(linenr, linenr_estimated).c_str(), options.toString());
+	    options.file_path, GetLineNumberStr(linenr, linenr_estimated, has_range).c_str(), options.toString());
 handle_escape:
 	escape_pos = 0;
 	quote_pos = 0;
@@ -979,7 +987,8 @@ handle_escape:
 			if (count > escape_pos && count > quote_pos) {
 				throw InvalidInputException(
 				    "Error in file \"%s\" on line %s: neither QUOTE nor ESCAPE is proceeded by ESCAPE. (%s)",
-				    options.file_path, GetLineNumberStr(linenr, linenr_estimated).c_str(), options.toString());
+				    options.file_path, GetLineNumberStr(linenr, linenr_estimated, has_range).c_str(),
+				    options.toString());
 			}
 			if (quote_pos == options.quote.size() || escape_pos == options.escape.size()) {
 				// found quote or escape: move back to quoted state
@@ -989,7 +998,7 @@ handle_escape:
 	} while (ReadBuffer(start));
 	throw InvalidInputException(
 	    "Error in file \"%s\" on line %s: neither QUOTE nor ESCAPE is proceeded by ESCAPE. (%s)", options.file_path,
-	    GetLineNumberStr(linenr, linenr_estimated).c_str(), options.toString());
+	    GetLineNumberStr(linenr, linenr_estimated, has_range).c_str(), options.toString());
 carriage_return:
 	/* state: carriage_return */
 	// this stage optionally skips a newline (\n) character, which allows \r\n to be interpreted as a single line
@@ -1119,7 +1128,7 @@ in_quotes:
 	} while (ReadBuffer(start));
 	// still in quoted state at the end of the file, error:
 	throw InvalidInputException("Error in file \"%s\" on line %s: unterminated quotes. (%s)", options.file_path,
-	                            GetLineNumberStr(linenr, linenr_estimated).c_str(), options.toString());
+	                            GetLineNumberStr(linenr, linenr_estimated, has_range).c_str(), options.toString());
 unquote:
 	/* state: unquote */
 	// this state handles the state directly after we unquote
@@ -1145,7 +1154,7 @@ unquote:
 	} else {
 		throw InvalidInputException("Error in file \"%s\" on line %s: quote should be followed by end of value, end of "
 		                            "row or another quote. (%s)",
-		                            options.file_path, GetLineNumberStr(linenr, linenr_estimated).c_str(),
+		                            options.file_path, GetLineNumberStr(linenr, linenr_estimated, has_range).c_str(),
 		                            options.toString());
 	}
 handle_escape:
@@ -1155,12 +1164,12 @@ handle_escape:
 	if (position >= buffer_size && !ReadBuffer(start)) {
 		throw InvalidInputException(
 		    "Error in file \"%s\" on line %s: neither QUOTE nor ESCAPE is proceeded by ESCAPE. (%s)", options.file_path,
-		    GetLineNumberStr(linenr, linenr_estimated).c_str(), options.toString());
+		    GetLineNumberStr(linenr, linenr_estimated, has_range).c_str(), options.toString());
 	}
 	if (buffer[position] != options.quote[0] && buffer[position] != options.escape[0]) {
 		throw InvalidInputException(
 		    "Error in file \"%s\" on line %s: neither QUOTE nor ESCAPE is proceeded by ESCAPE. (%s)", options.file_path,
-		    GetLineNumberStr(linenr, linenr_estimated).c_str(), options.toString());
+		    GetLineNumberStr(linenr, linenr_estimated, has_range).c_str(), options.toString());
 	}
 	// escape was followed by quote or escape, go back to quoted state
 	goto in_quotes;
@@ -1218,9 +1227,15 @@ bool BufferedCSVReader::ReadBuffer(idx_t &start) {
 		// remaining from last buffer: copy it here
 		memcpy(buffer.get(), old_buffer.get() + start, remaining);
 	}
-	source->read(buffer.get() + remaining, buffer_read_size);
+	idx_t read_size = buffer_read_size;
+	if (has_range) {
+		// do not read past the end of the range
+		read_size = MinValue<idx_t>(read_size, range_end - range_position);
+	}
+	source->read(buffer.get() + remaining, read_size);
 
-	idx_t read_count = source->eof() ? source->gcount() : buffer_read_size;
+	idx_t read_count = source->eof() ? source->gcount() : read_size;
+	range_position += read_count;
 	bytes_in_chunk += read_count;
 	buffer_size = remaining + read_count;
 	buffer[buffer_size] = '\0';
@@ -1239,6 +1254,128 @@ void BufferedCSVReader::ParseCSV(DataChunk &insert_chunk) {
 	ParseCSV(ParserMode::PARSING, insert_chunk);
 }
 
+void BufferedCSVReader::SetRange(idx_t range_start, idx_t range_end_p) {
+	D_ASSERT(plain_file_source);
+	ResetBuffer();
+	ResetParseChunk();
+	source->clear();
+	source->seekg(range_start, source->beg);
+	has_range = true;
+	range_position = range_start;
+	range_end = range_end_p;
+	end_of_file_reached = false;
+	// we do not know how many lines precede the range
+	linenr = 0;
+	linenr_estimated = true;
+}
+
+bool BufferedCSVReader::SupportsRanges(const BufferedCSVReaderOptions &options) {
+	// the row boundaries are found with the same state machine as ParseSimpleCSV uses
+	return options.quote.size() <= 1 && options.escape.size() <= 1 && options.delimiter.size() == 1;
+}
+
+enum class RowSearchState : uint8_t { VALUE_START, NORMAL, IN_QUOTES, UNQUOTE, ESCAPE };
+
+idx_t BufferedCSVReader::FindRowStart(FileSystem &fs, FileHandle &handle, idx_t file_size,
+                                      const BufferedCSVReaderOptions &options, idx_t start_offset,
+                                      idx_t target_offset) {
+	D_ASSERT(SupportsRanges(options));
+	if (target_offset <= start_offset) {
+		return start_offset;
+	}
+	if (target_offset >= file_size) {
+		return file_size;
+	}
+	// an empty quote or escape matches the null byte, exactly as in ParseSimpleCSV
+	char delimiter = options.delimiter[0];
+	char quote = options.quote[0];
+	char escape = options.escape[0];
+	bool quote_escapes_quote = options.escape.size() == 0 || escape == quote;
+
+	auto buffer = unique_ptr<char[]>(new char[ROW_SEARCH_BUFFER_SIZE]);
+	auto state = RowSearchState::VALUE_START;
+	for (idx_t offset = start_offset; offset < file_size; offset += ROW_SEARCH_BUFFER_SIZE) {
+		idx_t read_size = MinValue<idx_t>(ROW_SEARCH_BUFFER_SIZE, file_size - offset);
+		fs.Read(handle, buffer.get(), read_size, offset);
+		for (idx_t i = 0; i < read_size; i++) {
+			char c = buffer[i];
+			switch (state) {
+			case RowSearchState::IN_QUOTES:
+				if (c == quote) {
+					state = RowSearchState::UNQUOTE;
+				} else if (c == escape) {
+					state = RowSearchState::ESCAPE;
+				}
+				continue;
+			case RowSearchState::ESCAPE:
+				// the escaped character is part of the quoted value
+				state = RowSearchState::IN_QUOTES;
+				continue;
+			case RowSearchState::UNQUOTE:
+				if (c == quote && quote_escapes_quote) {
+					// escaped quote: back into the quoted value
+					state = RowSearchState::IN_QUOTES;
+					continue;
+				}
+				break;
+			case RowSearchState::VALUE_START:
+				if (c == quote) {
+					state = RowSearchState::IN_QUOTES;
+					continue;
+				}
+				break;
+			default:
+				break;
+			}
+			// we are outside of a quoted value
+			if (c == delimiter) {
+				state = RowSearchState::VALUE_START;
+			} else if (is_newline(c)) {
+				idx_t row_start = offset + i + 1;
+				if (row_start >= target_offset) {
+					if (c == '\r' && row_start < file_size) {
+						// \r\n is a single row terminator
+						char next;
+						if (i + 1 < read_size) {
+							next = buffer[i + 1];
+						} else {
+							fs.Read(handle, &next, 1, row_start);
+						}
+						if (next == '\n') {
+							row_start++;
+						}
+					}
+					return row_start;
+				}
+				state = RowSearchState::VALUE_START;
+			} else {
+				state = RowSearchState::NORMAL;
+			}
+		}
+	}
+	return file_size;
+}
+
+idx_t BufferedCSVReader::FindDataStart(FileSystem &fs, FileHandle &handle, idx_t file_size,
+                                       const BufferedCSVReaderOptions &options) {
+	// skip the same lines as SkipHeader: every skipped row and the header end at the next \n
+	idx_t skip_lines = options.skip_rows + (options.header ? 1 : 0);
+	if (skip_lines == 0) {
+		return 0;
+	}
+	auto buffer = unique_ptr<char[]>(new char[ROW_SEARCH_BUFFER_SIZE]);
+	for (idx_t offset = 0; offset < file_size; offset += ROW_SEARCH_BUFFER_SIZE) {
+		idx_t read_size = MinValue<idx_t>(ROW_SEARCH_BUFFER_SIZE, file_size - offset);
+		fs.Read(handle, buffer.get(), read_size, offset);
+		for (idx_t i = 0; i < read_size; i++) {
+			if (buffer[i] == '\n' && --skip_lines == 0) {
+				return offset + i + 1;
+			}
+		}
+	}
+	return file_size;
+}
+
 void BufferedCSVReader::ParseCSV(ParserMode parser_mode, DataChunk &insert_chunk) {
 	mode = parser_mode;
 
@@ -1260,7 +1397,7 @@ void BufferedCSVReader::AddValue(char *str_val, idx_t length, idx_t &column, vec
 	}
 	if (column >= sql_types.size()) {
 		throw InvalidInputException("Error on line %s: expected %lld values per row, but got more. (%s)",
-		                            GetLineNumberStr(linenr, linenr_estimated).c_str(), sql_types.size(),
+		                            GetLineNumberStr(linenr, linenr_estimated, has_range).c_str(), sql_types.size(),
 		                            options.toString());
 	}
 
@@ -1307,8 +1444,8 @@ bool BufferedCSVReader::AddRow(DataChunk &insert_chunk, idx_t &column) {
 
 	if (column < sql_types.size() && mode != ParserMode::SNIFFING_DIALECT) {
 		throw InvalidInputException("Error on line %s: expected %lld values per row, but got %d. (%s)",
-		                            GetLineNumberStr(linenr, linenr_estimated).c_str(), sql_types.size(), column,
-		                            options.toString());
+		                            GetLineNumberStr(linenr, linenr_estimated, has_range).c_str(), sql_types.size(),
+		                            column, options.toString());
 	}
 
 	if (mode == ParserMode::SNIFFING_DIALECT) {
@@ -1351,8 +1488,9 @@ void BufferedCSVReader::Flush(DataChunk &insert_chunk) {
 					auto utf_type = Utf8Proc::Analyze(s.GetData(), s.GetSize());
 					if (utf_type == UnicodeType::INVALID) {
 						throw InvalidInputException(
-						    "Error in file \"%s\" between line %d and %d: file is not valid UTF8. (%s)",
-						    options.file_path, linenr - parse_chunk.size(), linenr, options.toString());
+						    "Error in file \"%s\" between line %d and %d%s: file is not valid UTF8. (%s)",
+						    options.file_path, linenr - parse_chunk.size(), linenr,
+						    has_range ? PARALLEL_LINENR_NOTE : "", options.toString());
 					}
 				}
 			}
@@ -1364,9 +1502,9 @@ void BufferedCSVReader::Flush(DataChunk &insert_chunk) {
 				    parse_chunk.data[col_idx], insert_chunk.data[col_idx], parse_chunk.size(),
 				    [&](string_t input) { return options.date_format[LogicalTypeId::DATE].ParseDate(input); });
 			} catch (const Exception &e) {
-				throw InvalidInputException("Error in file \"%s\" between line %llu and %llu: %s. (%s)",
-				                            options.file_path, linenr - parse_chunk.size(), linenr, e.what(),
-				                            options.toString());
+				throw InvalidInputException("Error in file \"%s\" between line %llu and %llu%s: %s. (%s)",
+				                            options.file_path, linenr - parse_chunk.size(), linenr,
+				                            has_range ? PARALLEL_LINENR_NOTE : "", e.what(), options.toString());
 			}
 		} else if (options.has_format[LogicalTypeId::TIMESTAMP] &&
 		           sql_types[col_idx].id() == LogicalTypeId::TIMESTAMP) {
@@ -1377,18 +1515,18 @@ void BufferedCSVReader::Flush(DataChunk &insert_chunk) {
 					    return options.date_format[LogicalTypeId::TIMESTAMP].ParseTimestamp(input);
 				    });
 			} catch (const Exception &e) {
-				throw InvalidInputException("Error in file \"%s\" between line %llu and %llu: %s. (%s)",
-				                            options.file_path, linenr - parse_chunk.size(), linenr, e.what(),
-				                            options.toString());
+				throw InvalidInputException("Error in file \"%s\" between line %llu and %llu%s: %s. (%s)",
+				                            options.file_path, linenr - parse_chunk.size(), linenr,
+				                            has_range ? PARALLEL_LINENR_NOTE : "", e.what(), options.toString());
 			}
 		} else {
 			try {
 				// target type is not varchar: perform a cast
 				VectorOperations::Cast(parse_chunk.data[col_idx], insert_chunk.data[col_idx], parse_chunk.size());
 			} catch (const Exception &e) {
-				throw InvalidInputException("Error in file \"%s\" between line %llu and %llu: %s. (%s)",
-				                            options.file_path, linenr - parse_chunk.size(), linenr, e.what(),
-				                            options.toString());
+				throw InvalidInputException("Error in file \"%s\" between line %llu and %llu%s: %s. (%s)",
+				                            options.file_path, linenr - parse_chunk.size(), linenr,
+				                            has_range ? PARALLEL_LINENR_NOTE : "", e.what(), options.toString());
 			}
 		}
 	}
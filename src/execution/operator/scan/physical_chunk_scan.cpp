@@ -1,18 +1,33 @@
 #include "duckdb/execution/operator/scan/physical_chunk_scan.hpp"
 
+#include <atomic>
+
 using namespace std;
 
 namespace duckdb {
 
 class PhysicalChunkScanState : public PhysicalOperatorState {
 public:
-	PhysicalChunkScanState(PhysicalOperator &op) : PhysicalOperatorState(op, nullptr), chunk_index(0) {
+	PhysicalChunkScanState(PhysicalOperator &op)
+	    : PhysicalOperatorState(op, nullptr), initialized(false), parallel_state(nullptr), chunk_index(0) {
 	}
 
+	bool initialized;
+	//! The parallel state (if the collection is scanned by multiple threads)
+	ParallelState *parallel_state;
 	//! The current position in the scan
 	idx_t chunk_index;
 };
 
+class PhysicalChunkScanParallelState : public ParallelState {
+public:
+	PhysicalChunkScanParallelState() : chunk_index(0) {
+	}
+
+	//! The next chunk to hand out to a thread
+	std::atomic<idx_t> chunk_index;
+};
+
 void PhysicalChunkScan::GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
 	auto state = (PhysicalChunkScanState *)state_;
 	D_ASSERT(collection);
@@ -20,6 +35,15 @@ void PhysicalChunkScan::GetChunkInternal(ExecutionContext &context, DataChunk &c
 		return;
 	}
 	D_ASSERT(chunk.GetTypes() == collection->types);
+	if (!state->initialized) {
+		state->parallel_state = FindParallelState(context);
+		state->initialized = true;
+	}
+	if (state->parallel_state) {
+		// parallel scan: fetch the next chunk that has not been claimed by any of the threads
+		auto &pstate = (PhysicalChunkScanParallelState &)*state->parallel_state;
+		state->chunk_index = pstate.chunk_index++;
+	}
 	if (state->chunk_index >= collection->chunks.size()) {
 		return;
 	}
@@ -32,4 +56,15 @@ unique_ptr<PhysicalOperatorState> PhysicalChunkScan::GetOperatorState() {
 	return make_unique<PhysicalChunkScanState>(*this);
 }
 
+idx_t PhysicalChunkScan::MaxThreads(ClientContext &context) {
+	if (!collection) {
+		return 0;
+	}
+	return collection->chunks.size() / ParallelScanVectorCount(context) + 1;
+}
+
+unique_ptr<ParallelState> PhysicalChunkScan::GetParallelState() {
+	return make_unique<PhysicalChunkScanParallelState>();
+}
+
 } // namespace duckdb
@@ -4,6 +4,7 @@
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/execution/execution_context.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/task_context.hpp"
 #include "duckdb/parallel/thread_context.hpp"
 #include "duckdb/common/tree_renderer.hpp"
 
@@ -47,6 +48,19 @@ void PhysicalOperator::GetChunk(ExecutionContext &context, DataChunk &chunk, Phy
 	chunk.Verify();
 }
 
+ParallelState *PhysicalOperator::FindParallelState(ExecutionContext &context) {
+	auto entry = context.task.task_info.find(this);
+	if (entry == context.task.task_info.end()) {
+		return nullptr;
+	}
+	return entry->second;
+}
+
+idx_t PhysicalOperator::ParallelScanVectorCount(ClientContext &context) {
+	// hand out the same amount of vectors at once as the parallel table scan does
+	return context.force_parallelism ? 1 : 100;
+}
+
 void PhysicalOperator::Print() {
 	Printer::Print(ToString());
 }
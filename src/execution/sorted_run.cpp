@@ -0,0 +1,31 @@
+#include "duckdb/execution/sorted_run.hpp"
+
+#include "duckdb/common/vector_operations/vector_operations.hpp"
+
+namespace duckdb {
+using namespace std;
+
+SortedRun::SortedRun(BufferManager &buffer_manager, vector<LogicalType> types_p, idx_t key_count)
+    : types(move(types_p)), key_count(key_count), data(buffer_manager, types) {
+	D_ASSERT(key_count > 0 && key_count <= types.size());
+}
+
+void SortedRun::Append(DataChunk &chunk) {
+	if (chunk.size() == 0) {
+		return;
+	}
+	D_ASSERT(chunk.GetTypes() == types);
+	// keep track of the first row of the chunk, we use it to find split points when merging runs in parallel
+	vector<LogicalType> key_types(types.begin(), types.begin() + key_count);
+	DataChunk first_row;
+	first_row.Initialize(key_types);
+	for (idx_t col_idx = 0; col_idx < key_count; col_idx++) {
+		VectorOperations::Copy(chunk.data[col_idx], first_row.data[col_idx], 1, 0, 0);
+	}
+	first_row.SetCardinality(1);
+	boundaries.Append(first_row);
+
+	data.Append(chunk);
+}
+
+} // namespace duckdb
@@ -21,7 +21,7 @@ WindowSegmentTree::WindowSegmentTree(AggregateFunction &aggregate, LogicalType r
 
 	if (input_ref && input_ref->column_count() > 0) {
 		inputs.Initialize(input_ref->types);
-		if (aggregate.combine) {
+		if (UseSegmentTree()) {
 			ConstructTree();
 		}
 	}
@@ -37,10 +37,18 @@ Value WindowSegmentTree::AggegateFinal() {
 	result.vector_type = VectorType::CONSTANT_VECTOR;
 	ConstantVector::SetNull(result, false);
 	aggregate.finalize(statev, result, 1);
+	if (aggregate.destructor) {
+		aggregate.destructor(statev, 1);
+	}
 
 	return result.GetValue(0);
 }
 
+bool WindowSegmentTree::UseSegmentTree() {
+	// the tree nodes are plain copies of the aggregate states, which is only safe if the states do not own any memory
+	return aggregate.combine && !aggregate.destructor;
+}
+
 void WindowSegmentTree::WindowSegmentValue(idx_t l_idx, idx_t begin, idx_t end) {
 	D_ASSERT(begin <= end);
 	if (begin == end) {
@@ -135,7 +143,7 @@ Value WindowSegmentTree::Compute(idx_t begin, idx_t end) {
 	AggregateInit();
 
 	// Aggregate everything at once if we can't combine states
-	if (!aggregate.combine) {
+	if (!UseSegmentTree()) {
 		WindowSegmentValue(0, begin, end);
 		return AggegateFinal();
 	}
@@ -0,0 +1,158 @@
+#include "duckdb/function/aggregate/distributive_functions.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/common/types/null_value.hpp"
+#include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/common/vector_operations/aggregate_executor.hpp"
+#include "duckdb/planner/expression.hpp"
+
+#include <cmath>
+
+using namespace std;
+
+namespace duckdb {
+
+//! A HyperLogLog sketch with 2^HLL_PRECISION one-byte registers (standard error ~3.3%). The registers are stored inline
+//! so the state can be copied, combined and moved around by the aggregate hash tables and the window segment tree
+//! without any ownership tracking.
+struct hyperloglog_state_t {
+	static constexpr idx_t HLL_PRECISION = 10;
+	static constexpr idx_t HLL_REGISTERS = idx_t(1) << HLL_PRECISION;
+
+	uint8_t registers[HLL_REGISTERS];
+};
+
+//! The number of leading zero bits of a non-zero 64-bit value
+static inline uint8_t CountLeadingZeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+	return uint8_t(__builtin_clzll(value));
+#else
+	uint8_t zeros = 0;
+	while (!(value & (uint64_t(1) << 63))) {
+		value <<= 1;
+		zeros++;
+	}
+	return zeros;
+#endif
+}
+
+struct ApproxCountDistinctFunction {
+	template <class STATE> static void Initialize(STATE *state) {
+		memset(state->registers, 0, sizeof(state->registers));
+	}
+
+	template <class STATE> static void AddHash(STATE *state, hash_t hash) {
+		// the hash functions in hash.hpp are cheap but do not avalanche (e.g. for short strings), so mix the bits
+		// before splitting them into a register index and a run of leading zeros
+		hash ^= hash >> 33;
+		hash *= UINT64_C(0xff51afd7ed558ccd);
+		hash ^= hash >> 33;
+		hash *= UINT64_C(0xc4ceb9fe1a85ec53);
+		hash ^= hash >> 33;
+
+		auto index = hash >> (64 - STATE::HLL_PRECISION);
+		// the remaining bits with a sentinel bit, so the run of leading zeros is bounded
+		auto remainder = (hash << STATE::HLL_PRECISION) | (hash_t(1) << (STATE::HLL_PRECISION - 1));
+		auto rank = uint8_t(CountLeadingZeros(remainder) + 1);
+		if (rank > state->registers[index]) {
+			state->registers[index] = rank;
+		}
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void Operation(STATE *state, INPUT_TYPE *input, nullmask_t &nullmask, idx_t idx) {
+		AddHash(state, Hash<INPUT_TYPE>(input[idx]));
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void ConstantOperation(STATE *state, INPUT_TYPE *input, nullmask_t &nullmask, idx_t count) {
+		// adding the same value more than once does not change the sketch
+		AddHash(state, Hash<INPUT_TYPE>(input[0]));
+	}
+
+	template <class STATE, class OP> static void Combine(const STATE &source, STATE *target) {
+		for (idx_t i = 0; i < STATE::HLL_REGISTERS; i++) {
+			target->registers[i] = MaxValue<uint8_t>(target->registers[i], source.registers[i]);
+		}
+	}
+
+	template <class T, class STATE>
+	static void Finalize(Vector &result, STATE *state, T *target, nullmask_t &nullmask, idx_t idx) {
+		const double m = STATE::HLL_REGISTERS;
+		double sum = 0;
+		idx_t zero_registers = 0;
+		for (idx_t i = 0; i < STATE::HLL_REGISTERS; i++) {
+			sum += std::ldexp(1.0, -int(state->registers[i]));
+			if (state->registers[i] == 0) {
+				zero_registers++;
+			}
+		}
+		double alpha = 0.7213 / (1.0 + 1.079 / m);
+		double estimate = alpha * m * m / sum;
+		if (estimate <= 2.5 * m && zero_registers > 0) {
+			// small range correction: linear counting
+			estimate = m * std::log(m / double(zero_registers));
+		}
+		target[idx] = T(std::llround(estimate));
+	}
+
+	static bool IgnoreNull() {
+		return true;
+	}
+};
+
+template <class INPUT_TYPE> static AggregateFunction GetApproxCountDistinctFunction(LogicalType type) {
+	return AggregateFunction::UnaryAggregate<hyperloglog_state_t, INPUT_TYPE, int64_t, ApproxCountDistinctFunction>(
+	    type, LogicalType::BIGINT);
+}
+
+static AggregateFunction GetApproxCountDistinctFunction(PhysicalType type) {
+	switch (type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+		return GetApproxCountDistinctFunction<int8_t>(LogicalType::TINYINT);
+	case PhysicalType::INT16:
+		return GetApproxCountDistinctFunction<int16_t>(LogicalType::SMALLINT);
+	case PhysicalType::INT32:
+		return GetApproxCountDistinctFunction<int32_t>(LogicalType::INTEGER);
+	case PhysicalType::INT64:
+		return GetApproxCountDistinctFunction<int64_t>(LogicalType::BIGINT);
+	case PhysicalType::INT128:
+		return GetApproxCountDistinctFunction<hugeint_t>(LogicalType::HUGEINT);
+	case PhysicalType::FLOAT:
+		return GetApproxCountDistinctFunction<float>(LogicalType::FLOAT);
+	case PhysicalType::DOUBLE:
+		return GetApproxCountDistinctFunction<double>(LogicalType::DOUBLE);
+	case PhysicalType::INTERVAL:
+		return GetApproxCountDistinctFunction<interval_t>(LogicalType::INTERVAL);
+	case PhysicalType::VARCHAR:
+		return GetApproxCountDistinctFunction<string_t>(LogicalType::VARCHAR);
+	default:
+		throw NotImplementedException("Unimplemented type for approx_count_distinct");
+	}
+}
+
+static unique_ptr<FunctionData> bind_approx_count_distinct(ClientContext &context, AggregateFunction &function,
+                                                           vector<unique_ptr<Expression>> &arguments) {
+	auto input_type = arguments[0]->return_type;
+	function = GetApproxCountDistinctFunction(input_type.InternalType());
+	function.arguments[0] = input_type;
+	return nullptr;
+}
+
+void ApproxCountDistinctFun::RegisterFunction(BuiltinFunctions &set) {
+	AggregateFunctionSet approx_count("approx_count_distinct");
+	for (auto type : LogicalType::ALL_TYPES) {
+		if (type.id() == LogicalTypeId::DECIMAL) {
+			approx_count.AddFunction(AggregateFunction({type}, LogicalType::BIGINT, nullptr, nullptr, nullptr, nullptr,
+			                                           nullptr, nullptr, bind_approx_count_distinct));
+		} else {
+			auto function = GetApproxCountDistinctFunction(type.InternalType());
+			function.arguments[0] = type;
+			approx_count.AddFunction(function);
+		}
+	}
+	set.AddFunction(approx_count);
+}
+
+} // namespace duckdb
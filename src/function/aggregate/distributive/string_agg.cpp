@@ -12,6 +12,9 @@ struct string_agg_state_t {
 	idx_t size;
 	idx_t alloc_size;
 	char *dataptr;
+	//! The buffer starts with the separator that preceded the first string; it is not part of the result, but it is
+	//! needed to join the state to the end of another state in Combine
+	idx_t offset;
 };
 
 struct StringAggBaseFunction {
@@ -19,6 +22,7 @@ struct StringAggBaseFunction {
 		state->dataptr = nullptr;
 		state->alloc_size = 0;
 		state->size = 0;
+		state->offset = 0;
 	}
 
 	template <class T, class STATE>
@@ -26,7 +30,7 @@ struct StringAggBaseFunction {
 		if (!state->dataptr) {
 			nullmask[idx] = true;
 		} else {
-			target[idx] = StringVector::AddString(result, state->dataptr, state->size);
+			target[idx] = StringVector::AddString(result, state->dataptr + state->offset, state->size - state->offset);
 		}
 	}
 
@@ -40,42 +44,58 @@ struct StringAggBaseFunction {
 		return true;
 	}
 
-	static inline void PerformOperation(string_agg_state_t *state, const char *str, const char *sep, idx_t str_size,
-	                                    idx_t sep_size) {
-		if (state->dataptr == nullptr) {
-			// first iteration: allocate space for the string and copy it into the state
-			state->alloc_size = MaxValue<idx_t>(8, NextPowerOfTwo(str_size));
-			state->dataptr = new char[state->alloc_size];
-			state->size = str_size - 1;
-			memcpy(state->dataptr, str, str_size);
-		} else {
-			// subsequent iteration: first check if we have space to place the string and separator
-			idx_t required_size = state->size + str_size + sep_size;
-			if (required_size > state->alloc_size) {
-				// no space! allocate extra space
-				while (state->alloc_size < required_size) {
-					state->alloc_size *= 2;
-				}
-				auto new_data = new char[state->alloc_size];
+	static inline void Append(string_agg_state_t *state, const char *data, idx_t data_size) {
+		idx_t required_size = state->size + data_size;
+		if (!state->dataptr || required_size > state->alloc_size) {
+			// no space! allocate extra space
+			// the buffer is also allocated for empty input, as an allocated buffer marks a state that has seen a row
+			state->alloc_size = MaxValue<idx_t>(8, state->alloc_size);
+			while (state->alloc_size < required_size) {
+				state->alloc_size *= 2;
+			}
+			auto new_data = new char[state->alloc_size];
+			if (state->dataptr) {
 				memcpy(new_data, state->dataptr, state->size);
 				delete[] state->dataptr;
-				state->dataptr = new_data;
 			}
-			// copy the separator
-			memcpy(state->dataptr + state->size, sep, sep_size);
-			state->size += sep_size;
-			// copy the string
-			memcpy(state->dataptr + state->size, str, str_size);
-			state->size += str_size - 1;
+			state->dataptr = new_data;
 		}
+		memcpy(state->dataptr + state->size, data, data_size);
+		state->size += data_size;
+	}
+
+	static inline void PerformOperation(string_agg_state_t *state, const char *str, const char *sep, idx_t str_size,
+	                                    idx_t sep_size) {
+		if (state->dataptr == nullptr) {
+			state->offset = sep_size;
+		}
+		Append(state, sep, sep_size);
+		Append(state, str, str_size);
 	}
 
 	static inline void PerformOperation(string_agg_state_t *state, string_t str, string_t sep) {
-		PerformOperation(state, str.GetData(), sep.GetData(), str.GetSize() + 1, sep.GetSize());
+		PerformOperation(state, str.GetData(), sep.GetData(), str.GetSize(), sep.GetSize());
 	}
 
 	static inline void PerformOperation(string_agg_state_t *state, string_t str) {
-		PerformOperation(state, str.GetData(), ",", str.GetSize() + 1, 1);
+		PerformOperation(state, str.GetData(), ",", str.GetSize(), 1);
+	}
+
+	template <class STATE, class OP> static void Combine(STATE &source, STATE *target) {
+		if (source.dataptr == nullptr) {
+			// source is not set: skip combining
+			return;
+		}
+		if (target->dataptr == nullptr) {
+			// target is not set: take over the buffer of the source
+			*target = source;
+		} else {
+			// the strings of the source follow the strings of the target, joined by the first separator of the source
+			Append(target, source.dataptr, source.size);
+			Destroy(&source);
+		}
+		// the source state is moved by the combine
+		Initialize(&source);
 	}
 };
 
@@ -99,15 +119,6 @@ struct StringAggSingleFunction : public StringAggBaseFunction {
 			Operation<INPUT_TYPE, STATE, OP>(state, input, nullmask, 0);
 		}
 	}
-
-	template <class STATE, class OP> static void Combine(STATE source, STATE *target) {
-		if (source.dataptr == nullptr) {
-			// source is not set: skip combining
-			return;
-		}
-		PerformOperation(target, string_t(source.dataptr, source.size));
-		Destroy(&source);
-	}
 };
 
 void StringAggFun::RegisterFunction(BuiltinFunctions &set) {
@@ -116,7 +127,8 @@ void StringAggFun::RegisterFunction(BuiltinFunctions &set) {
 	    {LogicalType::VARCHAR, LogicalType::VARCHAR}, LogicalType::VARCHAR,
 	    AggregateFunction::StateSize<string_agg_state_t>,
 	    AggregateFunction::StateInitialize<string_agg_state_t, StringAggFunction>,
-	    AggregateFunction::BinaryScatterUpdate<string_agg_state_t, string_t, string_t, StringAggFunction>, nullptr,
+	    AggregateFunction::BinaryScatterUpdate<string_agg_state_t, string_t, string_t, StringAggFunction>,
+	    AggregateFunction::StateCombine<string_agg_state_t, StringAggFunction>,
 	    AggregateFunction::StateFinalize<string_agg_state_t, string_t, StringAggFunction>,
 	    AggregateFunction::BinaryUpdate<string_agg_state_t, string_t, string_t, StringAggFunction>, nullptr,
 	    AggregateFunction::StateDestroy<string_agg_state_t, StringAggFunction>));
@@ -0,0 +1,202 @@
+#include "duckdb/function/aggregate/holistic_functions.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/null_value.hpp"
+#include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/common/vector_operations/aggregate_executor.hpp"
+#include "duckdb/planner/expression.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace duckdb {
+
+struct tdigest_centroid_t {
+	double mean;
+	double weight;
+};
+
+//! A merging t-digest with the k1 scale function and compression DELTA. A compressed digest has at most ~DELTA
+//! centroids, so a digest of CAPACITY centroids always has room for new points after compression. The centroids are
+//! stored inline: the state has a fixed size and can be copied freely by the hash tables and the window segment tree.
+struct tdigest_state_t {
+	static constexpr double DELTA = 100;
+	static constexpr idx_t CAPACITY = 128;
+
+	tdigest_centroid_t centroids[CAPACITY];
+	idx_t count;
+	double min;
+	double max;
+	//! The requested quantile in [0, 1]
+	double q;
+};
+
+struct ApproxQuantileOperation {
+	template <class STATE> static void Initialize(STATE *state) {
+		state->count = 0;
+		state->min = 0;
+		state->max = 0;
+		state->q = 0.5;
+	}
+
+	static double ScaleK(double q) {
+		q = MinValue<double>(MaxValue<double>(q, 0), 1);
+		return tdigest_state_t::DELTA / (2 * PI) * std::asin(2 * q - 1);
+	}
+
+	static double ScaleKInverse(double k) {
+		if (k >= tdigest_state_t::DELTA / 4) {
+			return 1;
+		}
+		return (std::sin(k * 2 * PI / tdigest_state_t::DELTA) + 1) / 2;
+	}
+
+	template <class STATE> static void Compress(STATE *state) {
+		if (state->count <= 1) {
+			return;
+		}
+		auto centroids = state->centroids;
+		std::sort(centroids, centroids + state->count,
+		          [](const tdigest_centroid_t &a, const tdigest_centroid_t &b) { return a.mean < b.mean; });
+		double total_weight = 0;
+		for (idx_t i = 0; i < state->count; i++) {
+			total_weight += centroids[i].weight;
+		}
+		// greedily merge neighbouring centroids as long as the merged centroid spans at most one unit of k
+		idx_t result_count = 0;
+		double cumulative_weight = 0;
+		double q_limit = ScaleKInverse(ScaleK(0) + 1);
+		auto current = centroids[0];
+		for (idx_t i = 1; i < state->count; i++) {
+			auto &next = centroids[i];
+			if ((cumulative_weight + current.weight + next.weight) / total_weight <= q_limit) {
+				current.mean += (next.mean - current.mean) * next.weight / (current.weight + next.weight);
+				current.weight += next.weight;
+			} else {
+				cumulative_weight += current.weight;
+				centroids[result_count++] = current;
+				q_limit = ScaleKInverse(ScaleK(cumulative_weight / total_weight) + 1);
+				current = next;
+			}
+		}
+		centroids[result_count++] = current;
+		D_ASSERT(result_count < STATE::CAPACITY);
+		state->count = result_count;
+	}
+
+	template <class STATE> static void AddCentroid(STATE *state, double mean, double weight) {
+		if (state->count == STATE::CAPACITY) {
+			Compress(state);
+		}
+		state->centroids[state->count].mean = mean;
+		state->centroids[state->count].weight = weight;
+		state->count++;
+	}
+
+	template <class A_TYPE, class B_TYPE, class STATE, class OP>
+	static void Operation(STATE *state, A_TYPE *x_data, B_TYPE *q_data, nullmask_t &anullmask, nullmask_t &bnullmask,
+	                      idx_t xidx, idx_t qidx) {
+		double x = x_data[xidx];
+		if (std::isnan(x)) {
+			return;
+		}
+		state->q = q_data[qidx];
+		if (state->count == 0) {
+			state->min = state->max = x;
+		} else {
+			state->min = MinValue<double>(state->min, x);
+			state->max = MaxValue<double>(state->max, x);
+		}
+		AddCentroid(state, x, 1);
+	}
+
+	template <class STATE, class OP> static void Combine(const STATE &source, STATE *target) {
+		if (source.count == 0) {
+			return;
+		}
+		target->q = source.q;
+		if (target->count == 0) {
+			*target = source;
+			return;
+		}
+		target->min = MinValue<double>(target->min, source.min);
+		target->max = MaxValue<double>(target->max, source.max);
+		for (idx_t i = 0; i < source.count; i++) {
+			AddCentroid(target, source.centroids[i].mean, source.centroids[i].weight);
+		}
+	}
+
+	template <class T, class STATE>
+	static void Finalize(Vector &result, STATE *state, T *target, nullmask_t &nullmask, idx_t idx) {
+		if (state->count == 0) {
+			nullmask[idx] = true;
+			return;
+		}
+		Compress(state);
+		auto centroids = state->centroids;
+		if (state->count == 1) {
+			target[idx] = centroids[0].mean;
+			return;
+		}
+		double total_weight = 0;
+		for (idx_t i = 0; i < state->count; i++) {
+			total_weight += centroids[i].weight;
+		}
+		// every centroid represents its weight centered around its mean: interpolate between the centers of the
+		// neighbouring centroids, and between the outer centers and the minimum/maximum
+		double target_weight = state->q * total_weight;
+		double previous_center = 0;
+		double previous_mean = state->min;
+		double cumulative_weight = 0;
+		for (idx_t i = 0; i < state->count; i++) {
+			double center = cumulative_weight + centroids[i].weight / 2;
+			if (target_weight < center) {
+				if (center == previous_center) {
+					target[idx] = centroids[i].mean;
+				} else {
+					target[idx] = previous_mean + (centroids[i].mean - previous_mean) *
+					                                  (target_weight - previous_center) / (center - previous_center);
+				}
+				return;
+			}
+			previous_center = center;
+			previous_mean = centroids[i].mean;
+			cumulative_weight += centroids[i].weight;
+		}
+		if (total_weight == previous_center) {
+			target[idx] = state->max;
+		} else {
+			target[idx] = previous_mean + (state->max - previous_mean) * (target_weight - previous_center) /
+			                                  (total_weight - previous_center);
+		}
+	}
+
+	static bool IgnoreNull() {
+		return true;
+	}
+};
+
+static unique_ptr<FunctionData> bind_approx_quantile(ClientContext &context, AggregateFunction &function,
+                                                     vector<unique_ptr<Expression>> &arguments) {
+	if (!arguments[1]->IsFoldable()) {
+		throw BinderException("APPROX_QUANTILE can only take constant quantile parameters");
+	}
+	Value quantile_val = ExpressionExecutor::EvaluateScalar(*arguments[1]).CastAs(LogicalType::DOUBLE);
+	if (quantile_val.is_null || quantile_val.value_.double_ < 0 || quantile_val.value_.double_ > 1) {
+		throw BinderException("APPROX_QUANTILE can only take parameters in the range [0, 1]");
+	}
+	return nullptr;
+}
+
+void ApproxQuantileFun::RegisterFunction(BuiltinFunctions &set) {
+	AggregateFunctionSet approx_quantile("approx_quantile");
+	auto function = AggregateFunction::BinaryAggregate<tdigest_state_t, double, double, double, ApproxQuantileOperation>(
+	    LogicalType::DOUBLE, LogicalType::DOUBLE, LogicalType::DOUBLE);
+	function.bind = bind_approx_quantile;
+	approx_quantile.AddFunction(function);
+	set.AddFunction(approx_quantile);
+}
+
+} // namespace duckdb
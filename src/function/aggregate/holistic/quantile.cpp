@@ -0,0 +1,224 @@
+#include "duckdb/function/aggregate/holistic_functions.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/null_value.hpp"
+#include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/common/vector_operations/aggregate_executor.hpp"
+#include "duckdb/planner/expression.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace duckdb {
+
+template <class T> struct quantile_state_t {
+	//! The values seen so far
+	T *v;
+	//! The allocated capacity of v
+	idx_t len;
+	//! The number of values in v
+	idx_t pos;
+	//! The requested quantile in [0, 1]
+	double q;
+};
+
+struct QuantileOperation {
+	template <class STATE> static void Initialize(STATE *state) {
+		state->v = nullptr;
+		state->len = 0;
+		state->pos = 0;
+		state->q = 0.5;
+	}
+
+	template <class STATE> static void Resize(STATE *state, idx_t new_len) {
+		if (new_len <= state->len) {
+			return;
+		}
+		auto new_v = new typename std::remove_pointer<decltype(state->v)>::type[new_len];
+		if (state->pos > 0) {
+			memcpy(new_v, state->v, state->pos * sizeof(*state->v));
+		}
+		delete[] state->v;
+		state->v = new_v;
+		state->len = new_len;
+	}
+
+	template <class INPUT_TYPE, class STATE> static void Append(STATE *state, INPUT_TYPE input, idx_t count) {
+		if (state->pos + count > state->len) {
+			Resize(state, MaxValue<idx_t>(MaxValue<idx_t>(state->len * 2, 16), state->pos + count));
+		}
+		for (idx_t i = 0; i < count; i++) {
+			state->v[state->pos++] = input;
+		}
+	}
+
+	template <class STATE, class OP> static void Combine(STATE &source, STATE *target) {
+		if (source.pos == 0) {
+			return;
+		}
+		target->q = source.q;
+		if (target->pos == 0) {
+			// take over the buffer of the source
+			delete[] target->v;
+			*target = source;
+		} else {
+			Resize(target, MaxValue<idx_t>(target->len, target->pos + source.pos));
+			memcpy(target->v + target->pos, source.v, source.pos * sizeof(*source.v));
+			target->pos += source.pos;
+			delete[] source.v;
+		}
+		// the states are moved by the combine: the source no longer owns any values
+		source.v = nullptr;
+		source.len = 0;
+		source.pos = 0;
+	}
+
+	template <class T, class STATE>
+	static void Finalize(Vector &result, STATE *state, T *target, nullmask_t &nullmask, idx_t idx) {
+		if (state->pos == 0) {
+			nullmask[idx] = true;
+			return;
+		}
+		// the discrete quantile: the value at position floor((n - 1) * q) in sorted order
+		auto offset = (idx_t)std::floor((state->pos - 1) * state->q);
+		std::nth_element(state->v, state->v + offset, state->v + state->pos);
+		target[idx] = state->v[offset];
+	}
+
+	template <class STATE> static void Destroy(STATE *state) {
+		delete[] state->v;
+	}
+
+	static bool IgnoreNull() {
+		return true;
+	}
+};
+
+struct QuantileBinaryOperation : public QuantileOperation {
+	template <class A_TYPE, class B_TYPE, class STATE, class OP>
+	static void Operation(STATE *state, A_TYPE *x_data, B_TYPE *q_data, nullmask_t &anullmask, nullmask_t &bnullmask,
+	                      idx_t xidx, idx_t qidx) {
+		state->q = q_data[qidx];
+		Append<A_TYPE, STATE>(state, x_data[xidx], 1);
+	}
+};
+
+struct MedianOperation : public QuantileOperation {
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void Operation(STATE *state, INPUT_TYPE *input, nullmask_t &nullmask, idx_t idx) {
+		Append<INPUT_TYPE, STATE>(state, input[idx], 1);
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void ConstantOperation(STATE *state, INPUT_TYPE *input, nullmask_t &nullmask, idx_t count) {
+		Append<INPUT_TYPE, STATE>(state, input[0], count);
+	}
+};
+
+template <class T> static AggregateFunction GetQuantileFunction(LogicalType type) {
+	auto function = AggregateFunction::BinaryAggregate<quantile_state_t<T>, T, double, T, QuantileBinaryOperation>(
+	    type, LogicalType::DOUBLE, type);
+	function.destructor = AggregateFunction::StateDestroy<quantile_state_t<T>, QuantileBinaryOperation>;
+	return function;
+}
+
+template <class T> static AggregateFunction GetMedianFunction(LogicalType type) {
+	return AggregateFunction::UnaryAggregateDestructor<quantile_state_t<T>, T, T, MedianOperation>(type, type);
+}
+
+static AggregateFunction GetQuantileAggregate(PhysicalType type, bool median) {
+	switch (type) {
+	case PhysicalType::INT8:
+		return median ? GetMedianFunction<int8_t>(LogicalType::TINYINT)
+		              : GetQuantileFunction<int8_t>(LogicalType::TINYINT);
+	case PhysicalType::INT16:
+		return median ? GetMedianFunction<int16_t>(LogicalType::SMALLINT)
+		              : GetQuantileFunction<int16_t>(LogicalType::SMALLINT);
+	case PhysicalType::INT32:
+		return median ? GetMedianFunction<int32_t>(LogicalType::INTEGER)
+		              : GetQuantileFunction<int32_t>(LogicalType::INTEGER);
+	case PhysicalType::INT64:
+		return median ? GetMedianFunction<int64_t>(LogicalType::BIGINT)
+		              : GetQuantileFunction<int64_t>(LogicalType::BIGINT);
+	case PhysicalType::INT128:
+		return median ? GetMedianFunction<hugeint_t>(LogicalType::HUGEINT)
+		              : GetQuantileFunction<hugeint_t>(LogicalType::HUGEINT);
+	case PhysicalType::FLOAT:
+		return median ? GetMedianFunction<float>(LogicalType::FLOAT) : GetQuantileFunction<float>(LogicalType::FLOAT);
+	case PhysicalType::DOUBLE:
+		return median ? GetMedianFunction<double>(LogicalType::DOUBLE)
+		              : GetQuantileFunction<double>(LogicalType::DOUBLE);
+	default:
+		throw NotImplementedException("Unimplemented type for quantile aggregate");
+	}
+}
+
+static void SetQuantileType(AggregateFunction &function, LogicalType type) {
+	function.arguments[0] = type;
+	function.return_type = type;
+}
+
+static unique_ptr<FunctionData> bind_decimal_median(ClientContext &context, AggregateFunction &function,
+                                                    vector<unique_ptr<Expression>> &arguments) {
+	auto decimal_type = arguments[0]->return_type;
+	function = GetQuantileAggregate(decimal_type.InternalType(), true);
+	SetQuantileType(function, decimal_type);
+	return nullptr;
+}
+
+static unique_ptr<FunctionData> bind_quantile(ClientContext &context, AggregateFunction &function,
+                                              vector<unique_ptr<Expression>> &arguments) {
+	if (!arguments[1]->IsFoldable()) {
+		throw BinderException("QUANTILE can only take constant quantile parameters");
+	}
+	Value quantile_val = ExpressionExecutor::EvaluateScalar(*arguments[1]).CastAs(LogicalType::DOUBLE);
+	if (quantile_val.is_null || quantile_val.value_.double_ < 0 || quantile_val.value_.double_ > 1) {
+		throw BinderException("QUANTILE can only take parameters in the range [0, 1]");
+	}
+	auto input_type = arguments[0]->return_type;
+	if (input_type.id() == LogicalTypeId::DECIMAL) {
+		function = GetQuantileAggregate(input_type.InternalType(), false);
+		SetQuantileType(function, input_type);
+	}
+	return nullptr;
+}
+
+static vector<LogicalType> GetQuantileTypes() {
+	return {LogicalType::TINYINT, LogicalType::SMALLINT, LogicalType::INTEGER, LogicalType::BIGINT,
+	        LogicalType::HUGEINT, LogicalType::FLOAT,    LogicalType::DOUBLE,  LogicalType::DATE,
+	        LogicalType::TIMESTAMP, LogicalType::DECIMAL};
+}
+
+void QuantileFun::RegisterFunction(BuiltinFunctions &set) {
+	AggregateFunctionSet quantile("quantile");
+	for (auto &type : GetQuantileTypes()) {
+		AggregateFunction function({type, LogicalType::DOUBLE}, type, nullptr, nullptr, nullptr, nullptr, nullptr,
+		                           nullptr, bind_quantile);
+		if (type.id() != LogicalTypeId::DECIMAL) {
+			function = GetQuantileAggregate(type.InternalType(), false);
+			SetQuantileType(function, type);
+			function.bind = bind_quantile;
+		}
+		quantile.AddFunction(function);
+	}
+	set.AddFunction(quantile);
+}
+
+void MedianFun::RegisterFunction(BuiltinFunctions &set) {
+	AggregateFunctionSet median("median");
+	for (auto &type : GetQuantileTypes()) {
+		if (type.id() == LogicalTypeId::DECIMAL) {
+			median.AddFunction(
+			    AggregateFunction({type}, type, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, bind_decimal_median));
+		} else {
+			auto function = GetQuantileAggregate(type.InternalType(), true);
+			SetQuantileType(function, type);
+			median.AddFunction(function);
+		}
+	}
+	set.AddFunction(median);
+}
+
+} // namespace duckdb
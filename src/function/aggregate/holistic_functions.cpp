@@ -0,0 +1,13 @@
+#include "duckdb/function/aggregate/holistic_functions.hpp"
+
+using namespace std;
+
+namespace duckdb {
+
+void BuiltinFunctions::RegisterHolisticAggregates() {
+	Register<QuantileFun>();
+	Register<MedianFun>();
+	Register<ApproxQuantileFun>();
+}
+
+} // namespace duckdb
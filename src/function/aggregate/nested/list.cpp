@@ -15,10 +15,6 @@ struct ListFunction {
 		state->cc = nullptr;
 	}
 
-	template <class STATE, class OP> static void Combine(STATE source, STATE *target) {
-		throw NotImplementedException("COMBINE not implemented for LIST");
-	}
-
 	template <class STATE> static void Destroy(STATE *state) {
 		if (state->cc) {
 			delete state->cc;
@@ -65,12 +61,19 @@ static void list_combine(Vector &state, Vector &combined, idx_t count) {
 
 	for (idx_t i = 0; i < count; i++) {
 		auto state = states_ptr[sdata.sel->get_index(i)];
-		D_ASSERT(state->cc);
+		if (!state->cc) {
+			// the source state is empty (e.g. a thread that did not see any rows)
+			continue;
+		}
 		if (!combined_ptr[i]->cc) {
-			combined_ptr[i]->cc = new ChunkCollection();
+			// take over the collection of the source
+			combined_ptr[i]->cc = state->cc;
+		} else {
+			// the rows of the source follow the rows of the target
+			combined_ptr[i]->cc->Append(*state->cc);
+			delete state->cc;
 		}
-		combined_ptr[i]->cc->Append(*state->cc);
-		delete state->cc;
+		state->cc = nullptr;
 	}
 }
 
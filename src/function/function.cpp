@@ -33,6 +33,7 @@ void BuiltinFunctions::Initialize() {
 
 	RegisterAlgebraicAggregates();
 	RegisterDistributiveAggregates();
+	RegisterHolisticAggregates();
 	RegisterNestedAggregates();
 
 	RegisterDateFunctions();
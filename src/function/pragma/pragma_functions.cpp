@@ -60,6 +60,15 @@ static void pragma_memory_limit(ClientContext &context, FunctionParameters param
 	context.db.storage->buffer_manager->SetLimit(new_limit);
 }
 
+static void pragma_commit_delay(ClientContext &context, FunctionParameters parameters) {
+	auto commit_delay = parameters.values[0].GetValue<int64_t>();
+	if (commit_delay < 0) {
+		throw InvalidInputException("Commit delay must be a non-negative number of microseconds");
+	}
+	auto &config = DBConfig::GetConfig(context);
+	config.commit_delay = commit_delay;
+}
+
 static void pragma_collation(ClientContext &context, FunctionParameters parameters) {
 	auto collation_param = StringUtil::Lower(parameters.values[0].ToString());
 	// bind the collation to verify that it exists
@@ -161,6 +170,8 @@ void PragmaFunctions::RegisterFunction(BuiltinFunctions &set) {
 
 	set.AddFunction(PragmaFunction::PragmaAssignment("memory_limit", pragma_memory_limit, LogicalType::VARCHAR));
 
+	set.AddFunction(PragmaFunction::PragmaAssignment("commit_delay", pragma_commit_delay, LogicalType::BIGINT));
+
 	set.AddFunction(PragmaFunction::PragmaAssignment("collation", pragma_collation, LogicalType::VARCHAR));
 	set.AddFunction(PragmaFunction::PragmaAssignment("default_collation", pragma_collation, LogicalType::VARCHAR));
 
@@ -28,6 +28,10 @@ string pragma_show(ClientContext &context, FunctionParameters parameters) {
 	    parameters.values[0].ToString());
 }
 
+string pragma_buffer_manager_stats(ClientContext &context, FunctionParameters parameters) {
+	return "SELECT * FROM pragma_buffer_manager_stats()";
+}
+
 string pragma_version(ClientContext &context, FunctionParameters parameters) {
 	return "SELECT * FROM pragma_version()";
 }
@@ -56,6 +60,7 @@ void PragmaQueries::RegisterFunction(BuiltinFunctions &set) {
 	set.AddFunction(PragmaFunction::PragmaStatement("collations", pragma_collations));
 	set.AddFunction(PragmaFunction::PragmaCall("show", pragma_show, {LogicalType::VARCHAR}));
 	set.AddFunction(PragmaFunction::PragmaStatement("version", pragma_version));
+	set.AddFunction(PragmaFunction::PragmaStatement("buffer_manager_stats", pragma_buffer_manager_stats));
 	set.AddFunction(PragmaFunction::PragmaCall("import_database", pragma_import_database, {LogicalType::VARCHAR}));
 }
 
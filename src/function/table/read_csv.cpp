@@ -3,6 +3,9 @@
 #include "duckdb/function/function_set.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/database.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/parallel/parallel_state.hpp"
 
 using namespace std;
 
@@ -26,6 +29,7 @@ static unique_ptr<FunctionData> read_csv_bind(ClientContext &context, vector<Val
 	options.header = false;
 	options.delimiter = ",";
 	options.quote = "\"";
+	bool parallel = true;
 
 	for (auto &kv : named_parameters) {
 		if (kv.first == "auto_detect") {
@@ -87,6 +91,8 @@ static unique_ptr<FunctionData> read_csv_bind(ClientContext &context, vector<Val
 			}
 		} else if (kv.first == "filename") {
 			result->include_file_name = kv.second.value_.boolean;
+		} else if (kv.first == "parallel") {
+			parallel = kv.second.value_.boolean;
 		}
 	}
 	if (!options.auto_detect && return_types.size() == 0) {
@@ -98,11 +104,24 @@ static unique_ptr<FunctionData> read_csv_bind(ClientContext &context, vector<Val
 
 		return_types.assign(initial_reader->sql_types.begin(), initial_reader->sql_types.end());
 		names.assign(initial_reader->col_names.begin(), initial_reader->col_names.end());
+		// the byte ranges of all files are parsed with the sniffed dialect of the first file
+		result->range_options = initial_reader->options;
+		result->range_types = initial_reader->sql_types;
 		result->initial_reader = move(initial_reader);
 	} else {
 		result->sql_types = return_types;
+		result->range_options = options;
+		result->range_types = return_types;
 		D_ASSERT(return_types.size() == names.size());
 	}
+	result->range_options.auto_detect = false;
+	result->parallel = parallel && BufferedCSVReader::SupportsRanges(result->range_options);
+	for (auto &file : result->files) {
+		if (StringUtil::EndsWith(StringUtil::Lower(file), ".gz")) {
+			// compressed files cannot be split up into byte ranges
+			result->parallel = false;
+		}
+	}
 	if (result->include_file_name) {
 		return_types.push_back(LogicalType::VARCHAR);
 		names.push_back("filename");
@@ -113,10 +132,29 @@ static unique_ptr<FunctionData> read_csv_bind(ClientContext &context, vector<Val
 struct ReadCSVOperatorData : public FunctionOperatorData {
 	//! The CSV reader
 	unique_ptr<BufferedCSVReader> csv_reader;
-	//! The index of the next file to read (i.e. current file + 1)
+	//! The index of the next file to read (i.e. current file + 1), or the file of the reader in a parallel scan
+	idx_t file_index;
+	//! Whether or not the reader reads the byte ranges handed out by a parallel scan
+	bool is_parallel = false;
+};
+
+struct ReadCSVParallelState : public ParallelState {
+	mutex lock;
+	//! The index of the file that is currently split up into byte ranges
 	idx_t file_index;
+	//! The handle used to find the row boundaries in the current file
+	unique_ptr<FileHandle> handle;
+	//! The size of the current file
+	idx_t file_size;
+	//! The offset at which the next byte range starts; this is always the start of a row
+	idx_t next_offset;
 };
 
+//! The size of the byte ranges that the files are split into in a parallel scan
+static idx_t read_csv_range_size(ClientContext &context) {
+	return context.force_parallelism ? 1024 : 8 * 1024 * 1024;
+}
+
 static unique_ptr<FunctionOperatorData> read_csv_init(ClientContext &context, const FunctionData *bind_data_,
                                                       vector<column_t> &column_ids,
                                                       unordered_map<idx_t, vector<TableFilter>> &table_filters) {
@@ -145,7 +183,7 @@ static void read_csv_function(ClientContext &context, const FunctionData *bind_d
 	auto &data = (ReadCSVOperatorData &)*operator_state;
 	do {
 		data.csv_reader->ParseCSV(output);
-		if (output.size() == 0 && data.file_index < bind_data.files.size()) {
+		if (output.size() == 0 && !data.is_parallel && data.file_index < bind_data.files.size()) {
 			// exhausted this file, but we have more files we can read
 			// open the next file and increment the counter
 			bind_data.options.file_path = bind_data.files[data.file_index];
@@ -162,6 +200,86 @@ static void read_csv_function(ClientContext &context, const FunctionData *bind_d
 	}
 }
 
+static idx_t read_csv_max_threads(ClientContext &context, const FunctionData *bind_data_) {
+	auto &bind_data = (ReadCSVData &)*bind_data_;
+	if (!bind_data.parallel) {
+		return 1;
+	}
+	auto &fs = FileSystem::GetFileSystem(context);
+	idx_t total_size = 0;
+	for (auto &file : bind_data.files) {
+		auto handle = fs.OpenFile(file, FileFlags::FILE_FLAGS_READ);
+		total_size += fs.GetFileSize(*handle);
+	}
+	return total_size / read_csv_range_size(context) + 1;
+}
+
+static void read_csv_open_file(ClientContext &context, ReadCSVData &bind_data, ReadCSVParallelState &state,
+                               idx_t file_index) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	state.file_index = file_index;
+	state.handle = fs.OpenFile(bind_data.files[file_index], FileFlags::FILE_FLAGS_READ);
+	state.file_size = fs.GetFileSize(*state.handle);
+	// the rows of every file start after its skipped rows and header
+	state.next_offset = BufferedCSVReader::FindDataStart(fs, *state.handle, state.file_size, bind_data.range_options);
+}
+
+static unique_ptr<ParallelState> read_csv_init_parallel_state(ClientContext &context, const FunctionData *bind_data_) {
+	auto &bind_data = (ReadCSVData &)*bind_data_;
+	auto result = make_unique<ReadCSVParallelState>();
+	read_csv_open_file(context, bind_data, *result, 0);
+	return move(result);
+}
+
+static bool read_csv_parallel_state_next(ClientContext &context, const FunctionData *bind_data_,
+                                         FunctionOperatorData *operator_state, ParallelState *parallel_state_) {
+	auto &bind_data = (ReadCSVData &)*bind_data_;
+	auto &data = (ReadCSVOperatorData &)*operator_state;
+	auto &parallel_state = (ReadCSVParallelState &)*parallel_state_;
+
+	idx_t file_index, range_start, range_end;
+	{
+		lock_guard<mutex> parallel_lock(parallel_state.lock);
+		while (parallel_state.next_offset >= parallel_state.file_size) {
+			// the current file has been handed out entirely: move to the next file (if any)
+			if (parallel_state.file_index + 1 >= bind_data.files.size()) {
+				return false;
+			}
+			read_csv_open_file(context, bind_data, parallel_state, parallel_state.file_index + 1);
+		}
+		// the range ends at the first row boundary after the range size, taking quoted newlines into account
+		auto &fs = FileSystem::GetFileSystem(context);
+		file_index = parallel_state.file_index;
+		range_start = parallel_state.next_offset;
+		range_end =
+		    BufferedCSVReader::FindRowStart(fs, *parallel_state.handle, parallel_state.file_size, bind_data.range_options,
+		                                    range_start, range_start + read_csv_range_size(context));
+		parallel_state.next_offset = range_end;
+	}
+	if (!data.csv_reader || data.file_index != file_index) {
+		// the ranges are parsed without re-sniffing, and contain neither skipped rows nor headers
+		auto options = bind_data.range_options;
+		options.file_path = bind_data.files[file_index];
+		options.header = false;
+		options.skip_rows = 0;
+		data.csv_reader = make_unique<BufferedCSVReader>(context, options, bind_data.range_types);
+		data.file_index = file_index;
+	}
+	data.csv_reader->SetRange(range_start, range_end);
+	return true;
+}
+
+static unique_ptr<FunctionOperatorData>
+read_csv_parallel_init(ClientContext &context, const FunctionData *bind_data_, ParallelState *parallel_state_,
+                       vector<column_t> &column_ids, unordered_map<idx_t, vector<TableFilter>> &table_filters) {
+	auto result = make_unique<ReadCSVOperatorData>();
+	result->is_parallel = true;
+	if (!read_csv_parallel_state_next(context, bind_data_, result.get(), parallel_state_)) {
+		return nullptr;
+	}
+	return move(result);
+}
+
 static void add_named_parameters(TableFunction &table_function) {
 	table_function.named_parameters["sep"] = LogicalType::VARCHAR;
 	table_function.named_parameters["delim"] = LogicalType::VARCHAR;
@@ -176,11 +294,20 @@ static void add_named_parameters(TableFunction &table_function) {
 	table_function.named_parameters["dateformat"] = LogicalType::VARCHAR;
 	table_function.named_parameters["timestampformat"] = LogicalType::VARCHAR;
 	table_function.named_parameters["filename"] = LogicalType::BOOLEAN;
+	table_function.named_parameters["parallel"] = LogicalType::BOOLEAN;
+}
+
+static void add_parallel_scan(TableFunction &table_function) {
+	table_function.max_threads = read_csv_max_threads;
+	table_function.init_parallel_state = read_csv_init_parallel_state;
+	table_function.parallel_init = read_csv_parallel_init;
+	table_function.parallel_state_next = read_csv_parallel_state_next;
 }
 
 TableFunction ReadCSVTableFunction::GetFunction() {
 	TableFunction read_csv("read_csv", {LogicalType::VARCHAR}, read_csv_function, read_csv_bind, read_csv_init);
 	add_named_parameters(read_csv);
+	add_parallel_scan(read_csv);
 	return read_csv;
 }
 
@@ -190,6 +317,7 @@ void ReadCSVTableFunction::RegisterFunction(BuiltinFunctions &set) {
 	TableFunction read_csv_auto("read_csv_auto", {LogicalType::VARCHAR}, read_csv_function, read_csv_auto_bind,
 	                            read_csv_init);
 	add_named_parameters(read_csv_auto);
+	add_parallel_scan(read_csv_auto);
 	set.AddFunction(read_csv_auto);
 }
 
@@ -0,0 +1,72 @@
+#include "duckdb/function/table/sqlite_functions.hpp"
+
+#include "duckdb/storage/buffer_manager.hpp"
+
+using namespace std;
+
+namespace duckdb {
+
+struct PragmaBufferManagerStatsData : public FunctionOperatorData {
+	PragmaBufferManagerStatsData() : finished(false) {
+	}
+
+	bool finished;
+};
+
+static unique_ptr<FunctionData> pragma_buffer_manager_stats_bind(ClientContext &context, vector<Value> &inputs,
+                                                                 unordered_map<string, Value> &named_parameters,
+                                                                 vector<LogicalType> &return_types,
+                                                                 vector<string> &names) {
+	names.push_back("memory_usage");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.push_back("memory_limit");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.push_back("hits");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.push_back("misses");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.push_back("evictions");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.push_back("prefetches");
+	return_types.push_back(LogicalType::BIGINT);
+
+	return nullptr;
+}
+
+unique_ptr<FunctionOperatorData>
+pragma_buffer_manager_stats_init(ClientContext &context, const FunctionData *bind_data, vector<column_t> &column_ids,
+                                 unordered_map<idx_t, vector<TableFilter>> &table_filters) {
+	return make_unique<PragmaBufferManagerStatsData>();
+}
+
+void pragma_buffer_manager_stats(ClientContext &context, const FunctionData *bind_data,
+                                 FunctionOperatorData *operator_state, DataChunk &output) {
+	auto &data = (PragmaBufferManagerStatsData &)*operator_state;
+	if (data.finished) {
+		return;
+	}
+	auto &buffer_manager = BufferManager::GetBufferManager(context);
+	auto stats = buffer_manager.GetStatistics();
+
+	output.SetCardinality(1);
+	output.data[0].SetValue(0, Value::BIGINT(buffer_manager.GetUsedMemory()));
+	output.data[1].SetValue(0, Value::BIGINT(buffer_manager.GetMaxMemory()));
+	output.data[2].SetValue(0, Value::BIGINT(stats.hits));
+	output.data[3].SetValue(0, Value::BIGINT(stats.misses));
+	output.data[4].SetValue(0, Value::BIGINT(stats.evictions));
+	output.data[5].SetValue(0, Value::BIGINT(stats.prefetches));
+
+	data.finished = true;
+}
+
+void PragmaBufferManagerStats::RegisterFunction(BuiltinFunctions &set) {
+	set.AddFunction(TableFunction("pragma_buffer_manager_stats", {}, pragma_buffer_manager_stats,
+	                              pragma_buffer_manager_stats_bind, pragma_buffer_manager_stats_init));
+}
+
+} // namespace duckdb
@@ -3,6 +3,7 @@
 
 #include "duckdb/parallel/task_context.hpp"
 #include "duckdb/storage/data_table.hpp"
+#include "duckdb/storage/index.hpp"
 #include "duckdb/transaction/transaction.hpp"
 #include "duckdb/transaction/local_storage.hpp"
 
@@ -14,6 +15,8 @@
 #include "duckdb/parallel/parallel_state.hpp"
 
 #include "duckdb/common/mutex.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
 
 namespace duckdb {
 
@@ -144,6 +147,152 @@ static void index_scan_function(ClientContext &context, const FunctionData *bind
 	}
 }
 
+//===--------------------------------------------------------------------===//
+// Index Range Scan
+//===--------------------------------------------------------------------===//
+//! The amount of sub-ranges the range of an index scan is split into
+static constexpr idx_t INDEX_RANGE_SCAN_MAX_RANGES = 1024;
+//! The maximum estimated fraction of the index that a range can cover for the index to be used instead of a
+//! sequential scan
+static constexpr double INDEX_RANGE_SCAN_MAX_FRACTION = 0.2;
+
+struct ParallelIndexRangeScanState : public ParallelState {
+	std::mutex lock;
+	//! The next sub-range to scan
+	idx_t next_range = 0;
+	//! Whether or not the transaction-local storage has been handed out to be scanned
+	bool local_storage_assigned = false;
+};
+
+struct IndexRangeScanOperatorData : public FunctionOperatorData {
+	//! The (sorted) row ids of the current sub-range
+	vector<row_t> row_ids;
+	//! The position of the next row id to fetch
+	idx_t offset = 0;
+	ColumnFetchState fetch_state;
+	//! Whether or not the transaction-local storage is scanned
+	bool scan_local_storage = false;
+	LocalScanState local_storage_state;
+	vector<column_t> column_ids;
+	//! The state of the sub-ranges in case of a sequential scan
+	unique_ptr<ParallelIndexRangeScanState> sequential_state;
+};
+
+static bool index_range_scan_next(ClientContext &context, const TableScanBindData &bind_data,
+                                  IndexRangeScanOperatorData &state, ParallelIndexRangeScanState &parallel_state) {
+	state.row_ids.clear();
+	state.offset = 0;
+	idx_t range_idx;
+	{
+		lock_guard<mutex> parallel_lock(parallel_state.lock);
+		if (parallel_state.next_range >= bind_data.range_count) {
+			if (parallel_state.local_storage_assigned) {
+				return false;
+			}
+			parallel_state.local_storage_assigned = true;
+			// the rows that were appended by the transaction itself are not in the index yet: scan all of them
+			auto &transaction = Transaction::GetTransaction(context);
+			transaction.storage.InitializeScan(bind_data.table->storage.get(), state.local_storage_state);
+			state.scan_local_storage = true;
+			return true;
+		}
+		range_idx = parallel_state.next_range++;
+	}
+	IndexLock lock;
+	bind_data.index->InitializeLock(lock);
+	bind_data.index->ScanRange(lock, *bind_data.index_state, range_idx, state.row_ids);
+	// fetch the rows in the order in which they are stored
+	sort(state.row_ids.begin(), state.row_ids.end());
+	return true;
+}
+
+static void index_range_scan_fetch(ClientContext &context, const TableScanBindData &bind_data,
+                                   IndexRangeScanOperatorData &state, DataChunk &output) {
+	auto &transaction = Transaction::GetTransaction(context);
+	// rows that are not visible to the transaction are skipped by the fetch: keep fetching until we have any rows
+	while (output.size() == 0 && state.offset < state.row_ids.size()) {
+		idx_t count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, state.row_ids.size() - state.offset);
+		Vector row_ids(LOGICAL_ROW_TYPE, (data_ptr_t)&state.row_ids[state.offset]);
+		bind_data.table->storage->Fetch(transaction, output, state.column_ids, row_ids, count, state.fetch_state);
+		state.offset += count;
+	}
+	if (output.size() == 0 && state.scan_local_storage) {
+		transaction.storage.Scan(state.local_storage_state, state.column_ids, output);
+	}
+}
+
+static unique_ptr<FunctionOperatorData> index_range_scan_init(ClientContext &context, const FunctionData *bind_data_,
+                                                              vector<column_t> &column_ids,
+                                                              unordered_map<idx_t, vector<TableFilter>> &table_filters) {
+	auto &bind_data = (const TableScanBindData &)*bind_data_;
+	auto result = make_unique<IndexRangeScanOperatorData>();
+	result->column_ids = column_ids;
+	result->sequential_state = make_unique<ParallelIndexRangeScanState>();
+	index_range_scan_next(context, bind_data, *result, *result->sequential_state);
+	return move(result);
+}
+
+static void index_range_scan_function(ClientContext &context, const FunctionData *bind_data_,
+                                      FunctionOperatorData *operator_state, DataChunk &output) {
+	auto &bind_data = (const TableScanBindData &)*bind_data_;
+	auto &state = (IndexRangeScanOperatorData &)*operator_state;
+	do {
+		index_range_scan_fetch(context, bind_data, state, output);
+		if (output.size() > 0 || !state.sequential_state) {
+			// in a parallel scan the next sub-range is obtained through index_range_scan_parallel_state_next
+			return;
+		}
+	} while (index_range_scan_next(context, bind_data, state, *state.sequential_state));
+}
+
+static idx_t index_range_scan_max_threads(ClientContext &context, const FunctionData *bind_data_) {
+	auto &bind_data = (const TableScanBindData &)*bind_data_;
+	return bind_data.range_count;
+}
+
+static unique_ptr<ParallelState> index_range_scan_init_parallel_state(ClientContext &context,
+                                                                      const FunctionData *bind_data_) {
+	return make_unique<ParallelIndexRangeScanState>();
+}
+
+static unique_ptr<FunctionOperatorData>
+index_range_scan_parallel_init(ClientContext &context, const FunctionData *bind_data_, ParallelState *state,
+                               vector<column_t> &column_ids, unordered_map<idx_t, vector<TableFilter>> &table_filters) {
+	auto &bind_data = (const TableScanBindData &)*bind_data_;
+	auto result = make_unique<IndexRangeScanOperatorData>();
+	result->column_ids = column_ids;
+	if (!index_range_scan_next(context, bind_data, *result, (ParallelIndexRangeScanState &)*state)) {
+		return nullptr;
+	}
+	return move(result);
+}
+
+static bool index_range_scan_parallel_state_next(ClientContext &context, const FunctionData *bind_data_,
+                                                 FunctionOperatorData *operator_state, ParallelState *parallel_state_) {
+	auto &bind_data = (const TableScanBindData &)*bind_data_;
+	return index_range_scan_next(context, bind_data, (IndexRangeScanOperatorData &)*operator_state,
+	                             (ParallelIndexRangeScanState &)*parallel_state_);
+}
+
+static unique_ptr<IndexScanState> InitializeIndexScan(Transaction &transaction, Index &index, Value &equal_value,
+                                                      Value &low_value, ExpressionType low_comparison_type,
+                                                      Value &high_value, ExpressionType high_comparison_type) {
+	if (!equal_value.is_null) {
+		// equality predicate
+		return index.InitializeScanSinglePredicate(transaction, equal_value, ExpressionType::COMPARE_EQUAL);
+	} else if (!low_value.is_null && !high_value.is_null) {
+		// two-sided predicate
+		return index.InitializeScanTwoPredicates(transaction, low_value, low_comparison_type, high_value,
+		                                         high_comparison_type);
+	} else if (!low_value.is_null) {
+		// less than predicate
+		return index.InitializeScanSinglePredicate(transaction, low_value, low_comparison_type);
+	} else {
+		D_ASSERT(!high_value.is_null);
+		return index.InitializeScanSinglePredicate(transaction, high_value, high_comparison_type);
+	}
+}
+
 static void RewriteIndexExpression(Index &index, LogicalGet &get, Expression &expr, bool &rewrite_possible) {
 	if (expr.type == ExpressionType::BOUND_COLUMN_REF) {
 		auto &bound_colref = (BoundColumnRefExpression &)expr;
@@ -265,22 +414,8 @@ void table_scan_pushdown_complex_filter(ClientContext &context, LogicalGet &get,
 		if (!equal_value.is_null || !low_value.is_null || !high_value.is_null) {
 			// we can scan this index using this predicate: try a scan
 			auto &transaction = Transaction::GetTransaction(context);
-			unique_ptr<IndexScanState> index_state;
-			if (!equal_value.is_null) {
-				// equality predicate
-				index_state =
-				    index->InitializeScanSinglePredicate(transaction, equal_value, ExpressionType::COMPARE_EQUAL);
-			} else if (!low_value.is_null && !high_value.is_null) {
-				// two-sided predicate
-				index_state = index->InitializeScanTwoPredicates(transaction, low_value, low_comparison_type,
-				                                                 high_value, high_comparison_type);
-			} else if (!low_value.is_null) {
-				// less than predicate
-				index_state = index->InitializeScanSinglePredicate(transaction, low_value, low_comparison_type);
-			} else {
-				D_ASSERT(!high_value.is_null);
-				index_state = index->InitializeScanSinglePredicate(transaction, high_value, high_comparison_type);
-			}
+			auto index_state = InitializeIndexScan(transaction, *index, equal_value, low_value, low_comparison_type,
+			                                       high_value, high_comparison_type);
 			if (index->Scan(transaction, storage, *index_state, STANDARD_VECTOR_SIZE, bind_data.result_ids)) {
 				// use an index scan!
 				bind_data.is_index_scan = true;
@@ -292,6 +427,25 @@ void table_scan_pushdown_complex_filter(ClientContext &context, LogicalGet &get,
 				get.function.filter_pushdown = false;
 			} else {
 				bind_data.result_ids.clear();
+				// the scan matches more rows than fit in a vector: split the range into sub-ranges that are scanned
+				// in parallel, unless the range covers too much of the index to beat a sequential scan
+				shared_ptr<IndexScanState> range_state = InitializeIndexScan(
+				    transaction, *index, equal_value, low_value, low_comparison_type, high_value, high_comparison_type);
+				double estimated_fraction;
+				auto range_count = index->SplitScan(*range_state, INDEX_RANGE_SCAN_MAX_RANGES, estimated_fraction);
+				if (range_count > 0 && estimated_fraction <= INDEX_RANGE_SCAN_MAX_FRACTION) {
+					bind_data.is_index_scan = true;
+					bind_data.index = index.get();
+					bind_data.index_state = move(range_state);
+					bind_data.range_count = range_count;
+					get.function.init = index_range_scan_init;
+					get.function.function = index_range_scan_function;
+					get.function.max_threads = index_range_scan_max_threads;
+					get.function.init_parallel_state = index_range_scan_init_parallel_state;
+					get.function.parallel_init = index_range_scan_parallel_init;
+					get.function.parallel_state_next = index_range_scan_parallel_state_next;
+					get.function.filter_pushdown = false;
+				}
 			}
 			return;
 		}
@@ -0,0 +1,28 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/enums/compression_type.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/constants.hpp"
+
+namespace duckdb {
+
+//! The compression that is used for a persistent column segment
+enum class CompressionType : uint8_t {
+	//! The segment is stored as-is in the layout of the in-memory segment
+	UNCOMPRESSED = 0,
+	//! All rows of the segment have the same value (or are all NULL)
+	CONSTANT = 1,
+	//! Every vector is stored as a set of (value, run length) pairs
+	RLE = 2,
+	//! Every vector is stored as the offsets from its minimum value (frame of reference), bit-packed at the minimal
+	//! bit width
+	BITPACKING = 3
+};
+
+} // namespace duckdb
@@ -64,7 +64,12 @@ public:
 		return *chunks[LocateChunk(index)];
 	}
 
+	//! Sorts the leading desc.size() columns of the collection by radix sorting their normalized sort keys, and writes
+	//! the sorted row indices to the result
 	void Sort(vector<OrderType> &desc, vector<OrderByNullType> &null_order, idx_t result[]);
+	//! Compares the leading desc.size() columns of two rows, returns -1, 0 or 1 like a C comparator
+	static int CompareTuple(DataChunk &left, idx_t left_idx, DataChunk &right, idx_t right_idx,
+	                        vector<OrderType> &desc, vector<OrderByNullType> &null_order);
 	//! Reorders the rows in the collection according to the given indices. NB: order is changed!
 	void Reorder(idx_t order[]);
 
@@ -80,6 +85,7 @@ public:
 		return result;
 	}
 
+	//! Writes the row indices of the heap_size smallest rows in sorted order to the heap
 	void Heap(vector<OrderType> &desc, vector<OrderByNullType> &null_order, idx_t heap[], idx_t heap_size);
 	idx_t MaterializeHeapChunk(DataChunk &target, idx_t order[], idx_t start_offset, idx_t heap_size);
 };
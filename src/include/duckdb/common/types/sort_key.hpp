@@ -0,0 +1,55 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/types/sort_key.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/enums/order_type.hpp"
+#include "duckdb/common/types/data_chunk.hpp"
+
+namespace duckdb {
+
+//! The SortKeyLayout describes how the ORDER BY columns of a row are normalized into a fixed-width key that can be
+//! compared with memcmp. Every column is encoded as a single NULL byte followed by the big-endian value with the sign
+//! bit flipped; for descending columns all bytes of the column are inverted. Strings are encoded by a fixed-size
+//! prefix, after which the key ends: rows with equal keys then have to be compared on their actual values.
+class SortKeyLayout {
+public:
+	//! The maximum amount of bytes of a string that are stored in the key
+	static constexpr idx_t STRING_PREFIX_LENGTH = 12;
+
+	SortKeyLayout(vector<LogicalType> &types, vector<OrderType> &order_types, vector<OrderByNullType> &null_order);
+
+	//! The width of the key in bytes
+	idx_t key_width;
+	//! Whether or not the key fully determines the order of the rows. If this is false, rows with equal keys still
+	//! have to be compared on the actual values of the ORDER BY columns.
+	bool complete;
+
+public:
+	//! Encodes the keys of the rows of the chunk; the key of row i is written to (keys + i * key_stride)
+	void Encode(DataChunk &chunk, data_ptr_t keys, idx_t key_stride);
+
+private:
+	//! The physical types of the columns that are encoded into the key
+	vector<PhysicalType> column_types;
+	//! The order types of the encoded columns
+	vector<OrderType> order_types;
+	//! The NULL order of the encoded columns
+	vector<OrderByNullType> null_order;
+	//! The width of the encoded columns (including the NULL byte)
+	vector<idx_t> column_widths;
+};
+
+//! MSD radix sort over fixed-width entries that start with a memcmp-comparable key
+class RadixSort {
+public:
+	//! Sorts count entries of entry_width bytes on their first key_width bytes
+	static void Sort(data_ptr_t entries, idx_t count, idx_t entry_width, idx_t key_width);
+};
+
+} // namespace duckdb
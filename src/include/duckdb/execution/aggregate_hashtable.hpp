@@ -95,7 +95,8 @@ public:
 
 	//! Scan the HT starting from the scan_position until the result and group
 	//! chunks are filled. scan_position will be updated by this function.
-	//! Returns the amount of elements found.
+	//! Returns the amount of elements found. A finalized HT can be scanned by
+	//! multiple threads at the same time.
 	idx_t Scan(idx_t &scan_position, DataChunk &result);
 
 	//! Fetch the aggregates for specific groups from the HT and place them in the result
@@ -197,7 +198,14 @@ private:
 
 	void Verify();
 
-	void FlushMove(Vector &source_addresses, Vector &source_hashes, idx_t count);
+	//! Move the groups at the source addresses into this HT. If skip_distinct is set, the states of the distinct
+	//! aggregates are not combined: they are instead recomputed from the distinct HTs (see CombineDistinct)
+	void FlushMove(Vector &source_addresses, Vector &source_hashes, idx_t count, bool skip_distinct = false);
+	//! Fold the (group, argument) pairs of the distinct HTs of other that are not yet present in the distinct HTs of
+	//! this HT into the distinct aggregate states
+	void CombineDistinct(GroupedAggregateHashTable &other);
+	//! Radix-partition the distinct HTs by the hash of their group columns into the distinct HTs of partition_hts
+	void PartitionDistinct(vector<GroupedAggregateHashTable *> &partition_hts, hash_t mask, idx_t shift);
 	void NewBlock();
 
 	template <class T> void VerifyInternal();
@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/execution/buffered_chunk_collection.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/types/data_chunk.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+namespace duckdb {
+
+//! A BufferedChunkCollection is an append-only sequence of DataChunks that are serialized into buffers handed out by
+//! the BufferManager, which allows them to be offloaded to the temporary directory when they do not fit in memory.
+//! Types that cannot be serialized (e.g. LIST or STRUCT), or buffer managers without a temporary directory, keep the
+//! chunks in memory instead.
+class BufferedChunkCollection {
+public:
+	BufferedChunkCollection(BufferManager &buffer_manager, vector<LogicalType> types);
+	~BufferedChunkCollection();
+
+	//! The types of the chunks stored in the collection
+	vector<LogicalType> types;
+
+public:
+	//! Append a chunk to the end of the collection
+	void Append(DataChunk &chunk);
+	//! Loads the chunk at the specified index of the collection into the result
+	void GetChunk(idx_t chunk_idx, DataChunk &result);
+
+	//! The total amount of rows stored in the collection
+	idx_t Count() {
+		return count;
+	}
+	//! The amount of chunks stored in the collection
+	idx_t ChunkCount() {
+		return external ? chunk_locations.size() : chunks.size();
+	}
+
+	//! Returns true if chunks of the specified types can be stored in buffer-managed (evictable) blocks
+	static bool CanOffload(BufferManager &buffer_manager, vector<LogicalType> &types);
+
+private:
+	struct ChunkLocation {
+		//! The index of the buffer the chunk is stored in
+		idx_t buffer_idx;
+		//! The offset of the chunk within the buffer
+		idx_t offset;
+	};
+	struct ChunkBuffer {
+		block_id_t block_id;
+		//! The amount of bytes that can be written to the buffer
+		idx_t capacity;
+		//! The amount of bytes written to the buffer
+		idx_t size;
+	};
+
+	BufferManager &buffer_manager;
+	//! Whether the chunks are stored in buffer-managed blocks (true) or in memory (false)
+	bool external;
+	//! The total amount of rows in the collection
+	idx_t count;
+	//! The in-memory chunks (if external = false)
+	vector<unique_ptr<DataChunk>> chunks;
+	//! The buffers the chunks are serialized to (if external = true)
+	vector<ChunkBuffer> buffers;
+	//! The location of every chunk within the buffers (if external = true)
+	vector<ChunkLocation> chunk_locations;
+};
+
+} // namespace duckdb
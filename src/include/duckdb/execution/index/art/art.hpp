@@ -60,6 +60,18 @@ struct ARTIndexScanState : public IndexScanState {
 	Leaf *cur_leaf = nullptr;
 	//! Offset to leaf
 	idx_t result_index = 0;
+	//! The sub-ranges of a split scan, each sub-range holds the keys that start with the given bytes
+	vector<vector<data_t>> ranges;
+};
+
+struct ARTBulkLoadEntry {
+	unique_ptr<Key> key;
+	row_t row_id;
+};
+
+struct ARTBulkLoadState : public IndexBulkLoadState {
+	//! The (non-NULL) entries that are added to the index when the bulk load is finalized
+	vector<ARTBulkLoadEntry> entries;
 };
 
 class ART : public Index {
@@ -89,6 +101,10 @@ public:
 	//! Perform a lookup on the index
 	bool Scan(Transaction &transaction, DataTable &table, IndexScanState &state, idx_t max_count,
 	          vector<row_t> &result_ids) override;
+	//! Split the scan into the subtrees of the upper levels of the tree that overlap with the range of the scan
+	idx_t SplitScan(IndexScanState &state, idx_t max_ranges, double &estimated_fraction) override;
+	//! Append the row ids of the subtree of a sub-range that fall in the range of the scan
+	void ScanRange(IndexLock &lock, IndexScanState &state, idx_t range_idx, vector<row_t> &result_ids) override;
 	//! Append entries to the index
 	bool Append(IndexLock &lock, DataChunk &entries, Vector &row_identifiers) override;
 	//! Verify that data can be appended to the index
@@ -98,9 +114,26 @@ public:
 	//! Insert data into the index.
 	bool Insert(IndexLock &lock, DataChunk &data, Vector &row_ids) override;
 
+	//! Initialize a bulk load into the index
+	unique_ptr<IndexBulkLoadState> InitializeBulkLoad() override;
+	//! Collect the keys of the entries of a bulk load
+	void BulkLoadAppend(IndexBulkLoadState &state, DataChunk &input, Vector &row_ids) override;
+	//! Sort the keys of the bulk load and insert them. An empty tree is built bottom-up from the sorted keys in a
+	//! single pass.
+	bool BulkLoadFinalize(IndexLock &lock, IndexBulkLoadState &state, TaskScheduler &scheduler) override;
+
+	//! Write the tree to the writer, and return the location of its root
+	BlockPointer Serialize(MetaBlockWriter &writer);
+	//! Initialize the (empty) index with the tree written at the given location. The nodes of the tree are read from
+	//! disk when they are first accessed.
+	void Deserialize(BufferManager &buffer_manager, BlockPointer root);
+
 	bool SearchEqual(ARTIndexScanState *state, idx_t max_count, vector<row_t> &result_ids);
 	//! Search Equal used for Joins that do not need to fetch data
 	void SearchEqualJoinNoFetch(Value &equal_value, idx_t &result_size);
+	//! Look up all keys of the input at once, and write the leaf holding the row ids of every key (or nullptr if the
+	//! key is NULL or not found) to result. The traversals of the tree for different keys are interleaved.
+	void SearchEqualBatch(DataChunk &input, Leaf *result[]);
 
 private:
 	DataChunk expression_result;
@@ -10,11 +10,14 @@
 
 #include "duckdb/execution/index/art/art_key.hpp"
 #include "duckdb/common/common.hpp"
+#include "duckdb/storage/storage_info.hpp"
 
 namespace duckdb {
-enum class NodeType : uint8_t { N4 = 0, N16 = 1, N48 = 2, N256 = 3, NLeaf = 4 };
+enum class NodeType : uint8_t { N4 = 0, N16 = 1, N48 = 2, N256 = 3, NLeaf = 4, NUnloaded = 5 };
 
 class ART;
+class BufferManager;
+class MetaBlockWriter;
 
 class Node {
 public:
@@ -55,6 +58,8 @@ public:
 	//! the element is not found.
 	virtual unique_ptr<Node> *GetChild(idx_t pos);
 
+	//! Get the key byte of the child at the specified position in the node
+	static uint8_t GetKeyByte(Node &node, idx_t pos);
 	//! Compare the key with the prefix of the node, return the number matching bytes
 	static uint32_t PrefixMismatch(ART &art, Node *node, Key &key, uint64_t depth);
 	//! Insert leaf into inner node
@@ -62,9 +67,27 @@ public:
 	//! Erase entry from node
 	static void Erase(ART &art, unique_ptr<Node> &node, idx_t pos);
 
+	//! Reads the node from disk if it has not been read yet, and returns a pointer to the node
+	static unique_ptr<Node> *Load(unique_ptr<Node> &node);
+	//! Writes the subtree of the node to the writer, and returns the location of the node
+	static BlockPointer Serialize(ART &art, unique_ptr<Node> &node, MetaBlockWriter &writer);
+	//! Reads the node at the given location. The children of the node are only read when they are first accessed.
+	static unique_ptr<Node> Deserialize(ART &art, BufferManager &buffer_manager, BlockPointer pointer);
+
 protected:
 	//! Copies the prefix from the source to the destination node
 	static void CopyPrefix(ART &art, Node *src, Node *dst);
 };
 
+//! Placeholder for a node that is stored in the database file and has not been read yet
+class UnloadedNode : public Node {
+public:
+	UnloadedNode(ART &art, BufferManager &buffer_manager, BlockPointer pointer);
+
+	ART &art;
+	BufferManager &buffer_manager;
+	//! The location of the node in the database file
+	BlockPointer pointer;
+};
+
 } // namespace duckdb
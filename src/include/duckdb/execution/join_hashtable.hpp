@@ -106,6 +106,15 @@ private:
 		block_id_t block_id;
 	};
 
+	//! Blocks that hold the non-inlined strings of the entries appended with AppendEntries. Unlike the string heap
+	//! these blocks can be evicted: until the HT is finalized the entries store the location of their strings within the
+	//! string blocks instead of a pointer to them
+	struct HTStringBlock {
+		idx_t size;
+		idx_t capacity;
+		block_id_t block_id;
+	};
+
 	struct BlockAppendEntry {
 		BlockAppendEntry(data_ptr_t baseptr_, idx_t count_) : baseptr(baseptr_), count(count_) {
 		}
@@ -116,8 +125,15 @@ private:
 
 	idx_t AppendToBlock(HTDataBlock &block, BufferHandle &handle, vector<BlockAppendEntry> &append_entries,
 	                    idx_t remaining);
-
-	void Hash(DataChunk &keys, const SelectionVector &sel, idx_t count, Vector &hashes);
+	//! Allocates space for the specified amount of entries in the blocks of the HT, the handles keep the blocks pinned
+	//! until the entries have been written
+	void AllocateEntries(idx_t entry_count, vector<unique_ptr<BufferHandle>> &handles, data_ptr_t key_locations[]);
+	//! Copies serialized entries of a HT with the same layout into this HT, including their non-inlined strings
+	void AppendEntries(data_ptr_t entries[], idx_t entry_count);
+	//! Copies the non-inlined strings of the entries into the string blocks
+	void AppendStrings(data_ptr_t key_locations[], idx_t count);
+	//! Replaces the string block locations of the entries with pointers into the pinned string blocks
+	void SwizzleStrings(data_ptr_t key_locations[], idx_t count);
 
 public:
 	JoinHashTable(BufferManager &buffer_manager, vector<JoinCondition> &conditions, vector<LogicalType> build_types,
@@ -126,9 +142,23 @@ public:
 
 	//! Add the given data to the HT
 	void Build(DataChunk &keys, DataChunk &input);
+	//! Moves the blocks and strings of another (thread-local) HT with the same layout into this HT
+	void Merge(JoinHashTable &other);
 	//! Finalize the build of the HT, constructing the actual hash table and making the HT ready for probing. Finalize
 	//! must be called before any call to Probe, and after Finalize is called Build should no longer be ever called.
 	void Finalize();
+	//! Finalize the HT in parallel: InitializePointerTable allocates the pointer table, after which disjoint ranges of
+	//! blocks can be inserted into it by calling Finalize(block_start, block_end, true) from multiple threads
+	void InitializePointerTable();
+	void Finalize(idx_t block_start, idx_t block_end, bool parallel);
+	//! Hash the equality keys of the selected rows
+	void Hash(DataChunk &keys, const SelectionVector &sel, idx_t count, Vector &hashes);
+	//! Radix-partitions the entries of the blocks [block_start, block_end) of the HT into the partition HTs, which must
+	//! have been created with the same conditions and types. The blocks are destroyed afterwards. Disjoint ranges of
+	//! blocks can be partitioned in parallel; the strings are copied into the (evictable) string blocks of the
+	//! partitions, so the string heap of this HT can be destroyed once all blocks have been partitioned.
+	void Partition(vector<JoinHashTable *> &partition_hts, hash_t mask, idx_t shift, idx_t block_start,
+	               idx_t block_end);
 	//! Probe the HT with the given input chunk, resulting in the given result
 	unique_ptr<ScanStructure> Probe(DataChunk &keys);
 	//! Scan the HT to construct the final full outer join result after
@@ -137,6 +167,14 @@ public:
 	idx_t size() {
 		return count;
 	}
+	//! The amount of blocks holding the entries of the HT
+	idx_t BlockCount() {
+		return blocks.size();
+	}
+	//! The amount of memory (in bytes) that has to be pinned to finalize the HT
+	idx_t SizeInBytes();
+	//! The capacity of the pointer table of a finalized HT with the specified amount of entries
+	static idx_t PointerTableCapacity(idx_t count);
 
 	//! The stringheap of the JoinHashTable
 	StringHeap string_heap;
@@ -194,9 +232,9 @@ private:
 	//! Apply a bitmask to the hashes
 	void ApplyBitmask(Vector &hashes, idx_t count);
 	void ApplyBitmask(Vector &hashes, const SelectionVector &sel, idx_t count, Vector &pointers);
-	//! Insert the given set of locations into the HT with the given set of
-	//! hashes. Caller should hold lock in parallel HT.
-	void InsertHashes(Vector &hashes, idx_t count, data_ptr_t key_locations[]);
+	//! Insert the given set of locations into the HT with the given set of hashes. If parallel is true, the chains are
+	//! updated with atomic compare-and-swap operations.
+	void InsertHashes(Vector &hashes, idx_t count, data_ptr_t key_locations[], bool parallel);
 
 	idx_t PrepareKeys(DataChunk &keys, unique_ptr<VectorData[]> &key_data, const SelectionVector *&current_sel,
 	                  SelectionVector &sel);
@@ -208,8 +246,14 @@ private:
 	idx_t count;
 	//! The blocks holding the main data of the hash table
 	vector<HTDataBlock> blocks;
-	//! Pinned handles, these are pinned during finalization only
+	//! Pinned handles of the blocks, these are pinned during finalization only
 	vector<unique_ptr<BufferHandle>> pinned_handles;
+	//! The blocks holding the strings of the entries appended with AppendEntries
+	vector<HTStringBlock> string_blocks;
+	//! Pinned handles of the string blocks, these are pinned from finalization onwards
+	vector<unique_ptr<BufferHandle>> string_handles;
+	//! The offsets of the VARCHAR columns within an entry
+	vector<idx_t> string_offsets;
 	//! The hash map of the HT, created after finalization
 	unique_ptr<BufferHandle> hash_map;
 	//! Whether or not NULL values are considered equal in each of the comparisons
@@ -9,23 +9,32 @@
 #pragma once
 
 #include "duckdb/common/types/chunk_collection.hpp"
-#include "duckdb/execution/physical_operator.hpp"
+#include "duckdb/execution/physical_sink.hpp"
 
 namespace duckdb {
 
-//! PhysicalWindow implements window functions
-class PhysicalWindow : public PhysicalOperator {
+//! PhysicalWindow implements window functions. When all window functions share the same PARTITION BY clause, the
+//! input is hash partitioned on the partition keys, and the hash partitions are sorted and computed in parallel.
+class PhysicalWindow : public PhysicalSink {
 public:
 	PhysicalWindow(vector<LogicalType> types, vector<unique_ptr<Expression>> select_list,
 	               PhysicalOperatorType type = PhysicalOperatorType::WINDOW);
 
-	void GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state) override;
-
 	//! The projection list of the SELECT statement (that contains aggregates)
 	vector<unique_ptr<Expression>> select_list;
 
 public:
+	void Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate, DataChunk &input) override;
+	void Combine(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate) override;
+	void Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> state) override;
+	unique_ptr<GlobalOperatorState> GetGlobalState(ClientContext &context) override;
+	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) override;
+
+	void GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state) override;
 	unique_ptr<PhysicalOperatorState> GetOperatorState() override;
+
+	idx_t MaxThreads(ClientContext &context) override;
+	unique_ptr<ParallelState> GetParallelState() override;
 };
 
 } // namespace duckdb
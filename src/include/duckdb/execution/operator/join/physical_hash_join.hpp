@@ -15,6 +15,7 @@
 #include "duckdb/planner/operator/logical_join.hpp"
 
 namespace duckdb {
+class HashJoinDeferredTaskState;
 
 //! PhysicalHashJoin represents a hash loop join between two tables
 class PhysicalHashJoin : public PhysicalComparisonJoin {
@@ -38,13 +39,36 @@ public:
 
 	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) override;
 	void Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate, DataChunk &input) override;
+	void Combine(ExecutionContext &context, GlobalOperatorState &gstate, LocalSinkState &lstate) override;
 	void Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> gstate) override;
 
 	void GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state) override;
 	unique_ptr<PhysicalOperatorState> GetOperatorState() override;
 
+	//! Whether or not the build side was partitioned because it does not fit in memory. The first partition is joined
+	//! while the probe side is read, the other partitions are joined after the probe side has been read entirely.
+	bool IsPartitioned();
+	//! Whether the join has to finish its probe after the entire probe side has been read, i.e. a partitioned join or a
+	//! FULL OUTER join that scans the build-side tuples that did not find a match
+	bool HasDeferredProbe();
+	//! Prepares the join for a probe side that is read by multiple threads: the work that finishes the probe is then
+	//! left to the tasks returned by GetDeferredProbeTasks, which the pipeline schedules after all threads are done
+	void InitializeParallelProbe(ClientContext &context);
+	vector<unique_ptr<ParallelState>> GetDeferredProbeTasks(ClientContext &context);
+
 private:
+	//! The minimum amount of HT blocks that a single task finalizes
+	static constexpr idx_t MINIMUM_BLOCKS_PER_TASK = 4;
+
+	bool IsCorrelatedMarkJoin();
 	void ProbeHashTable(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_);
+	//! Probe a partitioned HT, joining one partition at a time
+	void ProbePartitions(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_);
+	//! Join a single partition of a partitioned HT in a deferred task, after all threads have read the probe side
+	void ProbeDeferredPartition(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_,
+	                            HashJoinDeferredTaskState &task_state);
+	//! Fetch the next probe-side chunk of the current partition, returns false if the partition is exhausted
+	bool NextPartitionChunk(ExecutionContext &context, PhysicalOperatorState *state_);
 };
 
 } // namespace duckdb
@@ -14,8 +14,8 @@
 
 namespace duckdb {
 
-//! Represents a physical ordering of the data. Note that this will not change
-//! the data but only add a selection vector.
+//! Represents a physical ordering of the data. Every thread sorts its input into sorted runs, which are merged in
+//! parallel in the Finalize phase. Sorted runs are offloaded to the temporary directory when memory runs out.
 class PhysicalOrder : public PhysicalSink {
 public:
 	PhysicalOrder(vector<LogicalType> types, vector<BoundOrderByNode> orders)
@@ -26,12 +26,17 @@ public:
 
 public:
 	void Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate, DataChunk &input) override;
+	void Combine(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate) override;
 	void Finalize(Pipeline &pipeline, ClientContext &context, unique_ptr<GlobalOperatorState> state) override;
 	unique_ptr<GlobalOperatorState> GetGlobalState(ClientContext &context) override;
+	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) override;
 
 	void GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state) override;
 	unique_ptr<PhysicalOperatorState> GetOperatorState() override;
 
+	idx_t MaxThreads(ClientContext &context) override;
+	unique_ptr<ParallelState> GetParallelState() override;
+
 	string ParamsToString() const override;
 };
 
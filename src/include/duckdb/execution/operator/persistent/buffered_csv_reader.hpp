@@ -24,6 +24,8 @@
 namespace duckdb {
 struct CopyInfo;
 struct StrpTimeFormat;
+class FileHandle;
+class FileSystem;
 
 //! The shifts array allows for linear searching of multi-byte values. For each position, it determines the next
 //! position given that we encounter a byte with the given value.
@@ -107,6 +109,8 @@ class BufferedCSVReader {
 	static constexpr idx_t INITIAL_BUFFER_SIZE = 16384;
 	//! Maximum CSV line size: specified because if we reach this amount, we likely have the wrong delimiters
 	static constexpr idx_t MAXIMUM_CSV_LINE_SIZE = 1048576;
+	//! Size of the blocks that are read when searching for row boundaries
+	static constexpr idx_t ROW_SEARCH_BUFFER_SIZE = 65536;
 	ParserMode mode;
 
 	//! Candidates for delimiter auto detection
@@ -152,6 +156,13 @@ public:
 
 	vector<unique_ptr<char[]>> cached_buffers;
 
+	//! Whether or not the reader is restricted to a byte range of the file
+	bool has_range = false;
+	//! The offset in the file up to which the source has been read (only used when reading a range)
+	idx_t range_position = 0;
+	//! The end of the byte range that is read
+	idx_t range_end = 0;
+
 	TextSearchShiftArray delimiter_search, escape_search, quote_search;
 
 	DataChunk parse_chunk;
@@ -159,6 +170,20 @@ public:
 public:
 	//! Extract a single DataChunk from the CSV file and stores it in insert_chunk
 	void ParseCSV(DataChunk &insert_chunk);
+	//! Restricts the reader to the byte range [range_start, range_end) of the file. The range has to start at the
+	//! start of a row and end at the end of a row, e.g. as found by FindRowStart.
+	void SetRange(idx_t range_start, idx_t range_end);
+
+	//! Whether or not files in the given dialect can be split into byte ranges that are parsed independently
+	static bool SupportsRanges(const BufferedCSVReaderOptions &options);
+	//! Returns the offset of the first row that starts at or after target_offset, given that a row starts at
+	//! start_offset. The quote state is tracked from start_offset onwards, so newlines within quoted values are never
+	//! taken as row boundaries. Returns the file size if no row starts after target_offset.
+	static idx_t FindRowStart(FileSystem &fs, FileHandle &handle, idx_t file_size,
+	                          const BufferedCSVReaderOptions &options, idx_t start_offset, idx_t target_offset);
+	//! Returns the offset of the first row after the skipped rows and the header line (if any)
+	static idx_t FindDataStart(FileSystem &fs, FileHandle &handle, idx_t file_size,
+	                           const BufferedCSVReaderOptions &options);
 
 private:
 	//! Initialize Parser
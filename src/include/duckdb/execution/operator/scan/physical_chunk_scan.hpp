@@ -23,6 +23,9 @@ public:
 	void GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state) override;
 	unique_ptr<PhysicalOperatorState> GetOperatorState() override;
 
+	idx_t MaxThreads(ClientContext &context) override;
+	unique_ptr<ParallelState> GetParallelState() override;
+
 public:
 	// the chunk collection to scan
 	ChunkCollection *collection;
@@ -14,6 +14,7 @@
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/planner/expression.hpp"
 #include "duckdb/execution/execution_context.hpp"
+#include "duckdb/parallel/parallel_state.hpp"
 
 #include <functional>
 
@@ -101,6 +102,23 @@ public:
 	virtual bool IsSink() const {
 		return false;
 	}
+
+	//! Returns the maximum amount of threads that can read the result of this operator in parallel when it is the
+	//! source of a pipeline. Operators that return 0 or 1 are always read by a single thread.
+	virtual idx_t MaxThreads(ClientContext &context) {
+		return 0;
+	}
+	//! Create the state that is shared by the threads reading the result of this operator in parallel
+	virtual unique_ptr<ParallelState> GetParallelState() {
+		return nullptr;
+	}
+
+protected:
+	//! Returns the parallel state of this operator in the current task, or nullptr if the result of the operator is
+	//! read by a single thread
+	ParallelState *FindParallelState(ExecutionContext &context);
+	//! The amount of vectors that are handed out at once to a thread reading the result of this operator in parallel
+	static idx_t ParallelScanVectorCount(ClientContext &context);
 };
 
 } // namespace duckdb
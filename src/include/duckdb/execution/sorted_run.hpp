@@ -0,0 +1,52 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/execution/sorted_run.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/types/chunk_collection.hpp"
+#include "duckdb/execution/buffered_chunk_collection.hpp"
+
+namespace duckdb {
+
+//! A SortedRun is an immutable, sorted sequence of DataChunks that is produced by a single thread (either by sorting
+//! thread-local input or by merging other runs). The chunks are stored in a BufferedChunkCollection, which allows them
+//! to be offloaded to the temporary directory when they do not fit in memory.
+class SortedRun {
+public:
+	SortedRun(BufferManager &buffer_manager, vector<LogicalType> types, idx_t key_count);
+
+	//! The types of the chunks stored in the run
+	vector<LogicalType> types;
+	//! The amount of leading columns of every chunk that contain the sort keys
+	idx_t key_count;
+	//! The sort keys of the first row of every chunk of the run, used to split up the run for the parallel merge
+	ChunkCollection boundaries;
+
+public:
+	//! Append a chunk to the end of the run; the chunk must be sorted with respect to the previously appended chunks
+	void Append(DataChunk &chunk);
+	//! Loads the chunk at the specified index of the run into the result
+	void GetChunk(idx_t chunk_idx, DataChunk &result) {
+		data.GetChunk(chunk_idx, result);
+	}
+
+	//! The total amount of rows stored in the run
+	idx_t Count() {
+		return data.Count();
+	}
+	//! The amount of chunks stored in the run
+	idx_t ChunkCount() {
+		return data.ChunkCount();
+	}
+
+private:
+	//! The chunks of the run
+	BufferedChunkCollection data;
+};
+
+} // namespace duckdb
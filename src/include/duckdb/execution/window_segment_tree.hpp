@@ -20,6 +20,7 @@ public:
 	Value Compute(idx_t start, idx_t end);
 
 private:
+	bool UseSegmentTree();
 	void ConstructTree();
 	void WindowSegmentValue(idx_t l_idx, idx_t begin, idx_t end);
 	void AggregateInit();
@@ -0,0 +1,28 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/function/aggregate/holistic_functions.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/function/aggregate_function.hpp"
+#include "duckdb/function/function_set.hpp"
+
+namespace duckdb {
+
+struct QuantileFun {
+	static void RegisterFunction(BuiltinFunctions &set);
+};
+
+struct MedianFun {
+	static void RegisterFunction(BuiltinFunctions &set);
+};
+
+struct ApproxQuantileFun {
+	static void RegisterFunction(BuiltinFunctions &set);
+};
+
+} // namespace duckdb
@@ -51,6 +51,12 @@ struct ReadCSVData : public BaseCSVData {
 	//! The initial reader (if any): this is used when automatic detection is used during binding.
 	//! In this case, the CSV reader is already created and might as well be re-used.
 	unique_ptr<BufferedCSVReader> initial_reader;
+	//! Whether or not the files can be split into byte ranges that are parsed in parallel
+	bool parallel = false;
+	//! The options used to parse the byte ranges, i.e. the (sniffed) dialect of the first file
+	BufferedCSVReaderOptions range_options;
+	//! The types used to parse the byte ranges
+	vector<LogicalType> range_types;
 };
 
 struct CSVCopyFunction {
@@ -32,4 +32,8 @@ struct PragmaDatabaseList {
 	static void RegisterFunction(BuiltinFunctions &set);
 };
 
+struct PragmaBufferManagerStats {
+	static void RegisterFunction(BuiltinFunctions &set);
+};
+
 } // namespace duckdb
@@ -11,10 +11,12 @@
 #include "duckdb/function/table_function.hpp"
 
 namespace duckdb {
+class Index;
 class TableCatalogEntry;
+struct IndexScanState;
 
 struct TableScanBindData : public FunctionData {
-	TableScanBindData(TableCatalogEntry *table) : table(table), is_index_scan(false) {
+	TableScanBindData(TableCatalogEntry *table) : table(table), is_index_scan(false), index(nullptr), range_count(0) {
 	}
 
 	//! The table to scan
@@ -24,11 +26,19 @@ struct TableScanBindData : public FunctionData {
 	bool is_index_scan;
 	//! The row ids to fetch (in case of an index scan)
 	vector<row_t> result_ids;
+	//! The index to scan and the split scan over it (in case of an index range scan)
+	Index *index;
+	shared_ptr<IndexScanState> index_state;
+	//! The amount of sub-ranges of the index range scan
+	idx_t range_count;
 
 	unique_ptr<FunctionData> Copy() override {
 		auto result = make_unique<TableScanBindData>(table);
 		result->is_index_scan = is_index_scan;
 		result->result_ids = result_ids;
+		result->index = index;
+		result->index_state = index_state;
+		result->range_count = range_count;
 		return move(result);
 	}
 };
@@ -27,8 +27,16 @@ public:
 
 	//! Access mode of the database (AUTOMATIC, READ_ONLY or READ_WRITE)
 	AccessMode access_mode = AccessMode::AUTOMATIC;
-	// Checkpoint when WAL reaches this size
+	//! Checkpoint when the WAL reaches this size when the database is opened
 	idx_t checkpoint_wal_size = 1 << 20;
+	//! Checkpoint the running database in the background when the WAL reaches this size
+	idx_t online_checkpoint_wal_size = 1 << 24;
+	//! The time (in microseconds) a committer waits before syncing the WAL, to allow concurrent commits to share the
+	//! same sync. Default: 0 (sync immediately)
+	idx_t commit_delay = 0;
+	//! The amount of threads used to replay the WAL when the database is opened. Default: 0 (one thread per hardware
+	//! thread)
+	idx_t wal_replay_threads = 0;
 	//! Whether or not to use Direct IO, bypassing operating system buffers
 	bool use_direct_io = false;
 	//! The FileSystem to use, can be overwritten to allow for injecting custom file systems for testing purposes (e.g.
@@ -18,6 +18,7 @@
 namespace duckdb {
 class Executor;
 class TaskContext;
+class PhysicalHashJoin;
 
 //! The Pipeline class represents an execution pipeline
 class Pipeline {
@@ -97,6 +98,9 @@ private:
 	PhysicalOperator *parallel_node;
 	//! The parallel state (if any)
 	unique_ptr<ParallelState> parallel_state;
+	//! The hash joins that are probed by multiple threads and have to finish their probe after all threads have read
+	//! the probe side (e.g. FULL OUTER joins), ordered from the top of the pipeline towards its source
+	vector<PhysicalHashJoin *> deferred_joins;
 
 	//! Whether or not the pipeline is finished executing
 	bool finished;
@@ -106,6 +110,11 @@ private:
 private:
 	void ScheduleSequentialTask();
 	bool ScheduleOperator(PhysicalOperator *op);
+	//! Schedule the pipeline in parallel by having multiple threads read the result of the source operator
+	bool ScheduleParallelSource(PhysicalOperator *op);
+	void ScheduleParallelTasks(idx_t max_threads);
+	//! Schedules the tasks that finish the probe of the lowest remaining deferred join, returns false if there are none
+	bool ScheduleDeferredTasks();
 };
 
 } // namespace duckdb
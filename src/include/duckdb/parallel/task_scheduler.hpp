@@ -48,6 +48,9 @@ public:
 	bool GetTaskFromProducer(ProducerToken &token, unique_ptr<Task> &task);
 	//! Run tasks forever until "marker" is set to false, "marker" must remain valid until the thread is joined
 	void ExecuteForever(bool *marker);
+	//! Schedule a set of tasks and wait until all of them have finished. The calling thread executes tasks of the
+	//! producer as well while waiting. If any of the tasks throws an exception, it is rethrown after all tasks finished.
+	void ExecuteTasks(ProducerToken &producer, vector<unique_ptr<Task>> tasks);
 
 	//! Sets the amount of active threads executing tasks for the system; n-1 background threads will be launched.
 	//! The main thread will also be used for execution
@@ -11,14 +11,14 @@
 #include "duckdb/parser/parsed_data/create_table_info.hpp"
 #include "duckdb/planner/bound_constraint.hpp"
 #include "duckdb/planner/expression.hpp"
-#include "duckdb/storage/table/persistent_segment.hpp"
+#include "duckdb/storage/storage_info.hpp"
 #include "duckdb/planner/logical_operator.hpp"
 
 namespace duckdb {
 class CatalogEntry;
 
 struct BoundCreateTableInfo {
-	BoundCreateTableInfo(unique_ptr<CreateInfo> base) : base(move(base)) {
+	BoundCreateTableInfo(unique_ptr<CreateInfo> base) : base(move(base)), row_count(0) {
 	}
 
 	//! The schema to create the table in
@@ -35,8 +35,14 @@ struct BoundCreateTableInfo {
 	vector<unique_ptr<Expression>> bound_defaults;
 	//! Dependents of the table (in e.g. default values)
 	unordered_set<CatalogEntry *> dependencies;
-	//! The existing table data on disk (if any)
-	unique_ptr<vector<unique_ptr<PersistentSegment>>[]> data;
+	//! The location of the existing table data on disk (if any); the data is only read when the table is first used
+	unique_ptr<BlockPointer> data;
+	//! The number of rows of the existing table data on disk, used as the cardinality of the table before its data
+	//! has been read
+	idx_t row_count;
+	//! The locations of the indexes of the UNIQUE and PRIMARY KEY constraints on disk (if any); the indexes are read
+	//! from disk instead of being built from the table data
+	vector<BlockPointer> indexes;
 	//! CREATE TABLE from QUERY
 	unique_ptr<LogicalOperator> query;
 
@@ -13,7 +13,7 @@
 namespace duckdb {
 
 struct BufferEntry {
-	BufferEntry(unique_ptr<FileBuffer> buffer) : buffer(move(buffer)), ref_count(1), prev(nullptr) {
+	BufferEntry(unique_ptr<FileBuffer> buffer) : buffer(move(buffer)), ref_count(1), hot(false), prev(nullptr) {
 	}
 	~BufferEntry() {
 		while (next) {
@@ -25,6 +25,9 @@ struct BufferEntry {
 	unique_ptr<FileBuffer> buffer;
 	//! The amount of references to this entry
 	idx_t ref_count;
+	//! Whether or not the buffer has been pinned again after it was loaded; hot buffers are evicted only after all
+	//! buffers that were used once
+	bool hot;
 	//! Next node
 	unique_ptr<BufferEntry> next;
 	//! Prev entry
@@ -14,13 +14,41 @@
 #include "duckdb/storage/block_manager.hpp"
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/unordered_set.hpp"
 
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
+#include <queue>
+#include <thread>
 
 namespace duckdb {
 
+//! Hints on how a pinned buffer is going to be used, which are taken into account by the replacement policy
+enum class PinHint : uint8_t {
+	//! The buffer can be accessed repeatedly
+	NORMAL = 0,
+	//! The buffer is read once by a sequential scan: the pin does not count as a re-reference of the buffer
+	USE_ONCE = 1
+};
+
+//! Statistics on how often pinned buffers were found in memory
+struct BufferManagerStatistics {
+	//! The amount of pins of buffers that were in memory
+	idx_t hits;
+	//! The amount of pins that required a buffer to be read from disk
+	idx_t misses;
+	//! The amount of buffers that were evicted from memory
+	idx_t evictions;
+	//! The amount of blocks that were read in the background by read-ahead
+	idx_t prefetches;
+};
+
 //! The buffer manager is in charge of handling memory management for the database. It hands out memory buffers that can
 //! be used by the database internally.
+//! The buffers are partitioned over a set of shards that each have their own lock. Unpinned buffers are evicted using
+//! a simplified 2Q policy: buffers that were only used once since being loaded (e.g. by a sequential scan) are evicted
+//! in FIFO order before any of the buffers that were used repeatedly, which are evicted in LRU order.
 class BufferManager {
 	friend class BufferHandle;
 
@@ -29,7 +57,10 @@ public:
 	~BufferManager();
 
 	//! Pin a block id, returning a block handle holding a pointer to the block
-	unique_ptr<BufferHandle> Pin(block_id_t block, bool can_destroy = false);
+	unique_ptr<BufferHandle> Pin(block_id_t block, bool can_destroy = false, PinHint hint = PinHint::NORMAL);
+	//! Request a block of the file to be read into memory in the background, so that a later Pin of the block does not
+	//! have to wait for the read. Does nothing if the block is already in memory or is already being read.
+	void Prefetch(block_id_t block_id);
 
 	//! Allocate a buffer of arbitrary size, as long as it is >= BLOCK_SIZE. can_destroy signifies whether or not the
 	//! buffer can be destroyed when unpinned, or whether or not it needs to be written to a temporary file so it can be
@@ -42,21 +73,76 @@ public:
 	//! blocks can be evicted
 	void SetLimit(idx_t limit = (idx_t)-1);
 
+	//! Returns the maximum amount of memory (in bytes) that the buffer manager can keep
+	idx_t GetMaxMemory() {
+		return maximum_memory;
+	}
+	//! Returns the amount of memory (in bytes) that is currently occupied by the buffer manager
+	idx_t GetUsedMemory() {
+		return current_memory;
+	}
+	//! Returns the hit, miss and eviction counters of the buffer manager
+	BufferManagerStatistics GetStatistics();
+
+	//! Returns true if buffers that cannot be destroyed can be offloaded to the temporary directory
+	bool HasTemporaryDirectory() {
+		return !temp_directory.empty();
+	}
+
 	static BufferManager &GetBufferManager(ClientContext &context);
 
 private:
-	unique_ptr<BufferHandle> PinBlock(block_id_t block_id);
-	unique_ptr<BufferHandle> PinBuffer(block_id_t block_id, bool can_destroy = false);
+	//! The amount of shards the buffers are partitioned over
+	static constexpr idx_t SHARD_COUNT = 16;
+	//! The amount of background threads that read prefetched blocks
+	static constexpr idx_t READ_AHEAD_THREADS = 2;
+	//! The maximum amount of prefetched blocks that are waiting to be read
+	static constexpr idx_t MAXIMUM_READ_AHEAD_QUEUE = 64;
+
+	//! A shard of the buffers, every buffer belongs to the shard given by its id
+	struct BufferShard {
+		//! The lock for the buffers of the shard
+		std::mutex lock;
+		//! A mapping of block id -> BufferEntry
+		unordered_map<block_id_t, BufferEntry *> blocks;
+		//! A linked list of buffer entries that are in use
+		BufferList used_list;
+		//! Unpinned buffers that were used once since being loaded, in FIFO order
+		BufferList cold_list;
+		//! Unpinned buffers that were used repeatedly, in LRU order
+		BufferList hot_list;
+		//! The blocks that are currently being read from disk
+		unordered_set<block_id_t> pending_reads;
+		//! Signaled whenever a read of a block of the shard finishes
+		std::condition_variable read_finished;
+	};
+
+	BufferShard &GetShard(block_id_t block_id) {
+		return shards[(idx_t)block_id % SHARD_COUNT];
+	}
+
+	unique_ptr<BufferHandle> PinBlock(block_id_t block_id, PinHint hint);
+	unique_ptr<BufferHandle> PinBuffer(block_id_t block_id, bool can_destroy, PinHint hint);
 
 	//! Unpin a block id, decreasing its reference count and potentially allowing it to be freed.
 	void Unpin(block_id_t block);
 
-	//! Evict the least recently used block from the buffer manager, or throws an exception if there are no blocks
-	//! available to evict
-	unique_ptr<Block> EvictBlock();
+	//! Reserve the specified amount of memory, evicting blocks until the reservation fits within the memory limit.
+	//! Throws an exception if not enough blocks can be evicted. Must not be called while holding the lock of a shard.
+	void ReserveMemory(idx_t size);
+	//! Evict an unpinned block from the buffer manager, returns false if there are no blocks available to evict
+	bool EvictBlock();
+
+	//! Read a block from disk and register it in its shard, the block has to be marked as pending in the shard. Returns
+	//! the entry of the block, which is pinned if pin is true.
+	BufferEntry *LoadBlock(block_id_t block_id, bool pin);
+	//! The main loop of the threads that read prefetched blocks
+	void ReadAheadThread();
 
 	//! Add a reference to the refcount of a buffer entry
-	void AddReference(BufferEntry *entry);
+	void AddReference(BufferShard &shard, BufferEntry *entry, PinHint hint);
+	//! Register a newly loaded buffer as a pinned entry of the shard
+	void RegisterBuffer(BufferShard &shard, block_id_t id, unique_ptr<FileBuffer> buffer);
 
 	//! Write a temporary buffer to disk
 	void WriteTemporaryBuffer(ManagedBuffer &buffer);
@@ -72,20 +158,37 @@ private:
 	//! The block manager
 	BlockManager &manager;
 	//! The current amount of memory that is occupied by the buffer manager (in bytes)
-	idx_t current_memory;
+	std::atomic<idx_t> current_memory;
 	//! The maximum amount of memory that the buffer manager can keep (in bytes)
-	idx_t maximum_memory;
+	std::atomic<idx_t> maximum_memory;
 	//! The directory name where temporary files are stored
 	string temp_directory;
-	//! The lock for the set of blocks
-	std::mutex block_lock;
-	//! A mapping of block id -> BufferEntry
-	unordered_map<block_id_t, BufferEntry *> blocks;
-	//! A linked list of buffer entries that are in use
-	BufferList used_list;
-	//! LRU list of unused blocks
-	BufferList lru;
+	//! The shards holding the buffers
+	BufferShard shards[SHARD_COUNT];
+	//! The shard at which the next eviction starts looking for a block to evict
+	std::atomic<idx_t> eviction_position;
 	//! The temporary id used for managed buffers
-	block_id_t temporary_id;
+	std::atomic<block_id_t> temporary_id;
+	//! The amount of pins of buffers that were in memory
+	std::atomic<idx_t> buffer_hits;
+	//! The amount of pins that required a buffer to be read from disk
+	std::atomic<idx_t> buffer_misses;
+	//! The amount of evicted buffers
+	std::atomic<idx_t> buffer_evictions;
+	//! The amount of blocks read by read-ahead
+	std::atomic<idx_t> buffer_prefetches;
+
+	//! The lock for the read-ahead queue and threads
+	std::mutex read_ahead_lock;
+	//! Signaled whenever a block is added to the read-ahead queue
+	std::condition_variable read_ahead_available;
+	//! The blocks that are waiting to be read by the read-ahead threads
+	std::queue<block_id_t> read_ahead_queue;
+	//! The set of blocks in the read-ahead queue
+	unordered_set<block_id_t> read_ahead_blocks;
+	//! The read-ahead threads, which are only started once the first block is prefetched
+	vector<std::thread> read_ahead_threads;
+	//! Whether or not the read-ahead threads have to stop
+	bool read_ahead_shutdown;
 };
 } // namespace duckdb
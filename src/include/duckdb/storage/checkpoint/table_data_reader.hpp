@@ -8,22 +8,25 @@
 
 #pragma once
 
-#include "duckdb/storage/checkpoint_manager.hpp"
+#include "duckdb/storage/data_table.hpp"
+#include "duckdb/storage/meta_block_reader.hpp"
 
 namespace duckdb {
-struct BoundCreateTableInfo;
+class BufferManager;
 
 //! The table data reader is responsible for reading the data of a table from the block manager
 class TableDataReader {
 public:
-	TableDataReader(CheckpointManager &manager, MetaBlockReader &reader, BoundCreateTableInfo &info);
+	TableDataReader(BufferManager &buffer_manager, MetaBlockReader &reader, const vector<LogicalType> &types);
 
-	void ReadTableData();
+	//! Reads the data pointers of the table and returns the persistent segments of each of the columns. The ranges
+	//! (start, count) of the rows that are stored as deleted rows are added to deleted_rows.
+	persistent_data_t ReadTableData(vector<std::pair<idx_t, idx_t>> &deleted_rows);
 
 private:
-	CheckpointManager &manager;
+	BufferManager &buffer_manager;
 	MetaBlockReader &reader;
-	BoundCreateTableInfo &info;
+	const vector<LogicalType> &types;
 };
 
 } // namespace duckdb
@@ -15,21 +15,57 @@ namespace duckdb {
 class UncompressedSegment;
 class SegmentStatistics;
 
-//! The table data writer is responsible for writing the data of a table to the block manager
+//! Packs the compressed segments of the columns of all tables together into shared blocks. The columns are written
+//! in parallel into blocks of their own; the last, partially filled block of every column is packed afterwards.
+class CompressedBlockPacker {
+public:
+	CompressedBlockPacker(CheckpointManager &manager);
+
+	//! Copies the data into the shared block, returns the block and the offset the data was written to
+	void Append(data_ptr_t data, idx_t size, block_id_t &result_block, idx_t &result_offset);
+	//! Writes the current shared block (if any) to disk
+	void Flush();
+
+private:
+	CheckpointManager &manager;
+	//! The shared block that is currently written to
+	unique_ptr<BufferHandle> handle;
+	block_id_t block_id;
+	//! The offset within the shared block
+	idx_t offset;
+};
+
+//! The table data writer is responsible for writing the data of a table to the block manager. The columns of a table
+//! are written independently of each other, so that they can be written in parallel.
 class TableDataWriter {
 public:
 	TableDataWriter(CheckpointManager &manager, TableCatalogEntry &table);
 	~TableDataWriter();
 
-	void WriteTableData(ClientContext &context);
+	//! Scans a single column of the table and writes its segments to disk. Different columns can be written
+	//! concurrently by different threads.
+	void WriteColumnData(Transaction &transaction, idx_t col_idx);
+	//! Packs the last compressed block of every column into the shared blocks of the packer; all columns have to be
+	//! written first
+	void PackCompressedBlocks(CompressedBlockPacker &packer);
+	//! Writes the data pointers of all columns to the table data of the checkpoint; all columns have to be written first
+	void WriteDataPointers();
+	//! Returns the number of rows written to the checkpoint that are not deleted
+	idx_t GetRowCount();
 
 private:
-	void AppendData(Transaction &transaction, idx_t col_idx, Vector &data, idx_t count);
+	void AppendData(Transaction &transaction, idx_t col_idx, Vector &data, idx_t offset, idx_t count);
+	//! Appends rows that are not visible to the checkpoint, these are stored as deleted rows to keep the row ids of
+	//! the rows that follow them intact
+	void AppendDeletedRows(Transaction &transaction, idx_t col_idx, idx_t row_start, idx_t count);
 
 	void CreateSegment(idx_t col_idx);
 	void FlushSegment(Transaction &transaction, idx_t col_idx);
+	//! Compresses the segment of the column into the current compressed block of the column
+	void WriteCompressedSegment(idx_t col_idx, DataPointer &data_pointer, idx_t compressed_size);
+	//! Writes the current compressed block of the column (if any) to a block of its own
+	void FlushCompressedBlock(idx_t col_idx);
 
-	void WriteDataPointers();
 	void VerifyDataPointers();
 
 private:
@@ -40,6 +76,16 @@ private:
 	vector<unique_ptr<SegmentStatistics>> stats;
 
 	vector<vector<DataPointer>> data_pointers;
+	//! The ranges (start, count) of the rows that are stored as deleted rows
+	vector<std::pair<idx_t, idx_t>> deleted_rows;
+
+	//! The block that compressed segments of each column are written to
+	vector<unique_ptr<BufferHandle>> compressed_handles;
+	//! The offset within the compressed block of each column
+	vector<idx_t> compressed_offsets;
+	//! The data pointers of the segments in the compressed block of each column, their block id is only assigned when
+	//! the block is written
+	vector<vector<idx_t>> compressed_pointers;
 };
 
 } // namespace duckdb
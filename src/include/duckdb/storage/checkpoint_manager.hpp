@@ -9,16 +9,22 @@
 #pragma once
 
 #include "duckdb/common/common.hpp"
+#include "duckdb/common/enums/compression_type.hpp"
 #include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/storage/meta_block_writer.hpp"
+#include "duckdb/common/unordered_map.hpp"
 
 namespace duckdb {
+class ART;
 class ClientContext;
+class Index;
+class IndexCatalogEntry;
 class MetaBlockReader;
 class SchemaCatalogEntry;
 class SequenceCatalogEntry;
 class TableCatalogEntry;
+class TableDataWriter;
 class ViewCatalogEntry;
 
 class DataPointer {
@@ -30,6 +36,8 @@ public:
 	uint64_t tuple_count;
 	block_id_t block_id;
 	uint32_t offset;
+	//! The compression method of the segment
+	CompressionType compression;
 	//! The minimum value of the segment
 	data_t min_stats[16];
 	//! The maximum value of the segment
@@ -39,10 +47,14 @@ public:
 //! CheckpointManager is responsible for checkpointing the database
 class CheckpointManager {
 public:
-	CheckpointManager(StorageManager &manager);
+	//! If keep_row_ids is set, the rows that are deleted are written as deleted rows instead of being removed from the
+	//! tables. This keeps the row ids of all rows intact, which is required if the WAL is not removed afterwards.
+	CheckpointManager(StorageManager &manager, bool keep_row_ids = false);
+	~CheckpointManager();
 
-	//! Checkpoint the current state of the WAL and flush it to the main storage. This should be called BEFORE any
-	//! connction is available because right now the checkpointing cannot be done online. (TODO)
+	//! Checkpoint the current state of the database and flush it to the main storage. The checkpoint contains the
+	//! changes of all transactions that committed before it started; the caller has to ensure that no transactions
+	//! commit changes while the checkpoint is created.
 	void CreateCheckpoint();
 	//! Load from a stored checkpoint
 	void LoadFromStorage();
@@ -53,21 +65,34 @@ public:
 	BufferManager &buffer_manager;
 	//! The database this storagemanager belongs to
 	DuckDB &database;
+	//! Whether or not the row ids of the rows are kept intact in the checkpoint
+	bool keep_row_ids;
 	//! The metadata writer is responsible for writing schema information
 	unique_ptr<MetaBlockWriter> metadata_writer;
 	//! The table data writer is responsible for writing the DataPointers used by the table chunks
 	unique_ptr<MetaBlockWriter> tabledata_writer;
+	//! The writers of the data of the tables in the checkpoint
+	unordered_map<TableCatalogEntry *, unique_ptr<TableDataWriter>> table_writers;
+	//! The indexes built from the data of the tables in the checkpoint, keyed by the index of the table they replace
+	unordered_map<Index *, unique_ptr<ART>> checkpoint_indexes;
 
 private:
+	void WriteCheckpoint(ClientContext &context);
+	//! Writes the data of all tables in the given schemas, the columns of all tables are written in parallel
+	void WriteTableData(ClientContext &context, vector<SchemaCatalogEntry *> &schemas);
 	void WriteSchema(ClientContext &context, SchemaCatalogEntry &schema);
 	void WriteTable(ClientContext &context, TableCatalogEntry &table);
 	void WriteView(ViewCatalogEntry &table);
 	void WriteSequence(SequenceCatalogEntry &table);
+	void WriteIndex(IndexCatalogEntry &index);
+	//! Writes the index built from the checkpointed data of the table for the given index of the table
+	void WriteIndexData(Index &index);
 
 	void ReadSchema(ClientContext &context, MetaBlockReader &reader);
 	void ReadTable(ClientContext &context, MetaBlockReader &reader);
 	void ReadView(ClientContext &context, MetaBlockReader &reader);
 	void ReadSequence(ClientContext &context, MetaBlockReader &reader);
+	void ReadIndex(ClientContext &context, MetaBlockReader &reader);
 };
 
 } // namespace duckdb
@@ -66,10 +66,19 @@ public:
 	void Fetch(ColumnScanState &state, row_t row_id, Vector &result);
 	//! Fetch a specific row id and append it to the vector
 	void FetchRow(ColumnFetchState &state, Transaction &transaction, row_t row_id, Vector &result, idx_t result_idx);
+	//! Fetch a set of row ids into the vector. Consecutive row ids that belong to the same segment only look up the
+	//! segment once, so sorted row ids are fetched segment by segment.
+	void FetchRows(ColumnFetchState &state, Transaction &transaction, row_t row_ids[], idx_t count, Vector &result);
 
 private:
+	//! The amount of segments following the current segment of a scan that are read ahead
+	static constexpr idx_t READ_AHEAD_SEGMENTS = 4;
+
 	//! Append a transient segment
 	void AppendTransientSegment(idx_t start_row);
+	//! Initialize the scan of the current segment, and request the blocks of the segments that follow it to be read
+	//! in the background
+	void InitializeSegmentScan(ColumnScanState &state);
 };
 
 } // namespace duckdb
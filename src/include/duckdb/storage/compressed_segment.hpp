@@ -0,0 +1,57 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/storage/compressed_segment.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/enums/compression_type.hpp"
+#include "duckdb/storage/numeric_segment.hpp"
+
+namespace duckdb {
+
+//! A CompressedSegment is a read-only numeric segment that is stored in a compressed form in (part of) an on-disk
+//! block. Scans decompress the data directly into the result vectors. When the segment is modified it is decompressed
+//! into a regular in-memory NumericSegment (see ToTemporary), after which it behaves exactly like a NumericSegment.
+class CompressedSegment : public NumericSegment {
+public:
+	CompressedSegment(BufferManager &manager, PhysicalType type, idx_t row_start, block_id_t block_id, idx_t offset,
+	                  CompressionType compression);
+
+	//! The offset of the compressed data within the block
+	idx_t offset;
+	//! The compression method of the segment
+	CompressionType compression;
+
+public:
+	//! Picks the compression method for the data of a (filled) numeric segment that results in the smallest size, and
+	//! returns the size of the compressed data. Returns CompressionType::UNCOMPRESSED if the data cannot be
+	//! compressed.
+	static CompressionType Analyze(NumericSegment &segment, SegmentStatistics &stats, idx_t &compressed_size);
+	//! Compresses the data of the numeric segment with the specified compression method into the target
+	static void Compress(NumericSegment &segment, CompressionType compression, data_ptr_t target);
+
+	void FetchRow(ColumnFetchState &state, Transaction &transaction, row_t row_id, Vector &result,
+	              idx_t result_idx) override;
+	void ToTemporary() override;
+
+protected:
+	void Select(ColumnScanState &state, Vector &result, SelectionVector &sel, idx_t &approved_tuple_count,
+	            vector<TableFilter> &tableFilter) override;
+	void FetchBaseData(ColumnScanState &state, idx_t vector_index, Vector &result) override;
+	void FilterFetchBaseData(ColumnScanState &state, Vector &result, SelectionVector &sel,
+	                         idx_t &approved_tuple_count) override;
+
+private:
+	//! Whether or not the data is still compressed, i.e. the segment has not been converted to a temporary segment
+	bool IsCompressed() {
+		return block_id < MAXIMUM_BLOCK;
+	}
+	//! Decompresses a vector into the uncompressed layout of a NumericSegment vector ([nullmask][values])
+	void DecompressVector(data_ptr_t base, idx_t vector_index, data_ptr_t target);
+};
+
+} // namespace duckdb
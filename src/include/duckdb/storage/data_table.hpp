@@ -59,8 +59,10 @@ struct ParallelTableScanState {
 //! DataTable represents a physical table on disk
 class DataTable {
 public:
-	//! Constructs a new data table from an (optional) set of persistent segments
-	DataTable(StorageManager &storage, string schema, string table, vector<LogicalType> types, persistent_data_t data);
+	//! Constructs a new data table from the (optional) location of its persistent data. The persistent segments are
+	//! only read from disk when the table is first used.
+	DataTable(StorageManager &storage, string schema, string table, vector<LogicalType> types,
+	          unique_ptr<BlockPointer> data);
 	//! Constructs a DataTable as a delta on an existing data table with a newly added column
 	DataTable(ClientContext &context, DataTable &parent, ColumnDefinition &new_column, Expression *default_value);
 	//! Constructs a DataTable as a delta on an existing data table but with one column removed
@@ -127,6 +129,9 @@ public:
 	//! Append a chunk with the row ids [row_start, ..., row_start + chunk.size()] to all indexes of the table, returns
 	//! whether or not the append succeeded
 	bool AppendToIndexes(TableAppendState &state, DataChunk &chunk, row_t row_start);
+	//! Append the rows [row_start, ..., row_start + count] of the table to all indexes of the table, returns whether or
+	//! not the append succeeded. Used to add rows that were appended without index maintenance to the indexes in bulk.
+	bool AppendToIndexes(idx_t row_start, idx_t count);
 	//! Remove a chunk with the row ids [row_start, ..., row_start + chunk.size()] from all indexes of the table
 	void RemoveFromIndexes(TableAppendState &state, DataChunk &chunk, row_t row_start);
 	//! Remove the chunk with the specified set of row identifiers from all indexes of the table
@@ -139,6 +144,12 @@ public:
 	}
 
 private:
+	//! Reads the persistent segments of the table from disk, if this has not happened yet
+	void LoadPersistentData();
+	//! Initializes the columns and versions of the table with the given persistent segments, the rows in the ranges
+	//! (start, count) of deleted_rows are marked as deleted
+	void InitializePersistentData(persistent_data_t data, const vector<std::pair<idx_t, idx_t>> &deleted_rows);
+
 	//! Verify constraints with a chunk from the Append containing all columns of the table
 	void VerifyAppendConstraints(TableCatalogEntry &table, DataChunk &chunk);
 	//! Verify constraints with a chunk from the Update containing only the specified column_ids
@@ -147,8 +158,14 @@ private:
 	void InitializeScanWithOffset(TableScanState &state, const vector<column_t> &column_ids,
 	                              unordered_map<idx_t, vector<TableFilter>> *table_filters, idx_t start_row,
 	                              idx_t end_row);
-	bool CheckZonemap(TableScanState &state, unordered_map<idx_t, vector<TableFilter>> &table_filters,
-	                  idx_t &current_row);
+	//! Check the zonemaps of the current segments of the scan against the filters. If no row of a segment can pass
+	//! the filters, the scan is moved to the end of that segment and false is returned.
+	bool CheckZonemap(TableScanState &state, const vector<column_t> &column_ids,
+	                  unordered_map<idx_t, vector<TableFilter>> &table_filters, idx_t &current_row);
+	//! Check the zonemaps of the segments containing the given row against the filters. If no row of a segment can
+	//! pass the filters, false is returned and skip_row is set to the end of that segment.
+	bool CheckZonemap(const vector<column_t> &column_ids, unordered_map<idx_t, vector<TableFilter>> &table_filters,
+	                  idx_t row, idx_t &skip_row);
 	bool ScanBaseTable(Transaction &transaction, DataChunk &result, TableScanState &state,
 	                   const vector<column_t> &column_ids, idx_t &current_row, idx_t max_row,
 	                   unordered_map<idx_t, vector<TableFilter>> &table_filters);
@@ -175,5 +192,11 @@ private:
 	//! Whether or not the data table is the root DataTable for this table; the root DataTable is the newest version
 	//! that can be appended to
 	bool is_root;
+	//! Lock for loading the persistent data of the table
+	std::mutex load_lock;
+	//! Whether or not the persistent data of the table has been loaded
+	std::atomic<bool> persistent_data_loaded;
+	//! The location of the persistent data of the table that has not been loaded yet (if any)
+	unique_ptr<BlockPointer> persistent_data;
 };
 } // namespace duckdb
@@ -19,10 +19,17 @@
 namespace duckdb {
 
 class ClientContext;
+class TaskScheduler;
 class Transaction;
 
 struct IndexLock;
 
+//! The state of a bulk load into an index
+struct IndexBulkLoadState {
+	virtual ~IndexBulkLoadState() {
+	}
+};
+
 //! The index is an abstract base class that serves as the basis for indexes
 class Index {
 public:
@@ -58,6 +65,11 @@ public:
 	//! and false otherwise.
 	virtual bool Scan(Transaction &transaction, DataTable &table, IndexScanState &state, idx_t max_count,
 	                  vector<row_t> &result_ids) = 0;
+	//! Split the scan into at most max_ranges sub-ranges that can be scanned independently with ScanRange. Returns
+	//! the amount of sub-ranges, and sets estimated_fraction to the estimated fraction of the index covered by the scan.
+	virtual idx_t SplitScan(IndexScanState &state, idx_t max_ranges, double &estimated_fraction) = 0;
+	//! Append the row ids of a sub-range of a split scan to result_ids. The lock must be held.
+	virtual void ScanRange(IndexLock &lock, IndexScanState &state, idx_t range_idx, vector<row_t> &result_ids) = 0;
 
 	//! Obtain a lock on the index
 	virtual void InitializeLock(IndexLock &state);
@@ -75,6 +87,17 @@ public:
 	//! Insert data into the index. Does not lock the index.
 	virtual bool Insert(IndexLock &lock, DataChunk &input, Vector &row_identifiers) = 0;
 
+	//! Initialize a bulk load into the index. Entries added to a bulk load are only inserted into the index when the
+	//! bulk load is finalized, which allows the index to insert all of them at once instead of one at a time.
+	virtual unique_ptr<IndexBulkLoadState> InitializeBulkLoad() = 0;
+	//! Add the (already resolved) index expressions of a chunk to the bulk load
+	virtual void BulkLoadAppend(IndexBulkLoadState &state, DataChunk &input, Vector &row_identifiers) = 0;
+	//! Add a chunk of the base table to the bulk load, resolving the index expressions first
+	void BulkLoadAppendData(IndexBulkLoadState &state, DataChunk &appended_data, Vector &row_identifiers);
+	//! Insert all entries of the bulk load into the index, using the tasks of the scheduler where possible. The lock
+	//! must be held. Returns false and leaves the index unchanged if the entries violate a constraint of the index.
+	virtual bool BulkLoadFinalize(IndexLock &lock, IndexBulkLoadState &state, TaskScheduler &scheduler) = 0;
+
 	//! Returns true if the index is affected by updates on the specified column ids, and false otherwise
 	bool IndexIsUpdated(vector<column_t> &column_ids);
 
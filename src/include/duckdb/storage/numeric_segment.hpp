@@ -20,6 +20,8 @@ public:
 	idx_t type_size;
 
 public:
+	void InitializeScan(ColumnScanState &state) override;
+
 	//! Fetch a single value and append it to the vector
 	void FetchRow(ColumnFetchState &state, Transaction &transaction, row_t row_id, Vector &result,
 	              idx_t result_idx) override;
@@ -43,6 +45,12 @@ protected:
 	void FetchUpdateData(ColumnScanState &state, Transaction &transaction, UpdateInfo *versions,
 	                     Vector &result) override;
 
+	//! Executes the filters on an uncompressed vector, laid out as [nullmask][values]
+	void SelectVector(data_ptr_t vector_ptr, ColumnScanState &state, Vector &result, SelectionVector &sel,
+	                  idx_t &approved_tuple_count, vector<TableFilter> &tableFilter);
+	//! Fetches the rows of an uncompressed vector that are in the selection vector into the result
+	void FilterFetchVector(data_ptr_t vector_ptr, Vector &result, SelectionVector &sel, idx_t &approved_tuple_count);
+
 public:
 	typedef void (*append_function_t)(SegmentStatistics &stats, data_ptr_t target, idx_t target_offset, Vector &source,
 	                                  idx_t offset, idx_t count);
@@ -12,6 +12,7 @@
 #include "duckdb/storage/block_manager.hpp"
 #include "duckdb/storage/block.hpp"
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/mutex.hpp"
 #include "duckdb/common/unordered_set.hpp"
 #include "duckdb/common/vector.hpp"
 
@@ -60,6 +61,14 @@ private:
 	vector<block_id_t> free_list;
 	//! The list of blocks that are used by the current block manager
 	unordered_set<block_id_t> used_blocks;
+	//! The blocks of the checkpoint the database was loaded from. The loaded tables keep reading from these blocks, so
+	//! they cannot be reused by checkpoints that are created while the database is running.
+	unordered_set<block_id_t> loaded_blocks;
+	//! Lock for the file operations: reads (through the buffer manager) and writes (by online checkpoints) can happen
+	//! concurrently
+	mutex io_lock;
+	//! Lock for the free list and the set of used blocks: the tasks of a checkpoint allocate blocks concurrently
+	mutex block_lock;
 	//! The current meta block id
 	block_id_t meta_block;
 	//! The current maximum block id, this id will be given away first after the free_list runs out
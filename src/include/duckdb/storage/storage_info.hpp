@@ -24,6 +24,15 @@ using block_id_t = int64_t;
 // maximum block id, 2^62
 #define MAXIMUM_BLOCK 4611686018427388000LL
 
+//! A pointer to a location within the meta blocks of the storage file
+struct BlockPointer {
+	BlockPointer(block_id_t block_id, idx_t offset) : block_id(block_id), offset(offset) {
+	}
+
+	block_id_t block_id;
+	idx_t offset;
+};
+
 //! The MainHeader is the first header in the storage file. The MainHeader is typically written only once for a database
 //! file.
 struct MainHeader {
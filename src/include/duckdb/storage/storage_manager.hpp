@@ -9,6 +9,7 @@
 #pragma once
 
 #include "duckdb/common/helper.hpp"
+#include "duckdb/common/mutex.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
 #include "duckdb/storage/data_table.hpp"
 #include "duckdb/storage/write_ahead_log.hpp"
@@ -43,6 +44,16 @@ public:
 	string GetDBPath() {
 		return path;
 	}
+
+	//! Checkpoints the database if the WAL has grown beyond the online_checkpoint_wal_size. The checkpoint is scheduled as a
+	//! background task, or created directly if the task scheduler has no background threads.
+	void CheckpointIfNeeded();
+	//! Creates a checkpoint of the running database and truncates the WAL. Transactions cannot commit changes while
+	//! the checkpoint is created, but readers are not blocked.
+	void CreateOnlineCheckpoint();
+	//! Returns the error of the last online checkpoint that failed, or an empty string if there is none. The error of
+	//! a checkpoint that can be retried is only returned once; a fatal error is returned on every call.
+	string GetCheckpointError();
 	//! The BlockManager to read/store meta information and data in blocks
 	unique_ptr<BlockManager> block_manager;
 	//! The BufferManager of the database
@@ -63,6 +74,14 @@ private:
 
 	//! Whether or not the database is opened in read-only mode
 	bool read_only;
+	//! Whether or not an online checkpoint is currently scheduled or running
+	std::atomic<bool> checkpoint_scheduled;
+	//! Lock for the error of the last failed online checkpoint
+	mutex checkpoint_error_lock;
+	//! The error of the last failed online checkpoint that has not been reported yet
+	string checkpoint_error;
+	//! Whether or not the checkpoint failed with a fatal error, after which no changes can be committed anymore
+	bool checkpoint_error_is_fatal;
 };
 
 } // namespace duckdb
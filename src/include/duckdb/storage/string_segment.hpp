@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "duckdb/common/unordered_map.hpp"
 #include "duckdb/storage/uncompressed_segment.hpp"
 
 namespace duckdb {
@@ -59,6 +60,10 @@ public:
 	unique_ptr<string_update_info_t[]> string_updates;
 	//! Overflow string writer (if any), if not set overflow strings will be written to memory blocks
 	unique_ptr<OverflowStringWriter> overflow_writer;
+	//! The dictionary offsets of the strings stored in the block (if set). Appending a string that is already stored
+	//! in the block reuses the existing dictionary entry, which compresses low-cardinality string columns. This is
+	//! only enabled for segments that are written to disk, as it requires all appended strings to be hashed.
+	unique_ptr<unordered_map<string, int32_t>> dictionary_entries;
 
 public:
 	void InitializeScan(ColumnScanState &state) override;
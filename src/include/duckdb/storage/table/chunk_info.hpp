@@ -38,6 +38,9 @@ public:
 	virtual idx_t GetSelVector(Transaction &transaction, SelectionVector &sel_vector, idx_t max_count) = 0;
 	//! Returns whether or not a single row in the ChunkInfo should be used or not for the given transaction
 	virtual bool Fetch(Transaction &transaction, row_t row) = 0;
+	//! Gets up to max_count entries that have not been deleted for every transaction that starts at or after
+	//! start_time, in the same way as GetSelVector
+	virtual idx_t GetUndeletedSelVector(transaction_t start_time, SelectionVector &sel_vector, idx_t max_count) = 0;
 	virtual void CommitAppend(transaction_t commit_id, idx_t start, idx_t end) = 0;
 };
 
@@ -51,6 +54,7 @@ public:
 public:
 	idx_t GetSelVector(Transaction &transaction, SelectionVector &sel_vector, idx_t max_count) override;
 	bool Fetch(Transaction &transaction, row_t row) override;
+	idx_t GetUndeletedSelVector(transaction_t start_time, SelectionVector &sel_vector, idx_t max_count) override;
 	void CommitAppend(transaction_t commit_id, idx_t start, idx_t end) override;
 };
 
@@ -70,6 +74,7 @@ public:
 public:
 	idx_t GetSelVector(Transaction &transaction, SelectionVector &sel_vector, idx_t max_count) override;
 	bool Fetch(Transaction &transaction, row_t row) override;
+	idx_t GetUndeletedSelVector(transaction_t start_time, SelectionVector &sel_vector, idx_t max_count) override;
 	void CommitAppend(transaction_t commit_id, idx_t start, idx_t end) override;
 
 	void Append(idx_t start, idx_t end, transaction_t commit_id);
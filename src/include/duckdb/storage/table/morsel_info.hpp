@@ -35,6 +35,10 @@ public:
 public:
 	idx_t GetSelVector(Transaction &transaction, idx_t vector_idx, SelectionVector &sel_vector, idx_t max_count);
 
+	//! Gets the rows of the vector that have not been deleted for every transaction that starts at or after start_time
+	idx_t GetUndeletedSelVector(transaction_t start_time, idx_t vector_idx, SelectionVector &sel_vector,
+	                            idx_t max_count);
+
 	//! For a specific row, returns true if it should be used for the transaction and false otherwise.
 	bool Fetch(Transaction &transaction, idx_t row);
 
@@ -48,6 +52,10 @@ public:
 
 	void RevertAppend(idx_t start);
 
+	//! Marks count rows starting at start as deleted for every transaction, used for rows that were stored as deleted
+	//! rows in the database file
+	void MarkDeleted(idx_t start, idx_t count);
+
 private:
 	ChunkInfo *GetChunkInfo(idx_t vector_idx);
 
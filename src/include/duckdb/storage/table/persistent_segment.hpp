@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "duckdb/common/enums/compression_type.hpp"
 #include "duckdb/storage/table/column_segment.hpp"
 #include "duckdb/storage/block.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
@@ -17,8 +18,8 @@ namespace duckdb {
 
 class PersistentSegment : public ColumnSegment {
 public:
-	PersistentSegment(BufferManager &manager, block_id_t id, idx_t offset, PhysicalType type, idx_t start, idx_t count,
-	                  data_t stats_min[], data_t stats_max[]);
+	PersistentSegment(BufferManager &manager, block_id_t id, idx_t offset, CompressionType compression, PhysicalType type,
+	                  idx_t start, idx_t count, data_t stats_min[], data_t stats_max[]);
 
 	//! The buffer manager
 	BufferManager &manager;
@@ -26,6 +27,8 @@ public:
 	block_id_t block_id;
 	//! The offset into the block
 	idx_t offset;
+	//! The compression method of the segment
+	CompressionType compression;
 	//! The uncompressed segment that the data of the persistent segment is loaded into
 	unique_ptr<UncompressedSegment> data;
 
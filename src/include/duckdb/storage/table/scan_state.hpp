@@ -91,6 +91,8 @@ public:
 	vector<unique_ptr<StorageLockKey>> locks;
 	std::unique_lock<std::mutex> append_lock;
 	std::unique_lock<std::mutex> delete_lock;
+	//! Rows that have been deleted for every transaction that starts at or after this time are not indexed
+	transaction_t lowest_active_start;
 };
 
 } // namespace duckdb
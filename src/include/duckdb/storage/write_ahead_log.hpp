@@ -13,6 +13,10 @@
 #include "duckdb/common/enums/wal_type.hpp"
 #include "duckdb/common/serializer/buffered_file_writer.hpp"
 #include "duckdb/catalog/catalog_entry/sequence_catalog_entry.hpp"
+#include "duckdb/common/mutex.hpp"
+
+#include <atomic>
+#include <condition_variable>
 
 namespace duckdb {
 
@@ -21,6 +25,7 @@ struct AlterInfo;
 class BufferedSerializer;
 class Catalog;
 class DuckDB;
+class IndexCatalogEntry;
 class SchemaCatalogEntry;
 class SequenceCatalogEntry;
 class ViewCatalogEntry;
@@ -61,6 +66,9 @@ public:
 	void WriteDropSequence(SequenceCatalogEntry *entry);
 	void WriteSequenceValue(SequenceCatalogEntry *entry, SequenceValue val);
 
+	void WriteCreateIndex(IndexCatalogEntry *entry);
+	void WriteDropIndex(IndexCatalogEntry *entry);
+
 	//! Sets the table used for subsequent insert/delete/update commands
 	void WriteSetTable(string &schema, string &table);
 
@@ -72,11 +80,40 @@ public:
 
 	//! Truncate the WAL to a previous size, and clear anything currently set in the writer
 	void Truncate(int64_t size);
+	//! Writes a flush marker and syncs all entries written to the WAL to disk
 	void Flush();
+	//! Syncs the WAL file to disk
+	void Sync();
+	//! Writes a flush marker and writes all buffered entries to the WAL file, without syncing them to disk. Returns
+	//! the id of the flush, which has to be passed to SyncFlush to make the entries durable.
+	idx_t FlushWithoutSync();
+	//! Waits until the entries of the given flush have been synced to disk (group commit). The first committer that
+	//! arrives becomes the leader: it optionally waits for commit_delay microseconds to let other commits join the
+	//! batch, and then issues a single sync for all flushes that were written up to that point. Other committers
+	//! wait for the sync of the leader instead of syncing the file themselves.
+	void SyncFlush(idx_t flush_id, idx_t commit_delay);
+	//! Waits until every flush written to the WAL so far has been synced to disk
+	void SyncAllFlushes();
+	//! Returns the id of the last flush that is known to be synced to disk
+	idx_t GetSyncedFlushId();
 
 private:
 	DuckDB &database;
 	unique_ptr<BufferedFileWriter> writer;
+
+	//! The id of the last flush written to the WAL file
+	std::atomic<idx_t> last_flush_id;
+	//! Lock protecting the group commit state
+	mutex sync_lock;
+	//! Condition variable used to wake up committers waiting for a sync of the leader
+	std::condition_variable sync_finished;
+	//! The id of the last flush that is known to be synced to disk
+	idx_t synced_flush_id;
+	//! Whether or not a leader is currently syncing the WAL
+	bool sync_in_progress;
+	//! The error of a failed sync, if any. After a failed sync it is unknown which entries have reached the disk, so
+	//! every later sync fails as well.
+	string sync_error;
 };
 
 } // namespace duckdb
@@ -34,7 +34,8 @@ class Transaction {
 public:
 	Transaction(transaction_t start_time, transaction_t transaction_id, timestamp_t start_timestamp)
 	    : start_time(start_time), transaction_id(transaction_id), commit_id(0), highest_active_query(0),
-	      active_query(MAXIMUM_QUERY_ID), start_timestamp(start_timestamp), storage(*this), is_invalidated(false) {
+	      active_query(MAXIMUM_QUERY_ID), start_timestamp(start_timestamp), storage(*this), is_invalidated(false),
+	      wal_flush_id(0) {
 	}
 
 	//! The start timestamp of this transaction
@@ -56,6 +57,9 @@ public:
 	unordered_map<SequenceCatalogEntry *, SequenceValue> sequence_usage;
 	//! Whether or not the transaction has been invalidated
 	bool is_invalidated;
+	//! The WAL flush that contains the changes of this transaction, which has to be synced to disk before the commit
+	//! is durable (or 0 if nothing was written to the WAL)
+	idx_t wal_flush_id;
 
 public:
 	static Transaction &GetTransaction(ClientContext &context);
@@ -65,6 +69,8 @@ public:
 	//! Commit the current transaction with the given commit identifier. Returns an error message if the transaction
 	//! commit failed, or an empty string if the commit was sucessful
 	string Commit(WriteAheadLog *log, transaction_t commit_id) noexcept;
+	//! Whether or not the transaction made any changes that have to be written to the WAL on commit
+	bool ChangesMade();
 	//! Rollback
 	void Rollback() noexcept {
 		undo_buffer.Rollback();
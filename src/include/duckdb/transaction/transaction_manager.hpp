@@ -21,6 +21,15 @@ class ClientContext;
 class StorageManager;
 class Transaction;
 
+//! A commit whose WAL flush has been written but not yet synced to disk
+struct PendingCommit {
+	//! The id of the WAL flush of the commit
+	idx_t wal_flush_id;
+	//! A timestamp directly below the commit id of the transaction; it is not used as a commit id by any transaction.
+	//! Transactions that start while the commit is pending use it as start time, so they do not see the commit.
+	transaction_t start_time;
+};
+
 struct StoredCatalogSet {
 	//! Stored catalog set
 	unique_ptr<CatalogSet> stored_set;
@@ -44,13 +53,23 @@ public:
 	//! Add the catalog set
 	void AddCatalogSet(ClientContext &context, unique_ptr<CatalogSet> catalog_set);
 
+	//! Returns the lowest start time of the transactions that are active or can still be started: the versions
+	//! committed before it are visible to every transaction
+	transaction_t LowestActiveStart();
+
 	transaction_t GetQueryNumber() {
 		return current_query_number++;
 	}
 
+	//! The lock held by commits that write to the WAL. Checkpoints hold this lock to prevent transactions from
+	//! committing changes while the checkpoint is created, without blocking readers.
+	mutex checkpoint_lock;
+
 private:
 	//! Remove the given transaction from the list of active transactions
 	void RemoveTransaction(Transaction *transaction) noexcept;
+	//! Removes the pending commits whose WAL flush has been synced, which makes them visible to new transactions
+	void PublishSyncedCommits();
 
 	//! The current query number
 	std::atomic<transaction_t> current_query_number;
@@ -64,6 +83,8 @@ private:
 	vector<unique_ptr<Transaction>> recently_committed_transactions;
 	//! Transactions awaiting GC
 	vector<unique_ptr<Transaction>> old_transactions;
+	//! Commits that are not visible yet because their WAL flush has not been synced, ordered on commit id
+	vector<PendingCommit> pending_commits;
 	//! Catalog sets
 	vector<StoredCatalogSet> old_catalog_sets;
 	//! The lock used for transaction operations
@@ -76,6 +76,9 @@ void DuckDB::Configure(DBConfig &new_config) {
 	}
 	config.checkpoint_only = new_config.checkpoint_only;
 	config.checkpoint_wal_size = new_config.checkpoint_wal_size;
+	config.online_checkpoint_wal_size = new_config.online_checkpoint_wal_size;
+	config.commit_delay = new_config.commit_delay;
+	config.wal_replay_threads = new_config.wal_replay_threads;
 	config.use_direct_io = new_config.use_direct_io;
 	config.maximum_memory = new_config.maximum_memory;
 	config.temporary_directory = new_config.temporary_directory;
@@ -11,6 +11,7 @@
 #include "duckdb/execution/operator/aggregate/physical_simple_aggregate.hpp"
 #include "duckdb/execution/operator/scan/physical_table_scan.hpp"
 #include "duckdb/execution/operator/aggregate/physical_hash_aggregate.hpp"
+#include "duckdb/execution/operator/join/physical_hash_join.hpp"
 
 using namespace std;
 
@@ -23,6 +24,8 @@ public:
 
 	TaskContext task;
 	Pipeline *pipeline;
+	//! The state of the operator that is finished by this task (only used for the deferred tasks of a join)
+	unique_ptr<ParallelState> operator_state;
 
 public:
 	void Execute() override {
@@ -75,6 +78,10 @@ void Pipeline::FinishTask() {
 	D_ASSERT(finished_tasks < total_tasks);
 	idx_t current_finished = ++finished_tasks;
 	if (current_finished == total_tasks) {
+		if (ScheduleDeferredTasks()) {
+			// all threads have finished probing a join: the tasks that finish its probe have been scheduled
+			return;
+		}
 		try {
 			sink->Finalize(*this, executor.context, move(sink_state));
 		} catch (std::exception &ex) {
@@ -100,12 +107,19 @@ bool Pipeline::ScheduleOperator(PhysicalOperator *op) {
 	switch (op->type) {
 	case PhysicalOperatorType::FILTER:
 	case PhysicalOperatorType::PROJECTION:
-	case PhysicalOperatorType::HASH_JOIN:
-		// filter, projection or hash probe: continue in children
+		// filter or projection: continue in children
+		return ScheduleOperator(op->children[0].get());
+	case PhysicalOperatorType::HASH_JOIN: {
+		// hash probe: continue in children
+		auto &join = (PhysicalHashJoin &)*op;
+		if (join.HasDeferredProbe()) {
+			// the join finishes its probe in separate tasks after all threads have read the probe side
+			deferred_joins.push_back(&join);
+		}
 		return ScheduleOperator(op->children[0].get());
+	}
 	case PhysicalOperatorType::TABLE_SCAN: {
 		// we reached a scan: split it up into parts and schedule the parts
-		auto &scheduler = TaskScheduler::GetScheduler(executor.context);
 		auto &get = (PhysicalTableScan &)*op;
 		if (!get.function.max_threads) {
 			// table function cannot be parallelized
@@ -123,27 +137,91 @@ bool Pipeline::ScheduleOperator(PhysicalOperator *op) {
 		}
 		this->parallel_state = get.function.init_parallel_state(executor.context, get.bind_data.get());
 		this->parallel_node = op;
-
-		// launch a task for every thread
-		this->total_tasks = max_threads;
-		for (idx_t i = 0; i < max_threads; i++) {
-			auto task = make_unique<PipelineTask>(this);
-			scheduler.ScheduleTask(*executor.producer, move(task));
-		}
+		ScheduleParallelTasks(max_threads);
 		return true;
 	}
-	case PhysicalOperatorType::HASH_GROUP_BY: {
-		// FIXME: parallelize scan of GROUP_BY HT
-		return false;
-	}
+	case PhysicalOperatorType::ORDER_BY:
+		// the rows are no longer returned in sorted order when the result is read by multiple threads
+		// only do so if the sink does not depend on the order of its input
+		if (sink->type != PhysicalOperatorType::HASH_JOIN && sink->type != PhysicalOperatorType::ORDER_BY) {
+			return false;
+		}
+		return ScheduleParallelSource(op);
+	case PhysicalOperatorType::HASH_GROUP_BY:
+	case PhysicalOperatorType::DISTINCT:
+	case PhysicalOperatorType::WINDOW:
+	case PhysicalOperatorType::CHUNK_SCAN:
+	case PhysicalOperatorType::DELIM_SCAN:
+	case PhysicalOperatorType::RECURSIVE_CTE_SCAN:
+		// materialized result of an earlier pipeline: hand out parts of the result to the threads
+		return ScheduleParallelSource(op);
 	default:
 		// unknown operator: skip parallel task scheduling
 		return false;
 	}
 }
 
+bool Pipeline::ScheduleParallelSource(PhysicalOperator *op) {
+	idx_t max_threads = op->MaxThreads(executor.context);
+	if (max_threads > executor.context.db.NumberOfThreads()) {
+		max_threads = executor.context.db.NumberOfThreads();
+	}
+	if (max_threads <= 1) {
+		// the result is too small to parallelize
+		return false;
+	}
+	this->parallel_state = op->GetParallelState();
+	this->parallel_node = op;
+	ScheduleParallelTasks(max_threads);
+	return true;
+}
+
+void Pipeline::ScheduleParallelTasks(idx_t max_threads) {
+	auto &scheduler = TaskScheduler::GetScheduler(executor.context);
+	for (auto join : deferred_joins) {
+		join->InitializeParallelProbe(executor.context);
+	}
+	// launch a task for every thread
+	this->total_tasks = max_threads;
+	for (idx_t i = 0; i < max_threads; i++) {
+		auto task = make_unique<PipelineTask>(this);
+		scheduler.ScheduleTask(*executor.producer, move(task));
+	}
+}
+
+bool Pipeline::ScheduleDeferredTasks() {
+	auto &scheduler = TaskScheduler::GetScheduler(executor.context);
+	while (!deferred_joins.empty()) {
+		// the joins are finished bottom-up: the tuples emitted by a join are probed by the joins above it
+		auto join = deferred_joins.back();
+		deferred_joins.pop_back();
+		vector<unique_ptr<ParallelState>> task_states;
+		try {
+			task_states = join->GetDeferredProbeTasks(executor.context);
+		} catch (std::exception &ex) {
+			executor.PushError(ex.what());
+		} catch (...) {
+			executor.PushError("Unknown exception in hash join probe!");
+		}
+		if (task_states.empty()) {
+			continue;
+		}
+		this->total_tasks += task_states.size();
+		for (auto &task_state : task_states) {
+			auto task = make_unique<PipelineTask>(this);
+			task->task.task_info[join] = task_state.get();
+			task->operator_state = move(task_state);
+			scheduler.ScheduleTask(*executor.producer, move(task));
+		}
+		return true;
+	}
+	return false;
+}
+
 void Pipeline::Reset(ClientContext &context) {
 	sink_state = sink->GetGlobalState(context);
+	parallel_state = nullptr;
+	deferred_joins.clear();
 	finished_tasks = 0;
 	total_tasks = 0;
 	finished = false;
@@ -180,6 +258,14 @@ void Pipeline::Schedule() {
 		}
 		break;
 	}
+	case PhysicalOperatorType::ORDER_BY: {
+		// order by: every thread sorts its own runs, which are merged in parallel in the Finalize
+		if (ScheduleOperator(sink->children[0].get())) {
+			// all parallel tasks have been scheduled: return
+			return;
+		}
+		break;
+	}
 	case PhysicalOperatorType::HASH_JOIN: {
 		// schedule build side of the join
 		if (ScheduleOperator(sink->children[1].get())) {
@@ -191,7 +277,8 @@ void Pipeline::Schedule() {
 	default:
 		break;
 	}
-	// could not parallelize this pipeline: push a sequential task instead
+	// could not parallelize this pipeline: push a sequential task instead, the joins finish their probe inline
+	deferred_joins.clear();
 	ScheduleSequentialTask();
 }
 
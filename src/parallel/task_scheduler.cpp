@@ -7,6 +7,8 @@
 #include "concurrentqueue.h"
 #include "lightweightsemaphore.h"
 
+#include <condition_variable>
+
 using namespace std;
 
 namespace duckdb {
@@ -78,6 +80,73 @@ void TaskScheduler::ExecuteForever(bool *marker) {
 	}
 }
 
+//! The shared state of a set of tasks executed by ExecuteTasks
+struct TaskGroupState {
+	TaskGroupState(idx_t total_tasks) : total_tasks(total_tasks), finished_tasks(0) {
+	}
+
+	idx_t total_tasks;
+	//! The amount of tasks that have finished, protected by the lock
+	idx_t finished_tasks;
+	mutex lock;
+	std::condition_variable tasks_finished;
+	//! The error thrown by one of the tasks, if any
+	string error;
+};
+
+//! Executes a task of a task group, and signals the group when the task has finished
+class TaskGroupTask : public Task {
+public:
+	TaskGroupTask(TaskGroupState &state, unique_ptr<Task> task) : state(state), task(move(task)) {
+	}
+
+	void Execute() override {
+		string error;
+		try {
+			task->Execute();
+		} catch (std::exception &ex) {
+			error = ex.what();
+		}
+		task.reset();
+		lock_guard<mutex> guard(state.lock);
+		if (!error.empty()) {
+			state.error = error;
+		}
+		state.finished_tasks++;
+		if (state.finished_tasks == state.total_tasks) {
+			state.tasks_finished.notify_all();
+		}
+	}
+
+private:
+	TaskGroupState &state;
+	unique_ptr<Task> task;
+};
+
+void TaskScheduler::ExecuteTasks(ProducerToken &producer, vector<unique_ptr<Task>> tasks) {
+	if (tasks.empty()) {
+		return;
+	}
+	TaskGroupState state(tasks.size());
+	for (auto &task : tasks) {
+		ScheduleTask(producer, make_unique<TaskGroupTask>(state, move(task)));
+	}
+	// execute tasks on this thread as well until the queue of the producer is empty
+	unique_ptr<Task> task;
+	while (GetTaskFromProducer(producer, task)) {
+		task->Execute();
+		task.reset();
+	}
+	// wait for the tasks that are still running on other threads
+	unique_lock<mutex> guard(state.lock);
+	while (state.finished_tasks < state.total_tasks) {
+		state.tasks_finished.wait(guard);
+	}
+	if (!state.error.empty()) {
+		throw Exception(state.error);
+	}
+}
+
 static void ThreadExecuteTasks(TaskScheduler *scheduler, bool *marker) {
 	scheduler->ExecuteForever(marker);
 }
@@ -7,171 +7,292 @@ using namespace std;
 
 BufferManager::BufferManager(FileSystem &fs, BlockManager &manager, string tmp, idx_t maximum_memory)
     : fs(fs), manager(manager), current_memory(0), maximum_memory(maximum_memory), temp_directory(move(tmp)),
-      temporary_id(MAXIMUM_BLOCK) {
+      eviction_position(0), temporary_id(MAXIMUM_BLOCK), buffer_hits(0), buffer_misses(0), buffer_evictions(0),
+      buffer_prefetches(0), read_ahead_shutdown(false) {
 	if (!temp_directory.empty()) {
 		fs.CreateDirectory(temp_directory);
 	}
 }
 
 BufferManager::~BufferManager() {
+	// stop the read-ahead threads before any of the buffers are destroyed
+	{
+		lock_guard<mutex> lock(read_ahead_lock);
+		read_ahead_shutdown = true;
+	}
+	read_ahead_available.notify_all();
+	for (auto &thread : read_ahead_threads) {
+		thread.join();
+	}
 	if (!temp_directory.empty()) {
 		fs.RemoveDirectory(temp_directory);
 	}
 }
 
-unique_ptr<BufferHandle> BufferManager::Pin(block_id_t block_id, bool can_destroy) {
-	// first obtain a lock on the set of blocks
-	lock_guard<mutex> lock(block_lock);
+unique_ptr<BufferHandle> BufferManager::Pin(block_id_t block_id, bool can_destroy, PinHint hint) {
 	if (block_id < MAXIMUM_BLOCK) {
-		return PinBlock(block_id);
+		return PinBlock(block_id, hint);
 	} else {
-		return PinBuffer(block_id, can_destroy);
+		return PinBuffer(block_id, can_destroy, hint);
 	}
 }
 
-unique_ptr<BufferHandle> BufferManager::PinBlock(block_id_t block_id) {
+unique_ptr<BufferHandle> BufferManager::PinBlock(block_id_t block_id, PinHint hint) {
 	// this method should only be used to pin blocks that exist in the file
 	D_ASSERT(block_id < MAXIMUM_BLOCK);
+	auto &shard = GetShard(block_id);
+	{
+		unique_lock<mutex> lock(shard.lock);
+		// if the block is being read by another thread (e.g. by read-ahead) wait for the read to finish
+		while (shard.pending_reads.find(block_id) != shard.pending_reads.end()) {
+			shard.read_finished.wait(lock);
+		}
+		// check if the block is already loaded
+		auto entry = shard.blocks.find(block_id);
+		if (entry != shard.blocks.end()) {
+			auto buffer = entry->second->buffer.get();
+			D_ASSERT(buffer->type == FileBufferType::BLOCK);
+			// add one to the reference count
+			AddReference(shard, entry->second, hint);
+			buffer_hits++;
+			return make_unique<BufferHandle>(*this, block_id, buffer);
+		}
+		// block is not loaded: mark it as pending, so other threads pinning the block wait for this read
+		shard.pending_reads.insert(block_id);
+	}
+	buffer_misses++;
+	auto entry = LoadBlock(block_id, true);
+	return make_unique<BufferHandle>(*this, block_id, entry->buffer.get());
+}
 
-	// check if the block is already loaded
-	Block *result_block;
-	auto entry = blocks.find(block_id);
-	if (entry == blocks.end()) {
-		// block is not loaded, load the block
-		current_memory += Storage::BLOCK_ALLOC_SIZE;
-		unique_ptr<Block> block;
-		if (current_memory > maximum_memory) {
-			// not enough memory to hold the block: have to evict a block first
-			block = EvictBlock();
-			if (!block) {
-				// evicted a managed buffer: no block returned
-				// create a new block
-				block = make_unique<Block>(block_id);
-			} else {
-				// take over the evicted block and use it to hold this block
-				block->id = block_id;
-			}
-		} else {
-			// enough memory to create a new block: allocate it
-			block = make_unique<Block>(block_id);
+BufferEntry *BufferManager::LoadBlock(block_id_t block_id, bool pin) {
+	auto &shard = GetShard(block_id);
+	// make room for the block and read it without holding the lock of the shard
+	unique_ptr<Block> block;
+	try {
+		ReserveMemory(Storage::BLOCK_ALLOC_SIZE);
+		block = make_unique<Block>(block_id);
+		try {
+			manager.Read(*block);
+		} catch (...) {
+			current_memory -= Storage::BLOCK_ALLOC_SIZE;
+			throw;
 		}
-		manager.Read(*block);
-		result_block = block.get();
-		// create a new buffer entry for this block and insert it into the block list
-		auto buffer_entry = make_unique<BufferEntry>(move(block));
-		blocks.insert(make_pair(block_id, buffer_entry.get()));
-		used_list.Append(move(buffer_entry));
+	} catch (...) {
+		lock_guard<mutex> lock(shard.lock);
+		shard.pending_reads.erase(block_id);
+		shard.read_finished.notify_all();
+		throw;
+	}
+
+	lock_guard<mutex> lock(shard.lock);
+	shard.pending_reads.erase(block_id);
+	shard.read_finished.notify_all();
+	D_ASSERT(shard.blocks.find(block_id) == shard.blocks.end());
+	// create a new buffer entry for this block and insert it into the used list
+	auto buffer_entry = make_unique<BufferEntry>(move(block));
+	auto result = buffer_entry.get();
+	shard.blocks.insert(make_pair(block_id, result));
+	if (pin) {
+		shard.used_list.Append(move(buffer_entry));
 	} else {
-		auto buffer = entry->second->buffer.get();
-		D_ASSERT(buffer->type == FileBufferType::BLOCK);
-		result_block = (Block *)buffer;
-		// add one to the reference count
-		AddReference(entry->second);
+		buffer_entry->ref_count = 0;
+		shard.cold_list.Append(move(buffer_entry));
 	}
-	return make_unique<BufferHandle>(*this, block_id, result_block);
+	return result;
 }
 
-void BufferManager::AddReference(BufferEntry *entry) {
+void BufferManager::Prefetch(block_id_t block_id) {
+	D_ASSERT(block_id < MAXIMUM_BLOCK);
+	lock_guard<mutex> read_ahead_guard(read_ahead_lock);
+	if (read_ahead_queue.size() >= MAXIMUM_READ_AHEAD_QUEUE ||
+	    read_ahead_blocks.find(block_id) != read_ahead_blocks.end()) {
+		// too many blocks are waiting to be read already, or this block is already waiting
+		return;
+	}
+	{
+		auto &shard = GetShard(block_id);
+		lock_guard<mutex> lock(shard.lock);
+		if (shard.blocks.find(block_id) != shard.blocks.end() ||
+		    shard.pending_reads.find(block_id) != shard.pending_reads.end()) {
+			// the block is already in memory or being read
+			return;
+		}
+	}
+	if (read_ahead_threads.empty()) {
+		for (idx_t i = 0; i < READ_AHEAD_THREADS; i++) {
+			read_ahead_threads.push_back(std::thread([this]() { ReadAheadThread(); }));
+		}
+	}
+	read_ahead_queue.push(block_id);
+	read_ahead_blocks.insert(block_id);
+	read_ahead_available.notify_one();
+}
+
+void BufferManager::ReadAheadThread() {
+	while (true) {
+		block_id_t block_id;
+		{
+			unique_lock<mutex> lock(read_ahead_lock);
+			while (read_ahead_queue.empty() && !read_ahead_shutdown) {
+				read_ahead_available.wait(lock);
+			}
+			if (read_ahead_shutdown) {
+				return;
+			}
+			block_id = read_ahead_queue.front();
+			read_ahead_queue.pop();
+			read_ahead_blocks.erase(block_id);
+		}
+		{
+			// the block might have been pinned since it was queued
+			auto &shard = GetShard(block_id);
+			lock_guard<mutex> lock(shard.lock);
+			if (shard.blocks.find(block_id) != shard.blocks.end() ||
+			    shard.pending_reads.find(block_id) != shard.pending_reads.end()) {
+				continue;
+			}
+			shard.pending_reads.insert(block_id);
+		}
+		try {
+			LoadBlock(block_id, false);
+			buffer_prefetches++;
+		} catch (...) {
+			// failing to read ahead is not an error: the block is read (and the error is reported) when it is pinned
+		}
+	}
+}
+
+void BufferManager::RegisterBuffer(BufferShard &shard, block_id_t id, unique_ptr<FileBuffer> buffer) {
+	// create a new buffer entry for this buffer and insert it into the used list
+	auto buffer_entry = make_unique<BufferEntry>(move(buffer));
+	shard.blocks.insert(make_pair(id, buffer_entry.get()));
+	shard.used_list.Append(move(buffer_entry));
+}
+
+void BufferManager::AddReference(BufferShard &shard, BufferEntry *entry, PinHint hint) {
 	entry->ref_count++;
 	if (entry->ref_count == 1) {
 		// ref count is 1, that means it used to be 0 (unused)
-		// move from lru to used_list
-		auto current_entry = lru.Erase(entry);
-		used_list.Append(move(current_entry));
+		// move from the cold or hot list to used_list
+		auto current_entry = entry->hot ? shard.hot_list.Erase(entry) : shard.cold_list.Erase(entry);
+		shard.used_list.Append(move(current_entry));
+	}
+	if (hint != PinHint::USE_ONCE) {
+		// the buffer is used again: keep it in the hot list when it is unpinned
+		entry->hot = true;
 	}
 }
 
 void BufferManager::Unpin(block_id_t block_id) {
-	lock_guard<mutex> lock(block_lock);
+	auto &shard = GetShard(block_id);
+	lock_guard<mutex> lock(shard.lock);
 	// first find the block in the set of blocks
-	auto entry = blocks.find(block_id);
-	D_ASSERT(entry != blocks.end());
+	auto entry = shard.blocks.find(block_id);
+	D_ASSERT(entry != shard.blocks.end());
 
 	auto buffer_entry = entry->second;
 	// then decerase the ref count
 	D_ASSERT(buffer_entry->ref_count > 0);
 	buffer_entry->ref_count--;
 	if (buffer_entry->ref_count == 0) {
-		// no references left: move block out of used list and into lru list
-		auto entry = used_list.Erase(buffer_entry);
+		// no references left: move block out of used list and into the cold or hot list
+		auto current_entry = shard.used_list.Erase(buffer_entry);
 		if (buffer_entry->buffer->type == FileBufferType::MANAGED_BUFFER) {
 			auto managed = (ManagedBuffer *)buffer_entry->buffer.get();
 			if (managed->can_destroy) {
 				// this is a managed buffer that we can destroy
-				// instead of adding it to the LRU list, just deallocate the managed buffer immediately
-				current_memory -= managed->size;
+				// instead of adding it to the cold list, just deallocate the managed buffer immediately
+				current_memory -= managed->AllocSize();
+				shard.blocks.erase(entry);
 				return;
 			}
 		}
-		lru.Append(move(entry));
+		if (buffer_entry->hot) {
+			shard.hot_list.Append(move(current_entry));
+		} else {
+			shard.cold_list.Append(move(current_entry));
+		}
 	}
 }
 
-unique_ptr<Block> BufferManager::EvictBlock() {
+void BufferManager::ReserveMemory(idx_t size) {
+	current_memory += size;
+	try {
+		while (current_memory > maximum_memory) {
+			if (!EvictBlock()) {
+				throw Exception("Not enough memory to complete operation!");
+			}
+		}
+	} catch (...) {
+		current_memory -= size;
+		throw;
+	}
+}
+
+bool BufferManager::EvictBlock() {
 	if (temp_directory.empty()) {
 		throw Exception("Out-of-memory: cannot evict buffer because no temporary directory is specified!\nTo enable "
 		                "temporary buffer eviction set a temporary directory in the configuration");
 	}
-	// pop the first entry from the lru list
-	auto entry = lru.Pop();
-	if (!entry) {
-		throw Exception("Not enough memory to complete operation!");
-	}
-	D_ASSERT(entry->ref_count == 0);
-	// erase this identifier from the set of blocks
-	auto buffer = entry->buffer.get();
-	if (buffer->type == FileBufferType::BLOCK) {
-		// block buffer: remove the block and reuse it
-		auto block = (Block *)buffer;
-		blocks.erase(block->id);
-		// free up the memory
-		current_memory -= Storage::BLOCK_ALLOC_SIZE;
-		// finally return the block obtained from the current entry
-		return unique_ptr_cast<FileBuffer, Block>(move(entry->buffer));
-	} else {
-		// managed buffer: cannot return a block here
-		auto managed = (ManagedBuffer *)buffer;
-		D_ASSERT(!managed->can_destroy);
-
-		// cannot destroy this buffer: write it to disk first so it can be reloaded later
-		WriteTemporaryBuffer(*managed);
-
-		blocks.erase(managed->id);
-		// free up the memory
-		current_memory -= managed->size;
-		return nullptr;
+	// first look for a buffer that was used only once, and only then evict buffers that were used repeatedly
+	// the search starts at a different shard every time, so the evictions are spread over the shards
+	for (idx_t hot = 0; hot < 2; hot++) {
+		idx_t start = eviction_position++;
+		for (idx_t i = 0; i < SHARD_COUNT; i++) {
+			auto &shard = shards[(start + i) % SHARD_COUNT];
+			lock_guard<mutex> lock(shard.lock);
+			auto entry = hot ? shard.hot_list.Pop() : shard.cold_list.Pop();
+			if (!entry) {
+				continue;
+			}
+			D_ASSERT(entry->ref_count == 0);
+			auto buffer = entry->buffer.get();
+			if (buffer->type == FileBufferType::BLOCK) {
+				// block buffer: the block can be read from the file again
+				shard.blocks.erase(((Block *)buffer)->id);
+			} else {
+				// managed buffer: cannot destroy this buffer, write it to disk first so it can be reloaded later
+				auto managed = (ManagedBuffer *)buffer;
+				D_ASSERT(!managed->can_destroy);
+				WriteTemporaryBuffer(*managed);
+				shard.blocks.erase(managed->id);
+			}
+			// free up the memory
+			current_memory -= buffer->AllocSize();
+			buffer_evictions++;
+			return true;
+		}
 	}
+	return false;
 }
 
 unique_ptr<BufferHandle> BufferManager::Allocate(idx_t alloc_size, bool can_destroy) {
 	D_ASSERT(alloc_size >= Storage::BLOCK_ALLOC_SIZE);
 
-	lock_guard<mutex> lock(block_lock);
-	// first evict blocks until we have enough memory to store this buffer
-	while (current_memory + alloc_size > maximum_memory) {
-		EvictBlock();
-	}
 	// now allocate the buffer with a new temporary id
 	auto temp_id = ++temporary_id;
 	auto buffer = make_unique<ManagedBuffer>(*this, alloc_size, can_destroy, temp_id);
 	auto managed_buffer = buffer.get();
-	current_memory += buffer->AllocSize();
+	// first evict blocks until we have enough memory to store this buffer
+	ReserveMemory(buffer->AllocSize());
 	// create a new entry and append it to the used list
-	auto buffer_entry = make_unique<BufferEntry>(move(buffer));
-	blocks.insert(make_pair(temp_id, buffer_entry.get()));
-	used_list.Append(move(buffer_entry));
+	auto &shard = GetShard(temp_id);
+	lock_guard<mutex> lock(shard.lock);
+	RegisterBuffer(shard, temp_id, move(buffer));
 	// now return a handle to the entry
 	return make_unique<BufferHandle>(*this, temp_id, managed_buffer);
 }
 
 void BufferManager::DestroyBuffer(block_id_t buffer_id, bool can_destroy) {
-	lock_guard<mutex> lock(block_lock);
-
 	D_ASSERT(buffer_id >= MAXIMUM_BLOCK);
-	// this is like unpin, except we just destroy the entry entirely instead of adding it to the LRU list
+	auto &shard = GetShard(buffer_id);
+	lock_guard<mutex> lock(shard.lock);
+
+	// this is like unpin, except we just destroy the entry entirely instead of adding it to the cold list
 	// first find the block in the set of blocks
-	auto entry = blocks.find(buffer_id);
-	if (entry == blocks.end()) {
+	auto entry = shard.blocks.find(buffer_id);
+	if (entry == shard.blocks.end()) {
 		// buffer is not currently loaded into memory
 		// check if it was offloaded to disk instead
 		if (!can_destroy) {
@@ -185,40 +306,58 @@ void BufferManager::DestroyBuffer(block_id_t buffer_id, bool can_destroy) {
 	D_ASSERT(handle->ref_count == 0);
 
 	current_memory -= handle->buffer->AllocSize();
-	blocks.erase(buffer_id);
-	lru.Erase(handle);
+	shard.blocks.erase(entry);
+	if (handle->hot) {
+		shard.hot_list.Erase(handle);
+	} else {
+		shard.cold_list.Erase(handle);
+	}
 }
 
 void BufferManager::SetLimit(idx_t limit) {
-	lock_guard<mutex> lock(block_lock);
-
 	while (current_memory > limit) {
-		EvictBlock();
+		if (!EvictBlock()) {
+			throw Exception("Not enough memory to complete operation!");
+		}
 	}
 	maximum_memory = limit;
 }
 
-unique_ptr<BufferHandle> BufferManager::PinBuffer(block_id_t buffer_id, bool can_destroy) {
+BufferManagerStatistics BufferManager::GetStatistics() {
+	BufferManagerStatistics result;
+	result.hits = buffer_hits;
+	result.misses = buffer_misses;
+	result.evictions = buffer_evictions;
+	result.prefetches = buffer_prefetches;
+	return result;
+}
+
+unique_ptr<BufferHandle> BufferManager::PinBuffer(block_id_t buffer_id, bool can_destroy, PinHint hint) {
 	D_ASSERT(buffer_id >= MAXIMUM_BLOCK);
-	// check if we have this buffer here
-	auto entry = blocks.find(buffer_id);
-	if (entry == blocks.end()) {
-		if (can_destroy) {
-			// buffer was destroyed: return nullptr
-			return nullptr;
-		} else {
-			// buffer was unloaded but not destroyed: read from disk
-			return ReadTemporaryBuffer(buffer_id);
+	auto &shard = GetShard(buffer_id);
+	{
+		// check if we have this buffer here
+		lock_guard<mutex> lock(shard.lock);
+		auto entry = shard.blocks.find(buffer_id);
+		if (entry != shard.blocks.end()) {
+			// we still have the buffer, add a reference to it
+			auto buffer = entry->second->buffer.get();
+			AddReference(shard, entry->second, hint);
+			buffer_hits++;
+			// now return it
+			D_ASSERT(buffer->type == FileBufferType::MANAGED_BUFFER);
+			auto managed = (ManagedBuffer *)buffer;
+			D_ASSERT(managed->id == buffer_id);
+			return make_unique<BufferHandle>(*this, buffer_id, managed);
 		}
 	}
-	// we still have the buffer, add a reference to it
-	auto buffer = entry->second->buffer.get();
-	AddReference(entry->second);
-	// now return it
-	D_ASSERT(buffer->type == FileBufferType::MANAGED_BUFFER);
-	auto managed = (ManagedBuffer *)buffer;
-	D_ASSERT(managed->id == buffer_id);
-	return make_unique<BufferHandle>(*this, buffer_id, managed);
+	if (can_destroy) {
+		// buffer was destroyed: return nullptr
+		return nullptr;
+	}
+	// buffer was unloaded but not destroyed: read from disk
+	buffer_misses++;
+	return ReadTemporaryBuffer(buffer_id);
 }
 
 string BufferManager::GetTemporaryPath(block_id_t id) {
@@ -246,19 +385,30 @@ unique_ptr<BufferHandle> BufferManager::ReadTemporaryBuffer(block_id_t id) {
 	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
 	handle->Read(&alloc_size, sizeof(idx_t), 0);
 	// first evict blocks until we can handle the size
-	while (current_memory + alloc_size > maximum_memory) {
-		EvictBlock();
-	}
-	// now allocate a buffer of this size and read the data into that buffer
 	auto buffer = make_unique<ManagedBuffer>(*this, alloc_size + Storage::BLOCK_HEADER_SIZE, false, id);
-	buffer->Read(*handle, sizeof(idx_t));
+	ReserveMemory(buffer->AllocSize());
 
+	// the buffer is read while holding the lock of the shard, so it cannot be evicted (and rewritten) concurrently
+	auto &shard = GetShard(id);
+	lock_guard<mutex> lock(shard.lock);
+	auto entry = shard.blocks.find(id);
+	if (entry != shard.blocks.end()) {
+		// the buffer was read by another thread in the meantime: use that buffer instead
+		current_memory -= buffer->AllocSize();
+		auto managed = (ManagedBuffer *)entry->second->buffer.get();
+		AddReference(shard, entry->second, PinHint::USE_ONCE);
+		return make_unique<BufferHandle>(*this, id, managed);
+	}
+	// now read the data into the buffer
+	try {
+		buffer->Read(*handle, sizeof(idx_t));
+	} catch (...) {
+		current_memory -= buffer->AllocSize();
+		throw;
+	}
 	auto managed_buffer = buffer.get();
-	current_memory += buffer->AllocSize();
 	// create a new entry and append it to the used list
-	auto buffer_entry = make_unique<BufferEntry>(move(buffer));
-	blocks.insert(make_pair(id, buffer_entry.get()));
-	used_list.Append(move(buffer_entry));
+	RegisterBuffer(shard, id, move(buffer));
 	// now return a handle to the entry
 	return make_unique<BufferHandle>(*this, id, managed_buffer);
 }
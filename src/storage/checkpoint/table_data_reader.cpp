@@ -5,30 +5,21 @@
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/common/types/null_value.hpp"
 
-#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
-
-#include "duckdb/planner/parsed_data/bound_create_table_info.hpp"
-
-#include "duckdb/main/database.hpp"
-#include "duckdb/main/client_context.hpp"
-
 namespace duckdb {
 using namespace std;
 
-TableDataReader::TableDataReader(CheckpointManager &manager, MetaBlockReader &reader, BoundCreateTableInfo &info)
-    : manager(manager), reader(reader), info(info) {
-	info.data = unique_ptr<vector<unique_ptr<PersistentSegment>>[]>(
-	    new vector<unique_ptr<PersistentSegment>>[info.Base().columns.size()]);
+TableDataReader::TableDataReader(BufferManager &buffer_manager, MetaBlockReader &reader,
+                                 const vector<LogicalType> &types)
+    : buffer_manager(buffer_manager), reader(reader), types(types) {
 }
 
-void TableDataReader::ReadTableData() {
-	auto &columns = info.Base().columns;
-	D_ASSERT(columns.size() > 0);
+persistent_data_t TableDataReader::ReadTableData(vector<pair<idx_t, idx_t>> &deleted_rows) {
+	D_ASSERT(types.size() > 0);
+	auto data = persistent_data_t(new vector<unique_ptr<PersistentSegment>>[types.size()]);
 
 	// load the data pointers for the table
 	idx_t table_count = 0;
-	for (idx_t col = 0; col < columns.size(); col++) {
-		auto &column = columns[col];
+	for (idx_t col = 0; col < types.size(); col++) {
 		idx_t column_count = 0;
 		idx_t data_pointer_count = reader.Read<idx_t>();
 		for (idx_t data_ptr = 0; data_ptr < data_pointer_count; data_ptr++) {
@@ -40,15 +31,17 @@ void TableDataReader::ReadTableData() {
 			data_pointer.tuple_count = reader.Read<idx_t>();
 			data_pointer.block_id = reader.Read<block_id_t>();
 			data_pointer.offset = reader.Read<uint32_t>();
+			data_pointer.compression = (CompressionType)reader.Read<uint8_t>();
 			reader.ReadData(data_pointer.min_stats, 16);
 			reader.ReadData(data_pointer.max_stats, 16);
 
 			column_count += data_pointer.tuple_count;
 			// create a persistent segment
 			auto segment = make_unique<PersistentSegment>(
-			    manager.buffer_manager, data_pointer.block_id, data_pointer.offset, column.type.InternalType(),
-			    data_pointer.row_start, data_pointer.tuple_count, data_pointer.min_stats, data_pointer.max_stats);
-			info.data[col].push_back(move(segment));
+			    buffer_manager, data_pointer.block_id, data_pointer.offset, data_pointer.compression,
+			    types[col].InternalType(), data_pointer.row_start, data_pointer.tuple_count, data_pointer.min_stats,
+			    data_pointer.max_stats);
+			data[col].push_back(move(segment));
 		}
 		if (col == 0) {
 			table_count = column_count;
@@ -58,6 +51,14 @@ void TableDataReader::ReadTableData() {
 			}
 		}
 	}
+	// finally read the ranges of rows that are deleted
+	idx_t deleted_count = reader.Read<idx_t>();
+	for (idx_t i = 0; i < deleted_count; i++) {
+		auto row_start = reader.Read<idx_t>();
+		auto count = reader.Read<idx_t>();
+		deleted_rows.push_back(make_pair(row_start, count));
+	}
+	return data;
 }
 
 } // namespace duckdb
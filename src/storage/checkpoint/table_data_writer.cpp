@@ -6,6 +6,7 @@
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/common/serializer/buffered_serializer.hpp"
 
+#include "duckdb/storage/compressed_segment.hpp"
 #include "duckdb/storage/numeric_segment.hpp"
 #include "duckdb/storage/string_segment.hpp"
 #include "duckdb/storage/table/column_segment.hpp"
@@ -39,56 +40,78 @@ private:
 
 TableDataWriter::TableDataWriter(CheckpointManager &manager, TableCatalogEntry &table)
     : manager(manager), table(table) {
-}
-
-TableDataWriter::~TableDataWriter() {
-}
-
-void TableDataWriter::WriteTableData(ClientContext &context) {
-	auto &transaction = Transaction::GetTransaction(context);
-	// allocate segments to write the table to
+	// allocate the state to write each of the columns
 	segments.resize(table.columns.size());
 	data_pointers.resize(table.columns.size());
+	compressed_handles.resize(table.columns.size());
+	compressed_offsets.resize(table.columns.size(), 0);
+	compressed_pointers.resize(table.columns.size());
 	for (idx_t i = 0; i < table.columns.size(); i++) {
 		auto type_id = table.columns[i].type.InternalType();
 		stats.push_back(make_unique<SegmentStatistics>(type_id, GetTypeIdSize(type_id)));
-		CreateSegment(i);
 	}
+}
+
+TableDataWriter::~TableDataWriter() {
+}
+
+void TableDataWriter::WriteColumnData(Transaction &transaction, idx_t col_idx) {
+	// allocate a segment to write the column to
+	CreateSegment(col_idx);
 
-	// now start scanning the table and append the data to the uncompressed segments
-	vector<column_t> column_ids;
-	for (auto &column : table.columns) {
-		column_ids.push_back(column.oid);
+	// now start scanning the column and append the data to the uncompressed segments
+	vector<column_t> column_ids{table.columns[col_idx].oid};
+	vector<LogicalType> types{table.columns[col_idx].type};
+	if (manager.keep_row_ids) {
+		// scan the row ids as well: the rows that are not visible to the checkpoint are written as deleted rows
+		column_ids.push_back(COLUMN_IDENTIFIER_ROW_ID);
+		types.push_back(LOGICAL_ROW_TYPE);
 	}
 	// initialize scan structures to prepare for the scan
 	TableScanState state;
 	table.storage->InitializeScan(transaction, state, column_ids);
-	//! get all types of the table and initialize the chunk
-	auto types = table.GetTypes();
+	idx_t total_rows = state.max_row;
 	DataChunk chunk;
 	chunk.Initialize(types);
 
+	idx_t next_row = 0;
 	while (true) {
 		chunk.Reset();
-		// now scan the table to construct the blocks
+		// now scan the column to construct the blocks
 		unordered_map<idx_t, vector<TableFilter>> mock;
 		table.storage->Scan(transaction, chunk, state, column_ids, mock);
 		if (chunk.size() == 0) {
 			break;
 		}
-		// for each column, we append whatever we can fit into the block
-		idx_t chunk_size = chunk.size();
-		for (idx_t i = 0; i < table.columns.size(); i++) {
-			D_ASSERT(chunk.data[i].type == table.columns[i].type);
-			AppendData(transaction, i, chunk.data[i], chunk_size);
+		// append whatever we can fit into the block
+		D_ASSERT(chunk.data[0].type == table.columns[col_idx].type);
+		if (!manager.keep_row_ids) {
+			AppendData(transaction, col_idx, chunk.data[0], 0, chunk.size());
+			continue;
+		}
+		// append the runs of consecutive rows, and fill the gaps between them with deleted rows
+		VectorData row_data;
+		chunk.data[1].Orrify(chunk.size(), row_data);
+		auto row_ids = (row_t *)row_data.data;
+		idx_t run_start = 0;
+		for (idx_t i = 0; i < chunk.size(); i++) {
+			idx_t row_id = row_ids[row_data.sel->get_index(i)];
+			D_ASSERT(row_id >= next_row);
+			if (row_id != next_row) {
+				AppendData(transaction, col_idx, chunk.data[0], run_start, i - run_start);
+				AppendDeletedRows(transaction, col_idx, next_row, row_id - next_row);
+				run_start = i;
+			}
+			next_row = row_id + 1;
 		}
+		AppendData(transaction, col_idx, chunk.data[0], run_start, chunk.size() - run_start);
 	}
-	// flush any remaining data and write the data pointers to disk
-	for (idx_t i = 0; i < table.columns.size(); i++) {
-		FlushSegment(transaction, i);
+	if (manager.keep_row_ids) {
+		// the rows at the end of the table that are not visible
+		AppendDeletedRows(transaction, col_idx, next_row, total_rows - next_row);
 	}
-	VerifyDataPointers();
-	WriteDataPointers();
+	// flush any remaining data; the last compressed block is packed together with those of the other columns
+	FlushSegment(transaction, col_idx);
 }
 
 void TableDataWriter::CreateSegment(idx_t col_idx) {
@@ -96,14 +119,14 @@ void TableDataWriter::CreateSegment(idx_t col_idx) {
 	if (type_id == PhysicalType::VARCHAR) {
 		auto string_segment = make_unique<StringSegment>(manager.buffer_manager, 0);
 		string_segment->overflow_writer = make_unique<WriteOverflowStringsToDisk>(manager);
+		string_segment->dictionary_entries = make_unique<unordered_map<string, int32_t>>();
 		segments[col_idx] = move(string_segment);
 	} else {
 		segments[col_idx] = make_unique<NumericSegment>(manager.buffer_manager, type_id, 0);
 	}
 }
 
-void TableDataWriter::AppendData(Transaction &transaction, idx_t col_idx, Vector &data, idx_t count) {
-	idx_t offset = 0;
+void TableDataWriter::AppendData(Transaction &transaction, idx_t col_idx, Vector &data, idx_t offset, idx_t count) {
 	while (count > 0) {
 		idx_t appended = segments[col_idx]->Append(*stats[col_idx], data, offset, count);
 		if (appended == count) {
@@ -120,22 +143,27 @@ void TableDataWriter::AppendData(Transaction &transaction, idx_t col_idx, Vector
 	}
 }
 
+void TableDataWriter::AppendDeletedRows(Transaction &transaction, idx_t col_idx, idx_t row_start, idx_t count) {
+	if (count == 0) {
+		return;
+	}
+	if (col_idx == 0) {
+		// all columns have the same deleted rows: only the first column keeps track of them
+		deleted_rows.push_back(make_pair(row_start, count));
+	}
+	// the deleted rows are stored as NULL values
+	Vector null_data(Value(table.columns[col_idx].type));
+	AppendData(transaction, col_idx, null_data, 0, count);
+}
+
 void TableDataWriter::FlushSegment(Transaction &transaction, idx_t col_idx) {
 	auto tuple_count = segments[col_idx]->tuple_count;
 	if (tuple_count == 0) {
 		return;
 	}
 
-	// get the buffer of the segment and pin it
-	auto handle = manager.buffer_manager.Pin(segments[col_idx]->block_id);
-
-	// get a free block id to write to
-	auto block_id = manager.block_manager.GetFreeBlockId();
-
-	// construct the data pointer, FIXME: add statistics as well
+	// construct the data pointer
 	DataPointer data_pointer;
-	data_pointer.block_id = block_id;
-	data_pointer.offset = 0;
 	data_pointer.row_start = 0;
 	if (data_pointers[col_idx].size() > 0) {
 		auto &last_pointer = data_pointers[col_idx].back();
@@ -145,12 +173,81 @@ void TableDataWriter::FlushSegment(Transaction &transaction, idx_t col_idx) {
 	idx_t type_size = stats[col_idx]->type == PhysicalType::VARCHAR ? 8 : stats[col_idx]->type_size;
 	memcpy(&data_pointer.min_stats, stats[col_idx]->minimum.get(), type_size);
 	memcpy(&data_pointer.max_stats, stats[col_idx]->maximum.get(), type_size);
+
+	// figure out which compression method to use for the segment based on its statistics and contents
+	idx_t compressed_size = 0;
+	data_pointer.compression = CompressionType::UNCOMPRESSED;
+	if (stats[col_idx]->type != PhysicalType::VARCHAR) {
+		data_pointer.compression =
+		    CompressedSegment::Analyze((NumericSegment &)*segments[col_idx], *stats[col_idx], compressed_size);
+	}
+	if (data_pointer.compression == CompressionType::UNCOMPRESSED) {
+		// get the buffer of the segment and pin it
+		auto handle = manager.buffer_manager.Pin(segments[col_idx]->block_id);
+
+		// the uncompressed segment is written to its own block
+		data_pointer.block_id = manager.block_manager.GetFreeBlockId();
+		data_pointer.offset = 0;
+		manager.block_manager.Write(*handle->node, data_pointer.block_id);
+	} else {
+		WriteCompressedSegment(col_idx, data_pointer, compressed_size);
+	}
 	data_pointers[col_idx].push_back(move(data_pointer));
-	// write the block to disk
-	manager.block_manager.Write(*handle->node, block_id);
 
-	handle.reset();
 	segments[col_idx] = nullptr;
+	// the statistics of the next segment start from scratch
+	stats[col_idx]->Reset();
+}
+
+void TableDataWriter::WriteCompressedSegment(idx_t col_idx, DataPointer &data_pointer, idx_t compressed_size) {
+	D_ASSERT(compressed_size <= Storage::BLOCK_SIZE);
+	auto &compressed_offset = compressed_offsets[col_idx];
+	// keep the segments within the block aligned
+	compressed_offset = (compressed_offset + 7) & ~((idx_t)7);
+	if (!compressed_handles[col_idx] || compressed_offset + compressed_size > Storage::BLOCK_SIZE) {
+		// the segment does not fit in the current block: write it and start a new block
+		FlushCompressedBlock(col_idx);
+		compressed_handles[col_idx] = manager.buffer_manager.Allocate(Storage::BLOCK_ALLOC_SIZE);
+		compressed_offset = 0;
+	}
+	CompressedSegment::Compress((NumericSegment &)*segments[col_idx], data_pointer.compression,
+	                            compressed_handles[col_idx]->node->buffer + compressed_offset);
+	data_pointer.block_id = INVALID_BLOCK;
+	data_pointer.offset = compressed_offset;
+	compressed_pointers[col_idx].push_back(data_pointers[col_idx].size());
+	compressed_offset += compressed_size;
+}
+
+void TableDataWriter::FlushCompressedBlock(idx_t col_idx) {
+	if (!compressed_handles[col_idx]) {
+		return;
+	}
+	auto block_id = manager.block_manager.GetFreeBlockId();
+	for (auto &pointer_idx : compressed_pointers[col_idx]) {
+		data_pointers[col_idx][pointer_idx].block_id = block_id;
+	}
+	manager.block_manager.Write(*compressed_handles[col_idx]->node, block_id);
+	compressed_handles[col_idx].reset();
+	compressed_pointers[col_idx].clear();
+}
+
+void TableDataWriter::PackCompressedBlocks(CompressedBlockPacker &packer) {
+	for (idx_t col_idx = 0; col_idx < compressed_handles.size(); col_idx++) {
+		if (!compressed_handles[col_idx]) {
+			continue;
+		}
+		// move the used part of the block to the shared block, the segments keep their offset relative to each other
+		block_id_t block_id;
+		idx_t offset;
+		packer.Append(compressed_handles[col_idx]->node->buffer, compressed_offsets[col_idx], block_id, offset);
+		for (auto &pointer_idx : compressed_pointers[col_idx]) {
+			auto &data_pointer = data_pointers[col_idx][pointer_idx];
+			data_pointer.block_id = block_id;
+			data_pointer.offset += offset;
+		}
+		compressed_handles[col_idx].reset();
+		compressed_pointers[col_idx].clear();
+	}
 }
 
 void TableDataWriter::VerifyDataPointers() {
@@ -178,6 +275,7 @@ void TableDataWriter::VerifyDataPointers() {
 }
 
 void TableDataWriter::WriteDataPointers() {
+	VerifyDataPointers();
 	for (idx_t i = 0; i < data_pointers.size(); i++) {
 		// get a reference to the data column
 		auto &data_pointer_list = data_pointers[i];
@@ -191,10 +289,57 @@ void TableDataWriter::WriteDataPointers() {
 			manager.tabledata_writer->Write<idx_t>(data_pointer.tuple_count);
 			manager.tabledata_writer->Write<block_id_t>(data_pointer.block_id);
 			manager.tabledata_writer->Write<uint32_t>(data_pointer.offset);
+			manager.tabledata_writer->Write<uint8_t>((uint8_t)data_pointer.compression);
 			manager.tabledata_writer->WriteData(data_pointer.min_stats, 16);
 			manager.tabledata_writer->WriteData(data_pointer.max_stats, 16);
 		}
 	}
+	// finally write the ranges of rows that are deleted
+	manager.tabledata_writer->Write<idx_t>(deleted_rows.size());
+	for (auto &range : deleted_rows) {
+		manager.tabledata_writer->Write<idx_t>(range.first);
+		manager.tabledata_writer->Write<idx_t>(range.second);
+	}
+}
+
+idx_t TableDataWriter::GetRowCount() {
+	idx_t row_count = 0;
+	for (auto &data_pointer : data_pointers[0]) {
+		row_count += data_pointer.tuple_count;
+	}
+	for (auto &range : deleted_rows) {
+		row_count -= range.second;
+	}
+	return row_count;
+}
+
+CompressedBlockPacker::CompressedBlockPacker(CheckpointManager &manager)
+    : manager(manager), block_id(INVALID_BLOCK), offset(0) {
+}
+
+void CompressedBlockPacker::Append(data_ptr_t data, idx_t size, block_id_t &result_block, idx_t &result_offset) {
+	D_ASSERT(size <= Storage::BLOCK_SIZE);
+	// keep the segments within the block aligned
+	offset = (offset + 7) & ~((idx_t)7);
+	if (!handle || offset + size > Storage::BLOCK_SIZE) {
+		// the data does not fit in the current block: write it and start a new block
+		Flush();
+		handle = manager.buffer_manager.Allocate(Storage::BLOCK_ALLOC_SIZE);
+		block_id = manager.block_manager.GetFreeBlockId();
+		offset = 0;
+	}
+	memcpy(handle->node->buffer + offset, data, size);
+	result_block = block_id;
+	result_offset = offset;
+	offset += size;
+}
+
+void CompressedBlockPacker::Flush() {
+	if (!handle) {
+		return;
+	}
+	manager.block_manager.Write(*handle->node, block_id);
+	handle.reset();
 }
 
 WriteOverflowStringsToDisk::WriteOverflowStringsToDisk(CheckpointManager &manager)
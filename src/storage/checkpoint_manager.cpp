@@ -7,6 +7,7 @@
 #include "duckdb/common/types/null_value.hpp"
 
 #include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/index_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/sequence_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
@@ -15,35 +16,54 @@
 #include "duckdb/parser/parsed_data/create_schema_info.hpp"
 #include "duckdb/parser/parsed_data/create_table_info.hpp"
 #include "duckdb/parser/parsed_data/create_view_info.hpp"
+#include "duckdb/parser/parser.hpp"
 
 #include "duckdb/planner/binder.hpp"
+#include "duckdb/planner/constraints/bound_unique_constraint.hpp"
+#include "duckdb/planner/operator/logical_create_index.hpp"
 #include "duckdb/planner/parsed_data/bound_create_table_info.hpp"
 
 #include "duckdb/main/client_context.hpp"
-#include "duckdb/main/connection.hpp"
 #include "duckdb/main/database.hpp"
 
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "duckdb/transaction/transaction.hpp"
 #include "duckdb/transaction/transaction_manager.hpp"
 
 #include "duckdb/storage/checkpoint/table_data_writer.hpp"
-#include "duckdb/storage/checkpoint/table_data_reader.hpp"
+#include "duckdb/execution/index/art/art.hpp"
 
 namespace duckdb {
 using namespace std;
 
 // constexpr uint64_t CheckpointManager::DATA_BLOCK_HEADER_SIZE;
 
-CheckpointManager::CheckpointManager(StorageManager &manager)
-    : block_manager(*manager.block_manager), buffer_manager(*manager.buffer_manager), database(manager.database) {
+CheckpointManager::CheckpointManager(StorageManager &manager, bool keep_row_ids)
+    : block_manager(*manager.block_manager), buffer_manager(*manager.buffer_manager), database(manager.database),
+      keep_row_ids(keep_row_ids) {
+}
+
+CheckpointManager::~CheckpointManager() {
 }
 
 void CheckpointManager::CreateCheckpoint() {
 	// assert that the checkpoint manager hasn't been used before
 	D_ASSERT(!metadata_writer);
 
-	Connection con(database);
-	con.BeginTransaction();
+	// scan the database using a regular transaction: the checkpoint sees a consistent snapshot of the database, and
+	// can run while other connections are using the database
+	ClientContext context(database);
+	context.transaction.BeginTransaction();
+	try {
+		WriteCheckpoint(context);
+	} catch (...) {
+		context.transaction.Rollback();
+		throw;
+	}
+	context.transaction.Rollback();
+}
 
+void CheckpointManager::WriteCheckpoint(ClientContext &context) {
 	block_manager.StartCheckpoint();
 
 	//! Set up the writers for the checkpoints
@@ -55,13 +75,15 @@ void CheckpointManager::CreateCheckpoint() {
 
 	vector<SchemaCatalogEntry *> schemas;
 	// we scan the schemas
-	database.catalog->schemas->Scan(*con.context,
+	database.catalog->schemas->Scan(context,
 	                                [&](CatalogEntry *entry) { schemas.push_back((SchemaCatalogEntry *)entry); });
-	// write the actual data into the database
+	// write the data of the tables first
+	WriteTableData(context, schemas);
+	// now write the meta data in order
 	// write the amount of schemas
 	metadata_writer->Write<uint32_t>(schemas.size());
 	for (auto &schema : schemas) {
-		WriteSchema(*con.context, *schema);
+		WriteSchema(context, *schema);
 	}
 	// flush the meta data to disk
 	metadata_writer->Flush();
@@ -73,6 +95,155 @@ void CheckpointManager::CreateCheckpoint() {
 	block_manager.WriteHeader(header);
 }
 
+class WriteColumnDataTask : public Task {
+public:
+	WriteColumnDataTask(TableDataWriter &writer, Transaction &transaction, idx_t col_idx)
+	    : writer(writer), transaction(transaction), col_idx(col_idx) {
+	}
+
+	void Execute() override {
+		writer.WriteColumnData(transaction, col_idx);
+	}
+
+private:
+	TableDataWriter &writer;
+	Transaction &transaction;
+	idx_t col_idx;
+};
+
+//! Builds the indexes of a table from the rows of the table that are written to the checkpoint. Unless the row ids
+//! are kept, deleted rows are not written, which changes the row ids of the rows that follow them, so the indexes of
+//! the table cannot be written as they are.
+class BuildIndexesTask : public Task {
+public:
+	BuildIndexesTask(TableCatalogEntry &table, Transaction &transaction, TaskScheduler &scheduler,
+	                 vector<ART *> indexes, bool keep_row_ids)
+	    : table(table), transaction(transaction), scheduler(scheduler), indexes(move(indexes)),
+	      keep_row_ids(keep_row_ids) {
+	}
+
+	void Execute() override {
+		// scan the columns that are used by any of the indexes
+		vector<column_t> column_ids;
+		for (auto &index : indexes) {
+			for (auto &column_id : index->column_ids) {
+				if (std::find(column_ids.begin(), column_ids.end(), column_id) == column_ids.end()) {
+					column_ids.push_back(column_id);
+				}
+			}
+		}
+		auto table_types = table.GetTypes();
+		vector<LogicalType> scan_types;
+		for (auto &column_id : column_ids) {
+			scan_types.push_back(table_types[column_id]);
+		}
+		idx_t index_column_count = column_ids.size();
+		if (keep_row_ids) {
+			// the rows keep their row ids in the checkpoint
+			column_ids.push_back(COLUMN_IDENTIFIER_ROW_ID);
+			scan_types.push_back(LOGICAL_ROW_TYPE);
+		}
+		DataChunk scan_chunk;
+		scan_chunk.Initialize(scan_types);
+		// the index expressions refer to the columns by their position in the table
+		DataChunk table_chunk;
+		table_chunk.InitializeEmpty(table_types);
+
+		vector<unique_ptr<IndexBulkLoadState>> bulk_loads;
+		for (auto &index : indexes) {
+			bulk_loads.push_back(index->InitializeBulkLoad());
+		}
+		TableScanState state;
+		table.storage->InitializeScan(transaction, state, column_ids);
+		row_t current_row = 0;
+		while (true) {
+			scan_chunk.Reset();
+			unordered_map<idx_t, vector<TableFilter>> mock;
+			table.storage->Scan(transaction, scan_chunk, state, column_ids, mock);
+			if (scan_chunk.size() == 0) {
+				break;
+			}
+			for (idx_t i = 0; i < index_column_count; i++) {
+				table_chunk.data[column_ids[i]].Reference(scan_chunk.data[i]);
+			}
+			table_chunk.SetCardinality(scan_chunk);
+			Vector row_identifiers(LOGICAL_ROW_TYPE);
+			if (keep_row_ids) {
+				row_identifiers.Reference(scan_chunk.data[index_column_count]);
+			} else {
+				VectorOperations::GenerateSequence(row_identifiers, scan_chunk.size(), current_row, 1);
+			}
+			for (idx_t i = 0; i < indexes.size(); i++) {
+				indexes[i]->BulkLoadAppendData(*bulk_loads[i], table_chunk, row_identifiers);
+			}
+			current_row += scan_chunk.size();
+		}
+		for (idx_t i = 0; i < indexes.size(); i++) {
+			IndexLock lock;
+			indexes[i]->InitializeLock(lock);
+			if (!indexes[i]->BulkLoadFinalize(lock, *bulk_loads[i], scheduler)) {
+				throw ConstraintException("Checkpoint of table \"%s\" contains duplicate data in a unique index",
+				                          table.name);
+			}
+		}
+	}
+
+private:
+	TableCatalogEntry &table;
+	Transaction &transaction;
+	TaskScheduler &scheduler;
+	vector<ART *> indexes;
+	bool keep_row_ids;
+};
+
+void CheckpointManager::WriteTableData(ClientContext &context, vector<SchemaCatalogEntry *> &schemas) {
+	auto &transaction = Transaction::GetTransaction(context);
+	auto &scheduler = *database.scheduler;
+	// every column of every table is written by a separate task, and the indexes of every table are built by a
+	// separate task
+	vector<unique_ptr<Task>> tasks;
+	vector<TableDataWriter *> writers;
+	for (auto &schema : schemas) {
+		schema->tables.Scan(context, [&](CatalogEntry *entry) {
+			if (entry->type != CatalogType::TABLE_ENTRY) {
+				return;
+			}
+			auto &table = (TableCatalogEntry &)*entry;
+			auto writer = make_unique<TableDataWriter>(*this, table);
+			for (idx_t col_idx = 0; col_idx < table.columns.size(); col_idx++) {
+				tasks.push_back(make_unique<WriteColumnDataTask>(*writer, transaction, col_idx));
+			}
+			writers.push_back(writer.get());
+			table_writers[&table] = move(writer);
+
+			vector<ART *> indexes;
+			for (auto &index : table.storage->info->indexes) {
+				D_ASSERT(index->type == IndexType::ART);
+				auto &art = (ART &)*index;
+				vector<unique_ptr<Expression>> unbound_expressions;
+				for (auto &expr : art.unbound_expressions) {
+					unbound_expressions.push_back(expr->Copy());
+				}
+				auto checkpoint_index = make_unique<ART>(art.column_ids, move(unbound_expressions), art.is_unique);
+				indexes.push_back(checkpoint_index.get());
+				checkpoint_indexes[index.get()] = move(checkpoint_index);
+			}
+			if (!indexes.empty()) {
+				tasks.push_back(make_unique<BuildIndexesTask>(table, transaction, scheduler, move(indexes), keep_row_ids));
+			}
+		});
+	}
+	auto producer = scheduler.CreateProducer();
+	scheduler.ExecuteTasks(*producer, move(tasks));
+
+	// every column was compressed into blocks of its own: pack the last blocks of the columns together
+	CompressedBlockPacker packer(*this);
+	for (auto &writer : writers) {
+		writer->PackCompressedBlocks(packer);
+	}
+	packer.Flush();
+}
+
 void CheckpointManager::LoadFromStorage() {
 	block_id_t meta_block = block_manager.GetMetaBlock();
 	if (meta_block < 0) {
@@ -122,11 +293,23 @@ void CheckpointManager::WriteSchema(ClientContext &context, SchemaCatalogEntry &
 	for (auto &table : tables) {
 		WriteTable(context, *table);
 	}
-	// finally write the views
+	// write the views
 	metadata_writer->Write<uint32_t>(views.size());
 	for (auto &view : views) {
 		WriteView(*view);
 	}
+	// finally write the indexes that were created with CREATE INDEX
+	vector<IndexCatalogEntry *> indexes;
+	schema.indexes.Scan(context, [&](CatalogEntry *entry) {
+		auto &index = (IndexCatalogEntry &)*entry;
+		if (index.index && checkpoint_indexes.find(index.index) != checkpoint_indexes.end()) {
+			indexes.push_back(&index);
+		}
+	});
+	metadata_writer->Write<uint32_t>(indexes.size());
+	for (auto &index : indexes) {
+		WriteIndex(*index);
+	}
 }
 
 void CheckpointManager::ReadSchema(ClientContext &context, MetaBlockReader &reader) {
@@ -146,11 +329,16 @@ void CheckpointManager::ReadSchema(ClientContext &context, MetaBlockReader &read
 	for (uint32_t i = 0; i < table_count; i++) {
 		ReadTable(context, reader);
 	}
-	// finally read the views
+	// read the views
 	uint32_t view_count = reader.Read<uint32_t>();
 	for (uint32_t i = 0; i < view_count; i++) {
 		ReadView(context, reader);
 	}
+	// finally read the indexes
+	uint32_t index_count = reader.Read<uint32_t>();
+	for (uint32_t i = 0; i < index_count; i++) {
+		ReadIndex(context, reader);
+	}
 }
 
 //===--------------------------------------------------------------------===//
@@ -166,6 +354,52 @@ void CheckpointManager::ReadView(ClientContext &context, MetaBlockReader &reader
 	database.catalog->CreateView(context, info.get());
 }
 
+//===--------------------------------------------------------------------===//
+// Indexes
+//===--------------------------------------------------------------------===//
+void CheckpointManager::WriteIndex(IndexCatalogEntry &index) {
+	// the index is recreated from the CREATE INDEX statement, its data is read from disk
+	metadata_writer->WriteString(index.sql);
+	WriteIndexData(*index.index);
+}
+
+void CheckpointManager::WriteIndexData(Index &index) {
+	auto entry = checkpoint_indexes.find(&index);
+	D_ASSERT(entry != checkpoint_indexes.end());
+	auto root = entry->second->Serialize(*tabledata_writer);
+	metadata_writer->Write<block_id_t>(root.block_id);
+	metadata_writer->Write<uint64_t>(root.offset);
+}
+
+void CheckpointManager::ReadIndex(ClientContext &context, MetaBlockReader &reader) {
+	auto sql = reader.Read<string>();
+	auto block_id = reader.Read<block_id_t>();
+	auto offset = reader.Read<uint64_t>();
+
+	// bind the CREATE INDEX statement to find the table and the expressions of the index
+	Parser parser;
+	parser.ParseQuery(sql);
+	if (parser.statements.size() != 1 || parser.statements[0]->type != StatementType::CREATE_STATEMENT) {
+		throw Exception("Expected a CREATE INDEX statement for an index in the database file");
+	}
+	Binder binder(context);
+	auto bound_statement = binder.Bind(*parser.statements[0]);
+	if (bound_statement.plan->type != LogicalOperatorType::CREATE_INDEX) {
+		throw Exception("Expected a CREATE INDEX statement for an index in the database file");
+	}
+	auto &create_index = (LogicalCreateIndex &)*bound_statement.plan;
+	auto &table = create_index.table;
+	auto index_entry = (IndexCatalogEntry *)table.schema->CreateIndex(context, create_index.info.get(), &table);
+
+	// instead of building the index from the table data, read it from disk
+	auto art = make_unique<ART>(create_index.column_ids, move(create_index.unbound_expressions),
+	                            create_index.info->unique);
+	art->Deserialize(buffer_manager, BlockPointer(block_id, offset));
+	index_entry->index = art.get();
+	index_entry->info = table.storage->info;
+	table.storage->info->indexes.push_back(move(art));
+}
+
 //===--------------------------------------------------------------------===//
 // Sequences
 //===--------------------------------------------------------------------===//
@@ -189,9 +423,24 @@ void CheckpointManager::WriteTable(ClientContext &context, TableCatalogEntry &ta
 	metadata_writer->Write<block_id_t>(tabledata_writer->block->id);
 	//! and the offset to where the info starts
 	metadata_writer->Write<uint64_t>(tabledata_writer->offset);
-	// now we need to write the table data
-	TableDataWriter writer(*this, table);
-	writer.WriteTableData(context);
+	// now we need to write the data pointers of the table, the data itself has already been written
+	auto writer = table_writers.find(&table);
+	D_ASSERT(writer != table_writers.end());
+	writer->second->WriteDataPointers();
+	// the row count is stored with the meta data: it is known before the data of the table is read
+	metadata_writer->Write<uint64_t>(writer->second->GetRowCount());
+	// finally write the indexes of the UNIQUE and PRIMARY KEY constraints, these are the first indexes of the table
+	idx_t unique_count = 0;
+	for (auto &constraint : table.bound_constraints) {
+		if (constraint->type == ConstraintType::UNIQUE) {
+			unique_count++;
+		}
+	}
+	D_ASSERT(unique_count <= table.storage->info->indexes.size());
+	metadata_writer->Write<uint32_t>(unique_count);
+	for (idx_t i = 0; i < unique_count; i++) {
+		WriteIndexData(*table.storage->info->indexes[i]);
+	}
 }
 
 void CheckpointManager::ReadTable(ClientContext &context, MetaBlockReader &reader) {
@@ -201,13 +450,19 @@ void CheckpointManager::ReadTable(ClientContext &context, MetaBlockReader &reade
 	Binder binder(context);
 	auto bound_info = binder.BindCreateTableInfo(move(info));
 
-	// now read the actual table data and place it into the create table info
+	// now read the location of the table data and place it into the create table info
+	// the table data itself is only read when the table is first used
 	auto block_id = reader.Read<block_id_t>();
 	auto offset = reader.Read<uint64_t>();
-	MetaBlockReader table_data_reader(buffer_manager, block_id);
-	table_data_reader.offset = offset;
-	TableDataReader data_reader(*this, table_data_reader, *bound_info);
-	data_reader.ReadTableData();
+	bound_info->data = make_unique<BlockPointer>(block_id, offset);
+	bound_info->row_count = reader.Read<uint64_t>();
+	// the indexes of the table are read from disk as well
+	auto index_count = reader.Read<uint32_t>();
+	for (idx_t i = 0; i < index_count; i++) {
+		auto index_block_id = reader.Read<block_id_t>();
+		auto index_offset = reader.Read<uint64_t>();
+		bound_info->indexes.push_back(BlockPointer(index_block_id, index_offset));
+	}
 
 	// finally create the table in the catalog
 	database.catalog->CreateTable(context, bound_info.get());
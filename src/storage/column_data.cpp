@@ -22,6 +22,7 @@ void ColumnData::InitializeScan(ColumnScanState &state) {
 	state.current = (ColumnSegment *)data.GetRootSegment();
 	state.vector_index = 0;
 	state.initialized = false;
+	state.segment_checked = false;
 }
 
 void ColumnData::InitializeScanWithOffset(ColumnScanState &state, idx_t vector_idx) {
@@ -29,12 +30,31 @@ void ColumnData::InitializeScanWithOffset(ColumnScanState &state, idx_t vector_i
 	state.current = (ColumnSegment *)data.GetSegment(row_idx);
 	state.vector_index = (row_idx - state.current->start) / STANDARD_VECTOR_SIZE;
 	state.initialized = false;
+	state.segment_checked = false;
+}
+
+void ColumnData::InitializeSegmentScan(ColumnScanState &state) {
+	state.current->InitializeScan(state);
+	state.initialized = true;
+	// read ahead the blocks of the next persistent segments, so their I/O overlaps with the scan of this segment
+	block_id_t previous_block = INVALID_BLOCK;
+	auto segment = (ColumnSegment *)state.current->next.get();
+	for (idx_t i = 0; segment && i < READ_AHEAD_SEGMENTS; i++) {
+		if (segment->segment_type == ColumnSegmentType::PERSISTENT) {
+			auto &persistent = (PersistentSegment &)*segment;
+			// segments that have been updated no longer refer to their on-disk block
+			if (persistent.data->block_id == persistent.block_id && persistent.block_id != previous_block) {
+				manager.Prefetch(persistent.block_id);
+				previous_block = persistent.block_id;
+			}
+		}
+		segment = (ColumnSegment *)segment->next.get();
+	}
 }
 
 void ColumnData::Scan(Transaction &transaction, ColumnScanState &state, Vector &result) {
 	if (!state.initialized) {
-		state.current->InitializeScan(state);
-		state.initialized = true;
+		InitializeSegmentScan(state);
 	}
 	// perform a scan of this segment
 	state.current->Scan(transaction, state, state.vector_index, result);
@@ -45,8 +65,7 @@ void ColumnData::Scan(Transaction &transaction, ColumnScanState &state, Vector &
 void ColumnData::FilterScan(Transaction &transaction, ColumnScanState &state, Vector &result, SelectionVector &sel,
                             idx_t &approved_tuple_count) {
 	if (!state.initialized) {
-		state.current->InitializeScan(state);
-		state.initialized = true;
+		InitializeSegmentScan(state);
 	}
 	// perform a scan of this segment
 	state.current->FilterScan(transaction, state, result, sel, approved_tuple_count);
@@ -57,8 +76,7 @@ void ColumnData::FilterScan(Transaction &transaction, ColumnScanState &state, Ve
 void ColumnData::Select(Transaction &transaction, ColumnScanState &state, Vector &result, SelectionVector &sel,
                         idx_t &approved_tuple_count, vector<TableFilter> &tableFilter) {
 	if (!state.initialized) {
-		state.current->InitializeScan(state);
-		state.initialized = true;
+		InitializeSegmentScan(state);
 	}
 	// perform a scan of this segment
 	state.current->Select(transaction, state, result, sel, approved_tuple_count, tableFilter);
@@ -68,8 +86,7 @@ void ColumnData::Select(Transaction &transaction, ColumnScanState &state, Vector
 
 void ColumnData::IndexScan(ColumnScanState &state, Vector &result) {
 	if (!state.initialized) {
-		state.current->InitializeScan(state);
-		state.initialized = true;
+		InitializeSegmentScan(state);
 	}
 	// perform a scan of this segment
 	state.current->IndexScan(state, result);
@@ -191,6 +208,18 @@ void ColumnData::FetchRow(ColumnFetchState &state, Transaction &transaction, row
 	segment->FetchRow(state, transaction, row_id, result, result_idx);
 }
 
+void ColumnData::FetchRows(ColumnFetchState &state, Transaction &transaction, row_t row_ids[], idx_t count,
+                           Vector &result) {
+	ColumnSegment *segment = nullptr;
+	for (idx_t i = 0; i < count; i++) {
+		idx_t row_id = row_ids[i];
+		if (!segment || row_id < segment->start || row_id >= segment->start + segment->count) {
+			segment = (ColumnSegment *)data.GetSegment(row_id);
+		}
+		segment->FetchRow(state, transaction, row_id, result, i);
+	}
+}
+
 void ColumnData::AppendTransientSegment(idx_t start_row) {
 	auto new_segment = make_unique<TransientSegment>(manager, type.InternalType(), start_row);
 	data.AppendSegment(move(new_segment));
@@ -0,0 +1,627 @@
+#include "duckdb/storage/compressed_segment.hpp"
+
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/table/append_state.hpp"
+#include "duckdb/transaction/update_info.hpp"
+
+#include <cstring>
+
+namespace duckdb {
+using namespace std;
+
+//===--------------------------------------------------------------------===//
+// Compressed Layout
+//===--------------------------------------------------------------------===//
+// CONSTANT:   [is_null (uint8)][value]
+// RLE:        [vector offsets (uint32[vector_count])][vectors]
+//             vector: [has_null (uint8)][nullmask (if has_null)][run count (uint16)][values][run lengths (uint16[])]
+// BITPACKING: [vector offsets (uint32[vector_count])][vectors]
+//             vector: [has_null (uint8)][nullmask (if has_null)][reference][bit width (uint8)][bit-packed offsets]
+// The values of NULL rows are not stored: they are encoded as the value of the previous run (RLE) or as the
+// reference value (BITPACKING).
+
+template <class T> struct BitpackingType {};
+template <> struct BitpackingType<int8_t> { typedef uint8_t type; };
+template <> struct BitpackingType<int16_t> { typedef uint16_t type; };
+template <> struct BitpackingType<int32_t> { typedef uint32_t type; };
+template <> struct BitpackingType<int64_t> { typedef uint64_t type; };
+
+static void BitpackWrite(data_ptr_t target, idx_t bit_pos, uint64_t value, uint8_t bit_width) {
+	while (bit_width > 0) {
+		idx_t shift = bit_pos % 8;
+		idx_t bits = MinValue<idx_t>(8 - shift, bit_width);
+		target[bit_pos / 8] |= (data_t)((value & ((1ULL << bits) - 1)) << shift);
+		value >>= bits;
+		bit_pos += bits;
+		bit_width -= bits;
+	}
+}
+
+static uint64_t BitpackRead(data_ptr_t source, idx_t bit_pos, uint8_t bit_width) {
+	uint64_t result = 0;
+	idx_t result_shift = 0;
+	while (bit_width > 0) {
+		idx_t shift = bit_pos % 8;
+		idx_t bits = MinValue<idx_t>(8 - shift, bit_width);
+		uint64_t byte = (source[bit_pos / 8] >> shift) & ((1ULL << bits) - 1);
+		result |= byte << result_shift;
+		result_shift += bits;
+		bit_pos += bits;
+		bit_width -= bits;
+	}
+	return result;
+}
+
+//! Frame of reference + bit-packing of integer vectors
+template <class T> struct Bitpacking {
+	typedef typename BitpackingType<T>::type U;
+	static constexpr bool SUPPORTED = true;
+
+	//! Computes the reference value (minimum) and the bit width of the offsets from the reference of the vector
+	static uint8_t Analyze(data_ptr_t vector_ptr, idx_t count, T &reference) {
+		auto &nullmask = *((nullmask_t *)vector_ptr);
+		auto data = (T *)(vector_ptr + sizeof(nullmask_t));
+		bool has_value = false;
+		T min = 0, max = 0;
+		for (idx_t i = 0; i < count; i++) {
+			if (nullmask[i]) {
+				continue;
+			}
+			if (!has_value || data[i] < min) {
+				min = data[i];
+			}
+			if (!has_value || data[i] > max) {
+				max = data[i];
+			}
+			has_value = true;
+		}
+		reference = min;
+		uint8_t bit_width = 0;
+		for (uint64_t range = (U)max - (U)min; range > 0; range >>= 1) {
+			bit_width++;
+		}
+		return bit_width;
+	}
+	static idx_t CompressedSize(data_ptr_t vector_ptr, idx_t count) {
+		T reference;
+		auto bit_width = Analyze(vector_ptr, count, reference);
+		return sizeof(T) + sizeof(uint8_t) + (count * bit_width + 7) / 8;
+	}
+	static idx_t Compress(data_ptr_t vector_ptr, idx_t count, data_ptr_t target) {
+		auto &nullmask = *((nullmask_t *)vector_ptr);
+		auto data = (T *)(vector_ptr + sizeof(nullmask_t));
+		T reference;
+		auto bit_width = Analyze(vector_ptr, count, reference);
+		Store<T>(reference, target);
+		Store<uint8_t>(bit_width, target + sizeof(T));
+		auto packed = target + sizeof(T) + sizeof(uint8_t);
+		idx_t packed_size = (count * bit_width + 7) / 8;
+		memset(packed, 0, packed_size);
+		if (bit_width > 0) {
+			for (idx_t i = 0; i < count; i++) {
+				if (!nullmask[i]) {
+					BitpackWrite(packed, i * bit_width, (U)data[i] - (U)reference, bit_width);
+				}
+			}
+		}
+		return sizeof(T) + sizeof(uint8_t) + packed_size;
+	}
+	static void Decompress(data_ptr_t source, idx_t count, T *result) {
+		auto reference = Load<T>(source);
+		auto bit_width = Load<uint8_t>(source + sizeof(T));
+		auto packed = source + sizeof(T) + sizeof(uint8_t);
+		if (bit_width == 0) {
+			for (idx_t i = 0; i < count; i++) {
+				result[i] = reference;
+			}
+			return;
+		}
+		for (idx_t i = 0; i < count; i++) {
+			result[i] = (T)((U)reference + (U)BitpackRead(packed, i * bit_width, bit_width));
+		}
+	}
+	static T Fetch(data_ptr_t source, idx_t row_idx) {
+		auto reference = Load<T>(source);
+		auto bit_width = Load<uint8_t>(source + sizeof(T));
+		auto packed = source + sizeof(T) + sizeof(uint8_t);
+		return (T)((U)reference + (U)BitpackRead(packed, row_idx * bit_width, bit_width));
+	}
+};
+
+//! Placeholder for the types that do not support bit-packing (hugeint and floating point numbers)
+template <class T> struct NoBitpacking {
+	static constexpr bool SUPPORTED = false;
+
+	static idx_t CompressedSize(data_ptr_t vector_ptr, idx_t count) {
+		throw InternalException("Bitpacking is not supported for this type");
+	}
+	static idx_t Compress(data_ptr_t vector_ptr, idx_t count, data_ptr_t target) {
+		throw InternalException("Bitpacking is not supported for this type");
+	}
+	static void Decompress(data_ptr_t source, idx_t count, T *result) {
+		throw InternalException("Bitpacking is not supported for this type");
+	}
+	static T Fetch(data_ptr_t source, idx_t row_idx) {
+		throw InternalException("Bitpacking is not supported for this type");
+	}
+};
+
+//! Computes the runs of the vector. NULL values extend the current run; a NULL value at the start of the vector
+//! starts a run with a zero value. Values are compared on their binary representation, so that e.g. -0.0 and 0.0
+//! are not merged into the same run.
+template <class T>
+static idx_t ComputeRuns(data_ptr_t vector_ptr, idx_t count, T values[], uint16_t lengths[]) {
+	auto &nullmask = *((nullmask_t *)vector_ptr);
+	auto data = (T *)(vector_ptr + sizeof(nullmask_t));
+	idx_t run_count = 0;
+	for (idx_t i = 0; i < count; i++) {
+		bool is_null = nullmask[i];
+		if (run_count > 0 && (is_null || memcmp(&values[run_count - 1], &data[i], sizeof(T)) == 0)) {
+			lengths[run_count - 1]++;
+			continue;
+		}
+		if (is_null) {
+			memset(&values[run_count], 0, sizeof(T));
+		} else {
+			values[run_count] = data[i];
+		}
+		lengths[run_count] = 1;
+		run_count++;
+	}
+	return run_count;
+}
+
+template <class T> static idx_t CompressRLE(data_ptr_t vector_ptr, idx_t count, data_ptr_t target) {
+	T values[STANDARD_VECTOR_SIZE];
+	uint16_t lengths[STANDARD_VECTOR_SIZE];
+	idx_t run_count = ComputeRuns<T>(vector_ptr, count, values, lengths);
+	Store<uint16_t>(run_count, target);
+	auto value_ptr = target + sizeof(uint16_t);
+	auto length_ptr = value_ptr + run_count * sizeof(T);
+	memcpy(value_ptr, values, run_count * sizeof(T));
+	memcpy(length_ptr, lengths, run_count * sizeof(uint16_t));
+	return sizeof(uint16_t) + run_count * (sizeof(T) + sizeof(uint16_t));
+}
+
+//===--------------------------------------------------------------------===//
+// Analyze
+//===--------------------------------------------------------------------===//
+template <class T, class BITPACKING>
+static CompressionType TemplatedAnalyze(NumericSegment &segment, SegmentStatistics &stats, idx_t &compressed_size) {
+	auto handle = segment.manager.Pin(segment.block_id);
+	auto data = handle->node->buffer;
+	idx_t vector_count = (segment.tuple_count + STANDARD_VECTOR_SIZE - 1) / STANDARD_VECTOR_SIZE;
+	bool all_null = true;
+	idx_t rle_size = vector_count * sizeof(uint32_t);
+	idx_t bitpacking_size = vector_count * sizeof(uint32_t);
+	T values[STANDARD_VECTOR_SIZE];
+	uint16_t lengths[STANDARD_VECTOR_SIZE];
+	for (idx_t vector_index = 0; vector_index < vector_count; vector_index++) {
+		auto vector_ptr = data + vector_index * segment.vector_size;
+		auto count = segment.GetVectorCount(vector_index);
+		auto &nullmask = *((nullmask_t *)vector_ptr);
+		bool has_null = nullmask.any();
+		if (nullmask.count() != count) {
+			all_null = false;
+		}
+		idx_t header_size = sizeof(uint8_t) + (has_null ? sizeof(nullmask_t) : 0);
+		idx_t run_count = ComputeRuns<T>(vector_ptr, count, values, lengths);
+		rle_size += header_size + sizeof(uint16_t) + run_count * (sizeof(T) + sizeof(uint16_t));
+		if (BITPACKING::SUPPORTED) {
+			bitpacking_size += header_size + BITPACKING::CompressedSize(vector_ptr, count);
+		}
+	}
+	if (all_null || (!stats.has_null && memcmp(stats.minimum.get(), stats.maximum.get(), sizeof(T)) == 0)) {
+		// every row has the same value: we only need to store a single value
+		compressed_size = sizeof(uint8_t) + sizeof(T);
+		return CompressionType::CONSTANT;
+	}
+	// only compress if the result is smaller than the raw data of the segment
+	compressed_size = segment.tuple_count * sizeof(T) + vector_count * sizeof(nullmask_t);
+	auto compression = CompressionType::UNCOMPRESSED;
+	if (rle_size < compressed_size) {
+		compressed_size = rle_size;
+		compression = CompressionType::RLE;
+	}
+	if (BITPACKING::SUPPORTED && bitpacking_size < compressed_size) {
+		compressed_size = bitpacking_size;
+		compression = CompressionType::BITPACKING;
+	}
+	return compression;
+}
+
+CompressionType CompressedSegment::Analyze(NumericSegment &segment, SegmentStatistics &stats,
+                                           idx_t &compressed_size) {
+	if (segment.tuple_count == 0) {
+		return CompressionType::UNCOMPRESSED;
+	}
+	switch (segment.type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+		return TemplatedAnalyze<int8_t, Bitpacking<int8_t>>(segment, stats, compressed_size);
+	case PhysicalType::INT16:
+		return TemplatedAnalyze<int16_t, Bitpacking<int16_t>>(segment, stats, compressed_size);
+	case PhysicalType::INT32:
+		return TemplatedAnalyze<int32_t, Bitpacking<int32_t>>(segment, stats, compressed_size);
+	case PhysicalType::INT64:
+		return TemplatedAnalyze<int64_t, Bitpacking<int64_t>>(segment, stats, compressed_size);
+	case PhysicalType::INT128:
+		return TemplatedAnalyze<hugeint_t, NoBitpacking<hugeint_t>>(segment, stats, compressed_size);
+	case PhysicalType::FLOAT:
+		return TemplatedAnalyze<float, NoBitpacking<float>>(segment, stats, compressed_size);
+	case PhysicalType::DOUBLE:
+		return TemplatedAnalyze<double, NoBitpacking<double>>(segment, stats, compressed_size);
+	default:
+		// intervals are not compressed
+		return CompressionType::UNCOMPRESSED;
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Compress
+//===--------------------------------------------------------------------===//
+template <class T, class BITPACKING>
+static void TemplatedCompress(NumericSegment &segment, CompressionType compression, data_ptr_t target) {
+	auto handle = segment.manager.Pin(segment.block_id);
+	auto data = handle->node->buffer;
+	idx_t vector_count = (segment.tuple_count + STANDARD_VECTOR_SIZE - 1) / STANDARD_VECTOR_SIZE;
+	if (compression == CompressionType::CONSTANT) {
+		// find the first non-NULL value
+		for (idx_t vector_index = 0; vector_index < vector_count; vector_index++) {
+			auto vector_ptr = data + vector_index * segment.vector_size;
+			auto &nullmask = *((nullmask_t *)vector_ptr);
+			for (idx_t i = 0; i < segment.GetVectorCount(vector_index); i++) {
+				if (!nullmask[i]) {
+					Store<uint8_t>(false, target);
+					memcpy(target + sizeof(uint8_t), vector_ptr + sizeof(nullmask_t) + i * sizeof(T), sizeof(T));
+					return;
+				}
+			}
+		}
+		// all values are NULL
+		Store<uint8_t>(true, target);
+		memset(target + sizeof(uint8_t), 0, sizeof(T));
+		return;
+	}
+	idx_t offset = vector_count * sizeof(uint32_t);
+	for (idx_t vector_index = 0; vector_index < vector_count; vector_index++) {
+		auto vector_ptr = data + vector_index * segment.vector_size;
+		auto count = segment.GetVectorCount(vector_index);
+		auto &nullmask = *((nullmask_t *)vector_ptr);
+		Store<uint32_t>(offset, target + vector_index * sizeof(uint32_t));
+
+		// write the nullmask, but only if there are any NULL values
+		bool has_null = nullmask.any();
+		Store<uint8_t>(has_null, target + offset);
+		offset += sizeof(uint8_t);
+		if (has_null) {
+			memcpy(target + offset, &nullmask, sizeof(nullmask_t));
+			offset += sizeof(nullmask_t);
+		}
+		if (compression == CompressionType::RLE) {
+			offset += CompressRLE<T>(vector_ptr, count, target + offset);
+		} else {
+			offset += BITPACKING::Compress(vector_ptr, count, target + offset);
+		}
+	}
+}
+
+void CompressedSegment::Compress(NumericSegment &segment, CompressionType compression, data_ptr_t target) {
+	D_ASSERT(compression != CompressionType::UNCOMPRESSED);
+	switch (segment.type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+		TemplatedCompress<int8_t, Bitpacking<int8_t>>(segment, compression, target);
+		break;
+	case PhysicalType::INT16:
+		TemplatedCompress<int16_t, Bitpacking<int16_t>>(segment, compression, target);
+		break;
+	case PhysicalType::INT32:
+		TemplatedCompress<int32_t, Bitpacking<int32_t>>(segment, compression, target);
+		break;
+	case PhysicalType::INT64:
+		TemplatedCompress<int64_t, Bitpacking<int64_t>>(segment, compression, target);
+		break;
+	case PhysicalType::INT128:
+		TemplatedCompress<hugeint_t, NoBitpacking<hugeint_t>>(segment, compression, target);
+		break;
+	case PhysicalType::FLOAT:
+		TemplatedCompress<float, NoBitpacking<float>>(segment, compression, target);
+		break;
+	case PhysicalType::DOUBLE:
+		TemplatedCompress<double, NoBitpacking<double>>(segment, compression, target);
+		break;
+	default:
+		throw InternalException("Unsupported type for compression");
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Decompress
+//===--------------------------------------------------------------------===//
+CompressedSegment::CompressedSegment(BufferManager &manager, PhysicalType type, idx_t row_start, block_id_t block_id,
+                                     idx_t offset, CompressionType compression)
+    : NumericSegment(manager, type, row_start, block_id), offset(offset), compression(compression) {
+	D_ASSERT(block_id < MAXIMUM_BLOCK);
+	D_ASSERT(compression != CompressionType::UNCOMPRESSED);
+}
+
+//! Returns a pointer to the compressed vector, and reads its nullmask
+static data_ptr_t LoadCompressedVector(data_ptr_t base, idx_t vector_index, nullmask_t &nullmask) {
+	auto vector_ptr = base + Load<uint32_t>(base + vector_index * sizeof(uint32_t));
+	bool has_null = Load<uint8_t>(vector_ptr);
+	vector_ptr += sizeof(uint8_t);
+	if (has_null) {
+		memcpy(&nullmask, vector_ptr, sizeof(nullmask_t));
+		vector_ptr += sizeof(nullmask_t);
+	} else {
+		nullmask.reset();
+	}
+	return vector_ptr;
+}
+
+template <class T> static void DecompressRLE(data_ptr_t source, idx_t count, T *result) {
+	auto run_count = Load<uint16_t>(source);
+	auto value_ptr = source + sizeof(uint16_t);
+	auto length_ptr = value_ptr + run_count * sizeof(T);
+	idx_t result_idx = 0;
+	for (idx_t run_idx = 0; run_idx < run_count; run_idx++) {
+		auto value = Load<T>(value_ptr + run_idx * sizeof(T));
+		auto length = Load<uint16_t>(length_ptr + run_idx * sizeof(uint16_t));
+		D_ASSERT(result_idx + length <= count);
+		for (idx_t i = 0; i < length; i++) {
+			result[result_idx++] = value;
+		}
+	}
+	D_ASSERT(result_idx == count);
+}
+
+template <class T> static T FetchRLE(data_ptr_t source, idx_t row_idx) {
+	auto run_count = Load<uint16_t>(source);
+	auto value_ptr = source + sizeof(uint16_t);
+	auto length_ptr = value_ptr + run_count * sizeof(T);
+	idx_t run_end = 0;
+	for (idx_t run_idx = 0; run_idx < run_count; run_idx++) {
+		run_end += Load<uint16_t>(length_ptr + run_idx * sizeof(uint16_t));
+		if (row_idx < run_end) {
+			return Load<T>(value_ptr + run_idx * sizeof(T));
+		}
+	}
+	throw InternalException("Row not found in RLE compressed vector");
+}
+
+//! Decompresses the vector at the specified index into the result data and nullmask
+template <class T, class BITPACKING>
+static void TemplatedDecompress(CompressionType compression, data_ptr_t base, idx_t vector_index, idx_t count,
+                                T *result, nullmask_t &nullmask) {
+	if (compression == CompressionType::CONSTANT) {
+		bool is_null = Load<uint8_t>(base);
+		auto value = Load<T>(base + sizeof(uint8_t));
+		nullmask.reset();
+		for (idx_t i = 0; i < count; i++) {
+			result[i] = value;
+			nullmask[i] = is_null;
+		}
+		return;
+	}
+	auto source = LoadCompressedVector(base, vector_index, nullmask);
+	if (compression == CompressionType::RLE) {
+		DecompressRLE<T>(source, count, result);
+	} else {
+		BITPACKING::Decompress(source, count, result);
+	}
+}
+
+template <class T, class BITPACKING>
+static void TemplatedFetchRow(CompressionType compression, data_ptr_t base, idx_t vector_index, idx_t row_idx,
+                              Vector &result, idx_t result_idx) {
+	auto result_data = FlatVector::GetData<T>(result);
+	if (compression == CompressionType::CONSTANT) {
+		FlatVector::SetNull(result, result_idx, Load<uint8_t>(base));
+		result_data[result_idx] = Load<T>(base + sizeof(uint8_t));
+		return;
+	}
+	nullmask_t nullmask;
+	auto source = LoadCompressedVector(base, vector_index, nullmask);
+	FlatVector::SetNull(result, result_idx, nullmask[row_idx]);
+	if (compression == CompressionType::RLE) {
+		result_data[result_idx] = FetchRLE<T>(source, row_idx);
+	} else {
+		result_data[result_idx] = BITPACKING::Fetch(source, row_idx);
+	}
+}
+
+template <class T, class BITPACKING>
+static void TemplatedFetchBaseData(CompressionType compression, data_ptr_t base, idx_t vector_index, idx_t count,
+                                   Vector &result) {
+	if (compression == CompressionType::CONSTANT) {
+		// the entire segment has the same value: emit a constant vector
+		result.vector_type = VectorType::CONSTANT_VECTOR;
+		ConstantVector::SetNull(result, Load<uint8_t>(base));
+		ConstantVector::GetData<T>(result)[0] = Load<T>(base + sizeof(uint8_t));
+		return;
+	}
+	result.vector_type = VectorType::FLAT_VECTOR;
+	TemplatedDecompress<T, BITPACKING>(compression, base, vector_index, count, FlatVector::GetData<T>(result),
+	                                   FlatVector::Nullmask(result));
+}
+
+void CompressedSegment::DecompressVector(data_ptr_t base, idx_t vector_index, data_ptr_t target) {
+	auto count = GetVectorCount(vector_index);
+	auto &nullmask = *((nullmask_t *)target);
+	auto data = target + sizeof(nullmask_t);
+	switch (type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+		TemplatedDecompress<int8_t, Bitpacking<int8_t>>(compression, base, vector_index, count,
+		                                                       (int8_t *)data, nullmask);
+		break;
+	case PhysicalType::INT16:
+		TemplatedDecompress<int16_t, Bitpacking<int16_t>>(compression, base, vector_index, count,
+		                                                         (int16_t *)data, nullmask);
+		break;
+	case PhysicalType::INT32:
+		TemplatedDecompress<int32_t, Bitpacking<int32_t>>(compression, base, vector_index, count,
+		                                                         (int32_t *)data, nullmask);
+		break;
+	case PhysicalType::INT64:
+		TemplatedDecompress<int64_t, Bitpacking<int64_t>>(compression, base, vector_index, count,
+		                                                         (int64_t *)data, nullmask);
+		break;
+	case PhysicalType::INT128:
+		TemplatedDecompress<hugeint_t, NoBitpacking<hugeint_t>>(compression, base, vector_index, count,
+		                                                               (hugeint_t *)data, nullmask);
+		break;
+	case PhysicalType::FLOAT:
+		TemplatedDecompress<float, NoBitpacking<float>>(compression, base, vector_index, count, (float *)data,
+		                                                       nullmask);
+		break;
+	case PhysicalType::DOUBLE:
+		TemplatedDecompress<double, NoBitpacking<double>>(compression, base, vector_index, count,
+		                                                         (double *)data, nullmask);
+		break;
+	default:
+		throw InternalException("Unsupported type for compressed segment");
+	}
+}
+
+void CompressedSegment::FetchBaseData(ColumnScanState &state, idx_t vector_index, Vector &result) {
+	if (!IsCompressed()) {
+		NumericSegment::FetchBaseData(state, vector_index, result);
+		return;
+	}
+	D_ASSERT(vector_index < max_vector_count);
+	D_ASSERT(vector_index * STANDARD_VECTOR_SIZE <= tuple_count);
+
+	auto handle = manager.Pin(block_id, false, PinHint::USE_ONCE);
+	auto base = handle->node->buffer + offset;
+	auto count = GetVectorCount(vector_index);
+	switch (type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+		TemplatedFetchBaseData<int8_t, Bitpacking<int8_t>>(compression, base, vector_index, count, result);
+		break;
+	case PhysicalType::INT16:
+		TemplatedFetchBaseData<int16_t, Bitpacking<int16_t>>(compression, base, vector_index, count, result);
+		break;
+	case PhysicalType::INT32:
+		TemplatedFetchBaseData<int32_t, Bitpacking<int32_t>>(compression, base, vector_index, count, result);
+		break;
+	case PhysicalType::INT64:
+		TemplatedFetchBaseData<int64_t, Bitpacking<int64_t>>(compression, base, vector_index, count, result);
+		break;
+	case PhysicalType::INT128:
+		TemplatedFetchBaseData<hugeint_t, NoBitpacking<hugeint_t>>(compression, base, vector_index, count,
+		                                                                  result);
+		break;
+	case PhysicalType::FLOAT:
+		TemplatedFetchBaseData<float, NoBitpacking<float>>(compression, base, vector_index, count, result);
+		break;
+	case PhysicalType::DOUBLE:
+		TemplatedFetchBaseData<double, NoBitpacking<double>>(compression, base, vector_index, count, result);
+		break;
+	default:
+		throw InternalException("Unsupported type for compressed segment");
+	}
+}
+
+void CompressedSegment::FilterFetchBaseData(ColumnScanState &state, Vector &result, SelectionVector &sel,
+                                            idx_t &approved_tuple_count) {
+	if (!IsCompressed()) {
+		NumericSegment::FilterFetchBaseData(state, result, sel, approved_tuple_count);
+		return;
+	}
+	auto handle = manager.Pin(block_id, false, PinHint::USE_ONCE);
+	auto uncompressed = unique_ptr<data_t[]>(new data_t[vector_size]);
+	DecompressVector(handle->node->buffer + offset, state.vector_index, uncompressed.get());
+	FilterFetchVector(uncompressed.get(), result, sel, approved_tuple_count);
+}
+
+void CompressedSegment::Select(ColumnScanState &state, Vector &result, SelectionVector &sel,
+                               idx_t &approved_tuple_count, vector<TableFilter> &tableFilter) {
+	if (!IsCompressed()) {
+		NumericSegment::Select(state, result, sel, approved_tuple_count, tableFilter);
+		return;
+	}
+	auto handle = manager.Pin(block_id, false, PinHint::USE_ONCE);
+	auto uncompressed = unique_ptr<data_t[]>(new data_t[vector_size]);
+	DecompressVector(handle->node->buffer + offset, state.vector_index, uncompressed.get());
+	SelectVector(uncompressed.get(), state, result, sel, approved_tuple_count, tableFilter);
+}
+
+void CompressedSegment::FetchRow(ColumnFetchState &state, Transaction &transaction, row_t row_id, Vector &result,
+                                 idx_t result_idx) {
+	auto read_lock = lock.GetSharedLock();
+	if (!IsCompressed()) {
+		read_lock.reset();
+		NumericSegment::FetchRow(state, transaction, row_id, result, result_idx);
+		return;
+	}
+	// compressed segments have no updates: they are converted to temporary segments first
+	D_ASSERT(!versions);
+	auto handle = manager.Pin(block_id);
+	auto base = handle->node->buffer + offset;
+	idx_t vector_index = row_id / STANDARD_VECTOR_SIZE;
+	idx_t id_in_vector = row_id - vector_index * STANDARD_VECTOR_SIZE;
+	D_ASSERT(vector_index < max_vector_count);
+	switch (type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+		TemplatedFetchRow<int8_t, Bitpacking<int8_t>>(compression, base, vector_index, id_in_vector, result,
+		                                                     result_idx);
+		break;
+	case PhysicalType::INT16:
+		TemplatedFetchRow<int16_t, Bitpacking<int16_t>>(compression, base, vector_index, id_in_vector, result,
+		                                                       result_idx);
+		break;
+	case PhysicalType::INT32:
+		TemplatedFetchRow<int32_t, Bitpacking<int32_t>>(compression, base, vector_index, id_in_vector, result,
+		                                                       result_idx);
+		break;
+	case PhysicalType::INT64:
+		TemplatedFetchRow<int64_t, Bitpacking<int64_t>>(compression, base, vector_index, id_in_vector, result,
+		                                                       result_idx);
+		break;
+	case PhysicalType::INT128:
+		TemplatedFetchRow<hugeint_t, NoBitpacking<hugeint_t>>(compression, base, vector_index, id_in_vector,
+		                                                             result, result_idx);
+		break;
+	case PhysicalType::FLOAT:
+		TemplatedFetchRow<float, NoBitpacking<float>>(compression, base, vector_index, id_in_vector, result,
+		                                                     result_idx);
+		break;
+	case PhysicalType::DOUBLE:
+		TemplatedFetchRow<double, NoBitpacking<double>>(compression, base, vector_index, id_in_vector, result,
+		                                                       result_idx);
+		break;
+	default:
+		throw InternalException("Unsupported type for compressed segment");
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// ToTemporary
+//===--------------------------------------------------------------------===//
+void CompressedSegment::ToTemporary() {
+	auto write_lock = lock.GetExclusiveLock();
+	if (!IsCompressed()) {
+		// conversion has already been performed by a different thread
+		return;
+	}
+	// decompress the segment into a new in-memory buffer in the layout of a NumericSegment
+	auto current = manager.Pin(block_id);
+	auto base = current->node->buffer + offset;
+	auto handle = manager.Allocate(Storage::BLOCK_ALLOC_SIZE);
+	idx_t vector_count = (tuple_count + STANDARD_VECTOR_SIZE - 1) / STANDARD_VECTOR_SIZE;
+	for (idx_t vector_index = 0; vector_index < max_vector_count; vector_index++) {
+		auto target = handle->node->buffer + vector_index * vector_size;
+		if (vector_index < vector_count) {
+			DecompressVector(base, vector_index, target);
+		} else {
+			((nullmask_t *)target)->reset();
+		}
+	}
+	this->block_id = handle->block_id;
+}
+
+} // namespace duckdb
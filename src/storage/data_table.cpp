@@ -10,7 +10,11 @@
 #include "duckdb/transaction/transaction_manager.hpp"
 #include "duckdb/storage/table/transient_segment.hpp"
 #include "duckdb/storage/storage_manager.hpp"
+#include "duckdb/storage/meta_block_reader.hpp"
+#include "duckdb/storage/checkpoint/table_data_reader.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 
 #include "duckdb/storage/table/morsel_info.hpp"
 
@@ -19,9 +23,10 @@ using namespace std;
 using namespace chrono;
 
 DataTable::DataTable(StorageManager &storage, string schema, string table, vector<LogicalType> types_,
-                     unique_ptr<vector<unique_ptr<PersistentSegment>>[]> data)
+                     unique_ptr<BlockPointer> data)
     : info(make_shared<DataTableInfo>(schema, table)), types(types_), storage(storage),
-      versions(make_shared<SegmentTree>()), total_rows(0), is_root(true) {
+      versions(make_shared<SegmentTree>()), total_rows(0), is_root(true), persistent_data_loaded(!data),
+      persistent_data(move(data)) {
 	// set up the segment trees for the column segments
 	for (idx_t i = 0; i < types.size(); i++) {
 		auto column_data = make_shared<ColumnData>(*storage.buffer_manager, *info);
@@ -29,8 +34,34 @@ DataTable::DataTable(StorageManager &storage, string schema, string table, vecto
 		column_data->column_idx = i;
 		columns.push_back(move(column_data));
 	}
+	if (persistent_data_loaded) {
+		// no data on disk: append one (empty) morsel to the table
+		auto segment = make_unique<MorselInfo>(0, MorselInfo::MORSEL_SIZE);
+		versions->AppendSegment(move(segment));
+	}
+}
 
-	// initialize the table with the existing data from disk, if any
+void DataTable::LoadPersistentData() {
+	if (persistent_data_loaded) {
+		return;
+	}
+	lock_guard<mutex> lock(load_lock);
+	if (persistent_data_loaded) {
+		return;
+	}
+	// read the data pointers of the table from disk
+	MetaBlockReader reader(*storage.buffer_manager, persistent_data->block_id);
+	reader.offset = persistent_data->offset;
+	TableDataReader data_reader(*storage.buffer_manager, reader, types);
+	vector<pair<idx_t, idx_t>> deleted_rows;
+	auto data = data_reader.ReadTableData(deleted_rows);
+	InitializePersistentData(move(data), deleted_rows);
+
+	persistent_data.reset();
+	persistent_data_loaded = true;
+}
+
+void DataTable::InitializePersistentData(persistent_data_t data, const vector<pair<idx_t, idx_t>> &deleted_rows) {
 	if (data && data[0].size() > 0) {
 		// first append all the segments to the set of column segments
 		for (idx_t i = 0; i < types.size(); i++) {
@@ -41,11 +72,21 @@ DataTable::DataTable(StorageManager &storage, string schema, string table, vecto
 		}
 		total_rows = columns[0]->persistent_rows;
 		// create empty morsel info's
-		// in the future, we should lazily load these from the file as well (once we support deleted flags)
 		for (idx_t i = 0; i < total_rows; i += MorselInfo::MORSEL_SIZE) {
 			auto segment = make_unique<MorselInfo>(i, MorselInfo::MORSEL_SIZE);
 			versions->AppendSegment(move(segment));
 		}
+		// mark the rows that were stored as deleted rows as deleted for every transaction
+		for (auto &range : deleted_rows) {
+			idx_t row = range.first;
+			idx_t end = range.first + range.second;
+			while (row < end) {
+				auto morsel = (MorselInfo *)versions->GetSegment(row);
+				idx_t morsel_end = MinValue<idx_t>(end, morsel->start + MorselInfo::MORSEL_SIZE);
+				morsel->MarkDeleted(row - morsel->start, morsel_end - row);
+				row = morsel_end;
+			}
+		}
 	} else {
 		// append one (empty) morsel to the table
 		auto segment = make_unique<MorselInfo>(0, MorselInfo::MORSEL_SIZE);
@@ -54,8 +95,12 @@ DataTable::DataTable(StorageManager &storage, string schema, string table, vecto
 }
 
 DataTable::DataTable(ClientContext &context, DataTable &parent, ColumnDefinition &new_column, Expression *default_value)
-    : info(parent.info), types(parent.types), storage(parent.storage), versions(parent.versions),
-      total_rows(parent.total_rows), columns(parent.columns), is_root(true) {
+    : info(parent.info), types(parent.types), storage(parent.storage), is_root(true), persistent_data_loaded(true) {
+	// the new table shares the persistent segments of the parent
+	parent.LoadPersistentData();
+	versions = parent.versions;
+	total_rows = parent.total_rows;
+	columns = parent.columns;
 	// prevent any new tuples from being added to the parent
 	lock_guard<mutex> parent_lock(parent.append_lock);
 	// add the new column to this DataTable
@@ -99,8 +144,12 @@ DataTable::DataTable(ClientContext &context, DataTable &parent, ColumnDefinition
 }
 
 DataTable::DataTable(ClientContext &context, DataTable &parent, idx_t removed_column)
-    : info(parent.info), types(parent.types), storage(parent.storage), versions(parent.versions),
-      total_rows(parent.total_rows), columns(parent.columns), is_root(true) {
+    : info(parent.info), types(parent.types), storage(parent.storage), is_root(true), persistent_data_loaded(true) {
+	// the new table shares the persistent segments of the parent
+	parent.LoadPersistentData();
+	versions = parent.versions;
+	total_rows = parent.total_rows;
+	columns = parent.columns;
 	// prevent any new tuples from being added to the parent
 	lock_guard<mutex> parent_lock(parent.append_lock);
 	// first check if there are any indexes that exist that point to the removed column
@@ -124,8 +173,12 @@ DataTable::DataTable(ClientContext &context, DataTable &parent, idx_t removed_co
 
 DataTable::DataTable(ClientContext &context, DataTable &parent, idx_t changed_idx, LogicalType target_type,
                      vector<column_t> bound_columns, Expression &cast_expr)
-    : info(parent.info), types(parent.types), storage(parent.storage), versions(parent.versions),
-      total_rows(parent.total_rows), columns(parent.columns), is_root(true) {
+    : info(parent.info), types(parent.types), storage(parent.storage), is_root(true), persistent_data_loaded(true) {
+	// the new table shares the persistent segments of the parent
+	parent.LoadPersistentData();
+	versions = parent.versions;
+	total_rows = parent.total_rows;
+	columns = parent.columns;
 
 	// prevent any new tuples from being added to the parent
 	CreateIndexScanState scan_state;
@@ -194,6 +247,7 @@ DataTable::DataTable(ClientContext &context, DataTable &parent, idx_t changed_id
 //===--------------------------------------------------------------------===//
 void DataTable::InitializeScan(TableScanState &state, const vector<column_t> &column_ids,
                                unordered_map<idx_t, vector<TableFilter>> *table_filters) {
+	LoadPersistentData();
 	// initialize a column scan state for each column
 	state.column_scans = unique_ptr<ColumnScanState[]>(new ColumnScanState[column_ids.size()]);
 	for (idx_t i = 0; i < column_ids.size(); i++) {
@@ -241,15 +295,17 @@ void DataTable::InitializeScanWithOffset(TableScanState &state, const vector<col
 	// initialize the chunk scan state
 	state.column_count = column_ids.size();
 	state.current_row = start_row;
-	state.base_row = start_row;
 	state.max_row = end_row;
 	state.version_info = (MorselInfo *)versions->GetSegment(state.current_row);
+	// the scan does not necessarily start at the beginning of the version info
+	state.base_row = state.version_info->start;
 	if (table_filters && table_filters->size() > 0 && !state.adaptive_filter) {
 		state.adaptive_filter = make_unique<AdaptiveFilter>(*table_filters);
 	}
 }
 
 idx_t DataTable::MaxThreads(ClientContext &context) {
+	LoadPersistentData();
 	idx_t PARALLEL_SCAN_VECTOR_COUNT = 100;
 	if (context.force_parallelism) {
 		PARALLEL_SCAN_VECTOR_COUNT = 1;
@@ -260,6 +316,7 @@ idx_t DataTable::MaxThreads(ClientContext &context) {
 }
 
 void DataTable::InitializeParallelScan(ParallelTableScanState &state) {
+	LoadPersistentData();
 	state.current_row = 0;
 	state.transaction_local_data = false;
 }
@@ -273,6 +330,15 @@ bool DataTable::NextParallelScan(ClientContext &context, ParallelTableScanState
 	}
 	idx_t PARALLEL_SCAN_TUPLE_COUNT = STANDARD_VECTOR_SIZE * PARALLEL_SCAN_VECTOR_COUNT;
 
+	if (table_filters && table_filters->size() > 0) {
+		// skip over the segments for which the zonemaps show that none of the rows can pass the filters
+		// this happens before the morsel is handed out, so no scan is initialized and no block is pinned for them
+		idx_t skip_row;
+		while (state.current_row < total_rows &&
+		       !CheckZonemap(column_ids, *table_filters, state.current_row, skip_row)) {
+			state.current_row = skip_row;
+		}
+	}
 	if (state.current_row < total_rows) {
 		idx_t next = MinValue(state.current_row + PARALLEL_SCAN_TUPLE_COUNT, total_rows);
 
@@ -310,9 +376,9 @@ void DataTable::Scan(Transaction &transaction, DataChunk &result, TableScanState
 	transaction.storage.Scan(state.local_state, column_ids, result, &table_filters);
 }
 
-template <class T> bool checkZonemap(TableScanState &state, TableFilter &table_filter, T constant) {
-	T *min = (T *)state.column_scans[table_filter.column_index].current->stats.minimum.get();
-	T *max = (T *)state.column_scans[table_filter.column_index].current->stats.maximum.get();
+template <class T> static bool CheckZonemapTemplated(SegmentStatistics &stats, TableFilter &table_filter, T constant) {
+	T *min = (T *)stats.minimum.get();
+	T *max = (T *)stats.maximum.get();
 	switch (table_filter.comparison_type) {
 	case ExpressionType::COMPARE_EQUAL:
 		return constant >= *min && constant <= *max;
@@ -329,9 +395,9 @@ template <class T> bool checkZonemap(TableScanState &state, TableFilter &table_f
 	}
 }
 
-bool checkZonemapString(TableScanState &state, TableFilter &table_filter, const char *constant) {
-	char *min = (char *)state.column_scans[table_filter.column_index].current->stats.minimum.get();
-	char *max = (char *)state.column_scans[table_filter.column_index].current->stats.maximum.get();
+static bool CheckZonemapString(SegmentStatistics &stats, TableFilter &table_filter, const char *constant) {
+	char *min = (char *)stats.minimum.get();
+	char *max = (char *)stats.maximum.get();
 	int min_comp = strcmp(min, constant);
 	int max_comp = strcmp(max, constant);
 	switch (table_filter.comparison_type) {
@@ -348,84 +414,78 @@ bool checkZonemapString(TableScanState &state, TableFilter &table_filter, const
 	}
 }
 
-bool DataTable::CheckZonemap(TableScanState &state, unordered_map<idx_t, vector<TableFilter>> &table_filters,
-                             idx_t &current_row) {
+//! Returns false if the zonemap of the segment shows that none of its rows can pass the filter
+static bool CheckZonemap(SegmentStatistics &stats, TableFilter &table_filter) {
+	auto &constant = table_filter.constant;
+	switch (stats.type) {
+	case PhysicalType::INT8:
+		return CheckZonemapTemplated<int8_t>(stats, table_filter, constant.value_.tinyint);
+	case PhysicalType::INT16:
+		return CheckZonemapTemplated<int16_t>(stats, table_filter, constant.value_.smallint);
+	case PhysicalType::INT32:
+		return CheckZonemapTemplated<int32_t>(stats, table_filter, constant.value_.integer);
+	case PhysicalType::INT64:
+		return CheckZonemapTemplated<int64_t>(stats, table_filter, constant.value_.bigint);
+	case PhysicalType::INT128:
+		return CheckZonemapTemplated<hugeint_t>(stats, table_filter, constant.value_.hugeint);
+	case PhysicalType::FLOAT:
+		return CheckZonemapTemplated<float>(stats, table_filter, constant.value_.float_);
+	case PhysicalType::DOUBLE:
+		return CheckZonemapTemplated<double>(stats, table_filter, constant.value_.double_);
+	case PhysicalType::VARCHAR: {
+		//! we can only compare the first 7 bytes
+		string prefix = constant.str_value.substr(0, 7);
+		return CheckZonemapString(stats, table_filter, prefix.c_str());
+	}
+	default:
+		throw NotImplementedException("Unimplemented type for zonemaps");
+	}
+}
+
+bool DataTable::CheckZonemap(const vector<column_t> &column_ids,
+                             unordered_map<idx_t, vector<TableFilter>> &table_filters, idx_t row, idx_t &skip_row) {
 	for (auto &table_filter : table_filters) {
+		auto column = column_ids[table_filter.first];
+		D_ASSERT(column != COLUMN_IDENTIFIER_ROW_ID);
+		auto segment = (ColumnSegment *)columns[column]->data.GetSegment(row);
 		for (auto &predicate_constant : table_filter.second) {
-			bool readSegment = true;
+			if (!::duckdb::CheckZonemap(segment->stats, predicate_constant)) {
+				skip_row = segment->start + segment->count;
+				return false;
+			}
+		}
+	}
+	return true;
+}
 
-			if (!state.column_scans[predicate_constant.column_index].segment_checked) {
-				state.column_scans[predicate_constant.column_index].segment_checked = true;
-				if (!state.column_scans[predicate_constant.column_index].current) {
-					return true;
-				}
-				switch (state.column_scans[predicate_constant.column_index].current->type) {
-				case PhysicalType::INT8: {
-					int8_t constant = predicate_constant.constant.value_.tinyint;
-					readSegment = checkZonemap<int8_t>(state, predicate_constant, constant);
-					break;
-				}
-				case PhysicalType::INT16: {
-					int16_t constant = predicate_constant.constant.value_.smallint;
-					readSegment = checkZonemap<int16_t>(state, predicate_constant, constant);
-					break;
-				}
-				case PhysicalType::INT32: {
-					int32_t constant = predicate_constant.constant.value_.integer;
-					readSegment = checkZonemap<int32_t>(state, predicate_constant, constant);
-					break;
-				}
-				case PhysicalType::INT64: {
-					int64_t constant = predicate_constant.constant.value_.bigint;
-					readSegment = checkZonemap<int64_t>(state, predicate_constant, constant);
-					break;
-				}
-				case PhysicalType::INT128: {
-					auto constant = predicate_constant.constant.value_.hugeint;
-					readSegment = checkZonemap<hugeint_t>(state, predicate_constant, constant);
-					break;
-				}
-				case PhysicalType::FLOAT: {
-					float constant = predicate_constant.constant.value_.float_;
-					readSegment = checkZonemap<float>(state, predicate_constant, constant);
-					break;
-				}
-				case PhysicalType::DOUBLE: {
-					double constant = predicate_constant.constant.value_.double_;
-					readSegment = checkZonemap<double>(state, predicate_constant, constant);
-					break;
-				}
-				case PhysicalType::VARCHAR: {
-					//! we can only compare the first 7 bytes
-					size_t value_size = predicate_constant.constant.str_value.size() > 7
-					                        ? 7
-					                        : predicate_constant.constant.str_value.size();
-					string constant;
-					for (size_t i = 0; i < value_size; i++) {
-						constant += predicate_constant.constant.str_value[i];
-					}
-					readSegment = checkZonemapString(state, predicate_constant, constant.c_str());
-					break;
-				}
-				default:
-					throw NotImplementedException("Unimplemented type for zonemaps");
-				}
+bool DataTable::CheckZonemap(TableScanState &state, const vector<column_t> &column_ids,
+                             unordered_map<idx_t, vector<TableFilter>> &table_filters, idx_t &current_row) {
+	for (auto &table_filter : table_filters) {
+		auto &column_scan = state.column_scans[table_filter.first];
+		if (column_scan.segment_checked || !column_scan.current) {
+			// the zonemap of this segment was already checked earlier in the scan
+			continue;
+		}
+		column_scan.segment_checked = true;
+		for (auto &predicate_constant : table_filter.second) {
+			if (::duckdb::CheckZonemap(column_scan.current->stats, predicate_constant)) {
+				continue;
 			}
-			if (!readSegment) {
-				//! We can skip this partition
-				idx_t vectorsToSkip =
-				    ceil((double)(state.column_scans[predicate_constant.column_index].current->count +
-				                  state.column_scans[predicate_constant.column_index].current->start - current_row) /
-				         STANDARD_VECTOR_SIZE);
-				for (idx_t i = 0; i < vectorsToSkip; ++i) {
-					state.NextVector();
-					current_row += STANDARD_VECTOR_SIZE;
+			// none of the rows in the remainder of this segment can pass the filter: skip ahead to the end of the
+			// segment. segments always hold a multiple of the vector size (except for the last one), so the scan
+			// stays aligned to vector boundaries
+			current_row = column_scan.current->start + column_scan.current->count;
+			if (current_row < state.max_row) {
+				idx_t vector_idx = current_row / STANDARD_VECTOR_SIZE;
+				for (idx_t i = 0; i < column_ids.size(); i++) {
+					if (column_ids[i] != COLUMN_IDENTIFIER_ROW_ID) {
+						columns[column_ids[i]]->InitializeScanWithOffset(state.column_scans[i], vector_idx);
+					}
 				}
-				return false;
 			}
+			return false;
 		}
 	}
-
 	return true;
 }
 
@@ -439,15 +499,16 @@ bool DataTable::ScanBaseTable(Transaction &transaction, DataChunk &result, Table
 	idx_t max_count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, max_row - current_row);
 	idx_t vector_offset = (current_row - state.base_row) / STANDARD_VECTOR_SIZE;
 	//! first check the zonemap if we have to scan this partition
-	if (!CheckZonemap(state, table_filters, current_row)) {
+	if (!CheckZonemap(state, column_ids, table_filters, current_row)) {
 		return true;
 	}
 	// second, scan the version chunk manager to figure out which tuples to load for this transaction
 	SelectionVector valid_sel(STANDARD_VECTOR_SIZE);
-	if (vector_offset >= MorselInfo::MORSEL_VECTOR_COUNT) {
+	while (vector_offset >= MorselInfo::MORSEL_VECTOR_COUNT) {
+		// skipping a segment can move the scan past multiple morsels at once
 		state.version_info = (MorselInfo *)state.version_info->next.get();
 		state.base_row += MorselInfo::MORSEL_SIZE;
-		vector_offset = 0;
+		vector_offset -= MorselInfo::MORSEL_VECTOR_COUNT;
 	}
 	idx_t count = state.version_info->GetSelVector(transaction, vector_offset, valid_sel, max_count);
 	if (count == 0) {
@@ -523,6 +584,7 @@ bool DataTable::ScanBaseTable(Transaction &transaction, DataChunk &result, Table
 //===--------------------------------------------------------------------===//
 void DataTable::Fetch(Transaction &transaction, DataChunk &result, vector<column_t> &column_ids,
                       Vector &row_identifiers, idx_t fetch_count, ColumnFetchState &state) {
+	LoadPersistentData();
 	// first figure out which row identifiers we should use for this transaction by looking at the VersionManagers
 	row_t rows[STANDARD_VECTOR_SIZE];
 	idx_t count = FetchRows(transaction, row_identifiers, fetch_count, rows);
@@ -544,10 +606,7 @@ void DataTable::Fetch(Transaction &transaction, DataChunk &result, vector<column
 			}
 		} else {
 			// regular column: fetch data from the base column
-			for (idx_t i = 0; i < count; i++) {
-				auto row_id = rows[i];
-				columns[column]->FetchRow(state, transaction, row_id, result.data[col_idx], i);
-			}
+			columns[column]->FetchRows(state, transaction, rows, count, result.data[col_idx]);
 		}
 	}
 }
@@ -559,9 +618,13 @@ idx_t DataTable::FetchRows(Transaction &transaction, Vector &row_identifiers, id
 	idx_t count = 0;
 
 	auto row_ids = FlatVector::GetData<row_t>(row_identifiers);
+	MorselInfo *segment = nullptr;
 	for (idx_t i = 0; i < fetch_count; i++) {
-		auto row_id = row_ids[i];
-		auto segment = (MorselInfo *)versions->GetSegment(row_id);
+		idx_t row_id = row_ids[i];
+		// consecutive row ids are likely to belong to the same morsel
+		if (!segment || row_id < segment->start || row_id >= segment->start + segment->count) {
+			segment = (MorselInfo *)versions->GetSegment(row_id);
+		}
 		bool use_row = segment->Fetch(transaction, row_id - segment->start);
 		if (use_row) {
 			// row is not deleted; use the row
@@ -652,6 +715,7 @@ void DataTable::Append(TableCatalogEntry &table, ClientContext &context, DataChu
 }
 
 void DataTable::InitializeAppend(Transaction &transaction, TableAppendState &state, idx_t append_count) {
+	LoadPersistentData();
 	// obtain the append lock for this table
 	state.append_lock = unique_lock<mutex>(append_lock);
 	if (!is_root) {
@@ -712,6 +776,7 @@ void DataTable::Append(Transaction &transaction, DataChunk &chunk, TableAppendSt
 }
 
 void DataTable::ScanTableSegment(idx_t row_start, idx_t count, std::function<void(DataChunk &chunk)> function) {
+	LoadPersistentData();
 	idx_t end = row_start + count;
 
 	vector<column_t> column_ids;
@@ -755,6 +820,7 @@ void DataTable::WriteToLog(WriteAheadLog &log, idx_t row_start, idx_t count) {
 }
 
 void DataTable::CommitAppend(transaction_t commit_id, idx_t row_start, idx_t count) {
+	LoadPersistentData();
 	lock_guard<mutex> lock(append_lock);
 
 	auto morsel = (MorselInfo *)versions->GetSegment(row_start);
@@ -814,6 +880,7 @@ void DataTable::RevertAppendInternal(idx_t start_row, idx_t count) {
 }
 
 void DataTable::RevertAppend(idx_t start_row, idx_t count) {
+	LoadPersistentData();
 	lock_guard<mutex> lock(append_lock);
 	if (info->indexes.size() > 0) {
 		auto index_locks = unique_ptr<IndexLock[]>(new IndexLock[info->indexes.size()]);
@@ -867,6 +934,47 @@ bool DataTable::AppendToIndexes(TableAppendState &state, DataChunk &chunk, row_t
 	return true;
 }
 
+bool DataTable::AppendToIndexes(idx_t row_start, idx_t count) {
+	if (info->indexes.size() == 0) {
+		return true;
+	}
+	lock_guard<mutex> lock(append_lock);
+	TableAppendState state;
+	state.index_locks = unique_ptr<IndexLock[]>(new IndexLock[info->indexes.size()]);
+	vector<unique_ptr<IndexBulkLoadState>> bulk_loads;
+	for (idx_t i = 0; i < info->indexes.size(); i++) {
+		info->indexes[i]->InitializeLock(state.index_locks[i]);
+		bulk_loads.push_back(info->indexes[i]->InitializeBulkLoad());
+	}
+	// collect the entries of the rows, and bulk load them into the indexes
+	row_t current_row = row_start;
+	ScanTableSegment(row_start, count, [&](DataChunk &chunk) {
+		Vector row_identifiers(LOGICAL_ROW_TYPE);
+		VectorOperations::GenerateSequence(row_identifiers, chunk.size(), current_row, 1);
+		for (idx_t i = 0; i < info->indexes.size(); i++) {
+			info->indexes[i]->BulkLoadAppendData(*bulk_loads[i], chunk, row_identifiers);
+		}
+		current_row += chunk.size();
+	});
+	auto &scheduler = *storage.GetDatabase().scheduler;
+	for (idx_t i = 0; i < info->indexes.size(); i++) {
+		if (!info->indexes[i]->BulkLoadFinalize(state.index_locks[i], *bulk_loads[i], scheduler)) {
+			// constraint violation: remove the rows from the indexes that were already loaded
+			current_row = row_start;
+			ScanTableSegment(row_start, count, [&](DataChunk &chunk) {
+				Vector row_identifiers(LOGICAL_ROW_TYPE);
+				VectorOperations::GenerateSequence(row_identifiers, chunk.size(), current_row, 1);
+				for (idx_t j = 0; j < i; j++) {
+					info->indexes[j]->Delete(state.index_locks[j], chunk, row_identifiers);
+				}
+				current_row += chunk.size();
+			});
+			return false;
+		}
+	}
+	return true;
+}
+
 void DataTable::RemoveFromIndexes(TableAppendState &state, DataChunk &chunk, row_t row_start) {
 	D_ASSERT(is_root);
 	if (info->indexes.size() == 0) {
@@ -889,6 +997,7 @@ void DataTable::RemoveFromIndexes(TableAppendState &state, DataChunk &chunk, Vec
 
 void DataTable::RemoveFromIndexes(Vector &row_identifiers, idx_t count) {
 	D_ASSERT(is_root);
+	LoadPersistentData();
 	auto row_ids = FlatVector::GetData<row_t>(row_identifiers);
 	// create a selection vector from the row_ids
 	SelectionVector sel(STANDARD_VECTOR_SIZE);
@@ -918,19 +1027,47 @@ void DataTable::Delete(TableCatalogEntry &table, ClientContext &context, Vector
 	if (count == 0) {
 		return;
 	}
+	LoadPersistentData();
 
 	auto &transaction = Transaction::GetTransaction(context);
 
+	D_ASSERT(count <= STANDARD_VECTOR_SIZE);
 	row_identifiers.Normalify(count);
 	auto ids = FlatVector::GetData<row_t>(row_identifiers);
-	auto first_id = ids[0];
 
-	if (first_id >= MAX_ROW_ID) {
-		// deletion is in transaction-local storage: push delete into local chunk collection
-		transaction.storage.Delete(this, row_identifiers, count);
-	} else {
-		auto morsel = (MorselInfo *)versions->GetSegment(first_id);
-		morsel->Delete(transaction, this, row_identifiers, count);
+	// the row ids can belong to different morsels (e.g. when they are produced by an index scan), but the deletes are
+	// applied per morsel (or per chunk of the transaction-local storage): split the row ids into groups
+	Vector group_identifiers(row_identifiers.type);
+	auto group_ids = FlatVector::GetData<row_t>(group_identifiers);
+	vector<row_t> remaining_ids(ids, ids + count);
+	while (!remaining_ids.empty()) {
+		auto first_id = remaining_ids[0];
+		row_t group_start, group_end;
+		MorselInfo *morsel = nullptr;
+		if (first_id >= MAX_ROW_ID) {
+			group_start = first_id - (first_id - MAX_ROW_ID) % STANDARD_VECTOR_SIZE;
+			group_end = group_start + STANDARD_VECTOR_SIZE;
+		} else {
+			morsel = (MorselInfo *)versions->GetSegment(first_id);
+			group_start = morsel->start;
+			group_end = morsel->start + morsel->count;
+		}
+		idx_t group_count = 0, remaining_count = 0;
+		for (auto id : remaining_ids) {
+			if (id >= group_start && id < group_end) {
+				group_ids[group_count++] = id;
+			} else {
+				remaining_ids[remaining_count++] = id;
+			}
+		}
+		remaining_ids.resize(remaining_count);
+
+		if (!morsel) {
+			// deletion is in transaction-local storage: push delete into local chunk collection
+			transaction.storage.Delete(this, group_identifiers, group_count);
+		} else {
+			morsel->Delete(transaction, this, group_identifiers, group_count);
+		}
 	}
 }
 
@@ -1019,6 +1156,7 @@ void DataTable::Update(TableCatalogEntry &table, ClientContext &context, Vector
 	if (updates.size() == 0) {
 		return;
 	}
+	LoadPersistentData();
 
 	// first verify that no constraints are violated
 	VerifyUpdateConstraints(table, updates, column_ids);
@@ -1047,17 +1185,22 @@ void DataTable::Update(TableCatalogEntry &table, ClientContext &context, Vector
 // Create Index Scan
 //===--------------------------------------------------------------------===//
 void DataTable::InitializeCreateIndexScan(CreateIndexScanState &state, const vector<column_t> &column_ids) {
+	LoadPersistentData();
 	// we grab the append lock to make sure nothing is appended until AFTER we finish the index scan
 	state.append_lock = unique_lock<mutex>(append_lock);
 	state.delete_lock = unique_lock<mutex>(versions->node_lock);
+	state.lowest_active_start = storage.GetDatabase().transaction_manager->LowestActiveStart();
 
 	InitializeScan(state, column_ids);
 }
 
 void DataTable::CreateIndexScan(CreateIndexScanState &state, const vector<column_t> &column_ids, DataChunk &result) {
-	// scan the persistent segments
-	if (ScanCreateIndex(state, column_ids, result, state.current_row, state.max_row)) {
-		return;
+	// scan the persistent segments, skipping the vectors in which every row has been deleted
+	while (ScanCreateIndex(state, column_ids, result, state.current_row, state.max_row)) {
+		if (result.size() > 0) {
+			return;
+		}
+		result.Reset();
 	}
 }
 
@@ -1069,8 +1212,6 @@ bool DataTable::ScanCreateIndex(CreateIndexScanState &state, const vector<column
 	idx_t count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, max_row - current_row);
 
 	// scan the base columns to fetch the actual data
-	// note that we insert all data into the index, even if it is marked as deleted
-	// FIXME: tuples that are already "cleaned up" do not need to be inserted into the index!
 	for (idx_t i = 0; i < column_ids.size(); i++) {
 		auto column = column_ids[i];
 		if (column == COLUMN_IDENTIFIER_ROW_ID) {
@@ -1084,6 +1225,21 @@ bool DataTable::ScanCreateIndex(CreateIndexScanState &state, const vector<column
 	}
 	result.SetCardinality(count);
 
+	// rows that have been deleted for every transaction are not inserted into the index: no transaction can see them,
+	// just like the rows that the cleanup of their deletes removes from the other indexes
+	idx_t vector_offset = (current_row - state.base_row) / STANDARD_VECTOR_SIZE;
+	while (vector_offset >= MorselInfo::MORSEL_VECTOR_COUNT) {
+		state.version_info = (MorselInfo *)state.version_info->next.get();
+		state.base_row += MorselInfo::MORSEL_SIZE;
+		vector_offset -= MorselInfo::MORSEL_VECTOR_COUNT;
+	}
+	SelectionVector sel(STANDARD_VECTOR_SIZE);
+	idx_t undeleted_count =
+	    state.version_info->GetUndeletedSelVector(state.lowest_active_start, vector_offset, sel, count);
+	if (undeleted_count != count) {
+		result.Slice(sel, undeleted_count);
+	}
+
 	current_row += STANDARD_VECTOR_SIZE;
 	return count > 0;
 }
@@ -1110,9 +1266,10 @@ void DataTable::AddIndex(unique_ptr<Index> index, vector<unique_ptr<Expression>>
 		throw TransactionException("Transaction conflict: cannot add an index to a table that has been altered!");
 	}
 
-	// now start incrementally building the index
+	// now collect the entries of the table and bulk load them into the index
 	IndexLock lock;
 	index->InitializeLock(lock);
+	auto bulk_load = index->InitializeBulkLoad();
 	ExpressionExecutor executor(expressions);
 	while (true) {
 		intermediate.Reset();
@@ -1126,10 +1283,10 @@ void DataTable::AddIndex(unique_ptr<Index> index, vector<unique_ptr<Expression>>
 		// resolve the expressions for this chunk
 		executor.Execute(intermediate, result);
 
-		// insert into the index
-		if (!index->Insert(lock, result, intermediate.data[intermediate.column_count() - 1])) {
-			throw ConstraintException("Cant create unique index, table contains duplicate data on indexed column(s)");
-		}
+		index->BulkLoadAppend(*bulk_load, result, intermediate.data[intermediate.column_count() - 1]);
+	}
+	if (!index->BulkLoadFinalize(lock, *bulk_load, *storage.GetDatabase().scheduler)) {
+		throw ConstraintException("Cant create unique index, table contains duplicate data on indexed column(s)");
 	}
 	info->indexes.push_back(move(index));
 }
@@ -39,6 +39,13 @@ void Index::Delete(DataChunk &entries, Vector &row_identifiers) {
 	Delete(state, entries, row_identifiers);
 }
 
+void Index::BulkLoadAppendData(IndexBulkLoadState &state, DataChunk &appended_data, Vector &row_identifiers) {
+	DataChunk result;
+	result.Initialize(logical_types);
+	ExecuteExpressions(appended_data, result);
+	BulkLoadAppend(state, result, row_identifiers);
+}
+
 void Index::ExecuteExpressions(DataChunk &input, DataChunk &result) {
 	executor.Execute(input, result);
 }
@@ -197,6 +197,16 @@ static void templated_select_operation_between(SelectionVector &sel, Vector &res
 	}
 }
 
+void NumericSegment::InitializeScan(ColumnScanState &state) {
+	// pin the buffer for this segment once for the whole scan of the segment
+	// the pins of the individual vectors are marked as use-once, so only repeated scans keep the buffer hot
+	if (state.primary_handle && state.primary_handle->block_id == block_id) {
+		// the previous segment of the scan was stored in the same block
+		return;
+	}
+	state.primary_handle = manager.Pin(block_id);
+}
+
 void NumericSegment::Select(ColumnScanState &state, Vector &result, SelectionVector &sel, idx_t &approved_tuple_count,
                             vector<TableFilter> &tableFilter) {
 	auto vector_index = state.vector_index;
@@ -204,11 +214,16 @@ void NumericSegment::Select(ColumnScanState &state, Vector &result, SelectionVec
 	D_ASSERT(vector_index * STANDARD_VECTOR_SIZE <= tuple_count);
 
 	// pin the buffer for this segment
-	auto handle = manager.Pin(block_id);
+	auto handle = manager.Pin(block_id, false, PinHint::USE_ONCE);
 	auto data = handle->node->buffer;
 	auto offset = vector_index * vector_size;
-	auto source_nullmask = (nullmask_t *)(data + offset);
-	auto source_data = data + offset + sizeof(nullmask_t);
+	SelectVector(data + offset, state, result, sel, approved_tuple_count, tableFilter);
+}
+
+void NumericSegment::SelectVector(data_ptr_t vector_ptr, ColumnScanState &state, Vector &result, SelectionVector &sel,
+                                  idx_t &approved_tuple_count, vector<TableFilter> &tableFilter) {
+	auto source_nullmask = (nullmask_t *)vector_ptr;
+	auto source_data = vector_ptr + sizeof(nullmask_t);
 
 	if (tableFilter.size() == 1) {
 		switch (tableFilter[0].comparison_type) {
@@ -279,7 +294,7 @@ void NumericSegment::FetchBaseData(ColumnScanState &state, idx_t vector_index, V
 	D_ASSERT(vector_index * STANDARD_VECTOR_SIZE <= tuple_count);
 
 	// pin the buffer for this segment
-	auto handle = manager.Pin(block_id);
+	auto handle = manager.Pin(block_id, false, PinHint::USE_ONCE);
 	auto data = handle->node->buffer;
 
 	auto offset = vector_index * vector_size;
@@ -324,12 +339,17 @@ void NumericSegment::FilterFetchBaseData(ColumnScanState &state, Vector &result,
 	D_ASSERT(vector_index * STANDARD_VECTOR_SIZE <= tuple_count);
 
 	// pin the buffer for this segment
-	auto handle = manager.Pin(block_id);
+	auto handle = manager.Pin(block_id, false, PinHint::USE_ONCE);
 	auto data = handle->node->buffer;
 
 	auto offset = vector_index * vector_size;
-	auto source_nullmask = (nullmask_t *)(data + offset);
-	auto source_data = data + offset + sizeof(nullmask_t);
+	FilterFetchVector(data + offset, result, sel, approved_tuple_count);
+}
+
+void NumericSegment::FilterFetchVector(data_ptr_t vector_ptr, Vector &result, SelectionVector &sel,
+                                       idx_t &approved_tuple_count) {
+	auto source_nullmask = (nullmask_t *)vector_ptr;
+	auto source_data = vector_ptr + sizeof(nullmask_t);
 	// fetch the nullmask and copy the data from the base table
 	result.vector_type = VectorType::FLAT_VECTOR;
 	auto result_data = FlatVector::GetData(result);
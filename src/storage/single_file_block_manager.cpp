@@ -123,7 +123,7 @@ SingleFileBlockManager::SingleFileBlockManager(FileSystem &fs, string path, bool
 		handle->Sync();
 		// we start with h2 as active_header, this way our initial write will be in h1
 		active_header = 1;
-		max_block = 0;
+		Initialize(h2);
 	} else {
 		// otherwise, we check the metadata of the file
 		header_buffer.Read(*handle, 0);
@@ -173,16 +173,21 @@ void SingleFileBlockManager::LoadFreeList(BufferManager &manager) {
 		// no need to load free list for read only db
 		return;
 	}
-	if (free_list_id == INVALID_BLOCK) {
-		// no free list
-		return;
+	if (free_list_id != INVALID_BLOCK) {
+		MetaBlockReader reader(manager, free_list_id);
+		auto free_list_count = reader.Read<uint64_t>();
+		free_list.clear();
+		free_list.reserve(free_list_count);
+		for (idx_t i = 0; i < free_list_count; i++) {
+			free_list.push_back(reader.Read<block_id_t>());
+		}
 	}
-	MetaBlockReader reader(manager, free_list_id);
-	auto free_list_count = reader.Read<uint64_t>();
-	free_list.clear();
-	free_list.reserve(free_list_count);
-	for (idx_t i = 0; i < free_list_count; i++) {
-		free_list.push_back(reader.Read<block_id_t>());
+	// all blocks that are not in the free list belong to the loaded checkpoint
+	unordered_set<block_id_t> free_blocks(free_list.begin(), free_list.end());
+	for (block_id_t i = 0; i < max_block; i++) {
+		if (free_blocks.find(i) == free_blocks.end()) {
+			loaded_blocks.insert(i);
+		}
 	}
 }
 
@@ -191,6 +196,7 @@ void SingleFileBlockManager::StartCheckpoint() {
 }
 
 block_id_t SingleFileBlockManager::GetFreeBlockId() {
+	lock_guard<mutex> lock(block_lock);
 	block_id_t block;
 	if (free_list.size() > 0) {
 		// free list is non empty
@@ -215,38 +221,51 @@ unique_ptr<Block> SingleFileBlockManager::CreateBlock() {
 
 void SingleFileBlockManager::Read(Block &block) {
 	D_ASSERT(block.id >= 0);
-	D_ASSERT(std::find(free_list.begin(), free_list.end(), block.id) == free_list.end());
+#ifdef DEBUG
+	{
+		lock_guard<mutex> lock(block_lock);
+		D_ASSERT(std::find(free_list.begin(), free_list.end(), block.id) == free_list.end());
+	}
+#endif
+	lock_guard<mutex> lock(io_lock);
 	block.Read(*handle, BLOCK_START + block.id * Storage::BLOCK_ALLOC_SIZE);
 }
 
 void SingleFileBlockManager::Write(FileBuffer &buffer, block_id_t block_id) {
 	D_ASSERT(block_id >= 0);
+	lock_guard<mutex> lock(io_lock);
 	buffer.Write(*handle, BLOCK_START + block_id * Storage::BLOCK_ALLOC_SIZE);
 }
 
 void SingleFileBlockManager::WriteHeader(DatabaseHeader header) {
 	// set the iteration count
 	header.iteration = ++iteration_count;
-	header.block_count = max_block;
-	// now handle the free list
-	free_list.clear();
+	// now handle the free list: every block that is not used by this checkpoint is free in the file
+	vector<block_id_t> free_blocks;
 	for (block_id_t i = 0; i < max_block; i++) {
 		if (used_blocks.find(i) == used_blocks.end()) {
-			free_list.push_back(i);
+			free_blocks.push_back(i);
 		}
 	}
-	if (free_list.size() > 0) {
+	// the blocks that the loaded tables are still reading from cannot be reused while the database is running
+	free_list.clear();
+	for (auto &block_id : free_blocks) {
+		if (loaded_blocks.find(block_id) == loaded_blocks.end()) {
+			free_list.push_back(block_id);
+		}
+	}
+	if (free_blocks.size() > 0) {
 		// there are blocks in the free list
 		// write them to the file
 		MetaBlockWriter writer(*this);
-		auto entry = std::find(free_list.begin(), free_list.end(), writer.block->id);
-		if (entry != free_list.end()) {
-			free_list.erase(entry);
+		auto entry = std::find(free_blocks.begin(), free_blocks.end(), writer.block->id);
+		if (entry != free_blocks.end()) {
+			free_blocks.erase(entry);
 		}
 		header.free_list = writer.block->id;
 
-		writer.Write<uint64_t>(free_list.size());
-		for (auto &block_id : free_list) {
+		writer.Write<uint64_t>(free_blocks.size());
+		for (auto &block_id : free_blocks) {
 			writer.Write<block_id_t>(block_id);
 		}
 		writer.Flush();
@@ -254,6 +273,7 @@ void SingleFileBlockManager::WriteHeader(DatabaseHeader header) {
 		// no blocks in the free list
 		header.free_list = INVALID_BLOCK;
 	}
+	header.block_count = max_block;
 	if (!use_direct_io) {
 		// if we are not using Direct IO we need to fsync BEFORE we write the header to ensure that all the previous
 		// blocks are written as well
@@ -264,17 +284,16 @@ void SingleFileBlockManager::WriteHeader(DatabaseHeader header) {
 	Store<DatabaseHeader>(header, header_buffer.buffer);
 	// now write the header to the file, active_header determines whether we write to h1 or h2
 	// note that if active_header is h1 we write to h2, and vice versa
-	header_buffer.Write(*handle, active_header == 1 ? Storage::FILE_HEADER_SIZE : Storage::FILE_HEADER_SIZE * 2);
+	{
+		lock_guard<mutex> lock(io_lock);
+		header_buffer.Write(*handle, active_header == 1 ? Storage::FILE_HEADER_SIZE : Storage::FILE_HEADER_SIZE * 2);
+	}
 	// switch active header to the other header
 	active_header = 1 - active_header;
 	//! Ensure the header write ends up on disk
 	handle->Sync();
 
-	// the free list is now equal to the blocks that were used by the previous iteration
-	free_list.clear();
-	for (auto &block_id : used_blocks) {
-		free_list.push_back(block_id);
-	}
+	// the free list now contains the blocks that can be used by the next checkpoint
 	used_blocks.clear();
 }
 
@@ -4,6 +4,7 @@
 #include "duckdb/storage/single_file_block_manager.hpp"
 
 #include "duckdb/catalog/catalog.hpp"
+#include "duckdb/common/exception.hpp"
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/main/database.hpp"
 #include "duckdb/main/client_context.hpp"
@@ -12,12 +13,14 @@
 #include "duckdb/transaction/transaction_manager.hpp"
 #include "duckdb/planner/binder.hpp"
 #include "duckdb/common/serializer/buffered_file_reader.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 
 namespace duckdb {
 using namespace std;
 
 StorageManager::StorageManager(DuckDB &db, string path, bool read_only)
-    : database(db), path(path), wal(db), read_only(read_only) {
+    : database(db), path(path), wal(db), read_only(read_only), checkpoint_scheduled(false),
+      checkpoint_error_is_fatal(false) {
 }
 
 StorageManager::~StorageManager() {
@@ -146,4 +149,81 @@ void StorageManager::LoadDatabase() {
 	}
 }
 
+class CheckpointTask : public Task {
+public:
+	CheckpointTask(StorageManager &storage) : storage(storage) {
+	}
+
+	void Execute() override {
+		storage.CreateOnlineCheckpoint();
+	}
+
+private:
+	StorageManager &storage;
+};
+
+void StorageManager::CheckpointIfNeeded() {
+	auto log = GetWriteAheadLog();
+	if (!log || log->GetWALSize() <= (int64_t)database.config.online_checkpoint_wal_size) {
+		// WAL is too small
+		return;
+	}
+	if (checkpoint_scheduled.exchange(true)) {
+		// another committer has already scheduled a checkpoint
+		return;
+	}
+	auto &scheduler = *database.scheduler;
+	if (scheduler.NumberOfThreads() == 1) {
+		// there are no background threads that can run the checkpoint: create it directly
+		CreateOnlineCheckpoint();
+		return;
+	}
+	// the producer token can be destroyed right away: the task remains in the queue until a thread picks it up
+	auto producer = scheduler.CreateProducer();
+	scheduler.ScheduleTask(*producer, make_unique<CheckpointTask>(*this));
+}
+
+void StorageManager::CreateOnlineCheckpoint() {
+	try {
+		// block transactions from committing changes: the checkpoint then contains exactly the changes of all
+		// transactions that have committed so far, and all of them can be removed from the WAL afterwards
+		lock_guard<mutex> checkpoint_guard(database.transaction_manager->checkpoint_lock);
+		// the WAL might have been truncated by another checkpoint in the meantime
+		if (wal.GetWALSize() > (int64_t)database.config.online_checkpoint_wal_size) {
+			// commits only become visible once their flush has been synced: sync the WAL so that the checkpoint
+			// includes the commits that are still waiting for their sync
+			wal.SyncAllFlushes();
+			// transactions that are still running can have deletes or updates in the WAL after the checkpoint that
+			// refer to rows by their row id: keep the deleted rows in the checkpoint so the row ids do not change
+			CheckpointManager checkpointer(*this, true);
+			checkpointer.CreateCheckpoint();
+			// the checkpoint has been written: truncate the WAL
+			wal.Truncate(0);
+			wal.Sync();
+		}
+	} catch (FatalException &ex) {
+		// the database is in an unusable state: no transaction can commit changes anymore
+		lock_guard<mutex> error_guard(checkpoint_error_lock);
+		checkpoint_error = ex.what();
+		checkpoint_error_is_fatal = true;
+	} catch (std::exception &ex) {
+		// the checkpoint failed: the previous checkpoint and the WAL are still intact, so we will try again later
+		lock_guard<mutex> error_guard(checkpoint_error_lock);
+		if (!checkpoint_error_is_fatal) {
+			checkpoint_error = ex.what();
+		}
+	}
+	checkpoint_scheduled = false;
+}
+
+string StorageManager::GetCheckpointError() {
+	lock_guard<mutex> error_guard(checkpoint_error_lock);
+	auto error = checkpoint_error;
+	if (!checkpoint_error_is_fatal) {
+		// the error is only reported once: the next checkpoint is attempted as usual
+		checkpoint_error = string();
+	}
+	return error;
+}
+
 } // namespace duckdb
@@ -518,6 +518,16 @@ void StringSegment::AppendData(BufferHandle &handle, SegmentStatistics &stats, d
 			if (string_length > stats.max_string_length) {
 				stats.max_string_length = string_length;
 			}
+			if (dictionary_entries && total_length < STRING_BLOCK_LIMIT) {
+				// check if the string is already stored in the dictionary of this block
+				auto entry = dictionary_entries->find(string(sdata[source_idx].GetData(), string_length));
+				if (entry != dictionary_entries->end()) {
+					update_min_max_string_segment(sdata[source_idx].GetData(), min, max);
+					result_data[target_idx] = entry->second;
+					remaining_strings--;
+					continue;
+				}
+			}
 			// determine whether or not the string needs to be stored in an overflow block
 			// we never place small strings in the overflow blocks: the pointer would take more space than the
 			// string itself we always place big strings (>= STRING_BLOCK_LIMIT) in the overflow blocks we also have
@@ -551,6 +561,10 @@ void StringSegment::AppendData(BufferHandle &handle, SegmentStatistics &stats, d
 				Store<uint16_t>(string_length, dict_pos);
 				// now write the actual string data into the dictionary
 				memcpy(dict_pos + sizeof(uint16_t), sdata[source_idx].GetData(), string_length + 1);
+				if (dictionary_entries) {
+					dictionary_entries->insert(
+					    make_pair(string(sdata[source_idx].GetData(), string_length), (int32_t)dictionary_offset));
+				}
 			}
 			D_ASSERT(RemainingSpace(handle) <= Storage::BLOCK_SIZE);
 			// place the dictionary offset into the set of vectors
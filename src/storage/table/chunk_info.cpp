@@ -26,6 +26,11 @@ bool ChunkConstantInfo::Fetch(Transaction &transaction, row_t row) {
 	return UseVersion(transaction, insert_id) && !UseVersion(transaction, delete_id);
 }
 
+idx_t ChunkConstantInfo::GetUndeletedSelVector(transaction_t start_time, SelectionVector &sel_vector,
+                                               idx_t max_count) {
+	return delete_id < start_time ? 0 : max_count;
+}
+
 void ChunkConstantInfo::CommitAppend(transaction_t commit_id, idx_t start, idx_t end) {
 	D_ASSERT(start == 0 && end == STANDARD_VECTOR_SIZE);
 	insert_id = commit_id;
@@ -83,6 +88,19 @@ bool ChunkVectorInfo::Fetch(Transaction &transaction, row_t row) {
 	return UseVersion(transaction, inserted[row]) && !UseVersion(transaction, deleted[row]);
 }
 
+idx_t ChunkVectorInfo::GetUndeletedSelVector(transaction_t start_time, SelectionVector &sel_vector, idx_t max_count) {
+	if (!any_deleted) {
+		return max_count;
+	}
+	idx_t count = 0;
+	for (idx_t i = 0; i < max_count; i++) {
+		if (deleted[i] >= start_time) {
+			sel_vector.set_index(count++, i);
+		}
+	}
+	return count;
+}
+
 void ChunkVectorInfo::Delete(Transaction &transaction, row_t rows[], idx_t count) {
 	any_deleted = true;
 
@@ -28,6 +28,17 @@ idx_t MorselInfo::GetSelVector(Transaction &transaction, idx_t vector_idx, Selec
 	return info->GetSelVector(transaction, sel_vector, max_count);
 }
 
+idx_t MorselInfo::GetUndeletedSelVector(transaction_t start_time, idx_t vector_idx, SelectionVector &sel_vector,
+                                        idx_t max_count) {
+	lock_guard<mutex> lock(morsel_lock);
+
+	auto info = GetChunkInfo(vector_idx);
+	if (!info) {
+		return max_count;
+	}
+	return info->GetUndeletedSelVector(start_time, sel_vector, max_count);
+}
+
 bool MorselInfo::Fetch(Transaction &transaction, idx_t row) {
 	D_ASSERT(row < MorselInfo::MORSEL_SIZE);
 	lock_guard<mutex> lock(morsel_lock);
@@ -105,6 +116,42 @@ void MorselInfo::RevertAppend(idx_t morsel_start) {
 	}
 }
 
+void MorselInfo::MarkDeleted(idx_t morsel_start, idx_t count) {
+	idx_t morsel_end = morsel_start + count;
+	lock_guard<mutex> lock(morsel_lock);
+
+	if (!root) {
+		root = make_unique<VersionNode>();
+	}
+	idx_t start_vector_idx = morsel_start / STANDARD_VECTOR_SIZE;
+	idx_t end_vector_idx = (morsel_end - 1) / STANDARD_VECTOR_SIZE;
+	for (idx_t vector_idx = start_vector_idx; vector_idx <= end_vector_idx; vector_idx++) {
+		idx_t start = vector_idx == start_vector_idx ? morsel_start - start_vector_idx * STANDARD_VECTOR_SIZE : 0;
+		idx_t end =
+		    vector_idx == end_vector_idx ? morsel_end - end_vector_idx * STANDARD_VECTOR_SIZE : STANDARD_VECTOR_SIZE;
+		if (start == 0 && end == STANDARD_VECTOR_SIZE) {
+			// the entire vector is deleted: a delete id of 0 hides the rows from every transaction
+			auto constant_info = make_unique<ChunkConstantInfo>(this->start + vector_idx * STANDARD_VECTOR_SIZE, *this);
+			constant_info->delete_id = 0;
+			root->info[vector_idx] = move(constant_info);
+		} else {
+			ChunkVectorInfo *info;
+			if (!root->info[vector_idx]) {
+				auto vector_info = make_unique<ChunkVectorInfo>(this->start + vector_idx * STANDARD_VECTOR_SIZE, *this);
+				info = vector_info.get();
+				root->info[vector_idx] = move(vector_info);
+			} else {
+				D_ASSERT(root->info[vector_idx]->type == ChunkInfoType::VECTOR_INFO);
+				info = (ChunkVectorInfo *)root->info[vector_idx].get();
+			}
+			info->any_deleted = true;
+			for (idx_t i = start; i < end; i++) {
+				info->deleted[i] = 0;
+			}
+		}
+	}
+}
+
 class VersionDeleteState {
 public:
 	VersionDeleteState(MorselInfo &info, Transaction &transaction, DataTable *table, idx_t base_row)
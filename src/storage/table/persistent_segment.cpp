@@ -6,20 +6,26 @@
 #include "duckdb/storage/checkpoint/table_data_writer.hpp"
 #include "duckdb/storage/meta_block_reader.hpp"
 
+#include "duckdb/storage/compressed_segment.hpp"
 #include "duckdb/storage/numeric_segment.hpp"
 #include "duckdb/storage/string_segment.hpp"
 
 namespace duckdb {
 using namespace std;
 
-PersistentSegment::PersistentSegment(BufferManager &manager, block_id_t id, idx_t offset, PhysicalType type,
-                                     idx_t start, idx_t count, data_t stats_min[], data_t stats_max[])
+PersistentSegment::PersistentSegment(BufferManager &manager, block_id_t id, idx_t offset, CompressionType compression,
+                                     PhysicalType type, idx_t start, idx_t count, data_t stats_min[],
+                                     data_t stats_max[])
     : ColumnSegment(type, ColumnSegmentType::PERSISTENT, start, count, stats_min, stats_max), manager(manager),
-      block_id(id), offset(offset) {
-	D_ASSERT(offset == 0);
+      block_id(id), offset(offset), compression(compression) {
+	// only compressed segments share their block with other segments
+	D_ASSERT(offset == 0 || compression != CompressionType::UNCOMPRESSED);
 	if (type == PhysicalType::VARCHAR) {
+		D_ASSERT(compression == CompressionType::UNCOMPRESSED);
 		data = make_unique<StringSegment>(manager, start, id);
 		data->max_vector_count = count / STANDARD_VECTOR_SIZE + (count % STANDARD_VECTOR_SIZE == 0 ? 0 : 1);
+	} else if (compression != CompressionType::UNCOMPRESSED) {
+		data = make_unique<CompressedSegment>(manager, type, start, id, offset, compression);
 	} else {
 		data = make_unique<NumericSegment>(manager, type, start, id);
 	}
@@ -290,7 +290,7 @@ void UncompressedSegment::Select(Transaction &transaction, Vector &result, vecto
 		Scan(transaction, state, state.vector_index, result, false);
 		auto vector_index = state.vector_index;
 		// pin the buffer for this segment
-		auto handle = manager.Pin(block_id);
+		auto handle = manager.Pin(block_id, false, PinHint::USE_ONCE);
 		auto data = handle->node->buffer;
 		auto offset = vector_index * vector_size;
 		auto source_nullmask = (nullmask_t *)(data + offset);
@@ -1,6 +1,7 @@
 #include "duckdb/storage/write_ahead_log.hpp"
 #include "duckdb/storage/data_table.hpp"
 #include "duckdb/common/serializer/buffered_file_reader.hpp"
+#include "duckdb/catalog/catalog_entry/index_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/view_catalog_entry.hpp"
 #include "duckdb/main/client_context.hpp"
@@ -10,47 +11,262 @@
 #include "duckdb/parser/parsed_data/create_schema_info.hpp"
 #include "duckdb/parser/parsed_data/create_table_info.hpp"
 #include "duckdb/parser/parsed_data/create_view_info.hpp"
+#include "duckdb/parser/parser.hpp"
 #include "duckdb/planner/binder.hpp"
+#include "duckdb/planner/operator/logical_create_index.hpp"
+#include "duckdb/execution/column_binding_resolver.hpp"
+#include "duckdb/execution/index/art/art.hpp"
 #include "duckdb/planner/parsed_data/bound_create_table_info.hpp"
 #include "duckdb/common/printer.hpp"
 #include "duckdb/common/string_util.hpp"
+#include "duckdb/common/thread.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "duckdb/storage/table/morsel_info.hpp"
+#include "duckdb/transaction/transaction.hpp"
+
+#include <condition_variable>
+#include <queue>
 
 using namespace std;
 
 namespace duckdb {
+//! A WAL entry that has been read from the WAL file, but that has not been replayed yet
+struct WALEntry {
+	WALType type = WALType::INVALID;
+	//! The info of CREATE and ALTER entries
+	unique_ptr<ParseInfo> info;
+	//! The schema and name of DROP, CREATE_SCHEMA, SEQUENCE_VALUE and USE_TABLE entries; the SQL statement of
+	//! CREATE_INDEX entries is stored in the name
+	string schema;
+	string name;
+	//! The sequence state of SEQUENCE_VALUE entries
+	uint64_t usage_count = 0;
+	int64_t counter = 0;
+	//! The updated column of UPDATE_TUPLE entries
+	column_t column_index = 0;
+	//! The data of INSERT_TUPLE, DELETE_TUPLE and UPDATE_TUPLE entries
+	unique_ptr<DataChunk> chunk;
+};
+
+//! The ReplayReader reads and deserializes the entries of the WAL in a background thread, so that reading the WAL
+//! overlaps with replaying the entries that were read before
+class ReplayReader {
+	//! The maximum amount of entries that are read ahead of the replay
+	static constexpr idx_t MAXIMUM_QUEUED_ENTRIES = 128;
+
+public:
+	ReplayReader(BufferedFileReader &source) : source(source), finished(false), stopped(false) {
+		reader_thread = thread([this]() { ReadEntries(); });
+	}
+	~ReplayReader() {
+		{
+			lock_guard<mutex> guard(lock);
+			stopped = true;
+		}
+		space_available.notify_one();
+		reader_thread.join();
+	}
+
+	//! Returns the next entry of the WAL, throws an exception if the WAL could not be read
+	unique_ptr<WALEntry> Next() {
+		unique_lock<mutex> guard(lock);
+		while (entries.empty() && !finished) {
+			entry_available.wait(guard);
+		}
+		if (entries.empty()) {
+			D_ASSERT(!error.empty());
+			throw Exception(error);
+		}
+		auto entry = move(entries.front());
+		entries.pop();
+		space_available.notify_one();
+		return entry;
+	}
+	//! Returns true if all entries of the WAL have been returned by Next
+	bool Finished() {
+		lock_guard<mutex> guard(lock);
+		return finished && error.empty() && entries.empty();
+	}
+
+private:
+	void ReadEntries() {
+		try {
+			while (true) {
+				auto entry = ReadEntry();
+				bool is_last = entry->type == WALType::WAL_FLUSH && source.Finished();
+				unique_lock<mutex> guard(lock);
+				while (entries.size() >= MAXIMUM_QUEUED_ENTRIES && !stopped) {
+					space_available.wait(guard);
+				}
+				if (stopped) {
+					return;
+				}
+				entries.push(move(entry));
+				if (is_last) {
+					finished = true;
+				}
+				entry_available.notify_one();
+				if (is_last) {
+					return;
+				}
+			}
+		} catch (std::exception &ex) {
+			lock_guard<mutex> guard(lock);
+			error = ex.what();
+			finished = true;
+			entry_available.notify_one();
+		}
+	}
+
+	unique_ptr<WALEntry> ReadEntry();
+
+private:
+	BufferedFileReader &source;
+	thread reader_thread;
+	//! Lock protecting the queue of entries
+	mutex lock;
+	//! Signaled when an entry is added to the queue, or when the reader has finished
+	std::condition_variable entry_available;
+	//! Signaled when an entry is taken from the queue, or when the reader has to stop
+	std::condition_variable space_available;
+	//! The entries that have been read but not returned by Next yet
+	std::queue<unique_ptr<WALEntry>> entries;
+	//! Whether or not the reader has finished reading the WAL
+	bool finished;
+	//! Whether or not the reader has to stop reading (because the replay is done)
+	bool stopped;
+	//! The error that occurred while reading the WAL, if any
+	string error;
+};
+
+//! The appends to a single table that are applied together when the pending appends are flushed
+struct PendingAppend {
+	PendingAppend(DataTable &table) : table(table), count(0), row_start(0), appended(false) {
+	}
+
+	DataTable &table;
+	//! The chunks to append to the table
+	vector<unique_ptr<DataChunk>> chunks;
+	//! The total amount of rows in the chunks
+	idx_t count;
+	//! The row id of the first appended row
+	idx_t row_start;
+	//! Whether or not the rows have been added to the table
+	bool appended;
+};
+
+//! A range of appended rows that still have to be added to the indexes of a table
+struct PendingIndexAppend {
+	DataTable *table;
+	idx_t row_start;
+	idx_t count;
+};
+
+//! Appends the pending chunks of a single table to the base table. The indexes of the table are not updated.
+class ReplayAppendTask : public Task {
+public:
+	ReplayAppendTask(Transaction &transaction, PendingAppend &append) : transaction(transaction), append(append) {
+	}
+
+	void Execute() override {
+		TableAppendState append_state;
+		append.table.InitializeAppend(transaction, append_state, append.count);
+		append.row_start = append_state.row_start;
+		append.appended = true;
+		for (auto &chunk : append.chunks) {
+			append.table.Append(transaction, *chunk, append_state);
+		}
+	}
+
+private:
+	Transaction &transaction;
+	PendingAppend &append;
+};
+
+//! Adds the appended rows of a single table to the indexes of that table
+class ReplayIndexTask : public Task {
+public:
+	ReplayIndexTask(DataTable &table, vector<PendingIndexAppend> appends) : table(table), appends(move(appends)) {
+	}
+
+	void Execute() override {
+		for (auto &append : appends) {
+			if (!table.AppendToIndexes(append.row_start, append.count)) {
+				throw ConstraintException("PRIMARY KEY or UNIQUE constraint violated: duplicated key");
+			}
+		}
+	}
+
+private:
+	DataTable &table;
+	vector<PendingIndexAppend> appends;
+};
+
 class ReplayState {
+	//! The maximum amount of rows that are kept in the pending appends before they are flushed
+	static constexpr idx_t MAXIMUM_PENDING_ROWS = 8 * MorselInfo::MORSEL_SIZE;
+
 public:
-	ReplayState(DuckDB &db, ClientContext &context, Deserializer &source)
-	    : db(db), context(context), source(source), current_table(nullptr) {
+	ReplayState(DuckDB &db, ClientContext &context)
+	    : db(db), context(context), current_table(nullptr), pending_rows(0), committed_index_appends(0) {
+		producer = db.scheduler->CreateProducer();
 	}
 
 	DuckDB &db;
 	ClientContext &context;
-	Deserializer &source;
 	TableCatalogEntry *current_table;
+	//! The error thrown while building the indexes, if any. Unlike other replay errors, this error cannot be undone by
+	//! rolling back the current transaction: the rows of earlier transactions would be missing from the indexes
+	string index_error;
 
 public:
-	void ReplayEntry(WALType entry_type);
+	void ReplayEntry(WALEntry &entry);
+	//! Applies the appends that have been collected so far, the appends to different tables are applied in parallel
+	void FlushAppends();
+	//! Adds the rows appended so far to the indexes of their tables, the indexes of different tables are built in
+	//! parallel
+	void BuildIndexes();
+	//! Called when the current transaction has been committed
+	void Commit();
+	//! Called when the current transaction has been rolled back
+	void Rollback();
 
 private:
-	void ReplayCreateTable();
-	void ReplayDropTable();
-	void ReplayAlter();
+	void ReplayCreateTable(WALEntry &entry);
+	void ReplayDropTable(WALEntry &entry);
+	void ReplayAlter(WALEntry &entry);
+
+	void ReplayCreateView(WALEntry &entry);
+	void ReplayDropView(WALEntry &entry);
 
-	void ReplayCreateView();
-	void ReplayDropView();
+	void ReplayCreateSchema(WALEntry &entry);
+	void ReplayDropSchema(WALEntry &entry);
 
-	void ReplayCreateSchema();
-	void ReplayDropSchema();
+	void ReplayCreateSequence(WALEntry &entry);
+	void ReplayDropSequence(WALEntry &entry);
+	void ReplaySequenceValue(WALEntry &entry);
 
-	void ReplayCreateSequence();
-	void ReplayDropSequence();
-	void ReplaySequenceValue();
+	void ReplayCreateIndex(WALEntry &entry);
+	void ReplayDropIndex(WALEntry &entry);
 
-	void ReplayUseTable();
-	void ReplayInsert();
-	void ReplayDelete();
-	void ReplayUpdate();
+	void ReplayUseTable(WALEntry &entry);
+	void ReplayInsert(WALEntry &entry);
+	void ReplayDelete(WALEntry &entry);
+	void ReplayUpdate(WALEntry &entry);
+
+private:
+	unique_ptr<ProducerToken> producer;
+	//! The appends that have not been applied yet, in the order in which their tables were first appended to
+	vector<unique_ptr<PendingAppend>> pending_appends;
+	//! Maps the tables to their entry in the pending appends
+	unordered_map<DataTable *, PendingAppend *> pending_tables;
+	//! The amount of rows in the pending appends
+	idx_t pending_rows;
+	//! The appended rows that have not been added to the indexes of their tables yet
+	vector<PendingIndexAppend> index_appends;
+	//! The amount of index appends that belong to committed transactions
+	idx_t committed_index_appends;
 };
 
 void WriteAheadLog::Replay(DuckDB &database, string &path) {
@@ -65,22 +281,36 @@ void WriteAheadLog::Replay(DuckDB &database, string &path) {
 	context.transaction.SetAutoCommit(false);
 	context.transaction.BeginTransaction();
 
-	ReplayState state(database, context, reader);
+	// the scheduler has no background threads yet while the database is being opened: launch threads that apply the
+	// entries of the WAL in parallel for the duration of the replay
+	auto &scheduler = *database.scheduler;
+	auto previous_threads = scheduler.NumberOfThreads();
+	auto replay_threads = database.config.wal_replay_threads;
+	if (replay_threads == 0) {
+		replay_threads = MaxValue<idx_t>(thread::hardware_concurrency(), 1);
+	}
+	scheduler.SetThreads(replay_threads);
+
+	ReplayState state(database, context);
 
 	// replay the WAL
 	// note that everything is wrapped inside a try/catch block here
 	// there can be errors in WAL replay because of a corrupt WAL file
 	// in this case we should throw a warning but startup anyway
 	try {
+		// the entries are read and deserialized by a background thread while they are being replayed
+		ReplayReader entries(reader);
 		while (true) {
-			// read the current entry
-			WALType entry_type = reader.Read<WALType>();
-			if (entry_type == WALType::WAL_FLUSH) {
+			// fetch the next entry
+			auto entry = entries.Next();
+			if (entry->type == WALType::WAL_FLUSH) {
 				// flush: commit the current transaction
+				state.FlushAppends();
 				context.transaction.Commit();
 				context.transaction.SetAutoCommit(false);
+				state.Commit();
 				// check if the file is exhausted
-				if (reader.Finished()) {
+				if (entries.Finished()) {
 					// we finished reading the file: break
 					break;
 				}
@@ -88,7 +318,7 @@ void WriteAheadLog::Replay(DuckDB &database, string &path) {
 				context.transaction.BeginTransaction();
 			} else {
 				// replay the entry
-				state.ReplayEntry(entry_type);
+				state.ReplayEntry(*entry);
 			}
 		}
 	} catch (std::exception &ex) {
@@ -96,55 +326,213 @@ void WriteAheadLog::Replay(DuckDB &database, string &path) {
 		Printer::Print(StringUtil::Format("Exception in WAL playback: %s\n", ex.what()));
 		// exception thrown in WAL replay: rollback
 		context.transaction.Rollback();
+		state.Rollback();
+	}
+	// the indexes are built in bulk for all rows that were appended by the replay
+	try {
+		state.BuildIndexes();
+	} catch (std::exception &ex) {
+		// the error has been recorded in the index_error
+	}
+	scheduler.SetThreads(previous_threads);
+	if (!state.index_error.empty()) {
+		// the indexes do not match the committed data: the database cannot be opened
+		throw Exception("Failed to build the indexes during WAL replay: " + state.index_error);
+	}
+}
+
+void ReplayState::FlushAppends() {
+	if (pending_appends.empty()) {
+		return;
+	}
+	auto &transaction = Transaction::GetTransaction(context);
+	vector<unique_ptr<Task>> tasks;
+	for (auto &append : pending_appends) {
+		tasks.push_back(make_unique<ReplayAppendTask>(transaction, *append));
+	}
+	string error;
+	try {
+		db.scheduler->ExecuteTasks(*producer, move(tasks));
+	} catch (std::exception &ex) {
+		error = ex.what();
+	}
+	// register the appends with the transaction, so they are committed or reverted together with it
+	for (auto &append : pending_appends) {
+		if (!append->appended) {
+			continue;
+		}
+		transaction.PushAppend(&append->table, append->row_start, append->count);
+		if (append->table.info->indexes.size() > 0) {
+			index_appends.push_back(PendingIndexAppend{&append->table, append->row_start, append->count});
+		}
+	}
+	pending_appends.clear();
+	pending_tables.clear();
+	pending_rows = 0;
+	if (!error.empty()) {
+		throw Exception(error);
 	}
 }
 
+void ReplayState::BuildIndexes() {
+	if (index_appends.empty()) {
+		return;
+	}
+	// group the appended ranges by table
+	vector<DataTable *> tables;
+	unordered_map<DataTable *, vector<PendingIndexAppend>> table_appends;
+	for (auto &append : index_appends) {
+		auto &appends = table_appends[append.table];
+		if (appends.empty()) {
+			tables.push_back(append.table);
+		}
+		appends.push_back(append);
+	}
+	index_appends.clear();
+	committed_index_appends = 0;
+
+	vector<unique_ptr<Task>> tasks;
+	for (auto &table : tables) {
+		tasks.push_back(make_unique<ReplayIndexTask>(*table, move(table_appends[table])));
+	}
+	try {
+		db.scheduler->ExecuteTasks(*producer, move(tasks));
+	} catch (std::exception &ex) {
+		index_error = ex.what();
+		throw;
+	}
+}
+
+void ReplayState::Commit() {
+	committed_index_appends = index_appends.size();
+}
+
+void ReplayState::Rollback() {
+	// the appends of the transaction have been reverted: they do not have to be added to the indexes
+	pending_appends.clear();
+	pending_tables.clear();
+	pending_rows = 0;
+	index_appends.erase(index_appends.begin() + committed_index_appends, index_appends.end());
+}
+
+//===--------------------------------------------------------------------===//
+// Read Entries
+//===--------------------------------------------------------------------===//
+unique_ptr<WALEntry> ReplayReader::ReadEntry() {
+	auto entry = make_unique<WALEntry>();
+	entry->type = source.Read<WALType>();
+	switch (entry->type) {
+	case WALType::CREATE_TABLE:
+		entry->info = TableCatalogEntry::Deserialize(source);
+		break;
+	case WALType::CREATE_VIEW:
+		entry->info = ViewCatalogEntry::Deserialize(source);
+		break;
+	case WALType::CREATE_SEQUENCE:
+		entry->info = SequenceCatalogEntry::Deserialize(source);
+		break;
+	case WALType::ALTER_INFO:
+		entry->info = AlterInfo::Deserialize(source);
+		break;
+	case WALType::CREATE_SCHEMA:
+	case WALType::DROP_SCHEMA:
+		entry->name = source.Read<string>();
+		break;
+	case WALType::CREATE_INDEX:
+		entry->name = source.Read<string>();
+		break;
+	case WALType::DROP_TABLE:
+	case WALType::DROP_VIEW:
+	case WALType::DROP_SEQUENCE:
+	case WALType::DROP_INDEX:
+	case WALType::USE_TABLE:
+		entry->schema = source.Read<string>();
+		entry->name = source.Read<string>();
+		break;
+	case WALType::SEQUENCE_VALUE:
+		entry->schema = source.Read<string>();
+		entry->name = source.Read<string>();
+		entry->usage_count = source.Read<uint64_t>();
+		entry->counter = source.Read<int64_t>();
+		break;
+	case WALType::INSERT_TUPLE:
+	case WALType::DELETE_TUPLE:
+		entry->chunk = make_unique<DataChunk>();
+		entry->chunk->Deserialize(source);
+		break;
+	case WALType::UPDATE_TUPLE:
+		entry->column_index = source.Read<column_t>();
+		entry->chunk = make_unique<DataChunk>();
+		entry->chunk->Deserialize(source);
+		break;
+	case WALType::WAL_FLUSH:
+		break;
+	default:
+		throw Exception("Invalid WAL entry type!");
+	}
+	return entry;
+}
+
 //===--------------------------------------------------------------------===//
 // Replay Entries
 //===--------------------------------------------------------------------===//
-void ReplayState::ReplayEntry(WALType entry_type) {
-	switch (entry_type) {
+void ReplayState::ReplayEntry(WALEntry &entry) {
+	if (entry.type != WALType::INSERT_TUPLE && entry.type != WALType::USE_TABLE) {
+		// the entry might depend on the appended rows: apply the pending appends first
+		FlushAppends();
+		if (entry.type != WALType::SEQUENCE_VALUE) {
+			// deletes, updates and catalog changes might also depend on the indexes
+			BuildIndexes();
+		}
+	}
+	switch (entry.type) {
 	case WALType::CREATE_TABLE:
-		ReplayCreateTable();
+		ReplayCreateTable(entry);
 		break;
 	case WALType::DROP_TABLE:
-		ReplayDropTable();
+		ReplayDropTable(entry);
 		break;
 	case WALType::ALTER_INFO:
-		ReplayAlter();
+		ReplayAlter(entry);
 		break;
 	case WALType::CREATE_VIEW:
-		ReplayCreateView();
+		ReplayCreateView(entry);
 		break;
 	case WALType::DROP_VIEW:
-		ReplayDropView();
+		ReplayDropView(entry);
 		break;
 	case WALType::CREATE_SCHEMA:
-		ReplayCreateSchema();
+		ReplayCreateSchema(entry);
 		break;
 	case WALType::DROP_SCHEMA:
-		ReplayDropSchema();
+		ReplayDropSchema(entry);
 		break;
 	case WALType::CREATE_SEQUENCE:
-		ReplayCreateSequence();
+		ReplayCreateSequence(entry);
 		break;
 	case WALType::DROP_SEQUENCE:
-		ReplayDropSequence();
+		ReplayDropSequence(entry);
 		break;
 	case WALType::SEQUENCE_VALUE:
-		ReplaySequenceValue();
+		ReplaySequenceValue(entry);
+		break;
+	case WALType::CREATE_INDEX:
+		ReplayCreateIndex(entry);
+		break;
+	case WALType::DROP_INDEX:
+		ReplayDropIndex(entry);
 		break;
 	case WALType::USE_TABLE:
-		ReplayUseTable();
+		ReplayUseTable(entry);
 		break;
 	case WALType::INSERT_TUPLE:
-		ReplayInsert();
+		ReplayInsert(entry);
 		break;
 	case WALType::DELETE_TUPLE:
-		ReplayDelete();
+		ReplayDelete(entry);
 		break;
 	case WALType::UPDATE_TUPLE:
-		ReplayUpdate();
+		ReplayUpdate(entry);
 		break;
 	default:
 		throw Exception("Invalid WAL entry type!");
@@ -154,8 +542,8 @@ void ReplayState::ReplayEntry(WALType entry_type) {
 //===--------------------------------------------------------------------===//
 // Replay Table
 //===--------------------------------------------------------------------===//
-void ReplayState::ReplayCreateTable() {
-	auto info = TableCatalogEntry::Deserialize(source);
+void ReplayState::ReplayCreateTable(WALEntry &entry) {
+	auto info = unique_ptr<CreateInfo>((CreateInfo *)entry.info.release());
 
 	// bind the constraints to the table again
 	Binder binder(context);
@@ -164,53 +552,50 @@ void ReplayState::ReplayCreateTable() {
 	db.catalog->CreateTable(context, bound_info.get());
 }
 
-void ReplayState::ReplayDropTable() {
+void ReplayState::ReplayDropTable(WALEntry &entry) {
 	DropInfo info;
 
 	info.type = CatalogType::TABLE_ENTRY;
-	info.schema = source.Read<string>();
-	info.name = source.Read<string>();
+	info.schema = entry.schema;
+	info.name = entry.name;
 
 	db.catalog->DropEntry(context, &info);
 }
 
-void ReplayState::ReplayAlter() {
-	auto info = AlterInfo::Deserialize(source);
-	db.catalog->Alter(context, info.get());
+void ReplayState::ReplayAlter(WALEntry &entry) {
+	db.catalog->Alter(context, (AlterInfo *)entry.info.get());
 }
 
 //===--------------------------------------------------------------------===//
 // Replay View
 //===--------------------------------------------------------------------===//
-void ReplayState::ReplayCreateView() {
-	auto entry = ViewCatalogEntry::Deserialize(source);
-
-	db.catalog->CreateView(context, entry.get());
+void ReplayState::ReplayCreateView(WALEntry &entry) {
+	db.catalog->CreateView(context, (CreateViewInfo *)entry.info.get());
 }
 
-void ReplayState::ReplayDropView() {
+void ReplayState::ReplayDropView(WALEntry &entry) {
 	DropInfo info;
 	info.type = CatalogType::VIEW_ENTRY;
-	info.schema = source.Read<string>();
-	info.name = source.Read<string>();
+	info.schema = entry.schema;
+	info.name = entry.name;
 	db.catalog->DropEntry(context, &info);
 }
 
 //===--------------------------------------------------------------------===//
 // Replay Schema
 //===--------------------------------------------------------------------===//
-void ReplayState::ReplayCreateSchema() {
+void ReplayState::ReplayCreateSchema(WALEntry &entry) {
 	CreateSchemaInfo info;
-	info.schema = source.Read<string>();
+	info.schema = entry.name;
 
 	db.catalog->CreateSchema(context, &info);
 }
 
-void ReplayState::ReplayDropSchema() {
+void ReplayState::ReplayDropSchema(WALEntry &entry) {
 	DropInfo info;
 
 	info.type = CatalogType::SCHEMA_ENTRY;
-	info.name = source.Read<string>();
+	info.name = entry.name;
 
 	db.catalog->DropEntry(context, &info);
 }
@@ -218,61 +603,112 @@ void ReplayState::ReplayDropSchema() {
 //===--------------------------------------------------------------------===//
 // Replay Sequence
 //===--------------------------------------------------------------------===//
-void ReplayState::ReplayCreateSequence() {
-	auto entry = SequenceCatalogEntry::Deserialize(source);
-
-	db.catalog->CreateSequence(context, entry.get());
+void ReplayState::ReplayCreateSequence(WALEntry &entry) {
+	db.catalog->CreateSequence(context, (CreateSequenceInfo *)entry.info.get());
 }
 
-void ReplayState::ReplayDropSequence() {
+void ReplayState::ReplayDropSequence(WALEntry &entry) {
 	DropInfo info;
 	info.type = CatalogType::SEQUENCE_ENTRY;
-	info.schema = source.Read<string>();
-	info.name = source.Read<string>();
+	info.schema = entry.schema;
+	info.name = entry.name;
 
 	db.catalog->DropEntry(context, &info);
 }
 
-void ReplayState::ReplaySequenceValue() {
-	auto schema = source.Read<string>();
-	auto name = source.Read<string>();
-	auto usage_count = source.Read<uint64_t>();
-	auto counter = source.Read<int64_t>();
-
+void ReplayState::ReplaySequenceValue(WALEntry &entry) {
 	// fetch the sequence from the catalog
-	auto seq = db.catalog->GetEntry<SequenceCatalogEntry>(context, schema, name);
-	if (usage_count > seq->usage_count) {
-		seq->usage_count = usage_count;
-		seq->counter = counter;
+	auto seq = db.catalog->GetEntry<SequenceCatalogEntry>(context, entry.schema, entry.name);
+	if (entry.usage_count > seq->usage_count) {
+		seq->usage_count = entry.usage_count;
+		seq->counter = entry.counter;
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Replay Index
+//===--------------------------------------------------------------------===//
+void ReplayState::ReplayCreateIndex(WALEntry &entry) {
+	// bind the CREATE INDEX statement to find the table and the expressions of the index
+	Parser parser;
+	parser.ParseQuery(entry.name);
+	if (parser.statements.size() != 1 || parser.statements[0]->type != StatementType::CREATE_STATEMENT) {
+		throw Exception("Corrupt WAL: expected a CREATE INDEX statement");
 	}
+	Binder binder(context);
+	auto bound_statement = binder.Bind(*parser.statements[0]);
+	if (bound_statement.plan->type != LogicalOperatorType::CREATE_INDEX) {
+		throw Exception("Corrupt WAL: expected a CREATE INDEX statement");
+	}
+	ColumnBindingResolver resolver;
+	resolver.VisitOperator(*bound_statement.plan);
+	auto &create_index = (LogicalCreateIndex &)*bound_statement.plan;
+	auto &table = create_index.table;
+	auto index_entry = (IndexCatalogEntry *)table.schema->CreateIndex(context, create_index.info.get(), &table);
+
+	// build the index from the data of the table
+	auto art = make_unique<ART>(create_index.column_ids, move(create_index.unbound_expressions),
+	                            create_index.info->unique);
+	index_entry->index = art.get();
+	index_entry->info = table.storage->info;
+	table.storage->AddIndex(move(art), create_index.expressions);
+}
+
+void ReplayState::ReplayDropIndex(WALEntry &entry) {
+	DropInfo info;
+	info.type = CatalogType::INDEX_ENTRY;
+	info.schema = entry.schema;
+	info.name = entry.name;
+
+	db.catalog->DropEntry(context, &info);
 }
 
 //===--------------------------------------------------------------------===//
 // Replay Data
 //===--------------------------------------------------------------------===//
-void ReplayState::ReplayUseTable() {
-	auto schema_name = source.Read<string>();
-	auto table_name = source.Read<string>();
-	current_table = db.catalog->GetEntry<TableCatalogEntry>(context, schema_name, table_name);
+void ReplayState::ReplayUseTable(WALEntry &entry) {
+	current_table = db.catalog->GetEntry<TableCatalogEntry>(context, entry.schema, entry.name);
 }
 
-void ReplayState::ReplayInsert() {
+void ReplayState::ReplayInsert(WALEntry &entry) {
 	if (!current_table) {
 		throw Exception("Corrupt WAL: insert without table");
 	}
-	DataChunk chunk;
-	chunk.Deserialize(source);
-
-	// append to the current table
-	current_table->storage->Append(*current_table, context, chunk);
+	auto &chunk = *entry.chunk;
+	if (chunk.size() == 0) {
+		return;
+	}
+	if (chunk.column_count() != current_table->columns.size()) {
+		throw CatalogException("Mismatch in column count for append");
+	}
+	chunk.Verify();
+
+	// the rows are not appended right away: the appends to the different tables are collected, so that they can be
+	// applied in parallel. the constraints are not verified again, they were verified when the rows were committed.
+	auto table = current_table->storage.get();
+	auto entry_ptr = pending_tables.find(table);
+	PendingAppend *append;
+	if (entry_ptr == pending_tables.end()) {
+		auto new_append = make_unique<PendingAppend>(*table);
+		append = new_append.get();
+		pending_tables[table] = append;
+		pending_appends.push_back(move(new_append));
+	} else {
+		append = entry_ptr->second;
+	}
+	append->count += chunk.size();
+	append->chunks.push_back(move(entry.chunk));
+	pending_rows += append->chunks.back()->size();
+	if (pending_rows >= MAXIMUM_PENDING_ROWS) {
+		FlushAppends();
+	}
 }
 
-void ReplayState::ReplayDelete() {
+void ReplayState::ReplayDelete(WALEntry &entry) {
 	if (!current_table) {
 		throw Exception("Corrupt WAL: delete without table");
 	}
-	DataChunk chunk;
-	chunk.Deserialize(source);
+	auto &chunk = *entry.chunk;
 
 	D_ASSERT(chunk.column_count() == 1 && chunk.data[0].type == LOGICAL_ROW_TYPE);
 	row_t row_ids[1];
@@ -286,15 +722,13 @@ void ReplayState::ReplayDelete() {
 	}
 }
 
-void ReplayState::ReplayUpdate() {
+void ReplayState::ReplayUpdate(WALEntry &entry) {
 	if (!current_table) {
 		throw Exception("Corrupt WAL: update without table");
 	}
 
-	idx_t column_index = source.Read<column_t>();
-
-	DataChunk chunk;
-	chunk.Deserialize(source);
+	idx_t column_index = entry.column_index;
+	auto &chunk = *entry.chunk;
 
 	vector<column_t> column_ids{column_index};
 	if (column_index >= current_table->columns.size()) {
@@ -1,15 +1,18 @@
 #include "duckdb/storage/write_ahead_log.hpp"
 #include "duckdb/main/database.hpp"
+#include "duckdb/catalog/catalog_entry/index_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/view_catalog_entry.hpp"
 #include "duckdb/parser/parsed_data/alter_table_info.hpp"
 #include <cstring>
+#include <thread>
 
 namespace duckdb {
 using namespace std;
 
-WriteAheadLog::WriteAheadLog(DuckDB &database) : initialized(false), database(database) {
+WriteAheadLog::WriteAheadLog(DuckDB &database)
+    : initialized(false), database(database), last_flush_id(0), synced_flush_id(0), sync_in_progress(false) {
 }
 
 void WriteAheadLog::Initialize(string &path) {
@@ -76,6 +79,21 @@ void WriteAheadLog::WriteSequenceValue(SequenceCatalogEntry *entry, SequenceValu
 	writer->Write<int64_t>(val.counter);
 }
 
+//===--------------------------------------------------------------------===//
+// INDEXES
+//===--------------------------------------------------------------------===//
+void WriteAheadLog::WriteCreateIndex(IndexCatalogEntry *entry) {
+	// the index is recreated from its CREATE INDEX statement
+	writer->Write<WALType>(WALType::CREATE_INDEX);
+	writer->WriteString(entry->ToSQL());
+}
+
+void WriteAheadLog::WriteDropIndex(IndexCatalogEntry *entry) {
+	writer->Write<WALType>(WALType::DROP_INDEX);
+	writer->WriteString(entry->schema->name);
+	writer->WriteString(entry->name);
+}
+
 //===--------------------------------------------------------------------===//
 // VIEWS
 //===--------------------------------------------------------------------===//
@@ -151,4 +169,64 @@ void WriteAheadLog::Flush() {
 	writer->Sync();
 }
 
+void WriteAheadLog::Sync() {
+	writer->Sync();
+}
+
+idx_t WriteAheadLog::FlushWithoutSync() {
+	// write an empty entry
+	writer->Write<WALType>(WALType::WAL_FLUSH);
+	// write the buffered entries to the file, the sync happens in SyncFlush
+	writer->Flush();
+	return ++last_flush_id;
+}
+
+void WriteAheadLog::SyncFlush(idx_t flush_id, idx_t commit_delay) {
+	std::unique_lock<mutex> lock(sync_lock);
+	while (synced_flush_id < flush_id) {
+		if (!sync_error.empty()) {
+			throw FatalException("Failed to sync the write-ahead log: %s", sync_error);
+		}
+		if (sync_in_progress) {
+			// another committer is syncing the WAL: wait for it to finish, the sync might include our flush
+			sync_finished.wait(lock);
+			continue;
+		}
+		// no sync is in progress: this committer becomes the leader
+		sync_in_progress = true;
+		lock.unlock();
+		if (commit_delay > 0) {
+			// give concurrent committers the chance to write their entries, so they are included in this sync
+			std::this_thread::sleep_for(std::chrono::microseconds(commit_delay));
+		}
+		// every flush up to this point has been written to the file, and is made durable by the sync
+		idx_t sync_target = last_flush_id;
+		string error;
+		try {
+			writer->handle->Sync();
+		} catch (std::exception &ex) {
+			error = ex.what();
+		}
+		lock.lock();
+		sync_in_progress = false;
+		if (error.empty()) {
+			synced_flush_id = MaxValue<idx_t>(synced_flush_id, sync_target);
+		} else {
+			sync_error = error;
+		}
+		// wake up the waiting committers: either their flush is now durable, one of them becomes the next leader, or
+		// the sync has failed
+		sync_finished.notify_all();
+	}
+}
+
+void WriteAheadLog::SyncAllFlushes() {
+	SyncFlush(last_flush_id, 0);
+}
+
+idx_t WriteAheadLog::GetSyncedFlushId() {
+	lock_guard<mutex> lock(sync_lock);
+	return synced_flush_id;
+}
+
 } // namespace duckdb
@@ -3,6 +3,7 @@
 #include "duckdb/transaction/delete_info.hpp"
 #include "duckdb/transaction/update_info.hpp"
 
+#include "duckdb/catalog/catalog_entry/index_catalog_entry.hpp"
 #include "duckdb/storage/data_table.hpp"
 #include "duckdb/storage/write_ahead_log.hpp"
 #include "duckdb/storage/uncompressed_segment.hpp"
@@ -27,6 +28,11 @@ void CommitState::SwitchTable(DataTableInfo *table_info, UndoFlags new_op) {
 	}
 }
 
+//! Indexes of temporary tables are not written to the WAL
+static bool IsTemporaryIndex(IndexCatalogEntry *index) {
+	return index->info && index->info->IsTemporary();
+}
+
 void CommitState::WriteCatalogEntry(CatalogEntry *entry, data_ptr_t dataptr) {
 	if (entry->temporary || entry->parent->temporary) {
 		return;
@@ -74,6 +80,12 @@ void CommitState::WriteCatalogEntry(CatalogEntry *entry, data_ptr_t dataptr) {
 	case CatalogType::SEQUENCE_ENTRY:
 		log->WriteCreateSequence((SequenceCatalogEntry *)parent);
 		break;
+	case CatalogType::INDEX_ENTRY:
+		if (IsTemporaryIndex((IndexCatalogEntry *)parent)) {
+			return;
+		}
+		log->WriteCreateIndex((IndexCatalogEntry *)parent);
+		break;
 	case CatalogType::DELETED_ENTRY:
 		if (entry->type == CatalogType::TABLE_ENTRY) {
 			log->WriteDropTable((TableCatalogEntry *)entry);
@@ -83,6 +95,11 @@ void CommitState::WriteCatalogEntry(CatalogEntry *entry, data_ptr_t dataptr) {
 			log->WriteDropView((ViewCatalogEntry *)entry);
 		} else if (entry->type == CatalogType::SEQUENCE_ENTRY) {
 			log->WriteDropSequence((SequenceCatalogEntry *)entry);
+		} else if (entry->type == CatalogType::INDEX_ENTRY) {
+			if (IsTemporaryIndex((IndexCatalogEntry *)entry)) {
+				return;
+			}
+			log->WriteDropIndex((IndexCatalogEntry *)entry);
 		} else if (entry->type == CatalogType::PREPARED_STATEMENT) {
 			// do nothing, we log the query to drop this
 		} else {
@@ -90,7 +107,6 @@ void CommitState::WriteCatalogEntry(CatalogEntry *entry, data_ptr_t dataptr) {
 		}
 		break;
 
-	case CatalogType::INDEX_ENTRY:
 	case CatalogType::PREPARED_STATEMENT:
 	case CatalogType::AGGREGATE_FUNCTION_ENTRY:
 	case CatalogType::SCALAR_FUNCTION_ENTRY:
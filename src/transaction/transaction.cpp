@@ -67,6 +67,10 @@ UpdateInfo *Transaction::CreateUpdateInfo(idx_t type_size, idx_t entries) {
 	return update_info;
 }
 
+bool Transaction::ChangesMade() {
+	return undo_buffer.ChangesMade() || storage.ChangesMade() || sequence_usage.size() > 0;
+}
+
 string Transaction::Commit(WriteAheadLog *log, transaction_t commit_id) noexcept {
 	this->commit_id = commit_id;
 
@@ -76,7 +80,7 @@ string Transaction::Commit(WriteAheadLog *log, transaction_t commit_id) noexcept
 	if (log) {
 		initial_wal_size = log->GetWALSize();
 	}
-	bool changes_made = undo_buffer.ChangesMade() || storage.ChangesMade() || sequence_usage.size() > 0;
+	bool changes_made = ChangesMade();
 	try {
 		// commit the undo buffer
 		storage.Commit(commit_state, *this, log, commit_id);
@@ -86,9 +90,10 @@ string Transaction::Commit(WriteAheadLog *log, transaction_t commit_id) noexcept
 			for (auto &entry : sequence_usage) {
 				log->WriteSequenceValue(entry.first, entry.second);
 			}
-			// flush the WAL
+			// write the changes to the WAL file: the WAL is synced after the transaction lock is released, so the sync
+			// can be shared with other committers (see TransactionManager::CommitTransaction)
 			if (changes_made) {
-				log->Flush();
+				wal_flush_id = log->FlushWithoutSync();
 			}
 		}
 		return string();
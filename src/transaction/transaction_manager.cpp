@@ -6,6 +6,7 @@
 #include "duckdb/common/types/timestamp.hpp"
 #include "duckdb/catalog/catalog.hpp"
 #include "duckdb/catalog/dependency_manager.hpp"
+#include "duckdb/main/database.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/transaction/transaction.hpp"
 
@@ -37,7 +38,13 @@ Transaction *TransactionManager::StartTransaction() {
 	}
 
 	// obtain the start time and transaction ID of this transaction
+	// commits become visible once their WAL flush has been synced: if there are commits that are still waiting for
+	// their sync, the transaction starts right before the first of them
+	PublishSyncedCommits();
 	transaction_t start_time = current_start_timestamp++;
+	if (!pending_commits.empty()) {
+		start_time = pending_commits[0].start_time;
+	}
 	transaction_t transaction_id = current_transaction_id++;
 	timestamp_t start_timestamp = Timestamp::GetCurrentTimestamp();
 
@@ -51,25 +58,97 @@ Transaction *TransactionManager::StartTransaction() {
 }
 
 string TransactionManager::CommitTransaction(Transaction *transaction) {
-	// obtain the transaction lock during this function
-	lock_guard<mutex> lock(transaction_lock);
+	string error;
+	idx_t wal_flush_id;
+	{
+		// transactions that made changes cannot commit while a checkpoint is running
+		std::unique_lock<mutex> checkpoint_guard(checkpoint_lock, std::defer_lock);
+		bool changes_made = transaction->ChangesMade();
+		if (changes_made) {
+			checkpoint_guard.lock();
+			// an online checkpoint that failed in the background is reported to the next transaction that commits
+			// changes
+			auto checkpoint_error = storage.GetCheckpointError();
+			if (!checkpoint_error.empty()) {
+				lock_guard<mutex> lock(transaction_lock);
+				transaction->Rollback();
+				RemoveTransaction(transaction);
+				return "Failed to commit: checkpoint of the database failed: " + checkpoint_error;
+			}
+		}
+		// obtain the transaction lock while committing the transaction
+		lock_guard<mutex> lock(transaction_lock);
 
-	// obtain a commit id for the transaction
-	transaction_t commit_id = current_start_timestamp++;
-	// commit the UndoBuffer of the transaction
-	string error = transaction->Commit(storage.GetWriteAheadLog(), commit_id);
-	if (!error.empty()) {
-		// commit unsuccessful: rollback the transaction instead
-		transaction->commit_id = 0;
-		transaction->Rollback();
-	}
+		// obtain a commit id for the transaction, preceded by a timestamp that can be used as the start time of
+		// transactions that should not see the commit until it has been synced
+		transaction_t pending_start_time = current_start_timestamp++;
+		transaction_t commit_id = current_start_timestamp++;
+		// commit the UndoBuffer of the transaction
+		error = transaction->Commit(storage.GetWriteAheadLog(), commit_id);
+		if (!error.empty()) {
+			// commit unsuccessful: rollback the transaction instead
+			transaction->commit_id = 0;
+			transaction->Rollback();
+		}
+		wal_flush_id = transaction->wal_flush_id;
+		PublishSyncedCommits();
+		if (error.empty() && wal_flush_id == 0 && changes_made && !pending_commits.empty()) {
+			// the commit did not write to the WAL (e.g. it only changed temporary tables), but new transactions start
+			// before the pending commits and would not see it: it is published together with the last of them
+			wal_flush_id = pending_commits.back().wal_flush_id;
+		}
+		if (error.empty() && wal_flush_id > 0) {
+			// the commit is not visible to new transactions until its flush has been synced
+			pending_commits.push_back(PendingCommit {wal_flush_id, pending_start_time});
+		}
 
-	// commit successful: remove the transaction id from the list of active transactions
-	// potentially resulting in garbage collection
-	RemoveTransaction(transaction);
+		// commit successful: remove the transaction id from the list of active transactions
+		// potentially resulting in garbage collection
+		RemoveTransaction(transaction);
+	}
+	if (error.empty() && wal_flush_id > 0) {
+		// the changes have been written to the WAL, but not yet synced to disk
+		// we wait for the sync outside of the transaction lock: this allows concurrent committers to write their
+		// changes in the meantime, and have them synced together with a single fsync (group commit)
+		// if the sync fails, the commit (and every later commit) is never published: the WAL is then in an unknown
+		// state, and every subsequent sync fails as well
+		try {
+			auto &config = storage.GetDatabase().config;
+			storage.GetWriteAheadLog()->SyncFlush(wal_flush_id, config.commit_delay);
+		} catch (std::exception &ex) {
+			return ex.what();
+		}
+		// checkpoint the database if the WAL has become too large
+		storage.CheckpointIfNeeded();
+	}
 	return error;
 }
 
+void TransactionManager::PublishSyncedCommits() {
+	if (pending_commits.empty()) {
+		return;
+	}
+	// the flushes are synced in order: the commits up to the last synced flush can all be published
+	auto synced_flush_id = storage.GetWriteAheadLog()->GetSyncedFlushId();
+	idx_t published = 0;
+	while (published < pending_commits.size() && pending_commits[published].wal_flush_id <= synced_flush_id) {
+		published++;
+	}
+	pending_commits.erase(pending_commits.begin(), pending_commits.begin() + published);
+}
+
+transaction_t TransactionManager::LowestActiveStart() {
+	lock_guard<mutex> lock(transaction_lock);
+	transaction_t lowest_start_time = current_start_timestamp;
+	for (auto &transaction : active_transactions) {
+		lowest_start_time = MinValue(lowest_start_time, transaction->start_time);
+	}
+	if (!pending_commits.empty()) {
+		lowest_start_time = MinValue(lowest_start_time, pending_commits[0].start_time);
+	}
+	return lowest_start_time;
+}
+
 void TransactionManager::RollbackTransaction(Transaction *transaction) {
 	// obtain the transaction lock during this function
 	lock_guard<mutex> lock(transaction_lock);
@@ -96,6 +175,10 @@ void TransactionManager::RemoveTransaction(Transaction *transaction) noexcept {
 			lowest_active_query = MinValue(lowest_active_query, active_transactions[i]->active_query);
 		}
 	}
+	if (!pending_commits.empty()) {
+		// transactions that start while the commits are pending still read the versions from before the commits
+		lowest_start_time = MinValue(lowest_start_time, pending_commits[0].start_time);
+	}
 	transaction_t lowest_stored_query = lowest_start_time;
 	D_ASSERT(t_index != active_transactions.size());
 	auto current_transaction = move(active_transactions[t_index]);
@@ -222,3 +222,100 @@ TEST_CASE("Modifying the buffer manager limit at runtime for an in-memory databa
 	REQUIRE_NO_FAIL(con.Query("DROP TABLE test"));
 	REQUIRE_NO_FAIL(con.Query("PRAGMA memory_limit='1MB'"));
 }
+
+static int64_t BufferManagerMisses(Connection &con) {
+	auto result = con.Query("SELECT misses FROM pragma_buffer_manager_stats()");
+	REQUIRE(result->success);
+	return result->GetValue(0, 0).GetValue<int64_t>();
+}
+
+TEST_CASE("Test that a large scan does not evict frequently used blocks", "[storage]") {
+	unique_ptr<MaterializedQueryResult> result;
+	auto storage_database = TestCreatePath("storage_test");
+	auto config = GetTestConfig();
+
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE small_table AS SELECT i FROM range(0, 100000) tbl(i)"));
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE big_table AS SELECT i FROM range(0, 3000000) tbl(i)"));
+	}
+	// restart with a memory limit of 4MB, which is smaller than the big table
+	config->maximum_memory = 4000000;
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+
+		result = con.Query("PRAGMA buffer_manager_stats");
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(4000000)}));
+
+		// scan the small table twice: the second scan finds all blocks in memory
+		for (idx_t i = 0; i < 2; i++) {
+			result = con.Query("SELECT SUM(i) FROM small_table");
+			REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(4999950000)}));
+		}
+		auto misses = BufferManagerMisses(con);
+		result = con.Query("SELECT SUM(i) FROM small_table");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(4999950000)}));
+		REQUIRE(BufferManagerMisses(con) == misses);
+
+		// the big table does not fit in memory: scanning it requires evicting blocks
+		result = con.Query("SELECT SUM(i) FROM big_table");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(4499998500000)}));
+		result = con.Query(
+		    "SELECT evictions > 0, misses > 0, memory_usage <= memory_limit FROM pragma_buffer_manager_stats()");
+		REQUIRE(CHECK_COLUMN(result, 0, {true}));
+		REQUIRE(CHECK_COLUMN(result, 1, {true}));
+		REQUIRE(CHECK_COLUMN(result, 2, {true}));
+
+		// the blocks of the small table were used repeatedly, so they are not evicted by the scan of the big table
+		misses = BufferManagerMisses(con);
+		result = con.Query("SELECT SUM(i) FROM small_table");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(4999950000)}));
+		REQUIRE(BufferManagerMisses(con) == misses);
+	}
+	DeleteDatabase(storage_database);
+}
+
+TEST_CASE("Test reading ahead the blocks of a persistent table during a scan", "[storage]") {
+	unique_ptr<MaterializedQueryResult> result;
+	auto storage_database = TestCreatePath("storage_test");
+	auto config = GetTestConfig();
+
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers AS SELECT i, i::VARCHAR AS s, i * 1000000007 AS j FROM "
+		                          "range(0, 1000000) tbl(i)"));
+	}
+	for (idx_t limit = 0; limit < 2; limit++) {
+		// restart the database: none of the blocks of the table are in memory
+		if (limit == 1) {
+			// read-ahead also works when blocks have to be evicted to make room for the prefetched blocks
+			config->maximum_memory = 4000000;
+		}
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT COUNT(*), SUM(i), SUM(LENGTH(s)), SUM(j) FROM integers");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(1000000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(499999500000)}));
+		REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(5888890)}));
+		REQUIRE(CHECK_COLUMN(result, 3, {Value::HUGEINT(hugeint_t(499999500000) * hugeint_t(1000000007))}));
+
+		result = con.Query("SELECT prefetches > 0 FROM pragma_buffer_manager_stats()");
+		REQUIRE(CHECK_COLUMN(result, 0, {true}));
+
+		// updated segments are not read from their original blocks
+		// the update is rolled back so the next iteration starts from the same table
+		REQUIRE_NO_FAIL(con.Query("BEGIN TRANSACTION"));
+		REQUIRE_NO_FAIL(con.Query("UPDATE integers SET i = i + 1 WHERE i % 100000 = 0"));
+		result = con.Query("SELECT COUNT(*), SUM(i), SUM(LENGTH(s)) FROM integers");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(1000000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(499999500010)}));
+		REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(5888890)}));
+		REQUIRE_NO_FAIL(con.Query("ROLLBACK"));
+	}
+	DeleteDatabase(storage_database);
+}
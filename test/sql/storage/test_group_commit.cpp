@@ -0,0 +1,122 @@
+#include "catch.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "test_helpers.hpp"
+
+#include <thread>
+
+using namespace duckdb;
+using namespace std;
+
+static constexpr idx_t GROUP_COMMIT_THREAD_COUNT = 8;
+static constexpr idx_t GROUP_COMMIT_INSERT_COUNT = 100;
+
+static void group_commit_insert(DuckDB *db, bool *correct, idx_t threadnr) {
+	correct[threadnr] = true;
+	Connection con(*db);
+	for (idx_t i = 0; i < GROUP_COMMIT_INSERT_COUNT; i++) {
+		// every insert is committed separately
+		auto value = threadnr * GROUP_COMMIT_INSERT_COUNT + i;
+		if (!con.Query("INSERT INTO integers VALUES (" + to_string(value) + ")")->success) {
+			correct[threadnr] = false;
+		}
+	}
+}
+
+TEST_CASE("Test concurrent commits sharing WAL syncs", "[storage]") {
+	auto config = GetTestConfig();
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("group_commit_test");
+
+	idx_t total_count = GROUP_COMMIT_THREAD_COUNT * GROUP_COMMIT_INSERT_COUNT;
+	idx_t total_sum = total_count * (total_count - 1) / 2;
+	// make sure the database does not exist
+	DeleteDatabase(storage_database);
+	for (idx_t commit_delay : {0, 100}) {
+		{
+			DuckDB db(storage_database, config.get());
+			Connection con(db);
+			REQUIRE_NO_FAIL(con.Query("PRAGMA commit_delay=" + to_string(commit_delay)));
+			REQUIRE_NO_FAIL(con.Query("DROP TABLE IF EXISTS integers"));
+			REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER)"));
+
+			bool correct[GROUP_COMMIT_THREAD_COUNT];
+			thread threads[GROUP_COMMIT_THREAD_COUNT];
+			for (idx_t i = 0; i < GROUP_COMMIT_THREAD_COUNT; i++) {
+				threads[i] = thread(group_commit_insert, &db, correct, i);
+			}
+			for (idx_t i = 0; i < GROUP_COMMIT_THREAD_COUNT; i++) {
+				threads[i].join();
+				REQUIRE(correct[i]);
+			}
+			result = con.Query("SELECT COUNT(*), SUM(i) FROM integers");
+			REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(total_count)}));
+			REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(total_sum)}));
+		}
+		// all commits are in the WAL after a restart
+		{
+			DuckDB db(storage_database, config.get());
+			Connection con(db);
+			result = con.Query("SELECT COUNT(*), SUM(i) FROM integers");
+			REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(total_count)}));
+			REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(total_sum)}));
+		}
+	}
+	DeleteDatabase(storage_database);
+}
+
+static void group_commit_temp_insert(DuckDB *db, bool *correct, idx_t threadnr) {
+	correct[threadnr] = true;
+	Connection con(*db);
+	if (!con.Query("CREATE TEMPORARY TABLE temp_integers(i INTEGER)")->success) {
+		correct[threadnr] = false;
+		return;
+	}
+	for (idx_t i = 0; i < GROUP_COMMIT_INSERT_COUNT; i++) {
+		// the commit does not write to the WAL: it has to be visible to the next transaction of this connection, even
+		// if the commits of the other threads are still waiting for their WAL sync
+		if (!con.Query("INSERT INTO temp_integers VALUES (" + to_string(i) + ")")->success) {
+			correct[threadnr] = false;
+		}
+		auto result = con.Query("SELECT COUNT(*) FROM temp_integers");
+		if (!CHECK_COLUMN(result, 0, {Value::BIGINT(i + 1)})) {
+			correct[threadnr] = false;
+		}
+	}
+}
+
+TEST_CASE("Test commits without WAL changes while other commits wait for their WAL sync", "[storage]") {
+	auto config = GetTestConfig();
+	auto storage_database = TestCreatePath("group_commit_temp_test");
+
+	// make sure the database does not exist
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("PRAGMA commit_delay=100"));
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER)"));
+
+		// half of the threads commit to a persistent table, the other half to a temporary table
+		bool correct[GROUP_COMMIT_THREAD_COUNT];
+		thread threads[GROUP_COMMIT_THREAD_COUNT];
+		for (idx_t i = 0; i < GROUP_COMMIT_THREAD_COUNT; i++) {
+			threads[i] = thread(i % 2 == 0 ? group_commit_insert : group_commit_temp_insert, &db, correct, i);
+		}
+		for (idx_t i = 0; i < GROUP_COMMIT_THREAD_COUNT; i++) {
+			threads[i].join();
+			REQUIRE(correct[i]);
+		}
+	}
+	DeleteDatabase(storage_database);
+}
+
+TEST_CASE("Test commit delay pragma", "[storage]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	REQUIRE_NO_FAIL(con.Query("PRAGMA commit_delay=1000"));
+	REQUIRE(db.config.commit_delay == 1000);
+	REQUIRE_FAIL(con.Query("PRAGMA commit_delay=-1"));
+	REQUIRE_NO_FAIL(con.Query("PRAGMA commit_delay=0"));
+	REQUIRE(db.config.commit_delay == 0);
+}
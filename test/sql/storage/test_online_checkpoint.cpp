@@ -0,0 +1,191 @@
+#include "catch.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/serializer/buffered_file_reader.hpp"
+#include "test_helpers.hpp"
+
+using namespace duckdb;
+using namespace std;
+
+static idx_t GetWALSize(const string &storage_database) {
+	FileSystem fs;
+	BufferedFileReader reader(fs, (storage_database + ".wal").c_str());
+	return reader.FileSize();
+}
+
+TEST_CASE("Test online checkpoints driven by the WAL size", "[storage]") {
+	auto config = GetTestConfig();
+	config->online_checkpoint_wal_size = 0;
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("online_checkpoint_test");
+
+	// make sure the database does not exist
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db), reader(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER, s VARCHAR)"));
+		REQUIRE_NO_FAIL(
+		    con.Query("INSERT INTO integers SELECT i, 'thisisalongerstring' || i::VARCHAR FROM range(0, 100000) tbl(i)"));
+		// the WAL is truncated by the checkpoints that are created after every commit
+		REQUIRE(GetWALSize(storage_database) == 0);
+
+		// a reader that started before a checkpoint keeps its snapshot
+		REQUIRE_NO_FAIL(reader.Query("BEGIN TRANSACTION"));
+		result = reader.Query("SELECT COUNT(*) FROM integers");
+		REQUIRE(CHECK_COLUMN(result, 0, {100000}));
+
+		REQUIRE_NO_FAIL(con.Query("DELETE FROM integers WHERE i % 2 = 0"));
+		REQUIRE_NO_FAIL(con.Query("UPDATE integers SET i = i + 1000000 WHERE i < 1000"));
+		REQUIRE(GetWALSize(storage_database) == 0);
+
+		result = reader.Query("SELECT COUNT(*), SUM(i) FROM integers");
+		REQUIRE(CHECK_COLUMN(result, 0, {100000}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(4999950000)}));
+		REQUIRE_NO_FAIL(reader.Query("COMMIT"));
+
+		result = con.Query("SELECT COUNT(*), SUM(i) FROM integers");
+		REQUIRE(CHECK_COLUMN(result, 0, {50000}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(2500000000 + 500000000)}));
+	}
+	// the data survives a restart, after which the online checkpoints write into the existing file
+	for (idx_t i = 0; i < 2; i++) {
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT COUNT(*), SUM(i) FROM integers");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(50000 + i * 10)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(2500000000 + 500000000 + i * 45)}));
+		result = con.Query("SELECT COUNT(*) FROM integers WHERE s LIKE 'thisisalongerstring%'");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(50000 + i * 10)}));
+
+		// several checkpoints are created while the loaded tables keep reading from the previous checkpoint
+		for (idx_t k = 0; k < 10; k++) {
+			REQUIRE_NO_FAIL(con.Query("INSERT INTO integers VALUES (" + to_string(k) + ", 'thisisalongerstring')"));
+			result = con.Query("SELECT COUNT(*), MAX(s) FROM integers WHERE i % 2 = 1");
+			REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(50000 + i * 5 + (k + 1) / 2)}));
+			REQUIRE(CHECK_COLUMN(result, 1, {"thisisalongerstring99999"}));
+		}
+		REQUIRE(GetWALSize(storage_database) == 0);
+	}
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT COUNT(*), SUM(i) FROM integers");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(50020)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(2500000000 + 500000000 + 90)}));
+	}
+	DeleteDatabase(storage_database);
+}
+
+TEST_CASE("Test online checkpoints keep the row ids of deleted rows", "[storage]") {
+	auto config = GetTestConfig();
+	config->online_checkpoint_wal_size = 100000;
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("online_checkpoint_row_ids_test");
+
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER PRIMARY KEY)"));
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE filler(i INTEGER)"));
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO integers SELECT * FROM range(0, 30)"));
+		REQUIRE_NO_FAIL(con.Query("DELETE FROM integers WHERE i < 10"));
+		// the filler grows the WAL beyond the threshold, the checkpoint contains the deleted rows of integers
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO filler SELECT * FROM range(0, 100000)"));
+		REQUIRE(GetWALSize(storage_database) == 0);
+		// the WAL entries written after the checkpoint refer to the row ids of the rows
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO integers VALUES (100)"));
+		REQUIRE_NO_FAIL(con.Query("DELETE FROM integers WHERE i = 12"));
+		REQUIRE_NO_FAIL(con.Query("UPDATE integers SET i = i + 1000 WHERE i = 13"));
+		REQUIRE(GetWALSize(storage_database) > 0);
+	}
+	for (idx_t i = 0; i < 2; i++) {
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT COUNT(*), SUM(i) FROM integers");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(20)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(1478)}));
+		result = con.Query("SELECT i FROM integers WHERE i = 12 OR i = 13 OR i = 1013 OR i = 100 ORDER BY i");
+		REQUIRE(CHECK_COLUMN(result, 0, {100, 1013}));
+		result = con.Query("SELECT COUNT(*) FROM filler");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(100000)}));
+	}
+	DeleteDatabase(storage_database);
+}
+
+TEST_CASE("Test background checkpoints with concurrent readers", "[storage]") {
+	auto config = GetTestConfig();
+	config->online_checkpoint_wal_size = 100000;
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("background_checkpoint_test");
+
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db), reader(db);
+		REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER)"));
+		for (idx_t i = 0; i < 20; i++) {
+			REQUIRE_NO_FAIL(con.Query("INSERT INTO integers SELECT * FROM range(0, 10000)"));
+			result = reader.Query("SELECT COUNT(*), SUM(i) FROM integers");
+			REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT((i + 1) * 10000)}));
+			REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT((i + 1) * 49995000)}));
+		}
+	}
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT COUNT(*), SUM(i) FROM integers");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(200000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(999900000)}));
+	}
+	DeleteDatabase(storage_database);
+}
+
+TEST_CASE("Test checkpoints writing the columns of several tables in parallel", "[storage]") {
+	auto config = GetTestConfig();
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("parallel_checkpoint_test");
+
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE a(i INTEGER, s VARCHAR, d DOUBLE)"));
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE b(i BIGINT, j INTEGER)"));
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE c(s VARCHAR)"));
+		REQUIRE_NO_FAIL(con.Query("CREATE VIEW v AS SELECT COUNT(*) AS cnt FROM b"));
+		REQUIRE_NO_FAIL(con.Query("BEGIN TRANSACTION"));
+		REQUIRE_NO_FAIL(
+		    con.Query("INSERT INTO a SELECT i, 'string' || i::VARCHAR, i / 2.0 FROM range(0, 300000) tbl(i)"));
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO b SELECT i % 100, 7 FROM range(0, 500000) tbl(i)"));
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO c SELECT repeat('x', 5000) || i::VARCHAR FROM range(0, 200) tbl(i)"));
+		REQUIRE_NO_FAIL(con.Query("COMMIT"));
+		REQUIRE_NO_FAIL(con.Query("UPDATE b SET j = 8 WHERE i = 0"));
+	}
+	for (idx_t i = 0; i < 2; i++) {
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+		result = con.Query("SELECT COUNT(*), SUM(i), SUM(LENGTH(s)), SUM(d) FROM a");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(300000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(44999850000)}));
+		REQUIRE(CHECK_COLUMN(result, 2, {Value::HUGEINT(3488890)}));
+		REQUIRE(CHECK_COLUMN(result, 3, {Value::DOUBLE(22499925000)}));
+		result = con.Query("SELECT COUNT(*), SUM(i), SUM(j) FROM b");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(500000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(24750000)}));
+		REQUIRE(CHECK_COLUMN(result, 2, {Value::HUGEINT(3505000)}));
+		result = con.Query("SELECT COUNT(*), MIN(s) = repeat('x', 5000) || '0', SUM(LENGTH(s)) FROM c");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(200)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {true}));
+		REQUIRE(CHECK_COLUMN(result, 2, {Value::HUGEINT(1000490)}));
+		result = con.Query("SELECT cnt FROM v");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(500000)}));
+		// write another checkpoint with the data of the loaded checkpoint
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO c VALUES (NULL)"));
+		REQUIRE_NO_FAIL(con.Query("DELETE FROM c WHERE s IS NULL"));
+	}
+	DeleteDatabase(storage_database);
+}
@@ -0,0 +1,68 @@
+#include "catch.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "test_helpers.hpp"
+
+using namespace duckdb;
+using namespace std;
+
+TEST_CASE("Test replaying a WAL with appends to several tables in parallel", "[storage]") {
+	auto config = GetTestConfig();
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("wal_replay_test");
+
+	// never checkpoint: everything has to be replayed from the WAL
+	config->checkpoint_wal_size = (idx_t)-1;
+	config->wal_replay_threads = 4;
+
+	// make sure the database does not exist
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE a(i INTEGER PRIMARY KEY, s VARCHAR)"));
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE b(i INTEGER, j INTEGER)"));
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE c(i INTEGER UNIQUE)"));
+		// a single transaction appending to all tables
+		REQUIRE_NO_FAIL(con.Query("BEGIN TRANSACTION"));
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO a SELECT i, 'hello' || i::VARCHAR FROM range(0, 200000) tbl(i)"));
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO b SELECT i, i * 2 FROM range(0, 300000) tbl(i)"));
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO c SELECT i FROM range(0, 100000) tbl(i)"));
+		REQUIRE_NO_FAIL(con.Query("COMMIT"));
+		// deletes and updates that have to be replayed after the appends
+		REQUIRE_NO_FAIL(con.Query("DELETE FROM a WHERE i % 2 = 0"));
+		REQUIRE_NO_FAIL(con.Query("UPDATE b SET j = 0 WHERE i < 1000"));
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO a VALUES (0, 'zero')"));
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO c SELECT i FROM range(100000, 150000) tbl(i)"));
+		// a transaction that is rolled back is not replayed
+		REQUIRE_NO_FAIL(con.Query("BEGIN TRANSACTION"));
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO b SELECT i, i FROM range(0, 1000) tbl(i)"));
+		REQUIRE_NO_FAIL(con.Query("ROLLBACK"));
+	}
+	for (idx_t replay_threads : {4, 1}) {
+		config->wal_replay_threads = replay_threads;
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT COUNT(*), SUM(i), MIN(s) FROM a");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(100001)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(10000000000)}));
+		REQUIRE(CHECK_COLUMN(result, 2, {"hello1"}));
+		result = con.Query("SELECT COUNT(*), SUM(i), SUM(j) FROM b");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(300000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(44999850000)}));
+		REQUIRE(CHECK_COLUMN(result, 2, {Value::HUGEINT(89999700000 - 999000)}));
+		result = con.Query("SELECT COUNT(*), SUM(i) FROM c");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(150000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(11249925000)}));
+
+		// the indexes contain the replayed rows
+		result = con.Query("SELECT s FROM a WHERE i = 0");
+		REQUIRE(CHECK_COLUMN(result, 0, {"zero"}));
+		result = con.Query("SELECT s FROM a WHERE i = 199999");
+		REQUIRE(CHECK_COLUMN(result, 0, {"hello199999"}));
+		REQUIRE_FAIL(con.Query("INSERT INTO a VALUES (12345, 'duplicate')"));
+		REQUIRE_FAIL(con.Query("INSERT INTO c VALUES (149999)"));
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO c VALUES (150000)"));
+		REQUIRE_NO_FAIL(con.Query("DELETE FROM c WHERE i = 150000"));
+	}
+	DeleteDatabase(storage_database);
+}